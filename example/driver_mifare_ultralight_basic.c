@@ -38,6 +38,17 @@
 
 static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
 
+/**
+ * @brief mifare_ultralight basic job structure definition
+ */
+typedef struct mifare_ultralight_basic_job_s
+{
+    uint8_t start_page;        /**< start page */
+    uint8_t stop_page;         /**< stop page */
+    uint8_t *data;             /**< data buffer */
+    uint16_t *len;             /**< data length buffer */
+} mifare_ultralight_basic_job_t;
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -50,6 +61,70 @@ static void s_debug_print(const char *const fmt, ...)
     return;
 }
 
+/**
+ * @brief     read page job
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *arg pointer to a job structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_basic_read_page(mifare_ultralight_handle_t *handle, void *arg)
+{
+    mifare_ultralight_basic_job_t *job = (mifare_ultralight_basic_job_t *)arg;
+    
+    return mifare_ultralight_read_page(handle, job->start_page, job->data);
+}
+
+/**
+ * @brief     read four pages job
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *arg pointer to a job structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_basic_read_four_pages(mifare_ultralight_handle_t *handle, void *arg)
+{
+    mifare_ultralight_basic_job_t *job = (mifare_ultralight_basic_job_t *)arg;
+    
+    return mifare_ultralight_read_four_pages(handle, job->start_page, job->data);
+}
+
+/**
+ * @brief     fast read job
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *arg pointer to a job structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_basic_fast_read_page(mifare_ultralight_handle_t *handle, void *arg)
+{
+    mifare_ultralight_basic_job_t *job = (mifare_ultralight_basic_job_t *)arg;
+    
+    return mifare_ultralight_fast_read_page(handle, job->start_page, job->stop_page, job->data, job->len);
+}
+
+/**
+ * @brief     write page job
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *arg pointer to a job structure
+ * @return    status code
+ *            - 0 success
+ *            - others write failed
+ * @note      none
+ */
+static uint8_t a_basic_write_page(mifare_ultralight_handle_t *handle, void *arg)
+{
+    mifare_ultralight_basic_job_t *job = (mifare_ultralight_basic_job_t *)arg;
+    
+    return mifare_ultralight_write_page(handle, job->start_page, job->data);
+}
+
 /**
  * @brief  basic example init
  * @return status code
@@ -60,6 +135,7 @@ static void s_debug_print(const char *const fmt, ...)
 uint8_t mifare_ultralight_basic_init(void)
 {
     uint8_t res;
+    mifare_ultralight_retry_policy_t policy;
     
     /* link function */
     DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
@@ -67,6 +143,8 @@ uint8_t mifare_ultralight_basic_init(void)
     DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
     DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_interface_contactless_transceiver);
     DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
 #ifndef NO_DEBUG
     DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
 #else
@@ -82,6 +160,23 @@ uint8_t mifare_ultralight_basic_init(void)
         return 1;
     }
     
+    /* set the retry policy */
+    memset(&policy, 0, sizeof(mifare_ultralight_retry_policy_t));
+    policy.failure[MIFARE_ULTRALIGHT_FAILURE_CORRUPT].budget = MIFARE_ULTRALIGHT_BASIC_DEFAULT_CORRUPT_BUDGET;
+    policy.failure[MIFARE_ULTRALIGHT_FAILURE_NO_RESPONSE].budget = MIFARE_ULTRALIGHT_BASIC_DEFAULT_NO_RESPONSE_BUDGET;
+    policy.failure[MIFARE_ULTRALIGHT_FAILURE_NO_RESPONSE].backoff_us = MIFARE_ULTRALIGHT_BASIC_DEFAULT_NO_RESPONSE_BACKOFF_US;
+    policy.failure[MIFARE_ULTRALIGHT_FAILURE_NAK_TRANSIENT].budget = MIFARE_ULTRALIGHT_BASIC_DEFAULT_NAK_TRANSIENT_BUDGET;
+    policy.max_retry = MIFARE_ULTRALIGHT_BASIC_DEFAULT_MAX_RETRY;
+    policy.max_backoff_us = MIFARE_ULTRALIGHT_BASIC_DEFAULT_MAX_BACKOFF_US;
+    res = mifare_ultralight_set_retry_policy(&gs_handle, &policy);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set retry policy failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
     return 0;
 }
 
@@ -162,56 +257,42 @@ uint8_t mifare_ultralight_basic_wake_up(void)
 uint8_t mifare_ultralight_basic_search(mifare_ultralight_storage_t *type, uint8_t id[8], int32_t timeout)
 {
     uint8_t res;
-    mifare_ultralight_type_t t;
+    uint8_t nak;
+    uint8_t fast;
+    mifare_ultralight_failure_t failure;
+    mifare_ultralight_activation_t activation;
     
     /* loop */
+    fast = 0;
     while (1)
     {
-        /* request */
-        res = mifare_ultralight_request(&gs_handle, &t);
+        /* forget the failure of the last round */
+        gs_handle.error = MIFARE_ULTRALIGHT_STATS_ERROR_MAX;
+        gs_handle.nak = MIFARE_ULTRALIGHT_NAK_NONE;
+        
+        /* request, anti collision, select, read page 0 and get version */
+        res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_NONE, &activation);
         if (res == 0)
         {
-            /* anti collision_cl1 */
-            res = mifare_ultralight_anticollision_cl1(&gs_handle, id);
-            if (res == 0)
-            {
-                /* cl1 */
-                res = mifare_ultralight_select_cl1(&gs_handle, id);
-                if (res == 0)
-                {
-                    /* anti collision_cl2 */
-                    res = mifare_ultralight_anticollision_cl2(&gs_handle, id + 4);
-                    if (res == 0)
-                    {
-                        /* cl2 */
-                        res = mifare_ultralight_select_cl2(&gs_handle, id + 4);
-                        if (res == 0)
-                        {
-                            uint8_t data[4];
-                            
-                            /* read page 0 */
-                            res = mifare_ultralight_read_page(&gs_handle, 0x00, data);
-                            if (res == 0)
-                            {
-                                mifare_ultralight_version_t version;
-                                
-                                /* get the chip version */
-                                res = mifare_ultralight_get_version(&gs_handle, &version);
-                                if (res == 0)
-                                {
-                                    /* get the type */
-                                    res = mifare_ultralight_get_storage(&gs_handle, type);
-                                    if (res == 0)
-                                    {
-                                        return 0;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
+            /* cascade tag and uid */
+            id[0] = 0x88;
+            memcpy(id + 1, activation.uid, 7);
+            *type = activation.storage;
+            
+            return 0;
+        }
+        
+        /* a card answered, retry at once */
+        (void)mifare_ultralight_get_failure(&gs_handle, &failure, &nak);
+        if ((failure != MIFARE_ULTRALIGHT_FAILURE_NONE) && 
+            (failure != MIFARE_ULTRALIGHT_FAILURE_NO_RESPONSE) && 
+            (fast < MIFARE_ULTRALIGHT_BASIC_DEFAULT_SEARCH_FAST_RETRY))
+        {
+            fast++;
+            
+            continue;
         }
+        fast = 0;
         
         /* delay */
         mifare_ultralight_interface_delay_ms(MIFARE_MIFARE_ULTRALIGHT_DEFAULT_SEARCH_DELAY_MS);
@@ -250,9 +331,14 @@ uint8_t mifare_ultralight_basic_search(mifare_ultralight_storage_t *type, uint8_
 uint8_t mifare_ultralight_basic_read(uint8_t page, uint8_t data[4])
 {
     uint8_t res;
+    mifare_ultralight_basic_job_t job;
     
     /* read */
-    res = mifare_ultralight_read_page(&gs_handle, page, data);
+    job.start_page = page;
+    job.stop_page = page;
+    job.data = data;
+    job.len = NULL;
+    res = mifare_ultralight_retry(&gs_handle, a_basic_read_page, &job, MIFARE_ULTRALIGHT_RETRY_FLAG_NONE);
     if (res != 0)
     {
         return 1;
@@ -273,9 +359,14 @@ uint8_t mifare_ultralight_basic_read(uint8_t page, uint8_t data[4])
 uint8_t mifare_ultralight_basic_read_four_pages(uint8_t start_page, uint8_t data[16])
 {
     uint8_t res;
+    mifare_ultralight_basic_job_t job;
     
     /* read */
-    res = mifare_ultralight_read_four_pages(&gs_handle, start_page, data);
+    job.start_page = start_page;
+    job.stop_page = start_page;
+    job.data = data;
+    job.len = NULL;
+    res = mifare_ultralight_retry(&gs_handle, a_basic_read_four_pages, &job, MIFARE_ULTRALIGHT_RETRY_FLAG_NONE);
     if (res != 0)
     {
         return 1;
@@ -299,9 +390,14 @@ uint8_t mifare_ultralight_basic_read_four_pages(uint8_t start_page, uint8_t data
 uint8_t mifare_ultralight_basic_read_pages(uint8_t start_page, uint8_t stop_page, uint8_t *data, uint16_t *len)
 {
     uint8_t res;
+    mifare_ultralight_basic_job_t job;
     
     /* fast read */
-    res = mifare_ultralight_fast_read_page(&gs_handle, start_page, stop_page, data, len);
+    job.start_page = start_page;
+    job.stop_page = stop_page;
+    job.data = data;
+    job.len = len;
+    res = mifare_ultralight_retry(&gs_handle, a_basic_fast_read_page, &job, MIFARE_ULTRALIGHT_RETRY_FLAG_NONE);
     if (res != 0)
     {
         return 1;
@@ -322,9 +418,14 @@ uint8_t mifare_ultralight_basic_read_pages(uint8_t start_page, uint8_t stop_page
 uint8_t mifare_ultralight_basic_write(uint8_t page, uint8_t data[4])
 {
     uint8_t res;
+    mifare_ultralight_basic_job_t job;
     
     /* write */
-    res = mifare_ultralight_write_page(&gs_handle, page, data);
+    job.start_page = page;
+    job.stop_page = page;
+    job.data = data;
+    job.len = NULL;
+    res = mifare_ultralight_retry(&gs_handle, a_basic_write_page, &job, MIFARE_ULTRALIGHT_RETRY_FLAG_NONE);
     if (res != 0)
     {
         return 1;
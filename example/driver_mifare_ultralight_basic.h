@@ -54,6 +54,13 @@ extern "C"{
  * @brief mifare_ultralight basic example default definition
  */
 #define MIFARE_MIFARE_ULTRALIGHT_DEFAULT_SEARCH_DELAY_MS        200        /**< 5Hz */
+#define MIFARE_ULTRALIGHT_BASIC_DEFAULT_SEARCH_FAST_RETRY       2          /**< 2 times */
+#define MIFARE_ULTRALIGHT_BASIC_DEFAULT_CORRUPT_BUDGET          2          /**< 2 times */
+#define MIFARE_ULTRALIGHT_BASIC_DEFAULT_NO_RESPONSE_BUDGET      1          /**< 1 time */
+#define MIFARE_ULTRALIGHT_BASIC_DEFAULT_NO_RESPONSE_BACKOFF_US  5000       /**< 5ms */
+#define MIFARE_ULTRALIGHT_BASIC_DEFAULT_NAK_TRANSIENT_BUDGET    1          /**< 1 time */
+#define MIFARE_ULTRALIGHT_BASIC_DEFAULT_MAX_RETRY               3          /**< 3 times */
+#define MIFARE_ULTRALIGHT_BASIC_DEFAULT_MAX_BACKOFF_US          20000      /**< 20ms */
 
 /**
  * @brief  basic example init
@@ -0,0 +1,333 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_manager.c
+ * @brief     driver mifare_ultralight manager source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_manager.h"
+
+/**
+ * @brief     manager take a runnable job
+ * @param[in] *manager pointer to a manager structure
+ * @return    pointer to a job or NULL
+ * @note      the manager lock must be held, the reader of the job is marked busy
+ */
+static mifare_ultralight_manager_job_t *a_mifare_ultralight_manager_take(mifare_ultralight_manager_t *manager)
+{
+    uint16_t i;
+    uint16_t j;
+    uint8_t r;
+    mifare_ultralight_manager_job_t *job;
+    
+    for (i = 0; i < manager->queue_count; i++)                                       /* scan in submit order */
+    {
+        job = manager->queue[i];                                                     /* get the job */
+        r = 0xFF;                                                                    /* no reader */
+        if (job->reader == MIFARE_ULTRALIGHT_MANAGER_ANY_READER)                     /* any reader */
+        {
+            for (j = 0; j < manager->reader_count; j++)                              /* find a free reader */
+            {
+                if (manager->busy[j] == 0)                                           /* check the busy flag */
+                {
+                    r = (uint8_t)j;                                                  /* set the reader */
+                    
+                    break;                                                           /* break */
+                }
+            }
+        }
+        else if (manager->busy[job->reader] == 0)                                    /* check the busy flag */
+        {
+            r = job->reader;                                                         /* set the reader */
+        }
+        else
+        {
+            continue;                                                                /* the reader is busy */
+        }
+        if (r == 0xFF)                                                               /* no free reader */
+        {
+            return NULL;                                                             /* every reader is busy */
+        }
+        for (j = i; j + 1 < manager->queue_count; j++)                               /* remove from the queue */
+        {
+            manager->queue[j] = manager->queue[j + 1];                               /* shift */
+        }
+        manager->queue_count--;                                                      /* queue count-- */
+        manager->busy[r] = 1;                                                        /* mark the reader busy */
+        job->used_reader = r;                                                        /* set the used reader */
+        
+        return job;                                                                  /* return the job */
+    }
+    
+    return NULL;                                                                     /* nothing runnable */
+}
+
+/**
+ * @brief     manager worker thread
+ * @param[in] *arg pointer to a manager structure
+ * @return    NULL
+ * @note      none
+ */
+static void *a_mifare_ultralight_manager_worker(void *arg)
+{
+    mifare_ultralight_manager_t *manager = (mifare_ultralight_manager_t *)arg;
+    mifare_ultralight_manager_job_t *job;
+    uint8_t r;
+    
+    pthread_mutex_lock(&manager->mutex);                                             /* lock */
+    while (1)
+    {
+        job = a_mifare_ultralight_manager_take(manager);                             /* take a job */
+        if (job == NULL)                                                             /* nothing runnable */
+        {
+            if ((manager->stop != 0) && (manager->queue_count == 0))                 /* check the stop flag */
+            {
+                break;                                                               /* exit */
+            }
+            pthread_cond_wait(&manager->job_cond, &manager->mutex);                  /* wait for a job or a reader */
+            
+            continue;                                                                /* retry */
+        }
+        r = job->used_reader;                                                        /* get the reader */
+        pthread_cond_broadcast(&manager->done_cond);                                 /* queue space */
+        pthread_mutex_unlock(&manager->mutex);                                       /* unlock */
+        
+        job->res = job->run(manager->handle[r], job->arg);                           /* run the job without the lock */
+        
+        pthread_mutex_lock(&manager->mutex);                                         /* lock */
+        manager->busy[r] = 0;                                                        /* free the reader */
+        job->done = 1;                                                               /* set the done flag */
+        pthread_cond_broadcast(&manager->done_cond);                                 /* job done */
+        pthread_cond_broadcast(&manager->job_cond);                                  /* reader freed */
+    }
+    pthread_mutex_unlock(&manager->mutex);                                           /* unlock */
+    
+    return NULL;                                                                     /* exit */
+}
+
+/**
+ * @brief     manager init
+ * @param[in] *manager pointer to a manager structure
+ * @param[in] **handle pointer to a linked handle array
+ * @param[in] reader_count reader number
+ * @param[in] worker_count worker number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 manager is NULL
+ *            - 4 param is invalid
+ * @note      the manager owns the handles and inits every one of them,
+ *            each handle should carry its own reader context in the user field
+ */
+uint8_t mifare_ultralight_manager_init(mifare_ultralight_manager_t *manager, mifare_ultralight_handle_t **handle,
+                                       uint8_t reader_count, uint8_t worker_count)
+{
+    uint8_t i;
+    uint8_t j;
+    
+    if (manager == NULL)                                                             /* check the manager */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if ((handle == NULL) || (reader_count == 0) || 
+        (reader_count > MIFARE_ULTRALIGHT_MANAGER_MAX_READER) ||
+        (worker_count == 0) || (worker_count > MIFARE_ULTRALIGHT_MANAGER_MAX_WORKER))   /* check the param */
+    {
+        return 4;                                                                    /* return error */
+    }
+    
+    for (i = 0; i < reader_count; i++)                                               /* init all readers */
+    {
+        if ((handle[i] == NULL) || (mifare_ultralight_init(handle[i]) != 0))         /* init the reader */
+        {
+            for (j = 0; j < i; j++)                                                  /* roll back */
+            {
+                (void)mifare_ultralight_deinit(handle[j]);                           /* deinit the reader */
+            }
+            
+            return 1;                                                                /* return error */
+        }
+        manager->handle[i] = handle[i];                                              /* save the handle */
+        manager->busy[i] = 0;                                                        /* reader is free */
+    }
+    manager->reader_count = reader_count;                                            /* set the reader count */
+    manager->queue_count = 0;                                                        /* empty queue */
+    manager->stop = 0;                                                               /* clear the stop flag */
+    pthread_mutex_init(&manager->mutex, NULL);                                       /* init the lock */
+    pthread_cond_init(&manager->job_cond, NULL);                                     /* init the job condition */
+    pthread_cond_init(&manager->done_cond, NULL);                                    /* init the done condition */
+    for (i = 0; i < worker_count; i++)                                               /* start all workers */
+    {
+        if (pthread_create(&manager->worker[i], NULL, 
+                           a_mifare_ultralight_manager_worker, manager) != 0)        /* create the worker */
+        {
+            break;                                                                   /* break */
+        }
+    }
+    manager->worker_count = i;                                                       /* set the worker count */
+    manager->inited = 1;                                                             /* flag finish initialization */
+    if (i != worker_count)                                                           /* check the workers */
+    {
+        (void)mifare_ultralight_manager_deinit(manager);                             /* stop the started workers */
+        
+        return 1;                                                                    /* return error */
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     manager deinit
+ * @param[in] *manager pointer to a manager structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ *            - 2 manager is NULL
+ *            - 3 manager is not inited
+ * @note      the queued jobs are finished before the workers stop
+ */
+uint8_t mifare_ultralight_manager_deinit(mifare_ultralight_manager_t *manager)
+{
+    uint8_t i;
+    uint8_t res;
+    
+    if (manager == NULL)                                                             /* check the manager */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (manager->inited != 1)                                                        /* check the manager initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    pthread_mutex_lock(&manager->mutex);                                             /* lock */
+    manager->stop = 1;                                                               /* set the stop flag */
+    pthread_cond_broadcast(&manager->job_cond);                                      /* wake up all workers */
+    pthread_mutex_unlock(&manager->mutex);                                           /* unlock */
+    for (i = 0; i < manager->worker_count; i++)                                      /* join all workers */
+    {
+        (void)pthread_join(manager->worker[i], NULL);                                /* join the worker */
+    }
+    res = 0;                                                                         /* init 0 */
+    for (i = 0; i < manager->reader_count; i++)                                      /* deinit all readers */
+    {
+        if (mifare_ultralight_deinit(manager->handle[i]) != 0)                       /* deinit the reader */
+        {
+            res = 1;                                                                 /* flag the error */
+        }
+    }
+    pthread_cond_destroy(&manager->done_cond);                                       /* destroy the done condition */
+    pthread_cond_destroy(&manager->job_cond);                                        /* destroy the job condition */
+    pthread_mutex_destroy(&manager->mutex);                                          /* destroy the lock */
+    manager->inited = 0;                                                             /* flag close */
+    
+    return res;                                                                      /* return the result */
+}
+
+/**
+ * @brief     manager submit a job
+ * @param[in] *manager pointer to a manager structure
+ * @param[in] *job pointer to a job structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 manager is NULL
+ *            - 3 manager is not inited
+ *            - 4 job is invalid
+ * @note      blocks while the queue is full, the job must stay valid until it is done
+ */
+uint8_t mifare_ultralight_manager_submit(mifare_ultralight_manager_t *manager, mifare_ultralight_manager_job_t *job)
+{
+    if (manager == NULL)                                                             /* check the manager */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (manager->inited != 1)                                                        /* check the manager initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if ((job == NULL) || (job->run == NULL) || 
+        ((job->reader != MIFARE_ULTRALIGHT_MANAGER_ANY_READER) && 
+         (job->reader >= manager->reader_count)))                                    /* check the job */
+    {
+        return 4;                                                                    /* return error */
+    }
+    
+    job->done = 0;                                                                   /* clear the done flag */
+    job->res = 0;                                                                    /* clear the result */
+    pthread_mutex_lock(&manager->mutex);                                             /* lock */
+    while (manager->queue_count >= MIFARE_ULTRALIGHT_MANAGER_QUEUE_LEN)              /* check the queue space */
+    {
+        pthread_cond_wait(&manager->done_cond, &manager->mutex);                     /* wait for space */
+    }
+    manager->queue[manager->queue_count] = job;                                      /* queue the job */
+    manager->queue_count++;                                                          /* queue count++ */
+    pthread_cond_signal(&manager->job_cond);                                         /* wake up a worker */
+    pthread_mutex_unlock(&manager->mutex);                                           /* unlock */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     manager wait a job
+ * @param[in] *manager pointer to a manager structure
+ * @param[in] *job pointer to a job structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 manager is NULL
+ *            - 3 manager is not inited
+ *            - 4 job is NULL
+ * @note      the job result is stored in job->res
+ */
+uint8_t mifare_ultralight_manager_wait(mifare_ultralight_manager_t *manager, mifare_ultralight_manager_job_t *job)
+{
+    if (manager == NULL)                                                             /* check the manager */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (manager->inited != 1)                                                        /* check the manager initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if (job == NULL)                                                                 /* check the job */
+    {
+        return 4;                                                                    /* return error */
+    }
+    
+    pthread_mutex_lock(&manager->mutex);                                             /* lock */
+    while (job->done == 0)                                                           /* check the done flag */
+    {
+        pthread_cond_wait(&manager->done_cond, &manager->mutex);                     /* wait for the job */
+    }
+    pthread_mutex_unlock(&manager->mutex);                                           /* unlock */
+    
+    return 0;                                                                        /* success return 0 */
+}
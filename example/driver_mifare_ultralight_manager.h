@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_manager.h
+ * @brief     driver mifare_ultralight manager header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MIFARE_ULTRALIGHT_MANAGER_H
+#define DRIVER_MIFARE_ULTRALIGHT_MANAGER_H
+
+#include "driver_mifare_ultralight.h"
+#include <pthread.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup mifare_ultralight_manager_driver mifare ultralight manager driver function
+ * @brief    mifare ultralight manager driver modules
+ * @ingroup  mifare_ultralight_driver
+ * @{
+ */
+
+/**
+ * @brief mifare_ultralight manager default definition
+ */
+#define MIFARE_ULTRALIGHT_MANAGER_MAX_READER         16          /**< max reader number */
+#define MIFARE_ULTRALIGHT_MANAGER_MAX_WORKER         16          /**< max worker number */
+#define MIFARE_ULTRALIGHT_MANAGER_QUEUE_LEN          64          /**< job queue length */
+#define MIFARE_ULTRALIGHT_MANAGER_ANY_READER         0xFF        /**< run on any free reader */
+
+/**
+ * @brief mifare_ultralight manager job structure definition
+ */
+typedef struct mifare_ultralight_manager_job_s
+{
+    uint8_t reader;                                                          /**< reader index or any reader */
+    uint8_t (*run)(mifare_ultralight_handle_t *handle, void *arg);           /**< point to a job function address */
+    void *arg;                                                               /**< job argument */
+    uint8_t res;                                                             /**< job result */
+    uint8_t used_reader;                                                     /**< reader which ran the job */
+    volatile uint8_t done;                                                   /**< done flag */
+} mifare_ultralight_manager_job_t;
+
+/**
+ * @brief mifare_ultralight manager structure definition
+ */
+typedef struct mifare_ultralight_manager_s
+{
+    mifare_ultralight_handle_t *handle[MIFARE_ULTRALIGHT_MANAGER_MAX_READER];        /**< reader handles */
+    uint8_t busy[MIFARE_ULTRALIGHT_MANAGER_MAX_READER];                              /**< reader busy flags */
+    uint8_t reader_count;                                                            /**< reader number */
+    pthread_t worker[MIFARE_ULTRALIGHT_MANAGER_MAX_WORKER];                          /**< worker threads */
+    uint8_t worker_count;                                                            /**< worker number */
+    mifare_ultralight_manager_job_t *queue[MIFARE_ULTRALIGHT_MANAGER_QUEUE_LEN];     /**< job queue */
+    uint16_t queue_count;                                                            /**< queued job number */
+    pthread_mutex_t mutex;                                                           /**< manager lock */
+    pthread_cond_t job_cond;                                                         /**< job queued or reader freed */
+    pthread_cond_t done_cond;                                                        /**< job done or queue space */
+    uint8_t stop;                                                                    /**< stop flag */
+    uint8_t inited;                                                                  /**< inited flag */
+} mifare_ultralight_manager_t;
+
+/**
+ * @brief     manager init
+ * @param[in] *manager pointer to a manager structure
+ * @param[in] **handle pointer to a linked handle array
+ * @param[in] reader_count reader number
+ * @param[in] worker_count worker number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ *            - 2 manager is NULL
+ *            - 4 param is invalid
+ * @note      the manager owns the handles and inits every one of them,
+ *            each handle should carry its own reader context in the user field
+ */
+uint8_t mifare_ultralight_manager_init(mifare_ultralight_manager_t *manager, mifare_ultralight_handle_t **handle,
+                                       uint8_t reader_count, uint8_t worker_count);
+
+/**
+ * @brief     manager deinit
+ * @param[in] *manager pointer to a manager structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ *            - 2 manager is NULL
+ *            - 3 manager is not inited
+ * @note      the queued jobs are finished before the workers stop
+ */
+uint8_t mifare_ultralight_manager_deinit(mifare_ultralight_manager_t *manager);
+
+/**
+ * @brief     manager submit a job
+ * @param[in] *manager pointer to a manager structure
+ * @param[in] *job pointer to a job structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 manager is NULL
+ *            - 3 manager is not inited
+ *            - 4 job is invalid
+ * @note      blocks while the queue is full, the job must stay valid until it is done
+ */
+uint8_t mifare_ultralight_manager_submit(mifare_ultralight_manager_t *manager, mifare_ultralight_manager_job_t *job);
+
+/**
+ * @brief     manager wait a job
+ * @param[in] *manager pointer to a manager structure
+ * @param[in] *job pointer to a job structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 manager is NULL
+ *            - 3 manager is not inited
+ *            - 4 job is NULL
+ * @note      the job result is stored in job->res
+ */
+uint8_t mifare_ultralight_manager_wait(mifare_ultralight_manager_t *manager, mifare_ultralight_manager_job_t *job);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
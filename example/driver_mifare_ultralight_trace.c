@@ -0,0 +1,555 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_trace.c
+ * @brief     driver mifare_ultralight trace source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_trace.h"
+#include <string.h>
+
+/**
+ * @brief ack and nak text table
+ */
+static const char *const gs_ack[16] =
+{
+    "NAK invalid argument", "NAK crc error", NULL, NULL,
+    "NAK invalid authentication counter", "NAK eeprom write error", NULL, NULL,
+    NULL, NULL, "ACK", NULL,
+    NULL, NULL, NULL, NULL,
+};
+
+/**
+ * @brief     iso14443-a crc check
+ * @param[in] *data pointer to the frame
+ * @param[in] len frame length with the crc
+ * @return    check result
+ *            - 0 crc is wrong
+ *            - 1 crc is right
+ * @note      none
+ */
+static uint8_t a_trace_crc_check(const uint8_t *data, uint8_t len)
+{
+    uint16_t crc = 0x6363;
+    uint8_t i;
+    uint8_t b;
+    
+    for (i = 0; i < len - 2; i++)                                             /* all bytes without the crc */
+    {
+        b = (uint8_t)(data[i] ^ (uint8_t)(crc & 0xFF));                       /* xor the low byte */
+        b = (uint8_t)(b ^ (uint8_t)(b << 4));                                 /* fold */
+        crc = (uint16_t)((crc >> 8) ^ ((uint16_t)b << 8) ^ 
+                         ((uint16_t)b << 3) ^ ((uint16_t)b >> 4));            /* update the crc */
+    }
+    
+    return ((data[len - 2] == (uint8_t)(crc & 0xFF)) && 
+            (data[len - 1] == (uint8_t)(crc >> 8))) ? 1 : 0;                  /* compare the crc */
+}
+
+/**
+ * @brief      annotate a sent frame
+ * @param[in]  dir frame direction
+ * @param[in]  last command of the previous exchange
+ * @param[in]  len frame length
+ * @param[in]  *data pointer to the frame bytes
+ * @param[in]  data_len number of the frame bytes
+ * @param[out] *text pointer to a text buffer
+ * @param[in]  size text buffer size
+ * @note       none
+ */
+static void a_trace_annotate_tx(uint8_t dir, uint8_t last, uint8_t len, const uint8_t *data, uint8_t data_len,
+                                char *text, uint16_t size)
+{
+    if (data_len == 0)
+    {
+        (void)snprintf(text, size, "empty frame");
+        
+        return;
+    }
+    if (dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX_BITS)
+    {
+        if ((len == 7) && (data[0] == 0x26))
+        {
+            (void)snprintf(text, size, "REQA");
+        }
+        else if ((len == 7) && (data[0] == 0x52))
+        {
+            (void)snprintf(text, size, "WUPA");
+        }
+        else if ((data_len >= 2) && ((data[0] == 0x93) || (data[0] == 0x95) || (data[0] == 0x97)))
+        {
+            (void)snprintf(text, size, "ANTICOLLISION CL%u, %u known bits", (unsigned int)((data[0] - 0x93) / 2 + 1), 
+                           (unsigned int)(((data[1] >> 4) - 2) * 8 + (data[1] & 0x0F)));
+        }
+        else
+        {
+            (void)snprintf(text, size, "short frame");
+        }
+        
+        return;
+    }
+    if ((last == 0xA0) && (len == 18))
+    {
+        (void)snprintf(text, size, "COMP_WRITE data");
+        
+        return;
+    }
+    switch (data[0])
+    {
+        case 0x26 :
+        case 0x52 :
+        {
+            (void)snprintf(text, size, "%s", (data[0] == 0x26) ? "REQA" : "WUPA");
+            
+            break;
+        }
+        case 0x93 :
+        case 0x95 :
+        case 0x97 :
+        {
+            if ((data_len >= 2) && (data[1] == 0x70))
+            {
+                (void)snprintf(text, size, "SELECT CL%u", (unsigned int)((data[0] - 0x93) / 2 + 1));
+            }
+            else
+            {
+                (void)snprintf(text, size, "ANTICOLLISION CL%u", (unsigned int)((data[0] - 0x93) / 2 + 1));
+            }
+            
+            break;
+        }
+        case 0x50 :
+        {
+            (void)snprintf(text, size, "HALT");
+            
+            break;
+        }
+        case 0x60 :
+        {
+            (void)snprintf(text, size, "GET_VERSION");
+            
+            break;
+        }
+        case 0x30 :
+        {
+            (void)snprintf(text, size, "READ page 0x%02X", (data_len >= 2) ? data[1] : 0);
+            
+            break;
+        }
+        case 0x3A :
+        {
+            (void)snprintf(text, size, "FAST_READ pages 0x%02X-0x%02X", (data_len >= 2) ? data[1] : 0, 
+                           (data_len >= 3) ? data[2] : 0);
+            
+            break;
+        }
+        case 0xA2 :
+        {
+            (void)snprintf(text, size, "WRITE page 0x%02X", (data_len >= 2) ? data[1] : 0);
+            
+            break;
+        }
+        case 0xA0 :
+        {
+            (void)snprintf(text, size, "COMP_WRITE page 0x%02X", (data_len >= 2) ? data[1] : 0);
+            
+            break;
+        }
+        case 0x39 :
+        {
+            (void)snprintf(text, size, "READ_CNT counter %u", (unsigned int)((data_len >= 2) ? data[1] : 0));
+            
+            break;
+        }
+        case 0xA5 :
+        {
+            (void)snprintf(text, size, "INCR_CNT counter %u", (unsigned int)((data_len >= 2) ? data[1] : 0));
+            
+            break;
+        }
+        case 0x1B :
+        {
+            (void)snprintf(text, size, "PWD_AUTH");
+            
+            break;
+        }
+        case 0x3C :
+        {
+            (void)snprintf(text, size, "READ_SIG");
+            
+            break;
+        }
+        case 0x3E :
+        {
+            (void)snprintf(text, size, "CHECK_TEARING_EVENT counter %u", (unsigned int)((data_len >= 2) ? data[1] : 0));
+            
+            break;
+        }
+        case 0x4B :
+        {
+            (void)snprintf(text, size, "VCSL");
+            
+            break;
+        }
+        default :
+        {
+            (void)snprintf(text, size, "unknown command 0x%02X", data[0]);
+            
+            break;
+        }
+    }
+}
+
+/**
+ * @brief      annotate a received frame
+ * @param[in]  dir frame direction
+ * @param[in]  command command of the exchange
+ * @param[in]  len frame length
+ * @param[in]  *data pointer to the frame bytes
+ * @param[in]  data_len number of the frame bytes
+ * @param[out] *text pointer to a text buffer
+ * @param[in]  size text buffer size
+ * @note       none
+ */
+static void a_trace_annotate_rx(uint8_t dir, uint8_t command, uint8_t len, const uint8_t *data, uint8_t data_len,
+                                char *text, uint16_t size)
+{
+    const char *crc;
+    
+    if ((command == 0x93) || (command == 0x95) || (command == 0x97))
+    {
+        if (len == 1)
+        {
+            (void)snprintf(text, size, "SAK 0x%02X%s", data[0], ((data[0] & 0x04) != 0) ? " uid not complete" : "");
+        }
+        else if ((len == 3) && (data_len == 3))
+        {
+            (void)snprintf(text, size, "SAK 0x%02X%s, crc %s", data[0], ((data[0] & 0x04) != 0) ? " uid not complete" : "", 
+                           (a_trace_crc_check(data, 3) != 0) ? "ok" : "wrong");
+        }
+        else
+        {
+            (void)snprintf(text, size, "UID CL%u%s", (unsigned int)((command - 0x93) / 2 + 1), 
+                           ((data_len >= 1) && (data[0] == 0x88)) ? " cascade tag" : "");
+        }
+        
+        return;
+    }
+    if (((dir == MIFARE_ULTRALIGHT_TRACE_DIR_RX_BITS) && (len == 4)) || 
+        ((dir == MIFARE_ULTRALIGHT_TRACE_DIR_RX) && (len == 1) && (data_len == 1)))
+    {
+        if (gs_ack[data[0] & 0x0F] != NULL)
+        {
+            (void)snprintf(text, size, "%s", gs_ack[data[0] & 0x0F]);
+        }
+        else
+        {
+            (void)snprintf(text, size, "unknown NAK 0x%X", (unsigned int)(data[0] & 0x0F));
+        }
+        
+        return;
+    }
+    if ((command == 0x26) || (command == 0x52))
+    {
+        (void)snprintf(text, size, "ATQA 0x%02X%02X", (data_len >= 2) ? data[1] : 0, data[0]);
+        
+        return;
+    }
+    
+    crc = "not kept";
+    if ((len >= 3) && (data_len == len))
+    {
+        crc = (a_trace_crc_check(data, len) != 0) ? "ok" : "wrong";
+    }
+    switch (command)
+    {
+        case 0x60 :
+        {
+            if (data_len >= 7)
+            {
+                (void)snprintf(text, size, "VERSION vendor 0x%02X type 0x%02X subtype 0x%02X v%u.%u size 0x%02X, crc %s", 
+                               data[1], data[2], data[3], (unsigned int)data[4], (unsigned int)data[5], data[6], crc);
+            }
+            else
+            {
+                (void)snprintf(text, size, "VERSION, crc %s", crc);
+            }
+            
+            break;
+        }
+        case 0x30 :
+        {
+            (void)snprintf(text, size, "DATA 4 pages, crc %s", crc);
+            
+            break;
+        }
+        case 0x3A :
+        {
+            (void)snprintf(text, size, "DATA %u pages, crc %s", (unsigned int)((len >= 2) ? (len - 2) / 4 : 0), crc);
+            
+            break;
+        }
+        case 0x39 :
+        {
+            (void)snprintf(text, size, "COUNTER %u, crc %s", (data_len >= 3) ? 
+                           (unsigned int)(data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16)) : 0U, crc);
+            
+            break;
+        }
+        case 0x1B :
+        {
+            (void)snprintf(text, size, "PACK 0x%02X%02X, crc %s", data[0], (data_len >= 2) ? data[1] : 0, crc);
+            
+            break;
+        }
+        case 0x3C :
+        {
+            (void)snprintf(text, size, "SIGNATURE, crc %s", crc);
+            
+            break;
+        }
+        case 0x3E :
+        {
+            (void)snprintf(text, size, "TEARING FLAG 0x%02X%s, crc %s", data[0], (data[0] == 0xBD) ? " intact" : " torn", crc);
+            
+            break;
+        }
+        case 0x4B :
+        {
+            (void)snprintf(text, size, "VCTID 0x%02X, crc %s", data[0], crc);
+            
+            break;
+        }
+        default :
+        {
+            (void)snprintf(text, size, "response, crc %s", crc);
+            
+            break;
+        }
+    }
+}
+
+/**
+ * @brief      annotate a traced frame
+ * @param[in]  dir frame direction
+ * @param[in]  command command of the exchange, for a sent frame the command of the previous exchange
+ * @param[in]  res transceiver result
+ * @param[in]  len frame length in bytes or in bits for the bit oriented frames
+ * @param[in]  *data pointer to the frame bytes
+ * @param[in]  data_len number of the frame bytes kept in the trace
+ * @param[out] *text pointer to a text buffer
+ * @param[in]  size text buffer size
+ * @return     status code
+ *             - 0 success
+ *             - 1 annotate failed
+ * @note       the previous command of a sent frame spots the data part of a compatibility write
+ */
+uint8_t mifare_ultralight_trace_annotate(uint8_t dir, uint8_t command, uint8_t res, uint8_t len,
+                                         const uint8_t *data, uint8_t data_len, char *text, uint16_t size)
+{
+    if ((data == NULL) || (text == NULL) || (size == 0) || (dir > MIFARE_ULTRALIGHT_TRACE_DIR_RX_BITS))
+    {
+        return 1;
+    }
+    
+    if ((dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX) || (dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX_BITS))
+    {
+        a_trace_annotate_tx(dir, command, len, data, data_len, text, size);
+    }
+    else if (res != 0)
+    {
+        (void)snprintf(text, size, "no response, result %u", (unsigned int)res);
+    }
+    else if (data_len == 0)
+    {
+        (void)snprintf(text, size, "empty frame");
+    }
+    else
+    {
+        a_trace_annotate_rx(dir, command, len, data, data_len, text, size);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      print a saved trace file
+ * @param[in]  *in pointer to the trace file
+ * @param[in]  *out pointer to the output file
+ * @param[out] *count pointer to a frame number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 file is invalid
+ * @note       none
+ */
+uint8_t mifare_ultralight_trace_print(FILE *in, FILE *out, uint32_t *count)
+{
+    uint8_t header[MIFARE_ULTRALIGHT_TRACE_FILE_HEADER_LEN];
+    uint8_t record[MIFARE_ULTRALIGHT_TRACE_FILE_RECORD_LEN + 255];
+    char text[96];
+    uint32_t timestamp;
+    uint32_t start;
+    uint8_t frame_len;
+    uint8_t data_len;
+    uint8_t last;
+    uint8_t dir;
+    uint8_t i;
+    size_t n;
+    
+    if ((in == NULL) || (out == NULL) || (count == NULL))
+    {
+        return 1;
+    }
+    
+    /* check the header */
+    if (fread(header, 1, MIFARE_ULTRALIGHT_TRACE_FILE_HEADER_LEN, in) != MIFARE_ULTRALIGHT_TRACE_FILE_HEADER_LEN)
+    {
+        return 1;
+    }
+    if ((memcmp(header, "MFUT", 4) != 0) || (header[4] != MIFARE_ULTRALIGHT_TRACE_FILE_VERSION) || (header[5] == 0))
+    {
+        return 1;
+    }
+    frame_len = header[5];
+    
+    /* print every record */
+    *count = 0;
+    start = 0;
+    last = 0;
+    while (1)
+    {
+        n = fread(record, 1, MIFARE_ULTRALIGHT_TRACE_FILE_RECORD_LEN + frame_len, in);
+        if (n == 0)
+        {
+            break;
+        }
+        if (n != (size_t)(MIFARE_ULTRALIGHT_TRACE_FILE_RECORD_LEN + frame_len))
+        {
+            return 1;
+        }
+        timestamp = (uint32_t)record[0] | ((uint32_t)record[1] << 8) | 
+                    ((uint32_t)record[2] << 16) | ((uint32_t)record[3] << 24);
+        if (*count == 0)
+        {
+            start = timestamp;
+        }
+        dir = record[4];
+        if ((dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX_BITS) || (dir == MIFARE_ULTRALIGHT_TRACE_DIR_RX_BITS))
+        {
+            data_len = (uint8_t)((record[7] + 7) / 8);
+        }
+        else
+        {
+            data_len = record[7];
+        }
+        if (data_len > frame_len)
+        {
+            data_len = frame_len;
+        }
+        if (mifare_ultralight_trace_annotate(dir, 
+                                             ((dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX) || 
+                                              (dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX_BITS)) ? last : record[5], 
+                                             record[6], record[7], &record[8], data_len, text, sizeof(text)) != 0)
+        {
+            return 1;
+        }
+        (void)fprintf(out, "%10u  %s %3u%s ", (unsigned int)(timestamp - start), 
+                      ((dir & 0x01) == 0) ? "TX" : "RX", (unsigned int)record[7], 
+                      ((dir & 0x02) != 0) ? "b" : " ");
+        for (i = 0; i < data_len; i++)
+        {
+            (void)fprintf(out, "%02X", record[8 + i]);
+        }
+        (void)fprintf(out, "%s  %s\n", 
+                      ((dir & 0x02) == 0) && (record[7] > data_len) ? ".." : "", text);
+        if ((dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX) || (dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX_BITS))
+        {
+            last = (data_len != 0) ? record[8] : 0;
+        }
+        (*count)++;
+    }
+    
+    return 0;
+}
+
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+/**
+ * @brief      drain the trace ring into a trace file
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *fp pointer to the trace file
+ * @param[out] *count pointer to a frame number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 save failed
+ * @note       the header is written before the first frame
+ */
+uint8_t mifare_ultralight_trace_save(mifare_ultralight_handle_t *handle, FILE *fp, uint32_t *count)
+{
+    mifare_ultralight_trace_entry_t entry;
+    uint8_t header[MIFARE_ULTRALIGHT_TRACE_FILE_HEADER_LEN] = {'M', 'F', 'U', 'T', MIFARE_ULTRALIGHT_TRACE_FILE_VERSION, 
+                                                               MIFARE_ULTRALIGHT_TRACE_FRAME_LEN, 0, 0};
+    uint8_t record[MIFARE_ULTRALIGHT_TRACE_FILE_RECORD_LEN];
+    
+    if ((fp == NULL) || (count == NULL))
+    {
+        return 1;
+    }
+    
+    /* write the header */
+    if (fwrite(header, 1, sizeof(header), fp) != sizeof(header))
+    {
+        return 1;
+    }
+    
+    /* write every entry */
+    *count = 0;
+    while (mifare_ultralight_read_trace(handle, &entry) == 0)
+    {
+        record[0] = (uint8_t)(entry.timestamp >> 0);
+        record[1] = (uint8_t)(entry.timestamp >> 8);
+        record[2] = (uint8_t)(entry.timestamp >> 16);
+        record[3] = (uint8_t)(entry.timestamp >> 24);
+        record[4] = entry.dir;
+        record[5] = entry.command;
+        record[6] = entry.res;
+        record[7] = entry.len;
+        if ((fwrite(record, 1, sizeof(record), fp) != sizeof(record)) || 
+            (fwrite(entry.data, 1, MIFARE_ULTRALIGHT_TRACE_FRAME_LEN, fp) != MIFARE_ULTRALIGHT_TRACE_FRAME_LEN))
+        {
+            return 1;
+        }
+        (*count)++;
+    }
+    
+    return 0;
+}
+#endif
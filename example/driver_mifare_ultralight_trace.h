@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_trace.h
+ * @brief     driver mifare_ultralight trace header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MIFARE_ULTRALIGHT_TRACE_H
+#define DRIVER_MIFARE_ULTRALIGHT_TRACE_H
+
+#include "driver_mifare_ultralight.h"
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup mifare_ultralight_trace_example_driver mifare ultralight trace example driver function
+ * @brief    mifare ultralight trace example driver modules
+ * @ingroup  mifare_ultralight_driver
+ * @{
+ */
+
+/**
+ * @brief mifare_ultralight trace file definition
+ */
+#define MIFARE_ULTRALIGHT_TRACE_FILE_VERSION        1           /**< file version */
+#define MIFARE_ULTRALIGHT_TRACE_FILE_HEADER_LEN     8           /**< "MFUT", version, frame length, 2 reserved bytes */
+#define MIFARE_ULTRALIGHT_TRACE_FILE_RECORD_LEN     8           /**< le32 timestamp, dir, command, res, len, then the frame bytes */
+
+/**
+ * @brief      annotate a traced frame
+ * @param[in]  dir frame direction
+ * @param[in]  command command of the exchange, for a sent frame the command of the previous exchange
+ * @param[in]  res transceiver result
+ * @param[in]  len frame length in bytes or in bits for the bit oriented frames
+ * @param[in]  *data pointer to the frame bytes
+ * @param[in]  data_len number of the frame bytes kept in the trace
+ * @param[out] *text pointer to a text buffer
+ * @param[in]  size text buffer size
+ * @return     status code
+ *             - 0 success
+ *             - 1 annotate failed
+ * @note       the previous command of a sent frame spots the data part of a compatibility write
+ */
+uint8_t mifare_ultralight_trace_annotate(uint8_t dir, uint8_t command, uint8_t res, uint8_t len,
+                                         const uint8_t *data, uint8_t data_len, char *text, uint16_t size);
+
+/**
+ * @brief      print a saved trace file
+ * @param[in]  *in pointer to the trace file
+ * @param[in]  *out pointer to the output file
+ * @param[out] *count pointer to a frame number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 file is invalid
+ * @note       none
+ */
+uint8_t mifare_ultralight_trace_print(FILE *in, FILE *out, uint32_t *count);
+
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+/**
+ * @brief      drain the trace ring into a trace file
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *fp pointer to the trace file
+ * @param[out] *count pointer to a frame number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 save failed
+ * @note       the header is written before the first frame
+ */
+uint8_t mifare_ultralight_trace_save(mifare_ultralight_handle_t *handle, FILE *fp, uint32_t *count);
+#endif
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
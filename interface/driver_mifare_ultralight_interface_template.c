@@ -86,6 +86,26 @@ void mifare_ultralight_interface_delay_ms(uint32_t ms)
 
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      none
+ */
+void mifare_ultralight_interface_delay_us(uint32_t us)
+{
+
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return timestamp in us
+ * @note   none
+ */
+uint32_t mifare_ultralight_interface_timestamp_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      emulator_driver_mifare_ultralight_interface.h
+ * @brief     emulator driver mifare_ultralight interface header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef EMULATOR_DRIVER_MIFARE_ULTRALIGHT_INTERFACE_H
+#define EMULATOR_DRIVER_MIFARE_ULTRALIGHT_INTERFACE_H
+
+#include "driver_mifare_ultralight_interface.h"
+#include "emulator_mifare_ultralight.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup emulator_mifare_ultralight
+ * @{
+ */
+
+/**
+ * @brief  get the field behind the interface
+ * @return pointer to the field
+ * @note   the field holds one mf0ul21 tag until the caller changes it
+ */
+emulator_mifare_ultralight_field_t *emulator_mifare_ultralight_interface_field(void);
+
+/**
+ * @brief     enable or disable the realtime mode
+ * @param[in] enable bool value
+ * @note      in the realtime mode every exchange and delay also sleeps for its modeled time
+ */
+void emulator_mifare_ultralight_interface_set_realtime(uint8_t enable);
+
+/**
+ * @brief      interface contactless transceiver bits
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_bits input bit number
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[out] *out_bits pointer to a output bit number buffer
+ * @param[out] *collision pointer to a collision index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 contactless transceiver bits failed
+ * @note       it can be linked with DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER_BITS
+ */
+uint8_t emulator_mifare_ultralight_interface_contactless_transceiver_bits(uint8_t *in_buf, uint8_t in_bits, uint8_t *out_buf,
+                                                                          uint8_t *out_bits, uint8_t *collision);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
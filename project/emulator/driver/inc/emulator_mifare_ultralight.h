@@ -0,0 +1,226 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      emulator_mifare_ultralight.h
+ * @brief     emulator mifare_ultralight header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef EMULATOR_MIFARE_ULTRALIGHT_H
+#define EMULATOR_MIFARE_ULTRALIGHT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup emulator_mifare_ultralight emulator mifare_ultralight function
+ * @brief    emulator mifare_ultralight modules
+ * @{
+ */
+
+/**
+ * @brief emulator mifare_ultralight definition
+ */
+#define EMULATOR_MIFARE_ULTRALIGHT_MAX_TAG         8         /**< max tag number in the field */
+#define EMULATOR_MIFARE_ULTRALIGHT_MAX_PAGE        41        /**< max page number */
+
+/**
+ * @brief emulator mifare_ultralight timing definition
+ * @note  times are in carrier cycles of fc = 13.56MHz unless noted, 1 etu is 128 / fc at 106kbit/s
+ */
+#define EMULATOR_MIFARE_ULTRALIGHT_ETU             128           /**< one bit at 106kbit/s */
+#define EMULATOR_MIFARE_ULTRALIGHT_FDT_1           1236          /**< pcd to picc fdt when the last bit is 1 */
+#define EMULATOR_MIFARE_ULTRALIGHT_FDT_0           1172          /**< pcd to picc fdt when the last bit is 0 */
+#define EMULATOR_MIFARE_ULTRALIGHT_FDT_PICC        1172          /**< min picc to pcd fdt before the next command */
+#define EMULATOR_MIFARE_ULTRALIGHT_TPROG_US        4100          /**< eeprom programming time of write and incr_cnt in us */
+#define EMULATOR_MIFARE_ULTRALIGHT_TIMEOUT_US      1000          /**< reader wait time without a response in us */
+
+/**
+ * @brief emulator mifare_ultralight type enumeration definition
+ */
+typedef enum
+{
+    EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL11 = 0x13,        /**< 20 pages */
+    EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21 = 0x28,        /**< 41 pages */
+} emulator_mifare_ultralight_type_t;
+
+/**
+ * @brief emulator mifare_ultralight state enumeration definition
+ */
+typedef enum
+{
+    EMULATOR_MIFARE_ULTRALIGHT_STATE_IDLE          = 0x00,        /**< idle */
+    EMULATOR_MIFARE_ULTRALIGHT_STATE_READY1        = 0x01,        /**< ready cascade level 1 */
+    EMULATOR_MIFARE_ULTRALIGHT_STATE_READY2        = 0x02,        /**< ready cascade level 2 */
+    EMULATOR_MIFARE_ULTRALIGHT_STATE_ACTIVE        = 0x03,        /**< active */
+    EMULATOR_MIFARE_ULTRALIGHT_STATE_AUTHENTICATED = 0x04,        /**< authenticated */
+    EMULATOR_MIFARE_ULTRALIGHT_STATE_HALT          = 0x05,        /**< halt */
+} emulator_mifare_ultralight_state_t;
+
+/**
+ * @brief emulator mifare_ultralight nak enumeration definition
+ */
+typedef enum
+{
+    EMULATOR_MIFARE_ULTRALIGHT_NAK_INVALID = 0x00,        /**< invalid argument */
+    EMULATOR_MIFARE_ULTRALIGHT_NAK_CRC     = 0x01,        /**< crc error */
+    EMULATOR_MIFARE_ULTRALIGHT_NAK_AUTH    = 0x04,        /**< authentication or counter overflow */
+    EMULATOR_MIFARE_ULTRALIGHT_NAK_EEPROM  = 0x05,        /**< eeprom write error */
+} emulator_mifare_ultralight_nak_t;
+
+/**
+ * @brief emulator mifare_ultralight tag structure definition
+ */
+typedef struct emulator_mifare_ultralight_tag_s
+{
+    uint8_t end_page;                                                 /**< last page */
+    uint8_t mem[EMULATOR_MIFARE_ULTRALIGHT_MAX_PAGE][4];              /**< memory */
+    uint8_t uid[7];                                                   /**< uid */
+    uint8_t signature[32];                                            /**< originality signature */
+    uint32_t counter[3];                                              /**< one way counters */
+    uint8_t tearing[3];                                               /**< tearing flags */
+    uint8_t tear_next;                                                /**< tear the next increment of the counters in this mask */
+    uint8_t auth_fail;                                                /**< failed password verification counter */
+    uint8_t state;                                                    /**< state */
+    uint8_t halted;                                                   /**< woken up from halt */
+    uint8_t comp_write;                                               /**< pending compatibility write page or 0xFF */
+    uint8_t programmed;                                               /**< the last command programmed the eeprom */
+} emulator_mifare_ultralight_tag_t;
+
+/**
+ * @brief emulator mifare_ultralight field structure definition
+ */
+typedef struct emulator_mifare_ultralight_field_s
+{
+    emulator_mifare_ultralight_tag_t *tag[EMULATOR_MIFARE_ULTRALIGHT_MAX_TAG];        /**< tags in the field */
+    uint8_t count;                                                                    /**< tag number */
+    uint32_t frames;                                                                  /**< frame counter */
+    uint32_t tx_bytes;                                                                /**< pcd to picc byte counter */
+    uint32_t rx_bytes;                                                                /**< picc to pcd byte counter */
+    uint64_t time_ns;                                                                 /**< modeled time in ns */
+    uint32_t last_ns;                                                                 /**< modeled time of the last exchange in ns */
+} emulator_mifare_ultralight_field_t;
+
+/**
+ * @brief     init a tag with the factory content
+ * @param[in] *tag pointer to a tag structure
+ * @param[in] type tag type
+ * @param[in] *uid pointer to a 7 bytes uid
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      password is 0xFFFFFFFF, pack is 0x0000, auth0 is 0xFF and vctid is 0x05
+ */
+uint8_t emulator_mifare_ultralight_tag_init(emulator_mifare_ultralight_tag_t *tag, emulator_mifare_ultralight_type_t type,
+                                            const uint8_t uid[7]);
+
+/**
+ * @brief     init an empty field
+ * @param[in] *field pointer to a field structure
+ * @note      none
+ */
+void emulator_mifare_ultralight_field_init(emulator_mifare_ultralight_field_t *field);
+
+/**
+ * @brief     put a tag into the field
+ * @param[in] *field pointer to a field structure
+ * @param[in] *tag pointer to a tag structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 field is full
+ * @note      the tag enters in the idle state
+ */
+uint8_t emulator_mifare_ultralight_field_add(emulator_mifare_ultralight_field_t *field, emulator_mifare_ultralight_tag_t *tag);
+
+/**
+ * @brief     remove a tag from the field
+ * @param[in] *field pointer to a field structure
+ * @param[in] *tag pointer to a tag structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 tag is not in the field
+ * @note      none
+ */
+uint8_t emulator_mifare_ultralight_field_remove(emulator_mifare_ultralight_field_t *field, emulator_mifare_ultralight_tag_t *tag);
+
+/**
+ * @brief     power cycle the field
+ * @param[in] *field pointer to a field structure
+ * @note      every tag goes to the idle state and loses its authentication
+ */
+void emulator_mifare_ultralight_field_reset(emulator_mifare_ultralight_field_t *field);
+
+/**
+ * @brief         exchange one frame with the field
+ * @param[in]     *field pointer to a field structure
+ * @param[in]     *in_buf pointer to an input buffer
+ * @param[in]     in_len input length
+ * @param[out]    *out_buf pointer to an output buffer
+ * @param[in,out] *out_len pointer to an output length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 no response, collision or buffer overflow
+ * @note          the frame format matches contactless_transceiver, ack and nak are 1 byte
+ *                and the sak is returned without crc like the reader does, the modeled
+ *                airtime, fdt and programming time are added to time_ns
+ */
+uint8_t emulator_mifare_ultralight_transceiver(emulator_mifare_ultralight_field_t *field, uint8_t *in_buf, uint8_t in_len,
+                                               uint8_t *out_buf, uint8_t *out_len);
+
+/**
+ * @brief      exchange one bit oriented anti collision frame with the field
+ * @param[in]  *field pointer to a field structure
+ * @param[in]  *in_buf pointer to an input buffer
+ * @param[in]  in_bits input bit number
+ * @param[out] *out_buf pointer to an output buffer
+ * @param[out] *out_bits pointer to an output bit number buffer
+ * @param[out] *collision pointer to a collision index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no response
+ * @note       the frame format matches contactless_transceiver_bits, the modeled
+ *             airtime and fdt are added to time_ns
+ */
+uint8_t emulator_mifare_ultralight_transceiver_bits(emulator_mifare_ultralight_field_t *field, uint8_t *in_buf, uint8_t in_bits,
+                                                    uint8_t *out_buf, uint8_t *out_bits, uint8_t *collision);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      emulator_driver_mifare_ultralight_interface.c
+ * @brief     emulator driver mifare_ultralight interface source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "emulator_driver_mifare_ultralight_interface.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static emulator_mifare_ultralight_field_t gs_field;        /**< emulated field */
+static emulator_mifare_ultralight_tag_t gs_tag;            /**< default tag */
+static uint8_t gs_field_inited = 0;                        /**< field inited flag */
+static uint8_t gs_realtime = 0;                            /**< realtime flag */
+
+/**
+ * @brief     sleep for a while when realtime is enabled
+ * @param[in] ns time in ns
+ * @note      none
+ */
+static void a_emulator_interface_sleep(uint64_t ns)
+{
+    struct timespec ts;
+    
+    if ((gs_realtime == 0) || (ns == 0))
+    {
+        return;
+    }
+    ts.tv_sec = (time_t)(ns / 1000000000ULL);
+    ts.tv_nsec = (long)(ns % 1000000000ULL);
+    (void)nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief  get the field behind the interface
+ * @return pointer to the field
+ * @note   the field holds one mf0ul21 tag until the caller changes it
+ */
+emulator_mifare_ultralight_field_t *emulator_mifare_ultralight_interface_field(void)
+{
+    const uint8_t uid[7] = {0x04, 0x5A, 0x3C, 0x12, 0x9E, 0x61, 0x80};
+    
+    if (gs_field_inited == 0)
+    {
+        (void)emulator_mifare_ultralight_tag_init(&gs_tag, EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21, uid);
+        emulator_mifare_ultralight_field_init(&gs_field);
+        (void)emulator_mifare_ultralight_field_add(&gs_field, &gs_tag);
+        gs_field_inited = 1;
+    }
+    
+    return &gs_field;
+}
+
+/**
+ * @brief     enable or disable the realtime mode
+ * @param[in] enable bool value
+ * @note      in the realtime mode every exchange and delay also sleeps for its modeled time
+ */
+void emulator_mifare_ultralight_interface_set_realtime(uint8_t enable)
+{
+    gs_realtime = (enable != 0) ? 1 : 0;
+}
+
+/**
+ * @brief  interface contactless init
+ * @return status code
+ *         - 0 success
+ *         - 1 contactless init failed
+ * @note   switching the field on resets every tag to idle
+ */
+uint8_t mifare_ultralight_interface_contactless_init(void)
+{
+    emulator_mifare_ultralight_field_reset(emulator_mifare_ultralight_interface_field());
+    
+    return 0;
+}
+
+/**
+ * @brief  interface contactless deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 contactless deinit failed
+ * @note   none
+ */
+uint8_t mifare_ultralight_interface_contactless_deinit(void)
+{
+    emulator_mifare_ultralight_field_reset(emulator_mifare_ultralight_interface_field());
+    
+    return 0;
+}
+
+/**
+ * @brief         interface contactless transceiver
+ * @param[in]     *in_buf pointer to a input buffer
+ * @param[in]     in_len input length
+ * @param[out]    *out_buf pointer to a output buffer
+ * @param[in,out] *out_len pointer to a output length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 contactless transceiver failed
+ * @note          none
+ */
+uint8_t mifare_ultralight_interface_contactless_transceiver(uint8_t *in_buf, uint8_t in_len, uint8_t *out_buf, uint8_t *out_len)
+{
+    emulator_mifare_ultralight_field_t *field;
+    uint8_t res;
+    
+    field = emulator_mifare_ultralight_interface_field();
+    res = emulator_mifare_ultralight_transceiver(field, in_buf, in_len, out_buf, out_len);
+    a_emulator_interface_sleep(field->last_ns);
+    
+    return res;
+}
+
+/**
+ * @brief      interface contactless transceiver bits
+ * @param[in]  *in_buf pointer to a input buffer
+ * @param[in]  in_bits input bit number
+ * @param[out] *out_buf pointer to a output buffer
+ * @param[out] *out_bits pointer to a output bit number buffer
+ * @param[out] *collision pointer to a collision index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 contactless transceiver bits failed
+ * @note       it can be linked with DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER_BITS
+ */
+uint8_t emulator_mifare_ultralight_interface_contactless_transceiver_bits(uint8_t *in_buf, uint8_t in_bits, uint8_t *out_buf,
+                                                                          uint8_t *out_bits, uint8_t *collision)
+{
+    emulator_mifare_ultralight_field_t *field;
+    uint8_t res;
+    
+    field = emulator_mifare_ultralight_interface_field();
+    res = emulator_mifare_ultralight_transceiver_bits(field, in_buf, in_bits, out_buf, out_bits, collision);
+    a_emulator_interface_sleep(field->last_ns);
+    
+    return res;
+}
+
+/**
+ * @brief     interface delay ms
+ * @param[in] ms time
+ * @note      the modeled time moves
+ */
+void mifare_ultralight_interface_delay_ms(uint32_t ms)
+{
+    emulator_mifare_ultralight_interface_field()->time_ns += (uint64_t)ms * 1000000;
+    a_emulator_interface_sleep((uint64_t)ms * 1000000);
+}
+
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      the modeled time moves
+ */
+void mifare_ultralight_interface_delay_us(uint32_t us)
+{
+    emulator_mifare_ultralight_interface_field()->time_ns += (uint64_t)us * 1000;
+    a_emulator_interface_sleep((uint64_t)us * 1000);
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return timestamp in us
+ * @note   modeled on air time
+ */
+uint32_t mifare_ultralight_interface_timestamp_us(void)
+{
+    return (uint32_t)(emulator_mifare_ultralight_interface_field()->time_ns / 1000);
+}
+
+/**
+ * @brief     interface print format data
+ * @param[in] fmt format data
+ * @note      none
+ */
+void mifare_ultralight_interface_debug_print(const char *const fmt, ...)
+{
+    char str[256];
+    va_list args;
+    
+    memset((char *)str, 0, sizeof(char) * 256); 
+    va_start(args, fmt);
+    vsnprintf((char *)str, 255, (char const *)fmt, args);
+    va_end(args);
+    
+    (void)printf("%s", str);
+}
@@ -0,0 +1,1086 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      emulator_mifare_ultralight.c
+ * @brief     emulator mifare_ultralight source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "emulator_mifare_ultralight.h"
+#include <string.h>
+
+/**
+ * @brief emulator command definition
+ */
+#define EMULATOR_COMMAND_REQUEST                0x26        /**< request command */
+#define EMULATOR_COMMAND_WAKE_UP                0x52        /**< wake up command */
+#define EMULATOR_COMMAND_SEL_CL1                0x93        /**< select code cascade level 1 */
+#define EMULATOR_COMMAND_SEL_CL2                0x95        /**< select code cascade level 2 */
+#define EMULATOR_COMMAND_HALT                   0x50        /**< halt command */
+#define EMULATOR_COMMAND_GET_VERSION            0x60        /**< get version command */
+#define EMULATOR_COMMAND_READ                   0x30        /**< read command */
+#define EMULATOR_COMMAND_FAST_READ              0x3A        /**< fast read command */
+#define EMULATOR_COMMAND_WRITE                  0xA2        /**< write command */
+#define EMULATOR_COMMAND_COMP_WRITE             0xA0        /**< comp write command */
+#define EMULATOR_COMMAND_READ_CNT               0x39        /**< read cnt command */
+#define EMULATOR_COMMAND_INCR_CNT               0xA5        /**< increment cnt command */
+#define EMULATOR_COMMAND_PWD_AUTH               0x1B        /**< pwd auth command */
+#define EMULATOR_COMMAND_READ_SIG               0x3C        /**< read sig command */
+#define EMULATOR_COMMAND_CHECK_TEARING_EVENT    0x3E        /**< check tearing event command */
+#define EMULATOR_COMMAND_VCSL                   0x4B        /**< vcsl command */
+
+/**
+ * @brief emulator response definition
+ */
+#define EMULATOR_ACK                            0x0A        /**< ack */
+#define EMULATOR_RESPONSE_LEN                   66          /**< max response length */
+
+/**
+ * @brief     iso14443a crc
+ * @param[in] *p pointer to a data buffer
+ * @param[in] len data length
+ * @param[out] *output pointer to a crc buffer
+ * @note      bit serial on purpose, so the driver crc engines are checked against an independent routine
+ */
+static void a_emulator_crc(const uint8_t *p, uint8_t len, uint8_t output[2])
+{
+    uint32_t w_crc = 0x6363;
+    
+    while (len != 0)
+    {
+        uint8_t bt;
+        
+        bt = *p++;
+        bt = (bt ^ (uint8_t)(w_crc & 0x00FF));
+        bt = (bt ^ (bt << 4));
+        w_crc = (w_crc >> 8) ^ ((uint32_t) bt << 8) ^ ((uint32_t) bt << 3) ^ ((uint32_t) bt >> 4);
+        len--;
+    }
+    output[0] = (uint8_t)(w_crc & 0xFF);
+    output[1] = (uint8_t)((w_crc >> 8) & 0xFF);
+}
+
+/**
+ * @brief     check the crc of a frame
+ * @param[in] *p pointer to a frame
+ * @param[in] len frame length with the crc
+ * @return    status code
+ *            - 0 crc is right
+ *            - 1 crc is wrong
+ * @note      none
+ */
+static uint8_t a_emulator_crc_check(const uint8_t *p, uint8_t len)
+{
+    uint8_t crc[2];
+    
+    if (len < 3)
+    {
+        return 1;
+    }
+    a_emulator_crc(p, (uint8_t)(len - 2), crc);
+    if ((p[len - 2] != crc[0]) || (p[len - 1] != crc[1]))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief         append the crc to a response
+ * @param[in]     *p pointer to a response buffer
+ * @param[in,out] *len pointer to a response length
+ * @note          none
+ */
+static void a_emulator_crc_append(uint8_t *p, uint8_t *len)
+{
+    a_emulator_crc(p, *len, p + *len);
+    *len = (uint8_t)(*len + 2);
+}
+
+/**
+ * @brief     convert carrier cycles to ns
+ * @param[in] cycles carrier cycles
+ * @return    time in ns
+ * @note      none
+ */
+static uint32_t a_emulator_cycles_ns(uint32_t cycles)
+{
+    return (uint32_t)(((uint64_t)cycles * 100000) / 1356);
+}
+
+/**
+ * @brief     get the pcd to picc fdt of a frame
+ * @param[in] last last transmitted byte
+ * @param[in] bits bits of the last byte
+ * @return    fdt in carrier cycles
+ * @note      the last bit on air is the odd parity of a full byte or the last data bit of a short frame
+ */
+static uint32_t a_emulator_fdt(uint8_t last, uint8_t bits)
+{
+    uint8_t bit;
+    uint8_t ones;
+    uint8_t i;
+    
+    if (bits < 8)
+    {
+        bit = (uint8_t)((last >> (bits - 1)) & 0x01);
+    }
+    else
+    {
+        ones = 0;
+        for (i = 0; i < 8; i++)
+        {
+            ones = (uint8_t)(ones + ((last >> i) & 0x01));
+        }
+        bit = ((ones & 0x01) == 0) ? 1 : 0;
+    }
+    
+    return (bit != 0) ? EMULATOR_MIFARE_ULTRALIGHT_FDT_1 : EMULATOR_MIFARE_ULTRALIGHT_FDT_0;
+}
+
+/**
+ * @brief         add the modeled time of one exchange
+ * @param[in]     *field pointer to a field structure
+ * @param[in]     tx_etu pcd frame length in etu
+ * @param[in]     fdt pcd to picc fdt in carrier cycles
+ * @param[in]     rx_etu picc frame length in etu or 0 without a response
+ * @param[in]     prog_us programming time in us
+ * @note          every exchange ends with the min picc to pcd fdt
+ */
+static void a_emulator_time(emulator_mifare_ultralight_field_t *field, uint32_t tx_etu, uint32_t fdt, 
+                            uint32_t rx_etu, uint32_t prog_us)
+{
+    uint32_t ns;
+    
+    ns = a_emulator_cycles_ns(tx_etu * EMULATOR_MIFARE_ULTRALIGHT_ETU);
+    if (rx_etu == 0)
+    {
+        ns += EMULATOR_MIFARE_ULTRALIGHT_TIMEOUT_US * 1000;
+    }
+    else
+    {
+        ns += a_emulator_cycles_ns(fdt + rx_etu * EMULATOR_MIFARE_ULTRALIGHT_ETU + 
+                                   EMULATOR_MIFARE_ULTRALIGHT_FDT_PICC);
+        ns += prog_us * 1000;
+    }
+    field->last_ns = ns;
+    field->time_ns += ns;
+}
+
+/**
+ * @brief     get the cascade level bytes of a tag
+ * @param[in] *tag pointer to a tag structure
+ * @param[in] sel select code
+ * @param[out] *cl pointer to a 5 bytes buffer
+ * @note      cl1 is the cascade tag, uid0 - uid2 and bcc0, cl2 is uid3 - uid6 and bcc1
+ */
+static void a_emulator_cascade(emulator_mifare_ultralight_tag_t *tag, uint8_t sel, uint8_t cl[5])
+{
+    if (sel == EMULATOR_COMMAND_SEL_CL1)
+    {
+        cl[0] = 0x88;
+        memcpy(cl + 1, tag->uid, 3);
+    }
+    else
+    {
+        memcpy(cl, tag->uid + 3, 4);
+    }
+    cl[4] = (uint8_t)(cl[0] ^ cl[1] ^ cl[2] ^ cl[3]);
+}
+
+/**
+ * @brief     leave the protocol after an error
+ * @param[in] *tag pointer to a tag structure
+ * @note      the tag goes back to halt when it was woken up from halt, otherwise to idle
+ */
+static void a_emulator_drop(emulator_mifare_ultralight_tag_t *tag)
+{
+    tag->state = (tag->halted != 0) ? EMULATOR_MIFARE_ULTRALIGHT_STATE_HALT : EMULATOR_MIFARE_ULTRALIGHT_STATE_IDLE;
+    tag->comp_write = 0xFF;
+}
+
+/**
+ * @brief      answer a nak
+ * @param[in]  *tag pointer to a tag structure
+ * @param[in]  nak nak code
+ * @param[out] *out pointer to a response buffer
+ * @param[out] *out_len pointer to a response length
+ * @return     0
+ * @note       the tag leaves the active state
+ */
+static uint8_t a_emulator_nak(emulator_mifare_ultralight_tag_t *tag, uint8_t nak, uint8_t *out, uint8_t *out_len)
+{
+    a_emulator_drop(tag);
+    out[0] = nak;
+    *out_len = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief      answer an ack
+ * @param[out] *out pointer to a response buffer
+ * @param[out] *out_len pointer to a response length
+ * @return     0
+ * @note       none
+ */
+static uint8_t a_emulator_ack(uint8_t *out, uint8_t *out_len)
+{
+    out[0] = EMULATOR_ACK;
+    *out_len = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     check the read access of a page
+ * @param[in] *tag pointer to a tag structure
+ * @param[in] page page address
+ * @return    1 if readable
+ * @note      auth0 protects reads only when prot is set
+ */
+static uint8_t a_emulator_readable(emulator_mifare_ultralight_tag_t *tag, uint8_t page)
+{
+    uint8_t auth0 = tag->mem[tag->end_page - 3][3];
+    uint8_t prot = tag->mem[tag->end_page - 2][0] & 0x80;
+    
+    if ((prot != 0) && (tag->state != EMULATOR_MIFARE_ULTRALIGHT_STATE_AUTHENTICATED) && (page >= auth0))
+    {
+        return 0;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     check the lock bits of a page
+ * @param[in] *tag pointer to a tag structure
+ * @param[in] page page address
+ * @return    1 if locked
+ * @note      static lock bits cover page 3 - 15, dynamic lock bits cover the mf0ul21 user pages 16 - 35
+ */
+static uint8_t a_emulator_locked(emulator_mifare_ultralight_tag_t *tag, uint8_t page)
+{
+    uint8_t lock0 = tag->mem[2][2];
+    uint8_t lock1 = tag->mem[2][3];
+    uint8_t n;
+    
+    if (page == 3)
+    {
+        return (uint8_t)((lock0 >> 3) & 0x01);
+    }
+    if ((page >= 4) && (page <= 7))
+    {
+        return (uint8_t)((lock0 >> (page - 4 + 4)) & 0x01);
+    }
+    if ((page >= 8) && (page <= 15))
+    {
+        return (uint8_t)((lock1 >> (page - 8)) & 0x01);
+    }
+    if ((tag->end_page == EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21) && (page >= 16) && (page < tag->end_page - 4))
+    {
+        n = (uint8_t)((page - 16) / 2);
+        if (n < 8)
+        {
+            return (uint8_t)((tag->mem[tag->end_page - 4][0] >> n) & 0x01);
+        }
+        
+        return (uint8_t)((tag->mem[tag->end_page - 4][1] >> (n - 8)) & 0x01);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      write one page with the access, lock and otp rules
+ * @param[in]  *tag pointer to a tag structure
+ * @param[in]  page page address
+ * @param[in]  *data pointer to 4 bytes
+ * @param[out] *out pointer to a response buffer
+ * @param[out] *out_len pointer to a response length
+ * @return     0
+ * @note       lock bytes, otp and the dynamic lock page use or semantics
+ */
+static uint8_t a_emulator_write(emulator_mifare_ultralight_tag_t *tag, uint8_t page, const uint8_t *data,
+                                uint8_t *out, uint8_t *out_len)
+{
+    uint8_t auth0 = tag->mem[tag->end_page - 3][3];
+    uint8_t cfglck = tag->mem[tag->end_page - 2][0] & 0x40;
+    uint8_t frozen0;
+    uint8_t frozen1;
+    uint8_t lock0;
+    
+    if ((page < 2) || (page > tag->end_page))
+    {
+        return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_INVALID, out, out_len);
+    }
+    if ((tag->state != EMULATOR_MIFARE_ULTRALIGHT_STATE_AUTHENTICATED) && (page >= auth0))
+    {
+        return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_INVALID, out, out_len);
+    }
+    if (a_emulator_locked(tag, page) != 0)
+    {
+        return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_INVALID, out, out_len);
+    }
+    if (page == 2)
+    {
+        /* block locking bits freeze their lock bits */
+        lock0 = tag->mem[2][2];
+        frozen0 = 0;
+        frozen1 = 0;
+        if ((lock0 & 0x01) != 0)
+        {
+            frozen0 |= 0x08;
+        }
+        if ((lock0 & 0x02) != 0)
+        {
+            frozen0 |= 0xF0;
+            frozen1 |= 0x03;
+        }
+        if ((lock0 & 0x04) != 0)
+        {
+            frozen1 |= 0xFC;
+        }
+        tag->mem[2][2] |= (uint8_t)(data[2] & (~frozen0));
+        tag->mem[2][3] |= (uint8_t)(data[3] & (~frozen1));
+    }
+    else if (page == 3)
+    {
+        tag->mem[3][0] |= data[0];
+        tag->mem[3][1] |= data[1];
+        tag->mem[3][2] |= data[2];
+        tag->mem[3][3] |= data[3];
+    }
+    else if ((tag->end_page == EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21) && (page == tag->end_page - 4))
+    {
+        tag->mem[page][0] |= data[0];
+        tag->mem[page][1] |= data[1];
+        tag->mem[page][2] |= data[2];
+    }
+    else if ((page == tag->end_page - 3) || (page == tag->end_page - 2))
+    {
+        if (cfglck != 0)
+        {
+            return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_INVALID, out, out_len);
+        }
+        memcpy(tag->mem[page], data, 4);
+    }
+    else
+    {
+        memcpy(tag->mem[page], data, 4);
+    }
+    tag->programmed = 1;
+    
+    return a_emulator_ack(out, out_len);
+}
+
+/**
+ * @brief      copy one page to a response
+ * @param[in]  *tag pointer to a tag structure
+ * @param[in]  page page address
+ * @param[out] *out pointer to 4 bytes
+ * @note       pwd and pack always read as zero
+ */
+static void a_emulator_page(emulator_mifare_ultralight_tag_t *tag, uint8_t page, uint8_t *out)
+{
+    if (page >= tag->end_page - 1)
+    {
+        memset(out, 0, 4);
+    }
+    else
+    {
+        memcpy(out, tag->mem[page], 4);
+    }
+}
+
+/**
+ * @brief      handle one frame in the active state
+ * @param[in]  *tag pointer to a tag structure
+ * @param[in]  *in pointer to a frame
+ * @param[in]  in_len frame length
+ * @param[out] *out pointer to a response buffer
+ * @param[out] *out_len pointer to a response length
+ * @return     status code
+ *             - 0 responded
+ *             - 1 no response
+ * @note       none
+ */
+static uint8_t a_emulator_active(emulator_mifare_ultralight_tag_t *tag, uint8_t *in, uint8_t in_len,
+                                 uint8_t *out, uint8_t *out_len)
+{
+    uint8_t i;
+    uint8_t page;
+    uint8_t limit;
+    uint8_t authlim;
+    uint32_t inc;
+    
+    if (a_emulator_crc_check(in, in_len) != 0)
+    {
+        tag->comp_write = 0xFF;
+        
+        return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_CRC, out, out_len);
+    }
+    
+    /* second part of the compatibility write */
+    if (tag->comp_write != 0xFF)
+    {
+        page = tag->comp_write;
+        tag->comp_write = 0xFF;
+        if (in_len != 18)
+        {
+            return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_INVALID, out, out_len);
+        }
+        
+        return a_emulator_write(tag, page, in, out, out_len);
+    }
+    
+    switch (in[0])
+    {
+        case EMULATOR_COMMAND_HALT :
+        {
+            if ((in_len != 4) || (in[1] != 0x00))
+            {
+                break;
+            }
+            tag->state = EMULATOR_MIFARE_ULTRALIGHT_STATE_HALT;
+            tag->halted = 1;
+            
+            return 1;
+        }
+        case EMULATOR_COMMAND_GET_VERSION :
+        {
+            if (in_len != 3)
+            {
+                break;
+            }
+            out[0] = 0x00;
+            out[1] = 0x04;
+            out[2] = 0x03;
+            out[3] = 0x01;
+            out[4] = 0x01;
+            out[5] = 0x00;
+            out[6] = (tag->end_page == EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL11) ? 0x0B : 0x0E;
+            out[7] = 0x03;
+            *out_len = 8;
+            a_emulator_crc_append(out, out_len);
+            
+            return 0;
+        }
+        case EMULATOR_COMMAND_READ :
+        {
+            if ((in_len != 4) || (in[1] > tag->end_page) || (a_emulator_readable(tag, in[1]) == 0))
+            {
+                break;
+            }
+            
+            /* roll over at the end or at the first protected page */
+            limit = (uint8_t)(tag->end_page + 1);
+            if (a_emulator_readable(tag, tag->end_page) == 0)
+            {
+                limit = tag->mem[tag->end_page - 3][3];
+            }
+            for (i = 0; i < 4; i++)
+            {
+                a_emulator_page(tag, (uint8_t)((in[1] + i) % limit), out + i * 4);
+            }
+            *out_len = 16;
+            a_emulator_crc_append(out, out_len);
+            
+            return 0;
+        }
+        case EMULATOR_COMMAND_FAST_READ :
+        {
+            if ((in_len != 5) || (in[1] > in[2]) || (in[2] > tag->end_page) || 
+                ((in[2] - in[1] + 1) * 4 + 2 > EMULATOR_RESPONSE_LEN))
+            {
+                break;
+            }
+            for (page = in[1]; page <= in[2]; page++)
+            {
+                if (a_emulator_readable(tag, page) == 0)
+                {
+                    return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_INVALID, out, out_len);
+                }
+                a_emulator_page(tag, page, out + (page - in[1]) * 4);
+            }
+            *out_len = (uint8_t)((in[2] - in[1] + 1) * 4);
+            a_emulator_crc_append(out, out_len);
+            
+            return 0;
+        }
+        case EMULATOR_COMMAND_WRITE :
+        {
+            if (in_len != 8)
+            {
+                break;
+            }
+            
+            return a_emulator_write(tag, in[1], in + 2, out, out_len);
+        }
+        case EMULATOR_COMMAND_COMP_WRITE :
+        {
+            if (in_len != 4)
+            {
+                break;
+            }
+            if ((in[1] < 2) || (in[1] > tag->end_page))
+            {
+                break;
+            }
+            tag->comp_write = in[1];
+            
+            return a_emulator_ack(out, out_len);
+        }
+        case EMULATOR_COMMAND_READ_CNT :
+        {
+            if ((in_len != 4) || (in[1] > 2))
+            {
+                break;
+            }
+            out[0] = (uint8_t)((tag->counter[in[1]] >> 0) & 0xFF);
+            out[1] = (uint8_t)((tag->counter[in[1]] >> 8) & 0xFF);
+            out[2] = (uint8_t)((tag->counter[in[1]] >> 16) & 0xFF);
+            *out_len = 3;
+            a_emulator_crc_append(out, out_len);
+            
+            return 0;
+        }
+        case EMULATOR_COMMAND_INCR_CNT :
+        {
+            if ((in_len != 8) || (in[1] > 2))
+            {
+                break;
+            }
+            inc = (uint32_t)in[2] | ((uint32_t)in[3] << 8) | ((uint32_t)in[4] << 16);
+            if (tag->counter[in[1]] + inc > 0xFFFFFF)
+            {
+                return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_AUTH, out, out_len);
+            }
+            if ((tag->tear_next & (1 << in[1])) != 0)
+            {
+                /* the field is lost while the counter is written */
+                tag->tear_next &= (uint8_t)(~(1 << in[1]));
+                tag->tearing[in[1]] = 0x00;
+                a_emulator_drop(tag);
+                
+                return 1;
+            }
+            tag->counter[in[1]] += inc;
+            tag->tearing[in[1]] = 0xBD;
+            tag->programmed = 1;
+            
+            return a_emulator_ack(out, out_len);
+        }
+        case EMULATOR_COMMAND_CHECK_TEARING_EVENT :
+        {
+            if ((in_len != 4) || (in[1] > 2))
+            {
+                break;
+            }
+            out[0] = tag->tearing[in[1]];
+            *out_len = 1;
+            a_emulator_crc_append(out, out_len);
+            
+            return 0;
+        }
+        case EMULATOR_COMMAND_PWD_AUTH :
+        {
+            if (in_len != 7)
+            {
+                break;
+            }
+            authlim = tag->mem[tag->end_page - 2][0] & 0x07;
+            if ((authlim != 0) && (tag->auth_fail >= authlim))
+            {
+                return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_AUTH, out, out_len);
+            }
+            if (memcmp(in + 1, tag->mem[tag->end_page - 1], 4) != 0)
+            {
+                if (tag->auth_fail < 0xFF)
+                {
+                    tag->auth_fail++;
+                }
+                
+                return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_AUTH, out, out_len);
+            }
+            tag->auth_fail = 0;
+            tag->state = EMULATOR_MIFARE_ULTRALIGHT_STATE_AUTHENTICATED;
+            out[0] = tag->mem[tag->end_page][0];
+            out[1] = tag->mem[tag->end_page][1];
+            *out_len = 2;
+            a_emulator_crc_append(out, out_len);
+            
+            return 0;
+        }
+        case EMULATOR_COMMAND_READ_SIG :
+        {
+            if ((in_len != 4) || (in[1] != 0x00))
+            {
+                break;
+            }
+            memcpy(out, tag->signature, 32);
+            *out_len = 32;
+            a_emulator_crc_append(out, out_len);
+            
+            return 0;
+        }
+        case EMULATOR_COMMAND_VCSL :
+        {
+            if (in_len != 23)
+            {
+                break;
+            }
+            out[0] = tag->mem[tag->end_page - 2][1];
+            *out_len = 1;
+            a_emulator_crc_append(out, out_len);
+            
+            return 0;
+        }
+        default :
+        {
+            break;
+        }
+    }
+    
+    return a_emulator_nak(tag, EMULATOR_MIFARE_ULTRALIGHT_NAK_INVALID, out, out_len);
+}
+
+/**
+ * @brief      handle one frame
+ * @param[in]  *tag pointer to a tag structure
+ * @param[in]  *in pointer to a frame
+ * @param[in]  in_len frame length
+ * @param[out] *out pointer to a response buffer
+ * @param[out] *out_len pointer to a response length
+ * @return     status code
+ *             - 0 responded
+ *             - 1 no response
+ * @note       none
+ */
+static uint8_t a_emulator_process(emulator_mifare_ultralight_tag_t *tag, uint8_t *in, uint8_t in_len,
+                                  uint8_t *out, uint8_t *out_len)
+{
+    uint8_t cl[5];
+    
+    tag->programmed = 0;
+    
+    /* short frames */
+    if ((in_len == 1) && ((in[0] == EMULATOR_COMMAND_REQUEST) || (in[0] == EMULATOR_COMMAND_WAKE_UP)))
+    {
+        if ((tag->state == EMULATOR_MIFARE_ULTRALIGHT_STATE_IDLE) || 
+            ((tag->state == EMULATOR_MIFARE_ULTRALIGHT_STATE_HALT) && (in[0] == EMULATOR_COMMAND_WAKE_UP)))
+        {
+            tag->halted = (tag->state == EMULATOR_MIFARE_ULTRALIGHT_STATE_HALT) ? 1 : 0;
+            tag->state = EMULATOR_MIFARE_ULTRALIGHT_STATE_READY1;
+            tag->comp_write = 0xFF;
+            out[0] = 0x44;
+            out[1] = 0x00;
+            *out_len = 2;
+            
+            return 0;
+        }
+        if (tag->state != EMULATOR_MIFARE_ULTRALIGHT_STATE_HALT)
+        {
+            a_emulator_drop(tag);
+        }
+        
+        return 1;
+    }
+    
+    switch (tag->state)
+    {
+        case EMULATOR_MIFARE_ULTRALIGHT_STATE_READY1 :
+        case EMULATOR_MIFARE_ULTRALIGHT_STATE_READY2 :
+        {
+            if ((in_len >= 2) && 
+                (((tag->state == EMULATOR_MIFARE_ULTRALIGHT_STATE_READY1) && (in[0] == EMULATOR_COMMAND_SEL_CL1)) ||
+                 ((tag->state == EMULATOR_MIFARE_ULTRALIGHT_STATE_READY2) && (in[0] == EMULATOR_COMMAND_SEL_CL2))))
+            {
+                a_emulator_cascade(tag, in[0], cl);
+                if ((in_len == 2) && (in[1] == 0x20))
+                {
+                    memcpy(out, cl, 5);
+                    *out_len = 5;
+                    
+                    return 0;
+                }
+                if ((in_len == 9) && (in[1] == 0x70) && (a_emulator_crc_check(in, 9) == 0) && (memcmp(in + 2, cl, 5) == 0))
+                {
+                    if (tag->state == EMULATOR_MIFARE_ULTRALIGHT_STATE_READY1)
+                    {
+                        tag->state = EMULATOR_MIFARE_ULTRALIGHT_STATE_READY2;
+                        out[0] = 0x04;
+                    }
+                    else
+                    {
+                        tag->state = EMULATOR_MIFARE_ULTRALIGHT_STATE_ACTIVE;
+                        out[0] = 0x00;
+                    }
+                    *out_len = 1;
+                    
+                    return 0;
+                }
+            }
+            a_emulator_drop(tag);
+            
+            return 1;
+        }
+        case EMULATOR_MIFARE_ULTRALIGHT_STATE_ACTIVE :
+        case EMULATOR_MIFARE_ULTRALIGHT_STATE_AUTHENTICATED :
+        {
+            return a_emulator_active(tag, in, in_len, out, out_len);
+        }
+        default :
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief     init a tag with the factory content
+ * @param[in] *tag pointer to a tag structure
+ * @param[in] type tag type
+ * @param[in] *uid pointer to a 7 bytes uid
+ * @return    status code
+ *            - 0 success
+ *            - 1 param is invalid
+ * @note      password is 0xFFFFFFFF, pack is 0x0000, auth0 is 0xFF and vctid is 0x05
+ */
+uint8_t emulator_mifare_ultralight_tag_init(emulator_mifare_ultralight_tag_t *tag, emulator_mifare_ultralight_type_t type,
+                                            const uint8_t uid[7])
+{
+    uint8_t i;
+    
+    if ((tag == NULL) || (uid == NULL) || 
+        ((type != EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL11) && (type != EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21)))
+    {
+        return 1;
+    }
+    
+    memset(tag, 0, sizeof(emulator_mifare_ultralight_tag_t));
+    tag->end_page = (uint8_t)type;
+    memcpy(tag->uid, uid, 7);
+    tag->mem[0][0] = uid[0];
+    tag->mem[0][1] = uid[1];
+    tag->mem[0][2] = uid[2];
+    tag->mem[0][3] = (uint8_t)(0x88 ^ uid[0] ^ uid[1] ^ uid[2]);
+    memcpy(tag->mem[1], uid + 3, 4);
+    tag->mem[2][0] = (uint8_t)(uid[3] ^ uid[4] ^ uid[5] ^ uid[6]);
+    tag->mem[2][1] = 0x48;
+    if (type == EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21)
+    {
+        tag->mem[tag->end_page - 4][3] = 0xBD;
+    }
+    tag->mem[tag->end_page - 3][3] = 0xFF;
+    tag->mem[tag->end_page - 2][1] = 0x05;
+    memset(tag->mem[tag->end_page - 1], 0xFF, 4);
+    for (i = 0; i < 32; i++)
+    {
+        tag->signature[i] = (uint8_t)(uid[i % 7] ^ (i * 0x3B));
+    }
+    for (i = 0; i < 3; i++)
+    {
+        tag->tearing[i] = 0xBD;
+    }
+    tag->state = EMULATOR_MIFARE_ULTRALIGHT_STATE_IDLE;
+    tag->comp_write = 0xFF;
+    
+    return 0;
+}
+
+/**
+ * @brief     init an empty field
+ * @param[in] *field pointer to a field structure
+ * @note      none
+ */
+void emulator_mifare_ultralight_field_init(emulator_mifare_ultralight_field_t *field)
+{
+    memset(field, 0, sizeof(emulator_mifare_ultralight_field_t));
+}
+
+/**
+ * @brief     put a tag into the field
+ * @param[in] *field pointer to a field structure
+ * @param[in] *tag pointer to a tag structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 field is full
+ * @note      the tag enters in the idle state
+ */
+uint8_t emulator_mifare_ultralight_field_add(emulator_mifare_ultralight_field_t *field, emulator_mifare_ultralight_tag_t *tag)
+{
+    if (field->count >= EMULATOR_MIFARE_ULTRALIGHT_MAX_TAG)
+    {
+        return 1;
+    }
+    tag->state = EMULATOR_MIFARE_ULTRALIGHT_STATE_IDLE;
+    tag->halted = 0;
+    tag->comp_write = 0xFF;
+    field->tag[field->count] = tag;
+    field->count++;
+    
+    return 0;
+}
+
+/**
+ * @brief     remove a tag from the field
+ * @param[in] *field pointer to a field structure
+ * @param[in] *tag pointer to a tag structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 tag is not in the field
+ * @note      none
+ */
+uint8_t emulator_mifare_ultralight_field_remove(emulator_mifare_ultralight_field_t *field, emulator_mifare_ultralight_tag_t *tag)
+{
+    uint8_t i;
+    
+    for (i = 0; i < field->count; i++)
+    {
+        if (field->tag[i] == tag)
+        {
+            field->count--;
+            field->tag[i] = field->tag[field->count];
+            field->tag[field->count] = NULL;
+            
+            return 0;
+        }
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     power cycle the field
+ * @param[in] *field pointer to a field structure
+ * @note      every tag goes to the idle state and loses its authentication
+ */
+void emulator_mifare_ultralight_field_reset(emulator_mifare_ultralight_field_t *field)
+{
+    uint8_t i;
+    
+    for (i = 0; i < field->count; i++)
+    {
+        field->tag[i]->state = EMULATOR_MIFARE_ULTRALIGHT_STATE_IDLE;
+        field->tag[i]->halted = 0;
+        field->tag[i]->comp_write = 0xFF;
+    }
+}
+
+/**
+ * @brief         exchange one frame with the field
+ * @param[in]     *field pointer to a field structure
+ * @param[in]     *in_buf pointer to an input buffer
+ * @param[in]     in_len input length
+ * @param[out]    *out_buf pointer to an output buffer
+ * @param[in,out] *out_len pointer to an output length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 no response, collision or buffer overflow
+ * @note          the frame format matches contactless_transceiver, ack and nak are 1 byte
+ *                and the sak is returned without crc like the reader does
+ */
+uint8_t emulator_mifare_ultralight_transceiver(emulator_mifare_ultralight_field_t *field, uint8_t *in_buf, uint8_t in_len,
+                                               uint8_t *out_buf, uint8_t *out_len)
+{
+    uint8_t i;
+    uint8_t n;
+    uint8_t len;
+    uint8_t first_len;
+    uint8_t collision;
+    uint8_t prog;
+    uint32_t tx_etu;
+    uint32_t rx_etu;
+    uint32_t fdt;
+    uint8_t buf[EMULATOR_RESPONSE_LEN];
+    uint8_t first[EMULATOR_RESPONSE_LEN];
+    
+    field->frames++;
+    field->tx_bytes += in_len;
+    if (in_len == 0)
+    {
+        return 1;
+    }
+    if ((in_len == 1) && ((in_buf[0] == EMULATOR_COMMAND_REQUEST) || (in_buf[0] == EMULATOR_COMMAND_WAKE_UP)))
+    {
+        tx_etu = 1 + 7 + 2;                                           /* short frame */
+        fdt = a_emulator_fdt(in_buf[0], 7);
+    }
+    else
+    {
+        tx_etu = 1 + 9 * (uint32_t)in_len + 2;                        /* standard frame */
+        fdt = a_emulator_fdt(in_buf[in_len - 1], 8);
+    }
+    n = 0;
+    first_len = 0;
+    collision = 0;
+    prog = 0;
+    for (i = 0; i < field->count; i++)
+    {
+        len = 0;
+        if (a_emulator_process(field->tag[i], in_buf, in_len, buf, &len) != 0)
+        {
+            continue;
+        }
+        if (field->tag[i]->programmed != 0)
+        {
+            prog = 1;
+        }
+        if (n == 0)
+        {
+            memcpy(first, buf, len);
+            first_len = len;
+        }
+        else if ((len != first_len) || (memcmp(first, buf, len) != 0))
+        {
+            collision = 1;
+        }
+        n++;
+    }
+    if (n == 0)
+    {
+        rx_etu = 0;                                                   /* no response */
+    }
+    else if ((first_len == 1) && (in_len == 9) && (in_buf[1] == 0x70))
+    {
+        rx_etu = 1 + 9 * 3 + 1;                                       /* sak with crc */
+    }
+    else if (first_len == 1)
+    {
+        rx_etu = 1 + 4 + 1;                                           /* 4 bits ack or nak */
+    }
+    else
+    {
+        rx_etu = 1 + 9 * (uint32_t)first_len + 1;                     /* standard frame */
+    }
+    a_emulator_time(field, tx_etu, fdt, rx_etu, (prog != 0) ? EMULATOR_MIFARE_ULTRALIGHT_TPROG_US : 0);
+    if ((n == 0) || (collision != 0) || (first_len > *out_len))
+    {
+        return 1;
+    }
+    memcpy(out_buf, first, first_len);
+    *out_len = first_len;
+    field->rx_bytes += first_len;
+    
+    return 0;
+}
+
+/**
+ * @brief      exchange one bit oriented anti collision frame with the field
+ * @param[in]  *field pointer to a field structure
+ * @param[in]  *in_buf pointer to an input buffer
+ * @param[in]  in_bits input bit number
+ * @param[out] *out_buf pointer to an output buffer
+ * @param[out] *out_bits pointer to an output bit number buffer
+ * @param[out] *collision pointer to a collision index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no response
+ * @note       the frame format matches contactless_transceiver_bits
+ */
+uint8_t emulator_mifare_ultralight_transceiver_bits(emulator_mifare_ultralight_field_t *field, uint8_t *in_buf, uint8_t in_bits,
+                                                    uint8_t *out_buf, uint8_t *out_bits, uint8_t *collision)
+{
+    uint8_t i;
+    uint8_t j;
+    uint8_t n;
+    uint8_t known;
+    uint8_t state;
+    uint8_t bit;
+    uint8_t value[40];
+    uint8_t cl[5];
+    
+    field->frames++;
+    field->tx_bytes += (uint32_t)((in_bits + 7) / 8);
+    if ((in_bits < 16) || (in_bits >= 56) || 
+        ((in_buf[0] != EMULATOR_COMMAND_SEL_CL1) && (in_buf[0] != EMULATOR_COMMAND_SEL_CL2)))
+    {
+        return 1;
+    }
+    known = (uint8_t)(in_bits - 16);
+    state = (in_buf[0] == EMULATOR_COMMAND_SEL_CL1) ? EMULATOR_MIFARE_ULTRALIGHT_STATE_READY1 : EMULATOR_MIFARE_ULTRALIGHT_STATE_READY2;
+    n = 0;
+    *collision = 0xFF;
+    for (i = 0; i < field->count; i++)
+    {
+        if (field->tag[i]->state != state)
+        {
+            continue;
+        }
+        a_emulator_cascade(field->tag[i], in_buf[0], cl);
+        for (j = 0; j < known; j++)                               /* match the known bits */
+        {
+            if (((cl[j / 8] >> (j % 8)) & 0x01) != ((in_buf[2 + j / 8] >> (j % 8)) & 0x01))
+            {
+                break;
+            }
+        }
+        if (j != known)
+        {
+            continue;
+        }
+        for (j = known; j < 40; j++)                              /* answer the other bits */
+        {
+            bit = (uint8_t)((cl[j / 8] >> (j % 8)) & 0x01);
+            if (n == 0)
+            {
+                value[j] = bit;
+            }
+            else if ((value[j] != bit) && (*collision == 0xFF || (j - known) < *collision))
+            {
+                *collision = (uint8_t)(j - known);
+                value[j] = 1;
+            }
+            else
+            {
+                value[j] |= bit;
+            }
+        }
+        n++;
+    }
+    a_emulator_time(field, 1 + (uint32_t)in_bits + (uint32_t)(in_bits / 8) + 2, EMULATOR_MIFARE_ULTRALIGHT_FDT_1, 
+                    (n == 0) ? 0 : (uint32_t)(1 + (40 - known) + (40 - known) / 8 + 1), 0);
+    if (n == 0)
+    {
+        return 1;
+    }
+    memset(out_buf, 0, (size_t)(5 - known / 8));
+    for (j = known; j < 40; j++)
+    {
+        out_buf[j / 8 - known / 8] |= (uint8_t)(value[j] << (j % 8));
+    }
+    *out_bits = (uint8_t)(40 - known);
+    field->rx_bytes += (uint32_t)((*out_bits + 7) / 8);
+    
+    return 0;
+}
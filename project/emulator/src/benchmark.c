@@ -0,0 +1,748 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      benchmark.c
+ * @brief     benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_benchmark_test.h"
+#include "driver_mifare_ultralight_diversify.h"
+#include "driver_mifare_ultralight_signature.h"
+#include "driver_mifare_ultralight_trace.h"
+#include "emulator_driver_mifare_ultralight_interface.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief benchmark definition
+ */
+#define MIFARE_ULTRALIGHT_BENCHMARK_DIVERSIFY_BATCH        1024        /**< diversify uids of one batch */
+
+static mifare_ultralight_handle_t gs_handle;                                          /**< mifare_ultralight handle */
+static mifare_ultralight_benchmark_result_t gs_result[MIFARE_ULTRALIGHT_BENCHMARK_MAX];   /**< benchmark results */
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+static mifare_ultralight_trace_t gs_trace;                                            /**< frame trace ring */
+#endif
+static mifare_ultralight_signature_key_t gs_signature_key;                            /**< signature key */
+static uint8_t gs_signature_uid[MIFARE_ULTRALIGHT_SIGNATURE_BATCH][7];                /**< signature uids */
+static uint8_t gs_signature[MIFARE_ULTRALIGHT_SIGNATURE_BATCH][32];                   /**< signatures */
+static uint32_t gs_signature_count;                                                   /**< signature verifies */
+static double gs_signature_ops[2];                                                    /**< single and batch verifies per second */
+static mifare_ultralight_diversify_key_t gs_diversify_key;                            /**< diversify key */
+static uint8_t gs_diversify_uid[MIFARE_ULTRALIGHT_BENCHMARK_DIVERSIFY_BATCH][7];      /**< diversify uids */
+static uint8_t gs_diversify_pwd[MIFARE_ULTRALIGHT_BENCHMARK_DIVERSIFY_BATCH][4];      /**< diversified passwords */
+static uint8_t gs_diversify_pack[MIFARE_ULTRALIGHT_BENCHMARK_DIVERSIFY_BATCH][2];     /**< diversified packs */
+static uint32_t gs_diversify_count;                                                   /**< diversify derivations */
+static double gs_diversify_ops[2];                                                    /**< single and batch derivations per second */
+
+/**
+ * @brief  host monotonic clock
+ * @return timestamp in us
+ * @note   measures the cpu cost of the driver and the emulator
+ */
+static uint32_t a_benchmark_host_timestamp_us(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000);
+}
+
+/**
+ * @brief transport structure definition
+ */
+typedef struct benchmark_transport_s
+{
+    const char *name;                      /**< transport name */
+    uint32_t (*timestamp_us)(void);        /**< transport clock */
+} benchmark_transport_t;
+
+/**
+ * @brief transport table
+ */
+static const benchmark_transport_t gs_transport[] =
+{
+    {"emulator", mifare_ultralight_interface_timestamp_us},        /* modeled on air time */
+    {"host", a_benchmark_host_timestamp_us},                       /* host cpu time */
+};
+
+/**
+ * @brief     write the results as json
+ * @param[in] *fp pointer to a file
+ * @param[in] *transport pointer to the transport name
+ * @param[in] *type pointer to the tag type name
+ * @param[in] samples samples of every operation
+ * @note      one result per line, so the baseline can be parsed line by line
+ */
+static void a_benchmark_json(FILE *fp, const char *transport, const char *type, uint32_t samples)
+{
+    uint32_t i;
+
+    (void)fprintf(fp, "{\n");
+    (void)fprintf(fp, "  \"transport\": \"%s\",\n", transport);
+    (void)fprintf(fp, "  \"type\": \"%s\",\n", type);
+    (void)fprintf(fp, "  \"samples\": %u,\n", (unsigned int)samples);
+    if (gs_signature_count != 0)
+    {
+        (void)fprintf(fp, "  \"signature\": {\"count\": %u, \"verify_ops\": %.1f, \"batch_verify_ops\": %.1f},\n",
+                      (unsigned int)gs_signature_count, gs_signature_ops[0], gs_signature_ops[1]);
+    }
+    if (gs_diversify_count != 0)
+    {
+        (void)fprintf(fp, "  \"diversify\": {\"count\": %u, \"derive_ops\": %.1f, \"batch_derive_ops\": %.1f},\n",
+                      (unsigned int)gs_diversify_count, gs_diversify_ops[0], gs_diversify_ops[1]);
+    }
+    (void)fprintf(fp, "  \"results\": [\n");
+    for (i = 0; i < MIFARE_ULTRALIGHT_BENCHMARK_MAX; i++)
+    {
+        (void)fprintf(fp, "    {\"name\": \"%s\", \"samples\": %u, \"mean_us\": %u, \"p50_us\": %u, \"p99_us\": %u, \"ops\": %.1f}%s\n",
+                      gs_result[i].name, (unsigned int)gs_result[i].samples, (unsigned int)gs_result[i].mean_us, 
+                      (unsigned int)gs_result[i].p50_us, (unsigned int)gs_result[i].p99_us, gs_result[i].ops,
+                      (i + 1 < MIFARE_ULTRALIGHT_BENCHMARK_MAX) ? "," : "");
+    }
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+    {
+        mifare_ultralight_stats_t stats;
+        uint32_t frames;
+
+        (void)mifare_ultralight_get_stats(&gs_handle, &stats);
+        frames = 0;
+        for (i = 0; i < MIFARE_ULTRALIGHT_STATS_COMMAND_MAX; i++)
+        {
+            frames += stats.command[i];
+        }
+        (void)fprintf(fp, "  ],\n");
+        (void)fprintf(fp, "  \"stats\": {\"frames\": %u, \"tx_bytes\": %u, \"rx_bytes\": %u, \"errors\": [",
+                      (unsigned int)frames, (unsigned int)stats.tx_bytes, (unsigned int)stats.rx_bytes);
+        for (i = 0; i < MIFARE_ULTRALIGHT_STATS_ERROR_MAX; i++)
+        {
+            (void)fprintf(fp, "%u%s", (unsigned int)stats.error[i], (i + 1 < MIFARE_ULTRALIGHT_STATS_ERROR_MAX) ? ", " : "");
+        }
+        (void)fprintf(fp, "]}\n");
+    }
+#else
+    (void)fprintf(fp, "  ]\n");
+#endif
+    (void)fprintf(fp, "}\n");
+}
+
+/**
+ * @brief     check the results against a baseline
+ * @param[in] *path pointer to the baseline path
+ * @param[in] *transport pointer to the transport name
+ * @param[in] *type pointer to the tag type name
+ * @param[in] tolerance allowed slowdown in percent
+ * @return    status code
+ *            - 0 success
+ *            - 1 regression found
+ *            - 2 baseline is invalid
+ * @note      p50 and p99 may grow and ops may drop by the tolerance
+ */
+static uint8_t a_benchmark_check(const char *path, const char *transport, const char *type, uint32_t tolerance)
+{
+    FILE *fp;
+    char line[256];
+    char name[64];
+    char value[16];
+    unsigned int samples;
+    unsigned int mean_us;
+    unsigned int p50_us;
+    unsigned int p99_us;
+    float ops;
+    uint32_t i;
+    uint32_t found;
+    uint8_t res;
+
+    fp = fopen(path, "r");
+    if (fp == NULL)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: open %s failed.\n", path);
+
+        return 2;
+    }
+    res = 0;
+    found = 0;
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        if (sscanf(line, " \"transport\": \"%15[^\"]\"", value) == 1)
+        {
+            if (strcmp(value, transport) != 0)
+            {
+                mifare_ultralight_interface_debug_print("mifare_ultralight: baseline transport is %s.\n", value);
+                res = 2;
+            }
+            continue;
+        }
+        if (sscanf(line, " \"type\": \"%15[^\"]\"", value) == 1)
+        {
+            if (strcmp(value, type) != 0)
+            {
+                mifare_ultralight_interface_debug_print("mifare_ultralight: baseline type is %s.\n", value);
+                res = 2;
+            }
+            continue;
+        }
+        if (sscanf(line, " {\"name\": \"%63[^\"]\", \"samples\": %u, \"mean_us\": %u, \"p50_us\": %u, \"p99_us\": %u, \"ops\": %f", 
+                   name, &samples, &mean_us, &p50_us, &p99_us, &ops) != 6)
+        {
+            continue;
+        }
+        found++;
+        for (i = 0; i < MIFARE_ULTRALIGHT_BENCHMARK_MAX; i++)
+        {
+            if (strcmp(name, gs_result[i].name) == 0)
+            {
+                break;
+            }
+        }
+        if (i == MIFARE_ULTRALIGHT_BENCHMARK_MAX)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: %s is not measured.\n", name);
+            res = (res != 0) ? res : 1;
+
+            continue;
+        }
+        if (((uint64_t)gs_result[i].p50_us * 100 > (uint64_t)p50_us * (100 + tolerance)) ||
+            ((uint64_t)gs_result[i].p99_us * 100 > (uint64_t)p99_us * (100 + tolerance)) ||
+            (gs_result[i].ops * 100.0f < ops * (float)(100 - ((tolerance > 100) ? 100 : tolerance))))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: %s regressed, p50 %u/%u us, p99 %u/%u us, %.1f/%.1f ops.\n",
+                                                    name, (unsigned int)gs_result[i].p50_us, p50_us, 
+                                                    (unsigned int)gs_result[i].p99_us, p99_us, gs_result[i].ops, ops);
+            res = (res != 0) ? res : 1;
+        }
+    }
+    (void)fclose(fp);
+    if (found == 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: baseline has no result.\n");
+
+        return 2;
+    }
+
+    return res;
+}
+
+/**
+ * @brief     measure the originality signature verifies
+ * @param[in] count verifies of every mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      in range random signatures cost the same as genuine ones, the host clock is always used
+ */
+static uint8_t a_benchmark_signature(uint32_t count)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t n;
+    uint32_t passed;
+    uint32_t start;
+    uint32_t elapsed;
+    mifare_ultralight_bool_t valid[MIFARE_ULTRALIGHT_SIGNATURE_BATCH];
+
+    if (mifare_ultralight_signature_init(&gs_signature_key, NULL) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: signature init failed.\n");
+
+        return 1;
+    }
+    srand(21);
+    for (i = 0; i < MIFARE_ULTRALIGHT_SIGNATURE_BATCH; i++)
+    {
+        for (j = 0; j < 7; j++)
+        {
+            gs_signature_uid[i][j] = (uint8_t)(rand() % 256);
+        }
+        for (j = 0; j < 32; j++)
+        {
+            gs_signature[i][j] = (uint8_t)(rand() % 256);
+        }
+        gs_signature[i][0] &= 0x7F;
+        gs_signature[i][16] &= 0x7F;
+    }
+
+    /* single verifies */
+    start = a_benchmark_host_timestamp_us();
+    for (i = 0; i < count; i++)
+    {
+        (void)mifare_ultralight_signature_verify(&gs_signature_key, gs_signature_uid[i % MIFARE_ULTRALIGHT_SIGNATURE_BATCH],
+                                                 gs_signature[i % MIFARE_ULTRALIGHT_SIGNATURE_BATCH], &valid[0]);
+    }
+    elapsed = a_benchmark_host_timestamp_us() - start;
+    gs_signature_ops[0] = (double)count * 1000000.0 / (double)((elapsed == 0) ? 1 : elapsed);
+
+    /* batch verifies */
+    start = a_benchmark_host_timestamp_us();
+    for (i = 0; i < count; i += n)
+    {
+        n = ((count - i) > MIFARE_ULTRALIGHT_SIGNATURE_BATCH) ? MIFARE_ULTRALIGHT_SIGNATURE_BATCH : (count - i);
+        (void)mifare_ultralight_signature_verify_batch(&gs_signature_key, (const uint8_t (*)[7])gs_signature_uid,
+                                                       (const uint8_t (*)[32])gs_signature, n, valid, &passed);
+    }
+    elapsed = a_benchmark_host_timestamp_us() - start;
+    gs_signature_ops[1] = (double)count * 1000000.0 / (double)((elapsed == 0) ? 1 : elapsed);
+    gs_signature_count = count;
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %u signature verifies, %.1f/s single, %.1f/s batch.\n",
+                                            (unsigned int)count, gs_signature_ops[0], gs_signature_ops[1]);
+
+    return 0;
+}
+
+/**
+ * @brief     measure the password and pack derivations
+ * @param[in] count derivations of every mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the host clock is always used
+ */
+static uint8_t a_benchmark_diversify(uint32_t count)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t n;
+    uint32_t start;
+    uint32_t elapsed;
+    uint8_t master[16];
+    uint8_t system[8];
+
+    srand(23);
+    for (i = 0; i < 16; i++)
+    {
+        master[i] = (uint8_t)(rand() % 256);
+    }
+    for (i = 0; i < 8; i++)
+    {
+        system[i] = (uint8_t)(rand() % 256);
+    }
+    if (mifare_ultralight_diversify_init(&gs_diversify_key, master, system, 8) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: diversify init failed.\n");
+
+        return 1;
+    }
+    for (i = 0; i < MIFARE_ULTRALIGHT_BENCHMARK_DIVERSIFY_BATCH; i++)
+    {
+        for (j = 0; j < 7; j++)
+        {
+            gs_diversify_uid[i][j] = (uint8_t)(rand() % 256);
+        }
+    }
+
+    /* single derivations */
+    start = a_benchmark_host_timestamp_us();
+    for (i = 0; i < count; i++)
+    {
+        (void)mifare_ultralight_diversify(&gs_diversify_key, gs_diversify_uid[i % MIFARE_ULTRALIGHT_BENCHMARK_DIVERSIFY_BATCH],
+                                          gs_diversify_pwd[i % MIFARE_ULTRALIGHT_BENCHMARK_DIVERSIFY_BATCH], gs_diversify_pack[i % MIFARE_ULTRALIGHT_BENCHMARK_DIVERSIFY_BATCH]);
+    }
+    elapsed = a_benchmark_host_timestamp_us() - start;
+    gs_diversify_ops[0] = (double)count * 1000000.0 / (double)((elapsed == 0) ? 1 : elapsed);
+
+    /* batch derivations */
+    start = a_benchmark_host_timestamp_us();
+    for (i = 0; i < count; i += n)
+    {
+        n = ((count - i) > MIFARE_ULTRALIGHT_BENCHMARK_DIVERSIFY_BATCH) ? MIFARE_ULTRALIGHT_BENCHMARK_DIVERSIFY_BATCH : (count - i);
+        (void)mifare_ultralight_diversify_batch(&gs_diversify_key, (const uint8_t (*)[7])gs_diversify_uid, n,
+                                                gs_diversify_pwd, gs_diversify_pack);
+    }
+    elapsed = a_benchmark_host_timestamp_us() - start;
+    gs_diversify_ops[1] = (double)count * 1000000.0 / (double)((elapsed == 0) ? 1 : elapsed);
+    gs_diversify_count = count;
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %u derivations, %.1f/s single, %.1f/s batch.\n",
+                                            (unsigned int)count, gs_diversify_ops[0], gs_diversify_ops[1]);
+
+    return 0;
+}
+
+/**
+ * @brief     mifare_ultralight benchmark function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 5 param is invalid
+ *             - 6 regression found
+ * @note      none
+ */
+uint8_t mifare_ultralight_benchmark(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"baseline", required_argument, NULL, 1},
+        {"output", required_argument, NULL, 2},
+        {"samples", required_argument, NULL, 3},
+        {"tolerance", required_argument, NULL, 4},
+        {"transport", required_argument, NULL, 5},
+        {"type", required_argument, NULL, 6},
+        {"trace", required_argument, NULL, 7},
+        {"signature", required_argument, NULL, 8},
+        {"diversify", required_argument, NULL, 9},
+        {NULL, 0, NULL, 0},
+    };
+    const char *baseline = NULL;
+    const char *output = NULL;
+    const char *trace = NULL;
+    const benchmark_transport_t *transport = &gs_transport[0];
+    const char *type = "MF0UL21";
+    emulator_mifare_ultralight_type_t tag_type = EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21;
+    uint32_t samples = 64;
+    uint32_t tolerance = 5;
+    uint32_t signature = 0;
+    uint32_t diversify = 0;
+    uint32_t i;
+    uint8_t res;
+    FILE *fp;
+
+    /* init 0 */
+    optind = 0;
+
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                mifare_ultralight_interface_debug_print("Usage:\n");
+                mifare_ultralight_interface_debug_print("  mifare_ultralight_benchmark [--transport=<emulator | host>] [--type=<MF0UL11 | MF0UL21>]\n");
+                mifare_ultralight_interface_debug_print("                              [--samples=<n>] [--output=<file>] [--baseline=<file>] [--tolerance=<percent>]\n");
+                mifare_ultralight_interface_debug_print("                              [--trace=<file>] [--signature=<n>] [--diversify=<n>]\n");
+                mifare_ultralight_interface_debug_print("\n");
+                mifare_ultralight_interface_debug_print("Options:\n");
+                mifare_ultralight_interface_debug_print("      --baseline=<file>            Check the results against a baseline json file.\n");
+                mifare_ultralight_interface_debug_print("      --diversify=<n>              Also measure n password and pack derivations on the host clock.\n");
+                mifare_ultralight_interface_debug_print("  -h, --help                       Show the help.\n");
+                mifare_ultralight_interface_debug_print("      --output=<file>              Write the json results to a file.([default: stdout])\n");
+                mifare_ultralight_interface_debug_print("      --samples=<n>                Set the samples of every operation.([default: 64])\n");
+                mifare_ultralight_interface_debug_print("      --signature=<n>              Also measure n originality signature verifies on the host clock.\n");
+                mifare_ultralight_interface_debug_print("      --tolerance=<percent>        Set the allowed slowdown against the baseline.([default: 5])\n");
+                mifare_ultralight_interface_debug_print("      --trace=<file>               Save the last frames of the run as a binary trace file.\n");
+                mifare_ultralight_interface_debug_print("      --transport=<emulator | host>\n");
+                mifare_ultralight_interface_debug_print("                                   Set the clock, modeled on air time or host cpu time.([default: emulator])\n");
+                mifare_ultralight_interface_debug_print("      --type=<MF0UL11 | MF0UL21>   Set the emulated tag type.([default: MF0UL21])\n");
+
+                return 0;
+            }
+
+            /* baseline */
+            case 1 :
+            {
+                baseline = optarg;
+
+                break;
+            }
+
+            /* output */
+            case 2 :
+            {
+                output = optarg;
+
+                break;
+            }
+
+            /* samples */
+            case 3 :
+            {
+                samples = (uint32_t)atol(optarg);
+                if ((samples == 0) || (samples > MIFARE_ULTRALIGHT_BENCHMARK_MAX_SAMPLE))
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* tolerance */
+            case 4 :
+            {
+                tolerance = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* transport */
+            case 5 :
+            {
+                for (i = 0; i < sizeof(gs_transport) / sizeof(gs_transport[0]); i++)
+                {
+                    if (strcmp(gs_transport[i].name, optarg) == 0)
+                    {
+                        break;
+                    }
+                }
+                if (i == sizeof(gs_transport) / sizeof(gs_transport[0]))
+                {
+                    return 5;
+                }
+                transport = &gs_transport[i];
+
+                break;
+            }
+
+            /* tag type */
+            case 6 :
+            {
+                if (strcmp("MF0UL11", optarg) == 0)
+                {
+                    tag_type = EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL11;
+                    type = "MF0UL11";
+                }
+                else if (strcmp("MF0UL21", optarg) == 0)
+                {
+                    tag_type = EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21;
+                    type = "MF0UL21";
+                }
+                else
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* trace */
+            case 7 :
+            {
+                trace = optarg;
+
+                break;
+            }
+
+            /* signature */
+            case 8 :
+            {
+                signature = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* diversify */
+            case 9 :
+            {
+                diversify = (uint32_t)atol(optarg);
+
+                break;
+            }
+
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+
+    /* put the emulated tag into the field */
+    if (tag_type != EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21)
+    {
+        emulator_mifare_ultralight_field_t *field = emulator_mifare_ultralight_interface_field();
+        uint8_t uid[7];
+
+        memcpy(uid, field->tag[0]->uid, 7);
+        (void)emulator_mifare_ultralight_tag_init(field->tag[0], tag_type, uid);
+    }
+
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_interface_contactless_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, transport->timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+    /* start the trace */
+    if (trace != NULL)
+    {
+        (void)mifare_ultralight_set_trace(&gs_handle, &gs_trace);
+    }
+#else
+    if (trace != NULL)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: trace is not compiled in.\n");
+
+        return 5;
+    }
+#endif
+
+    /* run the benchmark */
+    res = mifare_ultralight_benchmark_test(&gs_handle, transport->timestamp_us, samples, gs_result);
+    if (res != 0)
+    {
+        return 1;
+    }
+
+    /* run the signature benchmark, it is not part of the baseline */
+    if (signature != 0)
+    {
+        res = a_benchmark_signature(signature);
+        if (res != 0)
+        {
+            return 1;
+        }
+    }
+
+    /* run the diversify benchmark, it is not part of the baseline */
+    if (diversify != 0)
+    {
+        res = a_benchmark_diversify(diversify);
+        if (res != 0)
+        {
+            return 1;
+        }
+    }
+
+    /* output the json */
+    if (output != NULL)
+    {
+        fp = fopen(output, "w");
+        if (fp == NULL)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: open %s failed.\n", output);
+
+            return 1;
+        }
+        a_benchmark_json(fp, transport->name, type, samples);
+        (void)fclose(fp);
+    }
+    else
+    {
+        a_benchmark_json(stdout, transport->name, type, samples);
+    }
+
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+    /* save the trace */
+    if (trace != NULL)
+    {
+        uint32_t count;
+
+        fp = fopen(trace, "wb");
+        if (fp == NULL)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: open %s failed.\n", trace);
+
+            return 1;
+        }
+        res = mifare_ultralight_trace_save(&gs_handle, fp, &count);
+        (void)fclose(fp);
+        (void)mifare_ultralight_set_trace(&gs_handle, NULL);
+        if (res != 0)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: save %s failed.\n", trace);
+
+            return 1;
+        }
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %u frames saved to %s, %u frames lost.\n", 
+                                                (unsigned int)count, trace, (unsigned int)gs_trace.lost);
+    }
+#endif
+
+    /* check the baseline */
+    if (baseline != NULL)
+    {
+        res = a_benchmark_check(baseline, transport->name, type, tolerance);
+        if (res == 1)
+        {
+            return 6;
+        }
+        else if (res != 0)
+        {
+            return 1;
+        }
+        mifare_ultralight_interface_debug_print("mifare_ultralight: no regression against %s.\n", baseline);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed or regression found
+ * @note      a regression is reported in the exit code for the release gate
+ */
+int main(uint8_t argc, char **argv)
+{
+    uint8_t res;
+
+    res = mifare_ultralight_benchmark(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: param is invalid.\n");
+    }
+    else if (res == 6)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: regression found.\n");
+    }
+    else
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: unknown status code.\n");
+    }
+
+    return (res == 0) ? 0 : 1;
+}
@@ -0,0 +1,570 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      main.c
+ * @brief     main source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_cache_test.h"
+#include "driver_mifare_ultralight_diversify_test.h"
+#include "driver_mifare_ultralight_session_test.h"
+#include "driver_mifare_ultralight_personalize_test.h"
+#include "driver_mifare_ultralight_range_test.h"
+#include "driver_mifare_ultralight_inventory_test.h"
+#include "driver_mifare_ultralight_trace_test.h"
+#include "driver_mifare_ultralight_op_test.h"
+#include "driver_mifare_ultralight_conf_test.h"
+#include "driver_mifare_ultralight_diff_test.h"
+#include "driver_mifare_ultralight_guard_test.h"
+#include "driver_mifare_ultralight_enumerate_test.h"
+#include "driver_mifare_ultralight_stats_test.h"
+#include "driver_mifare_ultralight_verify_test.h"
+#include "driver_mifare_ultralight_card_test.h"
+#include "driver_mifare_ultralight_crc_test.h"
+#include "driver_mifare_ultralight_latency_test.h"
+#include "driver_mifare_ultralight_retry_test.h"
+#include "driver_mifare_ultralight_signature_test.h"
+#include "driver_mifare_ultralight_manager_test.h"
+#include "emulator_driver_mifare_ultralight_interface.h"
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+
+static emulator_mifare_ultralight_tag_t gs_inventory_tag[2];        /**< extra tags of the inventory test */
+static emulator_mifare_ultralight_tag_t gs_enumerate_tag[2];        /**< extra tags of the enumerate test */
+
+/**
+ * @brief     mifare_ultralight full function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 5 param is invalid
+ * @note      none
+ */
+uint8_t mifare_ultralight(uint8_t argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "hit:";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"information", no_argument, NULL, 'i'},
+        {"test", required_argument, NULL, 't'},
+        {"type", required_argument, NULL, 1},
+        {"realtime", no_argument, NULL, 2},
+        {NULL, 0, NULL, 0},
+    };
+    char type[33] = "unknown";
+    emulator_mifare_ultralight_type_t tag_type = EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21;
+
+    /* if no params */
+    if (argc == 1)
+    {
+        /* goto the help */
+        goto help;
+    }
+
+    /* init 0 */
+    optind = 0;
+
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "h");
+
+                break;
+            }
+
+            /* information */
+            case 'i' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "i");
+
+                break;
+            }
+
+            /* test */
+            case 't' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "t_%s", optarg);
+
+                break;
+            }
+
+            /* tag type */
+            case 1 :
+            {
+                /* set the tag type */
+                if (strcmp("MF0UL11", optarg) == 0)
+                {
+                    tag_type = EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL11;
+                }
+                else if (strcmp("MF0UL21", optarg) == 0)
+                {
+                    tag_type = EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21;
+                }
+                else
+                {
+                    return 5;
+                }
+
+                break;
+            }
+
+            /* realtime */
+            case 2 :
+            {
+                /* sleep for the modeled time */
+                emulator_mifare_ultralight_interface_set_realtime(1);
+
+                break;
+            }
+
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+
+    /* put the emulated tag into the field */
+    if (tag_type != EMULATOR_MIFARE_ULTRALIGHT_TYPE_MF0UL21)
+    {
+        emulator_mifare_ultralight_field_t *field = emulator_mifare_ultralight_interface_field();
+        uint8_t uid[7];
+
+        memcpy(uid, field->tag[0]->uid, 7);
+        (void)emulator_mifare_ultralight_tag_init(field->tag[0], tag_type, uid);
+    }
+
+    /* run the function */
+    if (strcmp("t_card", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the card test */
+        res = mifare_ultralight_card_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_crc", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the crc test */
+        res = mifare_ultralight_crc_test(100000);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_latency", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the latency test */
+        res = mifare_ultralight_latency_test(16);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_retry", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the retry test */
+        res = mifare_ultralight_retry_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_signature", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the signature test */
+        res = mifare_ultralight_signature_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_cache", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the cache test */
+        res = mifare_ultralight_cache_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_diversify", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the diversify test */
+        res = mifare_ultralight_diversify_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_session", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the session test */
+        res = mifare_ultralight_session_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_personalize", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the personalize test */
+        res = mifare_ultralight_personalize_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_range", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the range test */
+        res = mifare_ultralight_range_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_inventory", type) == 0)
+    {
+        uint8_t res;
+        uint8_t i;
+        uint8_t uid[7] = {0x04, 0x11, 0x22, 0x33, 0x44, 0x55, 0x80};
+        emulator_mifare_ultralight_field_t *field = emulator_mifare_ultralight_interface_field();
+
+        /* put two more tags into the field */
+        for (i = 0; i < 2; i++)
+        {
+            uid[1] = (uint8_t)(0x11 + i * 0x40);
+            (void)emulator_mifare_ultralight_tag_init(&gs_inventory_tag[i], tag_type, uid);
+            (void)emulator_mifare_ultralight_field_add(field, &gs_inventory_tag[i]);
+        }
+
+        /* run the inventory test */
+        res = mifare_ultralight_inventory_test(3, emulator_mifare_ultralight_interface_contactless_transceiver_bits);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_trace", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the trace test */
+        res = mifare_ultralight_trace_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_op", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the op test */
+        res = mifare_ultralight_op_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_conf", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the conf test */
+        res = mifare_ultralight_conf_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_diff", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the diff test */
+        res = mifare_ultralight_diff_test(MIFARE_ULTRALIGHT_BOOL_TRUE);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_guard", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the guard test */
+        res = mifare_ultralight_guard_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_enumerate", type) == 0)
+    {
+        uint8_t res;
+        uint8_t i;
+        uint8_t uid[7] = {0x04, 0x12, 0x22, 0x33, 0x44, 0x55, 0x80};
+        emulator_mifare_ultralight_field_t *field = emulator_mifare_ultralight_interface_field();
+
+        /* put two more tags into the field */
+        for (i = 0; i < 2; i++)
+        {
+            uid[3] = (uint8_t)(0x33 + i * 0x08);
+            (void)emulator_mifare_ultralight_tag_init(&gs_enumerate_tag[i], tag_type, uid);
+            (void)emulator_mifare_ultralight_field_add(field, &gs_enumerate_tag[i]);
+        }
+
+        /* run the enumerate test */
+        res = mifare_ultralight_enumerate_test(3, emulator_mifare_ultralight_interface_contactless_transceiver_bits);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_stats", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the stats test */
+        res = mifare_ultralight_stats_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_verify", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the verify test */
+        res = mifare_ultralight_verify_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_manager", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the manager test */
+        res = mifare_ultralight_manager_test(256);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("h", type) == 0)
+    {
+        help:
+        mifare_ultralight_interface_debug_print("Usage:\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-i | --information)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-h | --help)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t card | --test=card) [--type=<MF0UL11 | MF0UL21>]\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t crc | --test=crc)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t latency | --test=latency) [--type=<MF0UL11 | MF0UL21>] [--realtime]\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t manager | --test=manager)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t retry | --test=retry)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t signature | --test=signature)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t cache | --test=cache)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t diversify | --test=diversify)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t session | --test=session)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t personalize | --test=personalize)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t range | --test=range)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t inventory | --test=inventory)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t trace | --test=trace)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t op | --test=op)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t conf | --test=conf)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t diff | --test=diff)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t guard | --test=guard)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t enumerate | --test=enumerate)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t stats | --test=stats)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t verify | --test=verify)\n");
+        mifare_ultralight_interface_debug_print("\n");
+        mifare_ultralight_interface_debug_print("Options:\n");
+        mifare_ultralight_interface_debug_print("  -h, --help                     Show the help.\n");
+        mifare_ultralight_interface_debug_print("  -i, --information              Show the chip information.\n");
+        mifare_ultralight_interface_debug_print("  -t <card | crc | latency | manager | retry | signature | cache | diversify | session | personalize | range | inventory | trace | op | conf | diff | guard | enumerate | stats | verify>, --test=<card | crc | latency | manager | retry | signature | cache | diversify | session | personalize | range | inventory | trace | op | conf | diff | guard | enumerate | stats | verify>\n");
+        mifare_ultralight_interface_debug_print("                                 Run the driver test.\n");
+        mifare_ultralight_interface_debug_print("      --realtime                 Sleep for the modeled on air time.\n");
+        mifare_ultralight_interface_debug_print("      --type=<MF0UL11 | MF0UL21> Set the emulated tag type.([default: MF0UL21])\n");
+
+        return 0;
+    }
+    else if (strcmp("i", type) == 0)
+    {
+        mifare_ultralight_info_t info;
+
+        /* print mifare_ultralight info */
+        mifare_ultralight_info(&info);
+        mifare_ultralight_interface_debug_print("mifare_ultralight: chip is %s.\n", info.chip_name);
+        mifare_ultralight_interface_debug_print("mifare_ultralight: manufacturer is %s.\n", info.manufacturer_name);
+        mifare_ultralight_interface_debug_print("mifare_ultralight: interface is %s.\n", info.interface);
+        mifare_ultralight_interface_debug_print("mifare_ultralight: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        mifare_ultralight_interface_debug_print("mifare_ultralight: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        mifare_ultralight_interface_debug_print("mifare_ultralight: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        mifare_ultralight_interface_debug_print("mifare_ultralight: max current is %0.2fmA.\n", info.max_current_ma);
+        mifare_ultralight_interface_debug_print("mifare_ultralight: max temperature is %0.1fC.\n", info.temperature_max);
+        mifare_ultralight_interface_debug_print("mifare_ultralight: min temperature is %0.1fC.\n", info.temperature_min);
+
+        return 0;
+    }
+    else
+    {
+        return 5;
+    }
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      a failed run is reported in the exit code for ctest
+ */
+int main(uint8_t argc, char **argv)
+{
+    uint8_t res;
+
+    res = mifare_ultralight(argc, argv);
+    if (res == 0)
+    {
+        /* run success */
+    }
+    else if (res == 1)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: run failed.\n");
+    }
+    else if (res == 5)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: param is invalid.\n");
+    }
+    else
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: unknown status code.\n");
+    }
+
+    return (res == 0) ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      trace.c
+ * @brief     trace decoder source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_trace.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note      every frame is printed with its time from the first frame,
+ *            direction, length, bytes and annotation
+ */
+int main(int argc, char **argv)
+{
+    uint32_t count;
+    uint8_t res;
+    FILE *fp;
+
+    if ((argc != 2) || (strcmp(argv[1], "-h") == 0) || (strcmp(argv[1], "--help") == 0))
+    {
+        (void)printf("Usage:\n");
+        (void)printf("  mifare_ultralight_trace_decoder <file>\n");
+
+        return (argc == 2) ? 0 : 1;
+    }
+
+    fp = fopen(argv[1], "rb");
+    if (fp == NULL)
+    {
+        (void)printf("mifare_ultralight: open %s failed.\n", argv[1]);
+
+        return 1;
+    }
+    (void)printf("      time  dir len  frame  annotation\n");
+    res = mifare_ultralight_trace_print(fp, stdout, &count);
+    (void)fclose(fp);
+    if (res != 0)
+    {
+        (void)printf("mifare_ultralight: %s is invalid.\n", argv[1]);
+
+        return 1;
+    }
+    (void)printf("mifare_ultralight: %u frames decoded.\n", (unsigned int)count);
+
+    return 0;
+}
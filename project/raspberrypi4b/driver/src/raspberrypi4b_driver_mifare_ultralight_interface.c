@@ -39,6 +39,7 @@
 #include "gpio.h"
 #include <unistd.h>
 #include <stdarg.h>
+#include <time.h>
 
 uint8_t (*g_gpio_irq)(void) = NULL;        /**< gpio irq function address */
 
@@ -186,6 +187,39 @@ void mifare_ultralight_interface_delay_ms(uint32_t ms)
     usleep(1000 * ms);
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      busy wait, usleep overshoots short guard times
+ */
+void mifare_ultralight_interface_delay_us(uint32_t us)
+{
+    struct timespec start;
+    struct timespec now;
+    uint64_t ns;
+    
+    ns = (uint64_t)us * 1000;
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    do
+    {
+        (void)clock_gettime(CLOCK_MONOTONIC, &now);
+    } while ((uint64_t)(now.tv_sec - start.tv_sec) * 1000000000 + (uint64_t)now.tv_nsec - (uint64_t)start.tv_nsec < ns);
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return timestamp in us
+ * @note   none
+ */
+uint32_t mifare_ultralight_interface_timestamp_us(void)
+{
+    struct timespec t;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    
+    return (uint32_t)((uint64_t)t.tv_sec * 1000000 + (uint64_t)t.tv_nsec / 1000);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
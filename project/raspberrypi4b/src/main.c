@@ -35,7 +35,24 @@
  */
 
 #include "driver_mifare_ultralight_basic.h"
+#include "driver_mifare_ultralight_cache_test.h"
+#include "driver_mifare_ultralight_diversify_test.h"
+#include "driver_mifare_ultralight_session_test.h"
+#include "driver_mifare_ultralight_personalize_test.h"
+#include "driver_mifare_ultralight_range_test.h"
+#include "driver_mifare_ultralight_inventory_test.h"
+#include "driver_mifare_ultralight_op_test.h"
+#include "driver_mifare_ultralight_conf_test.h"
+#include "driver_mifare_ultralight_diff_test.h"
+#include "driver_mifare_ultralight_guard_test.h"
+#include "driver_mifare_ultralight_enumerate_test.h"
+#include "driver_mifare_ultralight_verify_test.h"
 #include "driver_mifare_ultralight_card_test.h"
+#include "driver_mifare_ultralight_crc_test.h"
+#include "driver_mifare_ultralight_latency_test.h"
+#include "driver_mifare_ultralight_retry_test.h"
+#include "driver_mifare_ultralight_signature_test.h"
+#include "driver_mifare_ultralight_manager_test.h"
 #include <getopt.h>
 #include <math.h>
 #include <stdlib.h>
@@ -578,6 +595,227 @@ uint8_t mifare_ultralight(uint8_t argc, char **argv)
 
         return 0;
     }
+    else if (strcmp("t_crc", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the crc test */
+        res = mifare_ultralight_crc_test(1000000);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_latency", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the latency test */
+        res = mifare_ultralight_latency_test(16);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_retry", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the retry test */
+        res = mifare_ultralight_retry_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_signature", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the signature test */
+        res = mifare_ultralight_signature_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_cache", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the cache test */
+        res = mifare_ultralight_cache_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_diversify", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the diversify test */
+        res = mifare_ultralight_diversify_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_session", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the session test */
+        res = mifare_ultralight_session_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_personalize", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the personalize test */
+        res = mifare_ultralight_personalize_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_range", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the range test */
+        res = mifare_ultralight_range_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_inventory", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the inventory test */
+        res = mifare_ultralight_inventory_test(1, NULL);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_op", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the op test */
+        res = mifare_ultralight_op_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_conf", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the conf test */
+        res = mifare_ultralight_conf_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_diff", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the diff test */
+        res = mifare_ultralight_diff_test(MIFARE_ULTRALIGHT_BOOL_FALSE);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_guard", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the guard test */
+        res = mifare_ultralight_guard_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_enumerate", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the enumerate test */
+        res = mifare_ultralight_enumerate_test(1, NULL);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_verify", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the verify test */
+        res = mifare_ultralight_verify_test();
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
+    else if (strcmp("t_manager", type) == 0)
+    {
+        uint8_t res;
+
+        /* run the manager test */
+        res = mifare_ultralight_manager_test(1024);
+        if (res != 0)
+        {
+            return 1;
+        }
+
+        return 0;
+    }
     else if (strcmp("e_halt", type) == 0)
     {
         uint8_t res;
@@ -1843,6 +2081,23 @@ uint8_t mifare_ultralight(uint8_t argc, char **argv)
         mifare_ultralight_interface_debug_print("  mifare_ultralight (-h | --help)\n");
         mifare_ultralight_interface_debug_print("  mifare_ultralight (-p | --port)\n");
         mifare_ultralight_interface_debug_print("  mifare_ultralight (-t card | --test=card)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t crc | --test=crc)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t latency | --test=latency)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t manager | --test=manager)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t retry | --test=retry)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t signature | --test=signature)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t cache | --test=cache)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t diversify | --test=diversify)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t session | --test=session)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t personalize | --test=personalize)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t range | --test=range)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t inventory | --test=inventory)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t op | --test=op)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t conf | --test=conf)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t diff | --test=diff)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t guard | --test=guard)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t enumerate | --test=enumerate)\n");
+        mifare_ultralight_interface_debug_print("  mifare_ultralight (-t verify | --test=verify)\n");
         mifare_ultralight_interface_debug_print("  mifare_ultralight (-e halt | --example=halt)\n");
         mifare_ultralight_interface_debug_print("  mifare_ultralight (-e wake-up | --example=wake-up)\n");
         mifare_ultralight_interface_debug_print("  mifare_ultralight (-e read | --example=read) [--page=<addr>]\n");
@@ -1891,7 +2146,8 @@ uint8_t mifare_ultralight(uint8_t argc, char **argv)
         mifare_ultralight_interface_debug_print("      --pwd=<password>           Set the password authentication and it is hexadecimal.([default: 0xFFFFFFFF])\n");
         mifare_ultralight_interface_debug_print("      --start=<taddr>            Set read pages start address.([default: 0])\n");
         mifare_ultralight_interface_debug_print("      --stop=<paddr>             Set read pages stop address.([default: 3])\n");
-        mifare_ultralight_interface_debug_print("  -t <card>, --test=<card>       Run the driver test.\n");
+        mifare_ultralight_interface_debug_print("  -t <card | crc | latency | manager | retry | signature | cache | diversify | session | personalize | range | inventory | op | conf | diff | guard | enumerate | verify>, --test=<card | crc | latency | manager | retry | signature | cache | diversify | session | personalize | range | inventory | op | conf | diff | guard | enumerate | verify>\n");
+        mifare_ultralight_interface_debug_print("                                 Run the driver test.\n");
 
         return 0;
     }
@@ -209,6 +209,38 @@ void mifare_ultralight_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      none
+ */
+void mifare_ultralight_interface_delay_us(uint32_t us)
+{
+    delay_us(us);
+}
+
+/**
+ * @brief  interface timestamp us
+ * @return timestamp in us
+ * @note   none
+ */
+uint32_t mifare_ultralight_interface_timestamp_us(void)
+{
+    uint32_t ms;
+    uint32_t val;
+    uint32_t load;
+    
+    /* read the tick and the systick counter coherently */
+    do
+    {
+        ms = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (ms != HAL_GetTick());
+    load = SysTick->LOAD + 1;
+    
+    return ms * 1000 + ((load - val) * 1000) / load;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
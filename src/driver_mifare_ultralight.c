@@ -71,300 +71,4466 @@
 #define MIFARE_ULTRALIGHT_COMMAND_VCSL                     0x4B           /**< vcsl command */
 
 /**
- * @brief     crc calculation
+ * @brief crc definition
+ */
+#define MIFARE_ULTRALIGHT_CRC_INIT                         0x6363U        /**< iso14443a crc_a preset */
+
+/**
+ * @brief prebuilt frame definition
+ */
+#define MIFARE_ULTRALIGHT_FRAME_PAGE_MAX                   0x28           /**< last page covered by the prebuilt frames */
+
+/**
+ * @brief frame length definition
+ */
+#define MIFARE_ULTRALIGHT_DEFAULT_MAX_FRAME_LEN            64             /**< default max frame length */
+#define MIFARE_ULTRALIGHT_SCRATCH_FRAME_PAGES              15             /**< max pages of a frame received into the stack buffer */
+
+/**
+ * @brief bounce buffer definition
+ */
+#define MIFARE_ULTRALIGHT_BOUNCE_TX_LEN                    32             /**< max gathered frame without the vector transceiver */
+#define MIFARE_ULTRALIGHT_BOUNCE_RX_LEN                    64             /**< max scattered frame without the vector transceiver */
+
+/**
+ * @brief inventory definition
+ */
+#define MIFARE_ULTRALIGHT_INVENTORY_MAX_CYCLE_TAGS         255            /**< max tags of one inventory cycle */
+
+/**
+ * @brief guard time definition
+ */
+#define MIFARE_ULTRALIGHT_DEFAULT_WAKE_UP_GUARD_US         1000           /**< default wait before wake up */
+
+/**
+ * @brief op definition
+ */
+#define MIFARE_ULTRALIGHT_DEFAULT_OP_TIMEOUT_US            10000          /**< default op response timeout */
+
+/**
+ * @brief page class definition
+ */
+#define MIFARE_ULTRALIGHT_PAGE_CLASS_USER                  0              /**< user page */
+#define MIFARE_ULTRALIGHT_PAGE_CLASS_UID                   1              /**< uid page */
+#define MIFARE_ULTRALIGHT_PAGE_CLASS_OTP                   2              /**< otp page */
+#define MIFARE_ULTRALIGHT_PAGE_CLASS_LOCK                  3              /**< lock page */
+#define MIFARE_ULTRALIGHT_PAGE_CLASS_CONF                  4              /**< configuration page */
+#define MIFARE_ULTRALIGHT_PAGE_CLASS_KEY                   5              /**< write only pwd or pack page */
+
+/**
+ * @brief write rank definition, the pages of a lower rank are written first
+ */
+#define MIFARE_ULTRALIGHT_WRITE_RANK_USER                  0              /**< user pages */
+#define MIFARE_ULTRALIGHT_WRITE_RANK_KEY                   1              /**< pwd and pack pages */
+#define MIFARE_ULTRALIGHT_WRITE_RANK_CFG1                  2              /**< cfg1 page */
+#define MIFARE_ULTRALIGHT_WRITE_RANK_CFG0                  3              /**< cfg0 page with auth0 */
+#define MIFARE_ULTRALIGHT_WRITE_RANK_OTP                   4              /**< otp page */
+#define MIFARE_ULTRALIGHT_WRITE_RANK_LOCK                  5              /**< static and dynamic lock pages */
+#define MIFARE_ULTRALIGHT_WRITE_RANK_MAX                   6              /**< rank number */
+
+/**
+ * @brief error record definition, the kind is kept for the retry policy and counted in the statistics
+ */
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+    #define MIFARE_ULTRALIGHT_ERROR(HANDLE, ERROR)    ((HANDLE)->error = (ERROR), (HANDLE)->stats.error[(ERROR)]++)
+#else
+    #define MIFARE_ULTRALIGHT_ERROR(HANDLE, ERROR)    ((HANDLE)->error = (ERROR))
+#endif
+
+#if (MIFARE_ULTRALIGHT_CRC_ENGINE == MIFARE_ULTRALIGHT_CRC_ENGINE_TABLE) || (MIFARE_ULTRALIGHT_CRC_ENGINE == MIFARE_ULTRALIGHT_CRC_ENGINE_SLICE_BY_4)
+/**
+ * @brief crc_a table definition
+ * @note  reflected polynomial 0x8408, one entry per input byte
+ */
+static const uint16_t gs_crc_table[256] =
+{
+    0x0000, 0x1189, 0x2312, 0x329B, 0x4624, 0x57AD, 0x6536, 0x74BF,
+    0x8C48, 0x9DC1, 0xAF5A, 0xBED3, 0xCA6C, 0xDBE5, 0xE97E, 0xF8F7,
+    0x1081, 0x0108, 0x3393, 0x221A, 0x56A5, 0x472C, 0x75B7, 0x643E,
+    0x9CC9, 0x8D40, 0xBFDB, 0xAE52, 0xDAED, 0xCB64, 0xF9FF, 0xE876,
+    0x2102, 0x308B, 0x0210, 0x1399, 0x6726, 0x76AF, 0x4434, 0x55BD,
+    0xAD4A, 0xBCC3, 0x8E58, 0x9FD1, 0xEB6E, 0xFAE7, 0xC87C, 0xD9F5,
+    0x3183, 0x200A, 0x1291, 0x0318, 0x77A7, 0x662E, 0x54B5, 0x453C,
+    0xBDCB, 0xAC42, 0x9ED9, 0x8F50, 0xFBEF, 0xEA66, 0xD8FD, 0xC974,
+    0x4204, 0x538D, 0x6116, 0x709F, 0x0420, 0x15A9, 0x2732, 0x36BB,
+    0xCE4C, 0xDFC5, 0xED5E, 0xFCD7, 0x8868, 0x99E1, 0xAB7A, 0xBAF3,
+    0x5285, 0x430C, 0x7197, 0x601E, 0x14A1, 0x0528, 0x37B3, 0x263A,
+    0xDECD, 0xCF44, 0xFDDF, 0xEC56, 0x98E9, 0x8960, 0xBBFB, 0xAA72,
+    0x6306, 0x728F, 0x4014, 0x519D, 0x2522, 0x34AB, 0x0630, 0x17B9,
+    0xEF4E, 0xFEC7, 0xCC5C, 0xDDD5, 0xA96A, 0xB8E3, 0x8A78, 0x9BF1,
+    0x7387, 0x620E, 0x5095, 0x411C, 0x35A3, 0x242A, 0x16B1, 0x0738,
+    0xFFCF, 0xEE46, 0xDCDD, 0xCD54, 0xB9EB, 0xA862, 0x9AF9, 0x8B70,
+    0x8408, 0x9581, 0xA71A, 0xB693, 0xC22C, 0xD3A5, 0xE13E, 0xF0B7,
+    0x0840, 0x19C9, 0x2B52, 0x3ADB, 0x4E64, 0x5FED, 0x6D76, 0x7CFF,
+    0x9489, 0x8500, 0xB79B, 0xA612, 0xD2AD, 0xC324, 0xF1BF, 0xE036,
+    0x18C1, 0x0948, 0x3BD3, 0x2A5A, 0x5EE5, 0x4F6C, 0x7DF7, 0x6C7E,
+    0xA50A, 0xB483, 0x8618, 0x9791, 0xE32E, 0xF2A7, 0xC03C, 0xD1B5,
+    0x2942, 0x38CB, 0x0A50, 0x1BD9, 0x6F66, 0x7EEF, 0x4C74, 0x5DFD,
+    0xB58B, 0xA402, 0x9699, 0x8710, 0xF3AF, 0xE226, 0xD0BD, 0xC134,
+    0x39C3, 0x284A, 0x1AD1, 0x0B58, 0x7FE7, 0x6E6E, 0x5CF5, 0x4D7C,
+    0xC60C, 0xD785, 0xE51E, 0xF497, 0x8028, 0x91A1, 0xA33A, 0xB2B3,
+    0x4A44, 0x5BCD, 0x6956, 0x78DF, 0x0C60, 0x1DE9, 0x2F72, 0x3EFB,
+    0xD68D, 0xC704, 0xF59F, 0xE416, 0x90A9, 0x8120, 0xB3BB, 0xA232,
+    0x5AC5, 0x4B4C, 0x79D7, 0x685E, 0x1CE1, 0x0D68, 0x3FF3, 0x2E7A,
+    0xE70E, 0xF687, 0xC41C, 0xD595, 0xA12A, 0xB0A3, 0x8238, 0x93B1,
+    0x6B46, 0x7ACF, 0x4854, 0x59DD, 0x2D62, 0x3CEB, 0x0E70, 0x1FF9,
+    0xF78F, 0xE606, 0xD49D, 0xC514, 0xB1AB, 0xA022, 0x92B9, 0x8330,
+    0x7BC7, 0x6A4E, 0x58D5, 0x495C, 0x3DE3, 0x2C6A, 0x1EF1, 0x0F78
+};
+#endif
+
+#if (MIFARE_ULTRALIGHT_CRC_ENGINE == MIFARE_ULTRALIGHT_CRC_ENGINE_SLICE_BY_4)
+/**
+ * @brief crc_a slice by 4 tables definition
+ * @note  gs_crc_slice_table[k][i] is gs_crc_table[i] advanced by k + 1 zero bytes
+ */
+static const uint16_t gs_crc_slice_table[3][256] =
+{
+    {
+        0x0000, 0x19D8, 0x33B0, 0x2A68, 0x6760, 0x7EB8, 0x54D0, 0x4D08,
+        0xCEC0, 0xD718, 0xFD70, 0xE4A8, 0xA9A0, 0xB078, 0x9A10, 0x83C8,
+        0x9591, 0x8C49, 0xA621, 0xBFF9, 0xF2F1, 0xEB29, 0xC141, 0xD899,
+        0x5B51, 0x4289, 0x68E1, 0x7139, 0x3C31, 0x25E9, 0x0F81, 0x1659,
+        0x2333, 0x3AEB, 0x1083, 0x095B, 0x4453, 0x5D8B, 0x77E3, 0x6E3B,
+        0xEDF3, 0xF42B, 0xDE43, 0xC79B, 0x8A93, 0x934B, 0xB923, 0xA0FB,
+        0xB6A2, 0xAF7A, 0x8512, 0x9CCA, 0xD1C2, 0xC81A, 0xE272, 0xFBAA,
+        0x7862, 0x61BA, 0x4BD2, 0x520A, 0x1F02, 0x06DA, 0x2CB2, 0x356A,
+        0x4666, 0x5FBE, 0x75D6, 0x6C0E, 0x2106, 0x38DE, 0x12B6, 0x0B6E,
+        0x88A6, 0x917E, 0xBB16, 0xA2CE, 0xEFC6, 0xF61E, 0xDC76, 0xC5AE,
+        0xD3F7, 0xCA2F, 0xE047, 0xF99F, 0xB497, 0xAD4F, 0x8727, 0x9EFF,
+        0x1D37, 0x04EF, 0x2E87, 0x375F, 0x7A57, 0x638F, 0x49E7, 0x503F,
+        0x6555, 0x7C8D, 0x56E5, 0x4F3D, 0x0235, 0x1BED, 0x3185, 0x285D,
+        0xAB95, 0xB24D, 0x9825, 0x81FD, 0xCCF5, 0xD52D, 0xFF45, 0xE69D,
+        0xF0C4, 0xE91C, 0xC374, 0xDAAC, 0x97A4, 0x8E7C, 0xA414, 0xBDCC,
+        0x3E04, 0x27DC, 0x0DB4, 0x146C, 0x5964, 0x40BC, 0x6AD4, 0x730C,
+        0x8CCC, 0x9514, 0xBF7C, 0xA6A4, 0xEBAC, 0xF274, 0xD81C, 0xC1C4,
+        0x420C, 0x5BD4, 0x71BC, 0x6864, 0x256C, 0x3CB4, 0x16DC, 0x0F04,
+        0x195D, 0x0085, 0x2AED, 0x3335, 0x7E3D, 0x67E5, 0x4D8D, 0x5455,
+        0xD79D, 0xCE45, 0xE42D, 0xFDF5, 0xB0FD, 0xA925, 0x834D, 0x9A95,
+        0xAFFF, 0xB627, 0x9C4F, 0x8597, 0xC89F, 0xD147, 0xFB2F, 0xE2F7,
+        0x613F, 0x78E7, 0x528F, 0x4B57, 0x065F, 0x1F87, 0x35EF, 0x2C37,
+        0x3A6E, 0x23B6, 0x09DE, 0x1006, 0x5D0E, 0x44D6, 0x6EBE, 0x7766,
+        0xF4AE, 0xED76, 0xC71E, 0xDEC6, 0x93CE, 0x8A16, 0xA07E, 0xB9A6,
+        0xCAAA, 0xD372, 0xF91A, 0xE0C2, 0xADCA, 0xB412, 0x9E7A, 0x87A2,
+        0x046A, 0x1DB2, 0x37DA, 0x2E02, 0x630A, 0x7AD2, 0x50BA, 0x4962,
+        0x5F3B, 0x46E3, 0x6C8B, 0x7553, 0x385B, 0x2183, 0x0BEB, 0x1233,
+        0x91FB, 0x8823, 0xA24B, 0xBB93, 0xF69B, 0xEF43, 0xC52B, 0xDCF3,
+        0xE999, 0xF041, 0xDA29, 0xC3F1, 0x8EF9, 0x9721, 0xBD49, 0xA491,
+        0x2759, 0x3E81, 0x14E9, 0x0D31, 0x4039, 0x59E1, 0x7389, 0x6A51,
+        0x7C08, 0x65D0, 0x4FB8, 0x5660, 0x1B68, 0x02B0, 0x28D8, 0x3100,
+        0xB2C8, 0xAB10, 0x8178, 0x98A0, 0xD5A8, 0xCC70, 0xE618, 0xFFC0
+    },
+    {
+        0x0000, 0x5ADC, 0xB5B8, 0xEF64, 0x6361, 0x39BD, 0xD6D9, 0x8C05,
+        0xC6C2, 0x9C1E, 0x737A, 0x29A6, 0xA5A3, 0xFF7F, 0x101B, 0x4AC7,
+        0x8595, 0xDF49, 0x302D, 0x6AF1, 0xE6F4, 0xBC28, 0x534C, 0x0990,
+        0x4357, 0x198B, 0xF6EF, 0xAC33, 0x2036, 0x7AEA, 0x958E, 0xCF52,
+        0x033B, 0x59E7, 0xB683, 0xEC5F, 0x605A, 0x3A86, 0xD5E2, 0x8F3E,
+        0xC5F9, 0x9F25, 0x7041, 0x2A9D, 0xA698, 0xFC44, 0x1320, 0x49FC,
+        0x86AE, 0xDC72, 0x3316, 0x69CA, 0xE5CF, 0xBF13, 0x5077, 0x0AAB,
+        0x406C, 0x1AB0, 0xF5D4, 0xAF08, 0x230D, 0x79D1, 0x96B5, 0xCC69,
+        0x0676, 0x5CAA, 0xB3CE, 0xE912, 0x6517, 0x3FCB, 0xD0AF, 0x8A73,
+        0xC0B4, 0x9A68, 0x750C, 0x2FD0, 0xA3D5, 0xF909, 0x166D, 0x4CB1,
+        0x83E3, 0xD93F, 0x365B, 0x6C87, 0xE082, 0xBA5E, 0x553A, 0x0FE6,
+        0x4521, 0x1FFD, 0xF099, 0xAA45, 0x2640, 0x7C9C, 0x93F8, 0xC924,
+        0x054D, 0x5F91, 0xB0F5, 0xEA29, 0x662C, 0x3CF0, 0xD394, 0x8948,
+        0xC38F, 0x9953, 0x7637, 0x2CEB, 0xA0EE, 0xFA32, 0x1556, 0x4F8A,
+        0x80D8, 0xDA04, 0x3560, 0x6FBC, 0xE3B9, 0xB965, 0x5601, 0x0CDD,
+        0x461A, 0x1CC6, 0xF3A2, 0xA97E, 0x257B, 0x7FA7, 0x90C3, 0xCA1F,
+        0x0CEC, 0x5630, 0xB954, 0xE388, 0x6F8D, 0x3551, 0xDA35, 0x80E9,
+        0xCA2E, 0x90F2, 0x7F96, 0x254A, 0xA94F, 0xF393, 0x1CF7, 0x462B,
+        0x8979, 0xD3A5, 0x3CC1, 0x661D, 0xEA18, 0xB0C4, 0x5FA0, 0x057C,
+        0x4FBB, 0x1567, 0xFA03, 0xA0DF, 0x2CDA, 0x7606, 0x9962, 0xC3BE,
+        0x0FD7, 0x550B, 0xBA6F, 0xE0B3, 0x6CB6, 0x366A, 0xD90E, 0x83D2,
+        0xC915, 0x93C9, 0x7CAD, 0x2671, 0xAA74, 0xF0A8, 0x1FCC, 0x4510,
+        0x8A42, 0xD09E, 0x3FFA, 0x6526, 0xE923, 0xB3FF, 0x5C9B, 0x0647,
+        0x4C80, 0x165C, 0xF938, 0xA3E4, 0x2FE1, 0x753D, 0x9A59, 0xC085,
+        0x0A9A, 0x5046, 0xBF22, 0xE5FE, 0x69FB, 0x3327, 0xDC43, 0x869F,
+        0xCC58, 0x9684, 0x79E0, 0x233C, 0xAF39, 0xF5E5, 0x1A81, 0x405D,
+        0x8F0F, 0xD5D3, 0x3AB7, 0x606B, 0xEC6E, 0xB6B2, 0x59D6, 0x030A,
+        0x49CD, 0x1311, 0xFC75, 0xA6A9, 0x2AAC, 0x7070, 0x9F14, 0xC5C8,
+        0x09A1, 0x537D, 0xBC19, 0xE6C5, 0x6AC0, 0x301C, 0xDF78, 0x85A4,
+        0xCF63, 0x95BF, 0x7ADB, 0x2007, 0xAC02, 0xF6DE, 0x19BA, 0x4366,
+        0x8C34, 0xD6E8, 0x398C, 0x6350, 0xEF55, 0xB589, 0x5AED, 0x0031,
+        0x4AF6, 0x102A, 0xFF4E, 0xA592, 0x2997, 0x734B, 0x9C2F, 0xC6F3
+    },
+    {
+        0x0000, 0x1CBB, 0x3976, 0x25CD, 0x72EC, 0x6E57, 0x4B9A, 0x5721,
+        0xE5D8, 0xF963, 0xDCAE, 0xC015, 0x9734, 0x8B8F, 0xAE42, 0xB2F9,
+        0xC3A1, 0xDF1A, 0xFAD7, 0xE66C, 0xB14D, 0xADF6, 0x883B, 0x9480,
+        0x2679, 0x3AC2, 0x1F0F, 0x03B4, 0x5495, 0x482E, 0x6DE3, 0x7158,
+        0x8F53, 0x93E8, 0xB625, 0xAA9E, 0xFDBF, 0xE104, 0xC4C9, 0xD872,
+        0x6A8B, 0x7630, 0x53FD, 0x4F46, 0x1867, 0x04DC, 0x2111, 0x3DAA,
+        0x4CF2, 0x5049, 0x7584, 0x693F, 0x3E1E, 0x22A5, 0x0768, 0x1BD3,
+        0xA92A, 0xB591, 0x905C, 0x8CE7, 0xDBC6, 0xC77D, 0xE2B0, 0xFE0B,
+        0x16B7, 0x0A0C, 0x2FC1, 0x337A, 0x645B, 0x78E0, 0x5D2D, 0x4196,
+        0xF36F, 0xEFD4, 0xCA19, 0xD6A2, 0x8183, 0x9D38, 0xB8F5, 0xA44E,
+        0xD516, 0xC9AD, 0xEC60, 0xF0DB, 0xA7FA, 0xBB41, 0x9E8C, 0x8237,
+        0x30CE, 0x2C75, 0x09B8, 0x1503, 0x4222, 0x5E99, 0x7B54, 0x67EF,
+        0x99E4, 0x855F, 0xA092, 0xBC29, 0xEB08, 0xF7B3, 0xD27E, 0xCEC5,
+        0x7C3C, 0x6087, 0x454A, 0x59F1, 0x0ED0, 0x126B, 0x37A6, 0x2B1D,
+        0x5A45, 0x46FE, 0x6333, 0x7F88, 0x28A9, 0x3412, 0x11DF, 0x0D64,
+        0xBF9D, 0xA326, 0x86EB, 0x9A50, 0xCD71, 0xD1CA, 0xF407, 0xE8BC,
+        0x2D6E, 0x31D5, 0x1418, 0x08A3, 0x5F82, 0x4339, 0x66F4, 0x7A4F,
+        0xC8B6, 0xD40D, 0xF1C0, 0xED7B, 0xBA5A, 0xA6E1, 0x832C, 0x9F97,
+        0xEECF, 0xF274, 0xD7B9, 0xCB02, 0x9C23, 0x8098, 0xA555, 0xB9EE,
+        0x0B17, 0x17AC, 0x3261, 0x2EDA, 0x79FB, 0x6540, 0x408D, 0x5C36,
+        0xA23D, 0xBE86, 0x9B4B, 0x87F0, 0xD0D1, 0xCC6A, 0xE9A7, 0xF51C,
+        0x47E5, 0x5B5E, 0x7E93, 0x6228, 0x3509, 0x29B2, 0x0C7F, 0x10C4,
+        0x619C, 0x7D27, 0x58EA, 0x4451, 0x1370, 0x0FCB, 0x2A06, 0x36BD,
+        0x8444, 0x98FF, 0xBD32, 0xA189, 0xF6A8, 0xEA13, 0xCFDE, 0xD365,
+        0x3BD9, 0x2762, 0x02AF, 0x1E14, 0x4935, 0x558E, 0x7043, 0x6CF8,
+        0xDE01, 0xC2BA, 0xE777, 0xFBCC, 0xACED, 0xB056, 0x959B, 0x8920,
+        0xF878, 0xE4C3, 0xC10E, 0xDDB5, 0x8A94, 0x962F, 0xB3E2, 0xAF59,
+        0x1DA0, 0x011B, 0x24D6, 0x386D, 0x6F4C, 0x73F7, 0x563A, 0x4A81,
+        0xB48A, 0xA831, 0x8DFC, 0x9147, 0xC666, 0xDADD, 0xFF10, 0xE3AB,
+        0x5152, 0x4DE9, 0x6824, 0x749F, 0x23BE, 0x3F05, 0x1AC8, 0x0673,
+        0x772B, 0x6B90, 0x4E5D, 0x52E6, 0x05C7, 0x197C, 0x3CB1, 0x200A,
+        0x92F3, 0x8E48, 0xAB85, 0xB73E, 0xE01F, 0xFCA4, 0xD969, 0xC5D2
+    }
+};
+#endif
+
+/**
+ * @brief     crc update
+ * @param[in] crc current crc
  * @param[in] *p pointer to a data buffer
  * @param[in] len data length
+ * @return    updated crc
+ * @note      none
+ */
+static uint16_t a_mifare_ultralight_crc_update(uint16_t crc, const uint8_t *p, uint16_t len)
+{
+#if (MIFARE_ULTRALIGHT_CRC_ENGINE == MIFARE_ULTRALIGHT_CRC_ENGINE_SLICE_BY_4)
+    while (len >= 4)                                                                            /* 4 bytes per round */
+    {
+        crc ^= (uint16_t)(((uint16_t)p[1] << 8) | p[0]);                                        /* xor the first two bytes */
+        crc = (uint16_t)(gs_crc_slice_table[2][crc & 0xFF] ^ gs_crc_slice_table[1][crc >> 8] ^
+                         gs_crc_slice_table[0][p[2]] ^ gs_crc_table[p[3]]);                     /* fold 4 bytes */
+        p += 4;                                                                                 /* next 4 bytes */
+        len -= 4;                                                                               /* len - 4 */
+    }
+#endif
+#if (MIFARE_ULTRALIGHT_CRC_ENGINE == MIFARE_ULTRALIGHT_CRC_ENGINE_TABLE) || (MIFARE_ULTRALIGHT_CRC_ENGINE == MIFARE_ULTRALIGHT_CRC_ENGINE_SLICE_BY_4)
+    while (len != 0)                                                                            /* remaining bytes */
+    {
+        crc = (uint16_t)((crc >> 8) ^ gs_crc_table[(crc ^ *p++) & 0xFF]);                      /* one byte */
+        len--;                                                                                  /* len-- */
+    }
+#else
+    while (len != 0)                                                                            /* all bytes */
+    {
+        uint8_t bt;
+        
+        bt = *p++;                                                                              /* get one byte */
+        bt = (bt ^ (uint8_t)(crc & 0x00FF));                                                    /* xor */
+        bt = (bt ^ (bt << 4));                                                                  /* xor */
+        crc = (uint16_t)((crc >> 8) ^ ((uint16_t)bt << 8) ^ ((uint16_t)bt << 3) ^ (bt >> 4));   /* get the crc */
+        len--;                                                                                  /* len-- */
+    }
+#endif
+    
+    return crc;                                                                                 /* return the crc */
+}
+
+/**
+ * @brief      crc calculation
+ * @param[in]  *p pointer to a data buffer
+ * @param[in]  len data length
+ * @param[out] *output pointer to a crc buffer
+ * @note       none
+ */
+static void a_mifare_ultralight_iso14443a_crc(uint8_t *p, uint8_t len, uint8_t output[2])
+{
+    uint16_t crc;
+    
+    crc = a_mifare_ultralight_crc_update(MIFARE_ULTRALIGHT_CRC_INIT, p, len);        /* get the crc */
+    output[0] = (uint8_t)(crc & 0xFF);                                              /* lsb */
+    output[1] = (uint8_t)((crc >> 8) & 0xFF);                                       /* msb */
+}
+
+/**
+ * @brief prebuilt get version frame
+ */
+static const uint8_t gs_frame_get_version[3] = {0x60, 0xF8, 0x32};
+
+/**
+ * @brief prebuilt read signature frame
+ */
+static const uint8_t gs_frame_read_sig[4] = {0x3C, 0x00, 0xA2, 0x01};
+
+/**
+ * @brief prebuilt halt frame
+ */
+static const uint8_t gs_frame_halt[4] = {0x50, 0x00, 0x57, 0xCD};
+
+/**
+ * @brief prebuilt read frames, one per page of the largest storage
+ */
+static const uint8_t gs_frame_read[41][4] =
+{
+    {0x30, 0x00, 0x02, 0xA8},        /* page 0x00 */
+    {0x30, 0x01, 0x8B, 0xB9},        /* page 0x01 */
+    {0x30, 0x02, 0x10, 0x8B},        /* page 0x02 */
+    {0x30, 0x03, 0x99, 0x9A},        /* page 0x03 */
+    {0x30, 0x04, 0x26, 0xEE},        /* page 0x04 */
+    {0x30, 0x05, 0xAF, 0xFF},        /* page 0x05 */
+    {0x30, 0x06, 0x34, 0xCD},        /* page 0x06 */
+    {0x30, 0x07, 0xBD, 0xDC},        /* page 0x07 */
+    {0x30, 0x08, 0x4A, 0x24},        /* page 0x08 */
+    {0x30, 0x09, 0xC3, 0x35},        /* page 0x09 */
+    {0x30, 0x0A, 0x58, 0x07},        /* page 0x0A */
+    {0x30, 0x0B, 0xD1, 0x16},        /* page 0x0B */
+    {0x30, 0x0C, 0x6E, 0x62},        /* page 0x0C */
+    {0x30, 0x0D, 0xE7, 0x73},        /* page 0x0D */
+    {0x30, 0x0E, 0x7C, 0x41},        /* page 0x0E */
+    {0x30, 0x0F, 0xF5, 0x50},        /* page 0x0F */
+    {0x30, 0x10, 0x83, 0xB8},        /* page 0x10 */
+    {0x30, 0x11, 0x0A, 0xA9},        /* page 0x11 */
+    {0x30, 0x12, 0x91, 0x9B},        /* page 0x12 */
+    {0x30, 0x13, 0x18, 0x8A},        /* page 0x13 */
+    {0x30, 0x14, 0xA7, 0xFE},        /* page 0x14 */
+    {0x30, 0x15, 0x2E, 0xEF},        /* page 0x15 */
+    {0x30, 0x16, 0xB5, 0xDD},        /* page 0x16 */
+    {0x30, 0x17, 0x3C, 0xCC},        /* page 0x17 */
+    {0x30, 0x18, 0xCB, 0x34},        /* page 0x18 */
+    {0x30, 0x19, 0x42, 0x25},        /* page 0x19 */
+    {0x30, 0x1A, 0xD9, 0x17},        /* page 0x1A */
+    {0x30, 0x1B, 0x50, 0x06},        /* page 0x1B */
+    {0x30, 0x1C, 0xEF, 0x72},        /* page 0x1C */
+    {0x30, 0x1D, 0x66, 0x63},        /* page 0x1D */
+    {0x30, 0x1E, 0xFD, 0x51},        /* page 0x1E */
+    {0x30, 0x1F, 0x74, 0x40},        /* page 0x1F */
+    {0x30, 0x20, 0x00, 0x89},        /* page 0x20 */
+    {0x30, 0x21, 0x89, 0x98},        /* page 0x21 */
+    {0x30, 0x22, 0x12, 0xAA},        /* page 0x22 */
+    {0x30, 0x23, 0x9B, 0xBB},        /* page 0x23 */
+    {0x30, 0x24, 0x24, 0xCF},        /* page 0x24 */
+    {0x30, 0x25, 0xAD, 0xDE},        /* page 0x25 */
+    {0x30, 0x26, 0x36, 0xEC},        /* page 0x26 */
+    {0x30, 0x27, 0xBF, 0xFD},        /* page 0x27 */
+    {0x30, 0x28, 0x48, 0x05}         /* page 0x28 */
+};
+
+/**
+ * @brief prebuilt single page fast read frames, one per page of the largest storage
+ */
+static const uint8_t gs_frame_fast_read[41][5] =
+{
+    {0x3A, 0x00, 0x00, 0xC0, 0x50},        /* page 0x00 */
+    {0x3A, 0x01, 0x01, 0x91, 0x58},        /* page 0x01 */
+    {0x3A, 0x02, 0x02, 0x62, 0x40},        /* page 0x02 */
+    {0x3A, 0x03, 0x03, 0x33, 0x48},        /* page 0x03 */
+    {0x3A, 0x04, 0x04, 0x84, 0x71},        /* page 0x04 */
+    {0x3A, 0x05, 0x05, 0xD5, 0x79},        /* page 0x05 */
+    {0x3A, 0x06, 0x06, 0x26, 0x61},        /* page 0x06 */
+    {0x3A, 0x07, 0x07, 0x77, 0x69},        /* page 0x07 */
+    {0x3A, 0x08, 0x08, 0x48, 0x12},        /* page 0x08 */
+    {0x3A, 0x09, 0x09, 0x19, 0x1A},        /* page 0x09 */
+    {0x3A, 0x0A, 0x0A, 0xEA, 0x02},        /* page 0x0A */
+    {0x3A, 0x0B, 0x0B, 0xBB, 0x0A},        /* page 0x0B */
+    {0x3A, 0x0C, 0x0C, 0x0C, 0x33},        /* page 0x0C */
+    {0x3A, 0x0D, 0x0D, 0x5D, 0x3B},        /* page 0x0D */
+    {0x3A, 0x0E, 0x0E, 0xAE, 0x23},        /* page 0x0E */
+    {0x3A, 0x0F, 0x0F, 0xFF, 0x2B},        /* page 0x0F */
+    {0x3A, 0x10, 0x10, 0xD0, 0xD5},        /* page 0x10 */
+    {0x3A, 0x11, 0x11, 0x81, 0xDD},        /* page 0x11 */
+    {0x3A, 0x12, 0x12, 0x72, 0xC5},        /* page 0x12 */
+    {0x3A, 0x13, 0x13, 0x23, 0xCD},        /* page 0x13 */
+    {0x3A, 0x14, 0x14, 0x94, 0xF4},        /* page 0x14 */
+    {0x3A, 0x15, 0x15, 0xC5, 0xFC},        /* page 0x15 */
+    {0x3A, 0x16, 0x16, 0x36, 0xE4},        /* page 0x16 */
+    {0x3A, 0x17, 0x17, 0x67, 0xEC},        /* page 0x17 */
+    {0x3A, 0x18, 0x18, 0x58, 0x97},        /* page 0x18 */
+    {0x3A, 0x19, 0x19, 0x09, 0x9F},        /* page 0x19 */
+    {0x3A, 0x1A, 0x1A, 0xFA, 0x87},        /* page 0x1A */
+    {0x3A, 0x1B, 0x1B, 0xAB, 0x8F},        /* page 0x1B */
+    {0x3A, 0x1C, 0x1C, 0x1C, 0xB6},        /* page 0x1C */
+    {0x3A, 0x1D, 0x1D, 0x4D, 0xBE},        /* page 0x1D */
+    {0x3A, 0x1E, 0x1E, 0xBE, 0xA6},        /* page 0x1E */
+    {0x3A, 0x1F, 0x1F, 0xEF, 0xAE},        /* page 0x1F */
+    {0x3A, 0x20, 0x20, 0xF1, 0x52},        /* page 0x20 */
+    {0x3A, 0x21, 0x21, 0xA0, 0x5A},        /* page 0x21 */
+    {0x3A, 0x22, 0x22, 0x53, 0x42},        /* page 0x22 */
+    {0x3A, 0x23, 0x23, 0x02, 0x4A},        /* page 0x23 */
+    {0x3A, 0x24, 0x24, 0xB5, 0x73},        /* page 0x24 */
+    {0x3A, 0x25, 0x25, 0xE4, 0x7B},        /* page 0x25 */
+    {0x3A, 0x26, 0x26, 0x17, 0x63},        /* page 0x26 */
+    {0x3A, 0x27, 0x27, 0x46, 0x6B},        /* page 0x27 */
+    {0x3A, 0x28, 0x28, 0x79, 0x10}         /* page 0x28 */
+};
+
+/**
+ * @brief prebuilt read counter frames, one per counter addr
+ */
+static const uint8_t gs_frame_read_cnt[3][4] =
+{
+    {0x39, 0x00, 0x1A, 0x7F},        /* addr 0x00 */
+    {0x39, 0x01, 0x93, 0x6E},        /* addr 0x01 */
+    {0x39, 0x02, 0x08, 0x5C}         /* addr 0x02 */
+};
+
+/**
+ * @brief prebuilt check tearing event frames, one per counter addr
+ */
+static const uint8_t gs_frame_check_tearing[3][4] =
+{
+    {0x3E, 0x00, 0x12, 0x32},        /* addr 0x00 */
+    {0x3E, 0x01, 0x9B, 0x23},        /* addr 0x01 */
+    {0x3E, 0x02, 0x00, 0x11}         /* addr 0x02 */
+};
+
+/**
+ * @brief      build a read frame
+ * @param[in]  page page of read
+ * @param[out] *frame pointer to a frame buffer
+ * @note       pages covered by the prebuilt table are copied without crc calculation
+ */
+static void a_mifare_ultralight_read_frame(uint8_t page, uint8_t frame[4])
+{
+    if (page <= MIFARE_ULTRALIGHT_FRAME_PAGE_MAX)                                /* check the page */
+    {
+        memcpy(frame, gs_frame_read[page], 4);                                   /* copy the prebuilt frame */
+    }
+    else
+    {
+        frame[0] = MIFARE_ULTRALIGHT_COMMAND_READ;                               /* set the command */
+        frame[1] = page;                                                         /* set the page */
+        a_mifare_ultralight_iso14443a_crc(frame, 2, frame + 2);                  /* get the crc */
+    }
+}
+
+/**
+ * @brief      build a fast read frame
+ * @param[in]  start_page start page
+ * @param[in]  stop_page stop page
+ * @param[out] *frame pointer to a frame buffer
+ * @note       single page frames covered by the prebuilt table are copied without crc calculation
+ */
+static void a_mifare_ultralight_fast_read_frame(uint8_t start_page, uint8_t stop_page, uint8_t frame[5])
+{
+    if ((start_page == stop_page) && (start_page <= MIFARE_ULTRALIGHT_FRAME_PAGE_MAX))        /* check the page */
+    {
+        memcpy(frame, gs_frame_fast_read[start_page], 5);                                     /* copy the prebuilt frame */
+    }
+    else
+    {
+        frame[0] = MIFARE_ULTRALIGHT_COMMAND_FAST_READ;                                       /* set the command */
+        frame[1] = start_page;                                                                /* set the start page */
+        frame[2] = stop_page;                                                                 /* set the stop page */
+        a_mifare_ultralight_iso14443a_crc(frame, 3, frame + 3);                               /* get the crc */
+    }
+}
+
+/**
+ * @brief hook linked check definition
+ */
+#define MIFARE_ULTRALIGHT_LINKED(handle, hook)    (((handle)->hook != NULL) || ((handle)->hook##_ctx != NULL))
+
+/**
+ * @brief frame hook definition, the transceiver wrappers record the frames when it is set
+ */
+#define MIFARE_ULTRALIGHT_FRAME_HOOK    ((MIFARE_ULTRALIGHT_STATS != 0) || (MIFARE_ULTRALIGHT_TRACE != 0))
+
+/**
+ * @brief     mifare_ultralight get the timestamp
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    timestamp in us
+ * @note      0 is returned without the timestamp_us function, the _ctx function is used when it is linked
+ */
+static uint32_t a_mifare_ultralight_timestamp_us(mifare_ultralight_handle_t *handle)
+{
+    if (handle->timestamp_us_ctx != NULL)                /* check the ctx function */
+    {
+        return handle->timestamp_us_ctx(handle->user);   /* get the timestamp */
+    }
+    if (handle->timestamp_us == NULL)                    /* check the timestamp_us */
+    {
+        return 0;                                        /* no timestamp */
+    }
+    
+    return handle->timestamp_us();                       /* get the timestamp */
+}
+
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+/**
+ * @brief     mifare_ultralight record a frame in the statistics
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *in_buf pointer to the sent frame
+ * @param[in] in_len sent length
+ * @param[in] out_len received length
+ * @param[in] us frame latency
+ * @note      the data frame after a comp write command is counted as comp write
+ */
+static void a_mifare_ultralight_stats_frame(mifare_ultralight_handle_t *handle, uint8_t *in_buf, uint8_t in_len,
+                                            uint8_t out_len, uint32_t us)
+{
+    uint8_t command;
+    uint8_t bucket;
+    
+    switch (in_buf[0])                                                                   /* check the command */
+    {
+        case MIFARE_ULTRALIGHT_COMMAND_REQUEST :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_REQUEST;                          /* request */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_WAKE_UP :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_WAKE_UP;                          /* wake up */
+            
+            break;
+        }
+        case (MIFARE_ULTRALIGHT_COMMAND_SELECT_CL1 >> 8) & 0xFF :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_CL1;                              /* cl1 */
+            
+            break;
+        }
+        case (MIFARE_ULTRALIGHT_COMMAND_SELECT_CL2 >> 8) & 0xFF :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_CL2;                              /* cl2 */
+            
+            break;
+        }
+        case (MIFARE_ULTRALIGHT_COMMAND_HALT >> 8) & 0xFF :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_HALT;                             /* halt */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_GET_VERSION :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_GET_VERSION;                      /* get version */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_READ :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_READ;                             /* read */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_FAST_READ :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_FAST_READ;                        /* fast read */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_WRITE :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_WRITE;                            /* write */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_COMP_WRITE :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_COMP_WRITE;                       /* comp write */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_READ_CNT :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_READ_CNT;                         /* read cnt */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_INCR_CNT :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_INCR_CNT;                         /* incr cnt */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_PWD_AUTH :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_PWD_AUTH;                         /* pwd auth */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_READ_SIG :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_READ_SIG;                         /* read sig */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_CHECK_TEARING_EVENT :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_CHECK_TEARING_EVENT;              /* check tearing event */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_COMMAND_VCSL :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_VCSL;                             /* vcsl */
+            
+            break;
+        }
+        default :
+        {
+            command = MIFARE_ULTRALIGHT_STATS_COMMAND_OTHER;                            /* other */
+            
+            break;
+        }
+    }
+    if (handle->stats_comp_write != 0)                                                   /* check the comp write data frame */
+    {
+        command = MIFARE_ULTRALIGHT_STATS_COMMAND_COMP_WRITE;                           /* comp write */
+    }
+    handle->stats_comp_write = ((in_buf[0] == MIFARE_ULTRALIGHT_COMMAND_COMP_WRITE) && 
+                                (in_len == 4)) ? 1 : 0;                                  /* the data frame follows */
+    for (bucket = 0; (us > 1) && (bucket < MIFARE_ULTRALIGHT_STATS_BUCKET - 1); bucket++) /* log2 of the latency */
+    {
+        us >>= 1;                                                                        /* next bucket */
+    }
+    handle->stats.command[command]++;                                                    /* count the frame */
+    handle->stats.tx_bytes += in_len;                                                    /* count the sent bytes */
+    handle->stats.rx_bytes += out_len;                                                   /* count the received bytes */
+    handle->stats.latency[command][bucket]++;                                            /* count the latency */
+}
+#endif
+
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+/**
+ * @brief     mifare_ultralight record a frame in the trace ring
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] dir frame direction
+ * @param[in] res transceiver result
+ * @param[in] timestamp timestamp in us
+ * @param[in] *seg pointer to the frame segments
+ * @param[in] count segment number
+ * @param[in] len frame length in bytes or in bits for the bit oriented frames
+ * @note      only the driver writes the ring, the entry is filled before the head moves
+ */
+static void a_mifare_ultralight_trace_record(mifare_ultralight_handle_t *handle, uint8_t dir, uint8_t res, uint32_t timestamp,
+                                             const mifare_ultralight_segment_t *seg, uint8_t count, uint8_t len)
+{
+    mifare_ultralight_trace_t *trace;
+    mifare_ultralight_trace_entry_t *entry;
+    uint16_t bytes;
+    uint16_t copy;
+    uint16_t n;
+    uint8_t i;
+    
+    trace = handle->trace;                                                                      /* get the ring */
+    if (trace == NULL)                                                                          /* check the ring */
+    {
+        return;                                                                                 /* no trace */
+    }
+    if ((dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX) || (dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX_BITS)) /* check the sent frame */
+    {
+        handle->trace_command = ((count != 0) && (len != 0)) ? seg[0].buf[0] : 0;               /* save the command */
+    }
+    bytes = ((dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX_BITS) || 
+             (dir == MIFARE_ULTRALIGHT_TRACE_DIR_RX_BITS)) ? (uint16_t)((len + 7) / 8) : len;   /* frame bytes */
+    if (bytes > MIFARE_ULTRALIGHT_TRACE_FRAME_LEN)                                              /* check the entry size */
+    {
+        bytes = MIFARE_ULTRALIGHT_TRACE_FRAME_LEN;                                              /* keep the first bytes */
+    }
+    entry = &trace->entry[trace->head & (MIFARE_ULTRALIGHT_TRACE_DEPTH - 1)];                   /* get the entry */
+    entry->timestamp = timestamp;                                                               /* set the timestamp */
+    entry->dir = dir;                                                                           /* set the direction */
+    entry->command = handle->trace_command;                                                     /* set the command */
+    entry->res = res;                                                                           /* set the result */
+    entry->len = len;                                                                           /* set the length */
+    copy = 0;                                                                                   /* init 0 */
+    for (i = 0; (i < count) && (copy < bytes); i++)                                             /* all segments */
+    {
+        n = (seg[i].len < bytes - copy) ? seg[i].len : (uint16_t)(bytes - copy);                /* set the copy length */
+        memcpy(entry->data + copy, seg[i].buf, n);                                              /* copy the segment */
+        copy = (uint16_t)(copy + n);                                                            /* next segment */
+    }
+    MIFARE_ULTRALIGHT_TRACE_BARRIER();                                                          /* entry before head */
+    trace->head = trace->head + 1;                                                              /* publish the entry */
+}
+
+/**
+ * @brief     mifare_ultralight record a buffer in the trace ring
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] dir frame direction
+ * @param[in] res transceiver result
+ * @param[in] timestamp timestamp in us
+ * @param[in] *buf pointer to the frame
+ * @param[in] len frame length in bytes or in bits for the bit oriented frames
  * @note      none
  */
-static void a_mifare_ultralight_iso14443a_crc(uint8_t *p, uint8_t len, uint8_t output[2])
+static void a_mifare_ultralight_trace_buf(mifare_ultralight_handle_t *handle, uint8_t dir, uint8_t res, uint32_t timestamp,
+                                          uint8_t *buf, uint8_t len)
+{
+    mifare_ultralight_segment_t seg;
+    
+    seg.buf = buf;                                                                              /* set the buffer */
+    seg.len = ((dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX_BITS) || 
+               (dir == MIFARE_ULTRALIGHT_TRACE_DIR_RX_BITS)) ? (uint8_t)((len + 7) / 8) : len;  /* set the length */
+    a_mifare_ultralight_trace_record(handle, dir, res, timestamp, &seg, 1, len);                /* record the frame */
+}
+#endif
+
+/**
+ * @brief     mifare_ultralight contactless init
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 contactless init failed
+ * @note      the _ctx function is used when it is linked
+ */
+static uint8_t a_mifare_ultralight_contactless_init(mifare_ultralight_handle_t *handle)
+{
+    if (handle->contactless_init_ctx != NULL)                                   /* check the ctx function */
+    {
+        return handle->contactless_init_ctx(handle->user);                      /* contactless init */
+    }
+    
+    return handle->contactless_init();                                          /* contactless init */
+}
+
+/**
+ * @brief     mifare_ultralight contactless deinit
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 contactless deinit failed
+ * @note      the _ctx function is used when it is linked
+ */
+static uint8_t a_mifare_ultralight_contactless_deinit(mifare_ultralight_handle_t *handle)
+{
+    if (handle->contactless_deinit_ctx != NULL)                                 /* check the ctx function */
+    {
+        return handle->contactless_deinit_ctx(handle->user);                    /* contactless deinit */
+    }
+    
+    return handle->contactless_deinit();                                        /* contactless deinit */
+}
+
+/**
+ * @brief         mifare_ultralight contactless transceiver
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in]     *in_buf pointer to an input buffer
+ * @param[in]     in_len input length
+ * @param[out]    *out_buf pointer to an output buffer
+ * @param[in,out] *out_len pointer to an output length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 transceiver failed
+ * @note          the _ctx function is used when it is linked
+ */
+static uint8_t a_mifare_ultralight_transceiver_link(mifare_ultralight_handle_t *handle, uint8_t *in_buf, uint8_t in_len,
+                                                    uint8_t *out_buf, uint8_t *out_len)
+{
+    if (handle->contactless_transceiver_ctx != NULL)                                                   /* check the ctx function */
+    {
+        return handle->contactless_transceiver_ctx(handle->user, in_buf, in_len, out_buf, out_len);    /* transceiver */
+    }
+    
+    return handle->contactless_transceiver(in_buf, in_len, out_buf, out_len);                          /* transceiver */
+}
+
+/**
+ * @brief     mifare_ultralight keep a 4 bits nak
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] command first byte of the sent frame
+ * @param[in] res transceiver result
+ * @param[in] *buf pointer to the response
+ * @param[in] len response length
+ * @note      a one byte response below 0x10 other than the ack is a nak only for a command
+ *            answered by an ack or data, the atqa, the uid and the sak are never naks,
+ *            a nak and a transport failure end the authenticated session
+ */
+static void a_mifare_ultralight_nak_keep(mifare_ultralight_handle_t *handle, uint8_t command, uint8_t res, uint8_t *buf, uint8_t len)
+{
+    uint8_t ack;
+    
+    switch (command)
+    {
+        case MIFARE_ULTRALIGHT_COMMAND_REQUEST :
+        case MIFARE_ULTRALIGHT_COMMAND_WAKE_UP :
+        case (uint8_t)(MIFARE_ULTRALIGHT_COMMAND_SELECT_CL1 >> 8) :
+        case (uint8_t)(MIFARE_ULTRALIGHT_COMMAND_SELECT_CL2 >> 8) :
+        case (uint8_t)(MIFARE_ULTRALIGHT_COMMAND_HALT >> 8) :
+        {
+            ack = 0;                                                            /* answered by atqa, uid, sak or nothing */
+            
+            break;
+        }
+        default :
+        {
+            ack = 1;                                                            /* answered by an ack or data */
+            
+            break;
+        }
+    }
+    if ((ack != 0) && (res == 0) && (len == 1) && 
+        (buf[0] < 0x10) && (buf[0] != 0x0A))                                    /* check the nak */
+    {
+        handle->nak = buf[0];                                                   /* keep the nak */
+        handle->auth = 0;                                                       /* a nak sends the card to idle */
+    }
+    else
+    {
+        handle->nak = MIFARE_ULTRALIGHT_NAK_NONE;                               /* no nak */
+        if (res != 0)                                                           /* check the result */
+        {
+            handle->auth = 0;                                                   /* the card state is unknown */
+        }
+    }
+}
+
+/**
+ * @brief     mifare_ultralight report an ack error
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] ack received ack or nak
+ * @note      the nak code is printed and kept for the retry policy
+ */
+static void a_mifare_ultralight_ack_error(mifare_ultralight_handle_t *handle, uint8_t ack)
+{
+    switch (ack)
+    {
+        case MIFARE_ULTRALIGHT_NAK_INVALID_ARGUMENT :
+        {
+            handle->debug_print("mifare_ultralight: nak, invalid argument or page address.\n");      /* invalid argument */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_NAK_CRC :
+        {
+            handle->debug_print("mifare_ultralight: nak, parity or crc error.\n");                  /* crc error */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_NAK_AUTH_COUNTER :
+        {
+            handle->debug_print("mifare_ultralight: nak, authentication counter overflow.\n");      /* authentication counter overflow */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_NAK_EEPROM :
+        {
+            handle->debug_print("mifare_ultralight: nak, eeprom write error.\n");                   /* eeprom write error */
+            
+            break;
+        }
+        default :
+        {
+            handle->debug_print("mifare_ultralight: ack error.\n");                                 /* ack error */
+            
+            break;
+        }
+    }
+    handle->nak = (ack < 0x10) ? ack : MIFARE_ULTRALIGHT_NAK_NONE;                              /* keep the nak */
+    MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_ACK);                         /* record the error */
+}
+
+/**
+ * @brief         mifare_ultralight contactless transceiver with the frame hook
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in]     *in_buf pointer to an input buffer
+ * @param[in]     in_len input length
+ * @param[out]    *out_buf pointer to an output buffer
+ * @param[in,out] *out_len pointer to an output length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 transceiver failed
+ * @note          a nak is kept for the retry policy
+ */
+static uint8_t a_mifare_ultralight_transceiver(mifare_ultralight_handle_t *handle, uint8_t *in_buf, uint8_t in_len,
+                                               uint8_t *out_buf, uint8_t *out_len)
+{
+    uint8_t res;
+#if (MIFARE_ULTRALIGHT_FRAME_HOOK != 0)
+    uint32_t timestamp;
+    
+    timestamp = a_mifare_ultralight_timestamp_us(handle);                                              /* save the start time */
+#endif
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+    a_mifare_ultralight_trace_buf(handle, MIFARE_ULTRALIGHT_TRACE_DIR_TX, 0, timestamp, in_buf, in_len);  /* trace the sent frame */
+#endif
+    res = a_mifare_ultralight_transceiver_link(handle, in_buf, in_len, out_buf, out_len);              /* transceiver */
+    a_mifare_ultralight_nak_keep(handle, in_buf[0], res, out_buf, *out_len);                           /* keep the nak */
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+    a_mifare_ultralight_trace_buf(handle, MIFARE_ULTRALIGHT_TRACE_DIR_RX, res, a_mifare_ultralight_timestamp_us(handle), 
+                                  out_buf, (res == 0) ? *out_len : 0);                                 /* trace the received frame */
+#endif
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+    a_mifare_ultralight_stats_frame(handle, in_buf, in_len, (res == 0) ? *out_len : 0, 
+                                    a_mifare_ultralight_timestamp_us(handle) - timestamp);             /* record the frame */
+#endif
+    
+    return res;                                                                                        /* return the result */
+}
+
+/**
+ * @brief      mifare_ultralight contactless bit oriented transceiver
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *in_buf pointer to an input buffer
+ * @param[in]  in_bits input bit number
+ * @param[out] *out_buf pointer to an output buffer
+ * @param[out] *out_bits pointer to an output bit number buffer
+ * @param[out] *collision pointer to a collision index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 transceiver failed
+ * @note       the _ctx function is used when it is linked
+ */
+#if (MIFARE_ULTRALIGHT_FRAME_HOOK != 0)
+static uint8_t a_mifare_ultralight_transceiver_bits_link(mifare_ultralight_handle_t *handle, uint8_t *in_buf, uint8_t in_bits,
+                                                         uint8_t *out_buf, uint8_t *out_bits, uint8_t *collision)
+#else
+static uint8_t a_mifare_ultralight_transceiver_bits(mifare_ultralight_handle_t *handle, uint8_t *in_buf, uint8_t in_bits,
+                                                    uint8_t *out_buf, uint8_t *out_bits, uint8_t *collision)
+#endif
+{
+    if (handle->contactless_transceiver_bits_ctx != NULL)                                              /* check the ctx function */
+    {
+        return handle->contactless_transceiver_bits_ctx(handle->user, in_buf, in_bits, 
+                                                        out_buf, out_bits, collision);                 /* transceiver bits */
+    }
+    
+    return handle->contactless_transceiver_bits(in_buf, in_bits, out_buf, out_bits, collision);        /* transceiver bits */
+}
+
+#if (MIFARE_ULTRALIGHT_FRAME_HOOK != 0)
+/**
+ * @brief      mifare_ultralight contactless bit oriented transceiver with the frame hook
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *in_buf pointer to an input buffer
+ * @param[in]  in_bits input bit number
+ * @param[out] *out_buf pointer to an output buffer
+ * @param[out] *out_bits pointer to an output bit number buffer
+ * @param[out] *collision pointer to a collision index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 transceiver failed
+ * @note       partial bytes are counted as whole bytes in the statistics
+ */
+static uint8_t a_mifare_ultralight_transceiver_bits(mifare_ultralight_handle_t *handle, uint8_t *in_buf, uint8_t in_bits,
+                                                    uint8_t *out_buf, uint8_t *out_bits, uint8_t *collision)
+{
+    uint8_t res;
+    uint32_t timestamp;
+    
+    timestamp = a_mifare_ultralight_timestamp_us(handle);                                              /* save the start time */
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+    a_mifare_ultralight_trace_buf(handle, MIFARE_ULTRALIGHT_TRACE_DIR_TX_BITS, 0, timestamp, in_buf, in_bits); /* trace the sent frame */
+#endif
+    res = a_mifare_ultralight_transceiver_bits_link(handle, in_buf, in_bits, out_buf, 
+                                                    out_bits, collision);                              /* transceiver bits */
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+    a_mifare_ultralight_trace_buf(handle, MIFARE_ULTRALIGHT_TRACE_DIR_RX_BITS, res, a_mifare_ultralight_timestamp_us(handle), 
+                                  out_buf, (res == 0) ? *out_bits : 0);                                /* trace the received frame */
+#endif
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+    a_mifare_ultralight_stats_frame(handle, in_buf, (uint8_t)((in_bits + 7) / 8), 
+                                    (res == 0) ? (uint8_t)((*out_bits + 7) / 8) : 0, 
+                                    a_mifare_ultralight_timestamp_us(handle) - timestamp);             /* record the frame */
+#endif
+    
+    return res;                                                                                        /* return the result */
+}
+#endif
+
+/**
+ * @brief     mifare_ultralight queue a frame
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *in_buf pointer to an input buffer
+ * @param[in] in_len input length
+ * @return    status code
+ *            - 0 queued
+ *            - 1 failed
+ *            - 2 busy
+ * @note      the _ctx function is used when it is linked
+ */
+static uint8_t a_mifare_ultralight_submit(mifare_ultralight_handle_t *handle, uint8_t *in_buf, uint8_t in_len)
+{
+    if (handle->contactless_submit_ctx != NULL)                                 /* check the ctx function */
+    {
+        return handle->contactless_submit_ctx(handle->user, in_buf, in_len);    /* submit */
+    }
+    
+    return handle->contactless_submit(in_buf, in_len);                          /* submit */
+}
+
+/**
+ * @brief         mifare_ultralight poll a response
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[out]    *out_buf pointer to an output buffer
+ * @param[in,out] *out_len pointer to an output length buffer
+ * @return        status code
+ *                - 0 response ready
+ *                - 1 failed
+ *                - 2 pending
+ * @note          the _ctx function is used when it is linked
+ */
+static uint8_t a_mifare_ultralight_poll(mifare_ultralight_handle_t *handle, uint8_t *out_buf, uint8_t *out_len)
+{
+    if (handle->contactless_poll_ctx != NULL)                                   /* check the ctx function */
+    {
+        return handle->contactless_poll_ctx(handle->user, out_buf, out_len);    /* poll */
+    }
+    
+    return handle->contactless_poll(out_buf, out_len);                          /* poll */
+}
+
+/**
+ * @brief     mifare_ultralight delay ms
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] ms time
+ * @note      the _ctx function is used when it is linked
+ */
+static void a_mifare_ultralight_delay_ms(mifare_ultralight_handle_t *handle, uint32_t ms)
+{
+    if (handle->delay_ms_ctx != NULL)                                           /* check the ctx function */
+    {
+        handle->delay_ms_ctx(handle->user, ms);                                 /* delay ms */
+        
+        return;
+    }
+    
+    handle->delay_ms(ms);                                                       /* delay ms */
+}
+
+/**
+ * @brief         vectored transceiver
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in]     *tx pointer to the transmit segments
+ * @param[in]     tx_count transmit segment number
+ * @param[out]    *rx pointer to the receive segments
+ * @param[in]     rx_count receive segment number
+ * @param[out]    *out_len pointer to a received length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 transceiver failed
+ * @note          without contactless_transceiver_vector the tx segments are gathered and the
+ *                rx segments are scattered through the bounce buffers, contiguous rx segments
+ *                are received in place
+ */
+static uint8_t a_mifare_ultralight_transceiver_vector(mifare_ultralight_handle_t *handle,
+                                                      mifare_ultralight_segment_t *tx, uint8_t tx_count,
+                                                      mifare_ultralight_segment_t *rx, uint8_t rx_count,
+                                                      uint8_t *out_len)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t input_len;
+    uint8_t input_buf[MIFARE_ULTRALIGHT_BOUNCE_TX_LEN];
+    uint8_t output_len;
+    uint8_t output_buf[MIFARE_ULTRALIGHT_BOUNCE_RX_LEN];
+    uint8_t *p;
+    uint16_t len;
+    
+    len = 0;                                                                                       /* init 0 */
+    for (i = 0; i < rx_count; i++)                                                                 /* all rx segments */
+    {
+        len += rx[i].len;                                                                          /* add the length */
+    }
+    if (len > 255)                                                                                 /* check the length */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    *out_len = (uint8_t)len;                                                                       /* set the capacity */
+#if (MIFARE_ULTRALIGHT_FRAME_HOOK != 0)
+    if (MIFARE_ULTRALIGHT_LINKED(handle, contactless_transceiver_vector))                         /* check the vector transceiver */
+    {
+        uint32_t timestamp;
+        
+        timestamp = a_mifare_ultralight_timestamp_us(handle);                                      /* save the start time */
+        len = 0;                                                                                   /* init 0 */
+        for (i = 0; i < tx_count; i++)                                                             /* all tx segments */
+        {
+            len += tx[i].len;                                                                      /* add the length */
+        }
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+        a_mifare_ultralight_trace_record(handle, MIFARE_ULTRALIGHT_TRACE_DIR_TX, 0, timestamp, 
+                                         tx, tx_count, (uint8_t)len);                              /* trace the sent frame */
+#endif
+        if (handle->contactless_transceiver_vector_ctx != NULL)                                    /* check the ctx function */
+        {
+            res = handle->contactless_transceiver_vector_ctx(handle->user, tx, tx_count, 
+                                                             rx, rx_count, out_len);               /* transceiver */
+        }
+        else
+        {
+            res = handle->contactless_transceiver_vector(tx, tx_count, rx, rx_count, out_len);     /* transceiver */
+        }
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+        a_mifare_ultralight_trace_record(handle, MIFARE_ULTRALIGHT_TRACE_DIR_RX, res, a_mifare_ultralight_timestamp_us(handle), 
+                                         rx, rx_count, (res == 0) ? *out_len : 0);                 /* trace the received frame */
+#endif
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+        a_mifare_ultralight_stats_frame(handle, tx[0].buf, (uint8_t)len, (res == 0) ? *out_len : 0, 
+                                        a_mifare_ultralight_timestamp_us(handle) - timestamp);     /* record the frame */
+#endif
+        a_mifare_ultralight_nak_keep(handle, tx[0].buf[0], res, rx[0].buf, *out_len);              /* keep the nak */
+        
+        return res;                                                                                /* return the result */
+    }
+#else
+    if (MIFARE_ULTRALIGHT_LINKED(handle, contactless_transceiver_vector))                         /* check the vector transceiver */
+    {
+        if (handle->contactless_transceiver_vector_ctx != NULL)                                    /* check the ctx function */
+        {
+            res = handle->contactless_transceiver_vector_ctx(handle->user, tx, tx_count, 
+                                                             rx, rx_count, out_len);               /* transceiver */
+        }
+        else
+        {
+            res = handle->contactless_transceiver_vector(tx, tx_count, rx, rx_count, out_len);     /* transceiver */
+        }
+        a_mifare_ultralight_nak_keep(handle, tx[0].buf[0], res, rx[0].buf, *out_len);              /* keep the nak */
+        
+        return res;                                                                                /* return the result */
+    }
+#endif
+    
+    len = 0;                                                                                       /* init 0 */
+    for (i = 0; i < tx_count; i++)                                                                 /* gather the tx segments */
+    {
+        if (len + tx[i].len > MIFARE_ULTRALIGHT_BOUNCE_TX_LEN)                                     /* check the bounce buffer */
+        {
+            return 1;                                                                              /* return error */
+        }
+        memcpy(input_buf + len, tx[i].buf, tx[i].len);                                             /* copy the segment */
+        len += tx[i].len;                                                                          /* add the length */
+    }
+    input_len = (uint8_t)len;                                                                      /* set the input length */
+    for (i = 1; i < rx_count; i++)                                                                 /* check the rx segments */
+    {
+        if (rx[i - 1].buf + rx[i - 1].len != rx[i].buf)                                            /* check the gap */
+        {
+            break;                                                                                 /* break */
+        }
+    }
+    if (i >= rx_count)                                                                             /* contiguous rx segments */
+    {
+        return a_mifare_ultralight_transceiver(handle, input_buf, input_len, rx[0].buf, out_len);  /* receive in place */
+    }
+    if (*out_len > MIFARE_ULTRALIGHT_BOUNCE_RX_LEN)                                                /* check the bounce buffer */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    output_len = *out_len;                                                                         /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len);  /* transceiver */
+    if (res != 0)                                                                                  /* check the result */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    if (output_len > *out_len)                                                                     /* check the output length */
+    {
+        output_len = *out_len;                                                                     /* clamp the output length */
+    }
+    *out_len = output_len;                                                                         /* set the received length */
+    p = output_buf;                                                                                /* set the bounce buffer */
+    for (i = 0; (i < rx_count) && (output_len != 0); i++)                                          /* scatter the rx segments */
+    {
+        len = (rx[i].len < output_len) ? rx[i].len : output_len;                                   /* set the segment length */
+        memcpy(rx[i].buf, p, len);                                                                 /* copy the segment */
+        p += len;                                                                                  /* next segment */
+        output_len = (uint8_t)(output_len - len);                                                  /* remain length */
+    }
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     check the crc trailer of received segments
+ * @param[in] *rx pointer to the receive segments
+ * @param[in] rx_count receive segment number
+ * @return    status code
+ *            - 0 success
+ *            - 1 crc error
+ * @note      the last segment is the 2 bytes crc, the crc runs over the others in place
+ */
+static uint8_t a_mifare_ultralight_segment_crc_check(mifare_ultralight_segment_t *rx, uint8_t rx_count)
+{
+    uint8_t i;
+    uint16_t crc;
+    
+    crc = MIFARE_ULTRALIGHT_CRC_INIT;                                                              /* set the preset */
+    for (i = 0; i < rx_count - 1; i++)                                                             /* all data segments */
+    {
+        crc = a_mifare_ultralight_crc_update(crc, rx[i].buf, rx[i].len);                           /* update the crc */
+    }
+    if ((rx[rx_count - 1].buf[0] != (uint8_t)(crc & 0xFF)) ||
+        (rx[rx_count - 1].buf[1] != (uint8_t)((crc >> 8) & 0xFF)))                                 /* check the crc */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      set the crc trailer of transmit segments
+ * @param[in]  *tx pointer to the transmit segments
+ * @param[in]  tx_count transmit segment number
+ * @note       the last segment is the 2 bytes crc, the crc runs over the others
+ */
+static void a_mifare_ultralight_segment_crc_set(mifare_ultralight_segment_t *tx, uint8_t tx_count)
+{
+    uint8_t i;
+    uint16_t crc;
+    
+    crc = MIFARE_ULTRALIGHT_CRC_INIT;                                                              /* set the preset */
+    for (i = 0; i < tx_count - 1; i++)                                                             /* all data segments */
+    {
+        crc = a_mifare_ultralight_crc_update(crc, tx[i].buf, tx[i].len);                           /* update the crc */
+    }
+    tx[tx_count - 1].buf[0] = (uint8_t)(crc & 0xFF);                                               /* lsb */
+    tx[tx_count - 1].buf[1] = (uint8_t)((crc >> 8) & 0xFF);                                        /* msb */
+}
+
+/**
+ * @brief     get the class of a page
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] page checked page
+ * @return    page class
+ * @note      the dynamic lock page only exists on the MF0UL21
+ */
+static uint8_t a_mifare_ultralight_page_class(mifare_ultralight_handle_t *handle, uint8_t page)
+{
+    if (page < 2)                                                                             /* serial number */
+    {
+        return MIFARE_ULTRALIGHT_PAGE_CLASS_UID;                                              /* uid page */
+    }
+    else if (page == 2)                                                                       /* static lock */
+    {
+        return MIFARE_ULTRALIGHT_PAGE_CLASS_LOCK;                                             /* lock page */
+    }
+    else if (page == 3)                                                                       /* otp */
+    {
+        return MIFARE_ULTRALIGHT_PAGE_CLASS_OTP;                                              /* otp page */
+    }
+    else if ((handle->end_page == (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21) && 
+             (page == handle->end_page - 4))                                                  /* dynamic lock */
+    {
+        return MIFARE_ULTRALIGHT_PAGE_CLASS_LOCK;                                             /* lock page */
+    }
+    else if ((page == handle->end_page - 3) || (page == handle->end_page - 2))                /* cfg0 and cfg1 */
+    {
+        return MIFARE_ULTRALIGHT_PAGE_CLASS_CONF;                                             /* conf page */
+    }
+    else if ((page == handle->end_page - 1) || (page == handle->end_page))                    /* pwd and pack */
+    {
+        return MIFARE_ULTRALIGHT_PAGE_CLASS_KEY;                                              /* key page */
+    }
+    else
+    {
+        return MIFARE_ULTRALIGHT_PAGE_CLASS_USER;                                             /* user page */
+    }
+}
+
+/**
+ * @brief     get the write rank of a page
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] page checked page
+ * @return    write rank
+ * @note      a new lock bit or a lower auth0 must not refuse the writes of the same image,
+ *            so the user pages go first, then pwd, pack and cfg1, cfg0 and at last otp and lock
+ */
+static uint8_t a_mifare_ultralight_write_rank(mifare_ultralight_handle_t *handle, uint8_t page)
+{
+    switch (a_mifare_ultralight_page_class(handle, page))                                     /* check the page class */
+    {
+        case MIFARE_ULTRALIGHT_PAGE_CLASS_KEY :
+        {
+            return MIFARE_ULTRALIGHT_WRITE_RANK_KEY;                                          /* pwd and pack */
+        }
+        case MIFARE_ULTRALIGHT_PAGE_CLASS_CONF :
+        {
+            return (page == handle->end_page - 3) ? MIFARE_ULTRALIGHT_WRITE_RANK_CFG0 : 
+                    MIFARE_ULTRALIGHT_WRITE_RANK_CFG1;                                        /* cfg0 after cfg1 */
+        }
+        case MIFARE_ULTRALIGHT_PAGE_CLASS_OTP :
+        {
+            return MIFARE_ULTRALIGHT_WRITE_RANK_OTP;                                          /* otp */
+        }
+        case MIFARE_ULTRALIGHT_PAGE_CLASS_LOCK :
+        {
+            return MIFARE_ULTRALIGHT_WRITE_RANK_LOCK;                                         /* lock */
+        }
+        default :
+        {
+            return MIFARE_ULTRALIGHT_WRITE_RANK_USER;                                         /* user */
+        }
+    }
+}
+
+/**
+ * @brief     queue a written page of the verified write
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] page written page
+ * @param[in] *data pointer to the written data
+ * @note      the otp and lock pages keep the or of all writes like the card does
+ */
+static void a_mifare_ultralight_verify_queue(mifare_ultralight_handle_t *handle, uint8_t page, const uint8_t *data)
+{
+    uint8_t i;
+    uint8_t cls;
+    uint8_t *exp;
+    mifare_ultralight_verify_t *verify;
+    
+    verify = handle->verify;                                                                  /* get the queue */
+    if ((verify == NULL) || (page > handle->end_page))                                        /* check the queue */
+    {
+        return;                                                                               /* not queued */
+    }
+    cls = a_mifare_ultralight_page_class(handle, page);                                       /* get the page class */
+    if ((cls == MIFARE_ULTRALIGHT_PAGE_CLASS_UID) || (cls == MIFARE_ULTRALIGHT_PAGE_CLASS_KEY))   /* check the readback */
+    {
+        return;                                                                               /* can't be checked */
+    }
+    exp = verify->data + 4 * page;                                                            /* set the expected content */
+    if (((cls == MIFARE_ULTRALIGHT_PAGE_CLASS_OTP) || (cls == MIFARE_ULTRALIGHT_PAGE_CLASS_LOCK)) &&
+        ((verify->queued[page / 8] & (1 << (page % 8))) != 0))                                /* check the one-time bits */
+    {
+        for (i = 0; i < 4; i++)                                                               /* or all bytes */
+        {
+            exp[i] |= data[i];                                                                /* the card ors the bits */
+        }
+    }
+    else
+    {
+        memcpy(exp, data, 4);                                                                 /* save the content */
+    }
+    verify->queued[page / 8] |= (uint8_t)(1 << (page % 8));                                   /* mark the page */
+}
+
+/**
+ * @brief     check a page of the verified write
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] page checked page
+ * @param[in] *cur pointer to the read content
+ * @return    status code
+ *            - 0 page matches
+ *            - 1 page mismatches
+ * @note      the otp and lock bits only need to be set, the first 2 bytes of page 2 are
+ *            serial number and internal bytes and are not checked
+ */
+static uint8_t a_mifare_ultralight_verify_check(mifare_ultralight_handle_t *handle, uint8_t page, const uint8_t *cur)
+{
+    uint8_t i;
+    uint8_t cls;
+    const uint8_t *exp;
+    
+    exp = handle->verify->data + 4 * page;                                                    /* set the expected content */
+    cls = a_mifare_ultralight_page_class(handle, page);                                       /* get the page class */
+    if ((cls == MIFARE_ULTRALIGHT_PAGE_CLASS_OTP) || (cls == MIFARE_ULTRALIGHT_PAGE_CLASS_LOCK))  /* one-time bits */
+    {
+        for (i = (page == 2) ? 2 : 0; i < 4; i++)                                             /* check all bytes */
+        {
+            if ((cur[i] & exp[i]) != exp[i])                                                  /* check the set bits */
+            {
+                return 1;                                                                     /* mismatch */
+            }
+        }
+        
+        return 0;                                                                             /* match */
+    }
+    
+    return (memcmp(cur, exp, 4) != 0) ? 1 : 0;                                                /* check the content */
+}
+
+/**
+ * @brief     mifare_ultralight keep the uid of the selected card
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] level cascade level 1 or 2
+ * @param[in] *id pointer to the selected id
+ * @note      the uid is complete when both levels were selected in order
+ */
+static void a_mifare_ultralight_uid_keep(mifare_ultralight_handle_t *handle, uint8_t level, uint8_t id[4])
+{
+    if (level == 1)                                                 /* cascade level 1 */
+    {
+        memcpy(handle->uid, id + 1, 3);                             /* skip the cascade tag */
+        handle->uid_valid = 1;                                      /* cl1 is selected */
+    }
+    else if ((handle->uid_valid & 1) != 0)                          /* cascade level 2 after cl1 */
+    {
+        memcpy(handle->uid + 3, id, 4);                             /* copy the uid */
+        handle->uid_valid |= 2;                                     /* cl2 is selected */
+    }
+    else
+    {
+                                                                    /* do nothing */
+    }
+}
+
+/**
+ * @brief     mifare_ultralight hash a uid
+ * @param[in] *uid pointer to a uid buffer
+ * @return    fnv-1a hash
+ * @note      none
+ */
+static uint32_t a_mifare_ultralight_uid_hash(const uint8_t uid[7])
+{
+    uint8_t i;
+    uint32_t hash;
+    
+    hash = 2166136261U;                                                           /* fnv offset basis */
+    for (i = 0; i < 7; i++)                                                       /* hash all bytes */
+    {
+        hash ^= uid[i];                                                           /* xor the byte */
+        hash *= 16777619U;                                                        /* fnv prime */
+    }
+    
+    return hash;                                                                  /* return the hash */
+}
+
+/**
+ * @brief      mifare_ultralight find a uid in the cache
+ * @param[in]  *cache pointer to a cache structure
+ * @param[in]  *uid pointer to a uid buffer
+ * @param[out] *slot pointer to a slot buffer
+ * @return     status code
+ *             - 0 uid is not cached, slot is the free slot
+ *             - 1 uid is cached, slot is its slot
+ * @note       linear probing, the cache is never full because at most 3 / 4 of the slots are used
+ */
+static uint8_t a_mifare_ultralight_cache_find(mifare_ultralight_cache_t *cache, uint8_t uid[7], uint16_t *slot)
+{
+    uint16_t mask;
+    uint16_t index;
+    
+    mask = (uint16_t)(cache->size - 1);                                           /* set the mask */
+    index = (uint16_t)(a_mifare_ultralight_uid_hash(uid) & mask);                 /* set the first slot */
+    while ((cache->entry[index].flag & 0x01) != 0)                                /* probe the used slots */
+    {
+        if (memcmp(cache->entry[index].uid, uid, 7) == 0)                         /* check the uid */
+        {
+            *slot = index;                                                        /* set the slot */
+            
+            return 1;                                                             /* found */
+        }
+        index = (uint16_t)((index + 1) & mask);                                   /* next slot */
+    }
+    *slot = index;                                                                /* set the free slot */
+    
+    return 0;                                                                     /* not found */
+}
+
+/**
+ * @brief     mifare_ultralight evict one uid from the cache
+ * @param[in] *cache pointer to a cache structure
+ * @note      the clock hand clears the referenced bits until it meets an unreferenced entry,
+ *            the following entries of its probe chain are shifted back so no tombstone is left
+ */
+static void a_mifare_ultralight_cache_evict(mifare_ultralight_cache_t *cache)
+{
+    uint16_t i;
+    uint16_t j;
+    uint16_t home;
+    uint16_t mask;
+    
+    mask = (uint16_t)(cache->size - 1);                                                   /* set the mask */
+    while (1)                                                                             /* sweep */
+    {
+        if ((cache->entry[cache->hand].flag & 0x01) != 0)                                 /* used slot */
+        {
+            if ((cache->entry[cache->hand].flag & 0x02) == 0)                             /* not referenced */
+            {
+                break;                                                                    /* evict it */
+            }
+            cache->entry[cache->hand].flag &= (uint8_t)(~0x02);                           /* give a second chance */
+        }
+        cache->hand = (uint16_t)((cache->hand + 1) & mask);                               /* advance the hand */
+    }
+    
+    i = cache->hand;                                                                      /* the hole */
+    j = i;                                                                                /* init the scan */
+    while (1)                                                                             /* backward shift */
+    {
+        j = (uint16_t)((j + 1) & mask);                                                   /* next slot */
+        if ((cache->entry[j].flag & 0x01) == 0)                                           /* end of the chain */
+        {
+            break;                                                                        /* stop */
+        }
+        home = (uint16_t)(a_mifare_ultralight_uid_hash(cache->entry[j].uid) & mask);      /* home slot of the entry */
+        if (((uint16_t)((j - home) & mask)) >= ((uint16_t)((j - i) & mask)))              /* the hole is on its probe path */
+        {
+            cache->entry[i] = cache->entry[j];                                            /* move it into the hole */
+            i = j;                                                                        /* new hole */
+        }
+    }
+    memset(&cache->entry[i], 0, sizeof(mifare_ultralight_cache_entry_t));                 /* free the hole */
+    cache->count--;                                                                       /* one less */
+    cache->evictions++;                                                                   /* count the eviction */
+}
+
+/**
+ * @brief     mifare_ultralight get the cache entry of a uid
+ * @param[in] *cache pointer to a cache structure
+ * @param[in] *uid pointer to a uid buffer
+ * @param[in] insert 1 inserts the uid when it is not cached
+ * @return    pointer to the entry, NULL when it is not cached
+ * @note      the pointer is valid until the next insert
+ */
+static mifare_ultralight_cache_entry_t *a_mifare_ultralight_cache_get(mifare_ultralight_cache_t *cache, uint8_t uid[7], uint8_t insert)
+{
+    uint16_t slot;
+    
+    if (a_mifare_ultralight_cache_find(cache, uid, &slot) != 0)                   /* check the uid */
+    {
+        return &cache->entry[slot];                                               /* return the entry */
+    }
+    if (insert == 0)                                                              /* check the insert flag */
+    {
+        return NULL;                                                              /* not cached */
+    }
+    if (cache->count >= (uint16_t)(cache->size - cache->size / 4))                /* check the load */
+    {
+        a_mifare_ultralight_cache_evict(cache);                                   /* make room */
+        (void)a_mifare_ultralight_cache_find(cache, uid, &slot);                  /* find the free slot again */
+    }
+    memcpy(cache->entry[slot].uid, uid, 7);                                       /* copy the uid */
+    cache->entry[slot].storage = 0;                                               /* unknown storage */
+    cache->entry[slot].verdict = (uint8_t)MIFARE_ULTRALIGHT_CACHE_VERDICT_UNKNOWN;    /* unknown verdict */
+    cache->entry[slot].key = 0;                                                   /* no key */
+    cache->entry[slot].flag = 0x01;                                               /* used and not referenced */
+    cache->count++;                                                               /* one more */
+    cache->inserts++;                                                             /* count the insert */
+    
+    return &cache->entry[slot];                                                   /* return the entry */
+}
+
+/**
+ * @brief     mifare_ultralight wait some time
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] us time
+ * @note      delay_ms is used with the time rounded up when delay_us is not linked
+ */
+static void a_mifare_ultralight_wait_us(mifare_ultralight_handle_t *handle, uint32_t us)
+{
+    if (handle->delay_us_ctx != NULL)                       /* check the delay_us_ctx */
+    {
+        handle->delay_us_ctx(handle->user, us);             /* delay us */
+    }
+    else if (handle->delay_us != NULL)                      /* check the delay_us */
+    {
+        handle->delay_us(us);                               /* delay us */
+    }
+    else
+    {
+        a_mifare_ultralight_delay_ms(handle, (us + 999) / 1000);    /* delay ms */
+    }
+}
+
+/**
+ * @brief     mifare_ultralight wait a guard time
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] guard guard time type
+ * @note      none
+ */
+static void a_mifare_ultralight_guard(mifare_ultralight_handle_t *handle, mifare_ultralight_guard_time_t guard)
+{
+    uint32_t us;
+    
+    us = handle->guard_time_us[guard];                      /* get the guard time */
+    if (us == 0)                                            /* check the time */
+    {
+        return;                                             /* no wait */
+    }
+    a_mifare_ultralight_wait_us(handle, us);                /* wait */
+}
+
+/**
+ * @brief      mifare_ultralight bit oriented anti collision
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  sel select code of the cascade level
+ * @param[out] *id pointer to an id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 anti collision failed
+ * @note       the bit 1 branch is taken at every collision
+ */
+static uint8_t a_mifare_ultralight_anticollision_bits(mifare_ultralight_handle_t *handle, uint8_t sel, uint8_t id[4])
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t known;
+    uint8_t pos;
+    uint8_t byte;
+    uint8_t bit;
+    uint8_t len;
+    uint8_t mask;
+    uint8_t collision;
+    uint8_t output_bits;
+    uint8_t input_buf[7];
+    uint8_t output_buf[5];
+    
+    memset(input_buf, 0, sizeof(input_buf));                                                       /* clear the buffer */
+    input_buf[0] = sel;                                                                            /* set the select code */
+    known = 0;                                                                                     /* no known bits */
+    while (known < 40)                                                                             /* resolve all bits */
+    {
+        byte = known / 8;                                                                          /* known bytes */
+        bit = known % 8;                                                                           /* known bits of the last byte */
+        input_buf[1] = (uint8_t)(((2 + byte) << 4) | bit);                                         /* set the nvb */
+        output_bits = (uint8_t)(40 - known);                                                       /* set the expected bits */
+        collision = 0xFF;                                                                          /* init no collision */
+        memset(output_buf, 0, sizeof(output_buf));                                                 /* clear the buffer */
+        res = a_mifare_ultralight_transceiver_bits(handle, input_buf, (uint8_t)(16 + known), 
+                                                   output_buf, &output_bits, &collision);          /* transceiver bits */
+        if (res != 0)                                                                              /* check the result */
+        {
+            handle->debug_print("mifare_ultralight: contactless transceiver bits failed.\n");      /* contactless transceiver bits failed */
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);            /* record the error */
+            
+            return 1;                                                                              /* return error */
+        }
+        if ((output_bits == 0) || (known + output_bits > 40) || 
+            ((collision != 0xFF) && (collision >= output_bits)))                                   /* check the output bits */
+        {
+            handle->debug_print("mifare_ultralight: output_bits is invalid.\n");                   /* output_bits is invalid */
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);             /* record the error */
+            
+            return 1;                                                                              /* return error */
+        }
+        mask = (uint8_t)((1 << bit) - 1);                                                          /* known bits mask */
+        len = (uint8_t)((bit + output_bits + 7) / 8);                                              /* received bytes */
+        input_buf[2 + byte] = (uint8_t)((input_buf[2 + byte] & mask) | (output_buf[0] & (~mask))); /* merge the first byte */
+        for (i = 1; i < len; i++)                                                                  /* copy the others */
+        {
+            input_buf[2 + byte + i] = output_buf[i];                                               /* copy the byte */
+        }
+        if (collision == 0xFF)                                                                     /* no collision */
+        {
+            known = (uint8_t)(known + output_bits);                                                /* all bits are known */
+            
+            break;                                                                                 /* break */
+        }
+        pos = (uint8_t)(known + collision);                                                        /* collision bit */
+        input_buf[2 + pos / 8] &= (uint8_t)((1 << (pos % 8)) - 1);                                 /* clear the unknown bits */
+        input_buf[2 + pos / 8] |= (uint8_t)(1 << (pos % 8));                                       /* take the bit 1 branch */
+        for (i = (uint8_t)(pos / 8 + 1); i < 5; i++)                                               /* clear the next bytes */
+        {
+            input_buf[2 + i] = 0;                                                                  /* clear the byte */
+        }
+        known = (uint8_t)(pos + 1);                                                                /* set the known bits */
+    }
+    if (known != 40)                                                                               /* check the known bits */
+    {
+        handle->debug_print("mifare_ultralight: output_bits is invalid.\n");                       /* output_bits is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);                 /* record the error */
+        
+        return 1;                                                                                  /* return error */
+    }
+    if ((input_buf[2] ^ input_buf[3] ^ input_buf[4] ^ input_buf[5]) != input_buf[6])               /* check the bcc */
+    {
+        handle->debug_print("mifare_ultralight: check error.\n");                                  /* check error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CHECK);                      /* record the error */
+        
+        return 1;                                                                                  /* return error */
+    }
+    memcpy(id, input_buf + 2, 4);                                                                  /* copy the id */
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     mifare_ultralight authenticate before a protected page access
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] page last accessed page
+ * @param[in] write 1 for a write and 0 for a read
+ * @return    status code
+ *            - 0 success
+ *            - 1 authenticate failed
+ * @note      PWD_AUTH is only sent with auto authenticate, outside an authenticated session
+ *            and for a protected page, every user page is taken as protected while auth0
+ *            is not in the conf shadow
+ */
+static uint8_t a_mifare_ultralight_auto_auth(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t write)
+{
+    if ((handle->auth_auto == 0) || (handle->auth != 0))                                        /* check the session */
+    {
+        return 0;                                                                               /* success return 0 */
+    }
+    if (((handle->conf_valid & 1) != 0) ? (page < handle->conf[0][3]) : (page < 4))             /* below auth0 */
+    {
+        return 0;                                                                               /* success return 0 */
+    }
+    if ((write == 0) && ((handle->conf_valid & 2) != 0) && ((handle->conf[1][0] & 0x80) == 0))  /* reads are not protected */
+    {
+        return 0;                                                                               /* success return 0 */
+    }
+    if (mifare_ultralight_authenticate(handle, handle->auth_pwd, handle->auth_pack) != 0)       /* authenticate */
+    {
+        handle->debug_print("mifare_ultralight: auto authenticate failed.\n");                  /* auto authenticate failed */
+        
+        return 1;                                                                               /* return error */
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight read conf
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  page page of read
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read conf failed
+ * @note       none
+ */
+static uint8_t a_mifare_ultralight_conf_read(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4])
+{
+    uint8_t res;
+    uint8_t input_len;
+    uint8_t input_buf[5];
+    uint8_t output_len;
+    uint8_t output_buf[6];
+    uint8_t crc_buf[2];
+    
+    if (a_mifare_ultralight_auto_auth(handle, page, 0) != 0)                                     /* authenticate when needed */
+    {
+        return 1;                                                                                /* return error */
+    }
+    input_len = 5;                                                                               /* set the input length */
+    a_mifare_ultralight_fast_read_frame(page, page, input_buf);                                  /* set the frame */
+    output_len = 6;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 6)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    a_mifare_ultralight_iso14443a_crc(output_buf, 4, crc_buf);                                   /* get the crc */
+    if ((output_buf[4] == crc_buf[0]) && (output_buf[5] == crc_buf[1]))                          /* check the crc */
+    {
+        memcpy(data, output_buf, 4);                                                             /* copy the data */
+        
+        return 0;                                                                                /* success return 0 */
+    }
+    else
+    {
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+}
+
+/**
+ * @brief     mifare_ultralight write conf
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] page page of write
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write conf failed
+ * @note      none
+ */
+static uint8_t a_mifare_ultralight_conf_write(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4])
+{
+    uint8_t res;
+    uint8_t input_len;
+    uint8_t input_buf[8];
+    uint8_t output_len;
+    uint8_t output_buf[1];
+    
+    if (a_mifare_ultralight_auto_auth(handle, page, 1) != 0)                                     /* authenticate when needed */
+    {
+        return 1;                                                                                /* return error */
+    }
+    input_len = 8;                                                                               /* set the input length */
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
+    input_buf[1] = page;                                                                         /* set the setting page */
+    input_buf[2] = data[0];                                                                      /* set data0 */
+    input_buf[3] = data[1];                                                                      /* set data1 */
+    input_buf[4] = data[2];                                                                      /* set data2 */
+    input_buf[5] = data[3];                                                                      /* set data3 */
+    a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
+    output_len = 1;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 1)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    {
+        a_mifare_ultralight_ack_error(handle, output_buf[0]);                                    /* decode the nak */
+        
+        return 1;                                                                                /* return error */
+    }
+    
+    a_mifare_ultralight_verify_queue(handle, page, data);                                        /* queue the page */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     mifare_ultralight reset the conf shadow
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @note      none
+ */
+static void a_mifare_ultralight_conf_reset(mifare_ultralight_handle_t *handle)
+{
+    handle->conf_valid = 0;                 /* clear the valid flag */
+    handle->conf_dirty = 0;                 /* clear the dirty flag */
+    handle->conf_transaction = 0;           /* close the transaction */
+}
+
+/**
+ * @brief      mifare_ultralight load conf
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  index 0 is cfg0 and 1 is cfg1
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ * @note       the card is only read when the shadow is invalid
+ */
+static uint8_t a_mifare_ultralight_conf_load(mifare_ultralight_handle_t *handle, uint8_t index, uint8_t data[4])
+{
+    uint8_t res;
+    
+    if ((handle->conf_valid & (1 << index)) == 0)                                                    /* check the shadow */
+    {
+        res = a_mifare_ultralight_conf_read(handle, handle->end_page - 3 + index, 
+                                            handle->conf[index]);                                    /* read conf */
+        if (res != 0)                                                                                /* check the result */
+        {
+            return 1;                                                                                /* return error */
+        }
+        handle->conf_valid |= (uint8_t)(1 << index);                                                 /* set the valid flag */
+    }
+    memcpy(data, handle->conf[index], 4);                                                            /* copy the shadow */
+    
+    return 0;                                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     mifare_ultralight store conf
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] index 0 is cfg0 and 1 is cfg1
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 store failed
+ * @note      the card is only written when no transaction is open
+ */
+static uint8_t a_mifare_ultralight_conf_store(mifare_ultralight_handle_t *handle, uint8_t index, uint8_t data[4])
+{
+    uint8_t res;
+    
+    memcpy(handle->conf[index], data, 4);                                                            /* copy to the shadow */
+    handle->conf_valid |= (uint8_t)(1 << index);                                                     /* set the valid flag */
+    if (handle->conf_transaction != 0)                                                               /* check the transaction */
+    {
+        handle->conf_dirty |= (uint8_t)(1 << index);                                                 /* set the dirty flag */
+        
+        return 0;                                                                                    /* success return 0 */
+    }
+    res = a_mifare_ultralight_conf_write(handle, handle->end_page - 3 + index, data);               /* write conf */
+    if (res != 0)                                                                                    /* check the result */
+    {
+        handle->conf_valid &= (uint8_t)(~(1 << index));                                              /* the card content is unknown */
+        
+        return 1;                                                                                    /* return error */
+    }
+    
+    return 0;                                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     set the storage
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] storage set storage
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t mifare_ultralight_set_storage(mifare_ultralight_handle_t *handle, mifare_ultralight_storage_t storage)
+{
+    if (handle == NULL)                         /* check handle */
+    {
+        return 2;                               /* return error */
+    }
+    if (handle->inited != 1)                    /* check handle initialization */
+    {
+        return 3;                               /* return error */
+    }
+    
+    handle->end_page = (uint8_t)storage;        /* set the storage */
+    a_mifare_ultralight_conf_reset(handle);     /* reset the conf shadow */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief      get the storage
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *storage pointer to a set storage buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_storage(mifare_ultralight_handle_t *handle, mifare_ultralight_storage_t *storage)
+{
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (handle->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    
+    *storage = (mifare_ultralight_storage_t)(handle->end_page);        /* get the storage */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     set the max frame length
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] len max frame length of the transceiver
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len < 6
+ * @note      the default max frame length is 64
+ */
+uint8_t mifare_ultralight_set_max_frame_length(mifare_ultralight_handle_t *handle, uint8_t len)
+{
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (handle->inited != 1)                                           /* check handle initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    if (len < 6)                                                       /* check the length */
+    {
+        handle->debug_print("mifare_ultralight: len < 6.\n");          /* len < 6 */
+        
+        return 4;                                                      /* return error */
+    }
+    
+    handle->max_frame_len = len;                                       /* set the max frame length */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the max frame length
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *len pointer to a max frame length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_max_frame_length(mifare_ultralight_handle_t *handle, uint8_t *len)
+{
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    if (handle->inited != 1)                            /* check handle initialization */
+    {
+        return 3;                                       /* return error */
+    }
+    
+    *len = handle->max_frame_len;                       /* get the max frame length */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief     set the guard time
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] guard guard time type
+ * @param[in] us guard time in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 guard is invalid
+ * @note      the default wake up guard time is 1000us, the others are 0
+ */
+uint8_t mifare_ultralight_set_guard_time(mifare_ultralight_handle_t *handle, mifare_ultralight_guard_time_t guard, uint32_t us)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if (guard > MIFARE_ULTRALIGHT_GUARD_TIME_HALT)                       /* check the guard */
+    {
+        handle->debug_print("mifare_ultralight: guard is invalid.\n");   /* guard is invalid */
+        
+        return 4;                                                        /* return error */
+    }
+    
+    handle->guard_time_us[guard] = us;                                   /* set the guard time */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the guard time
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  guard guard time type
+ * @param[out] *us pointer to a guard time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 guard is invalid
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_guard_time(mifare_ultralight_handle_t *handle, mifare_ultralight_guard_time_t guard, uint32_t *us)
+{
+    if (handle == NULL)                                                  /* check handle */
+    {
+        return 2;                                                        /* return error */
+    }
+    if (handle->inited != 1)                                             /* check handle initialization */
+    {
+        return 3;                                                        /* return error */
+    }
+    if (guard > MIFARE_ULTRALIGHT_GUARD_TIME_HALT)                       /* check the guard */
+    {
+        handle->debug_print("mifare_ultralight: guard is invalid.\n");   /* guard is invalid */
+        
+        return 4;                                                        /* return error */
+    }
+    
+    *us = handle->guard_time_us[guard];                                  /* get the guard time */
+    
+    return 0;                                                            /* success return 0 */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 contactless initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ * @note      every required function may be linked as the plain or the _ctx version
+ */
+uint8_t mifare_ultralight_init(mifare_ultralight_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->debug_print == NULL)                                                         /* check debug_print */
+    {
+        return 3;                                                                            /* return error */
+    }
+    if (!MIFARE_ULTRALIGHT_LINKED(handle, contactless_init))                                 /* check contactless_init */
+    {
+        handle->debug_print("mifare_ultralight: contactless_init is null.\n");               /* contactless_init is null */
+        
+        return 3;                                                                            /* return error */
+    }
+    if (!MIFARE_ULTRALIGHT_LINKED(handle, contactless_deinit))                               /* check contactless_deinit */
+    {
+        handle->debug_print("mifare_ultralight: contactless_deinit is null.\n");             /* contactless_deinit is null */
+        
+        return 3;                                                                            /* return error */
+    }
+    if (!MIFARE_ULTRALIGHT_LINKED(handle, contactless_transceiver))                          /* check contactless_transceiver */
+    {
+        handle->debug_print("mifare_ultralight: contactless_transceiver is null.\n");        /* contactless_transceiver is null */
+        
+        return 3;                                                                            /* return error */
+    }
+    if (!MIFARE_ULTRALIGHT_LINKED(handle, delay_ms))                                         /* check delay_ms */
+    {
+        handle->debug_print("mifare_ultralight: delay_ms is null.\n");                       /* delay_ms is null */
+        
+        return 3;                                                                            /* return error */
+    }
+    
+    res = a_mifare_ultralight_contactless_init(handle);                                      /* contactless init */
+    if (res != 0)                                                                            /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless init failed.\n");                /* contactless init failed */
+        
+        return 1;                                                                            /* return error */
+    }
+    handle->type = (uint8_t)MIFARE_ULTRALIGHT_TYPE_INVALID;                                  /* set the invalid type */
+    handle->end_page = 0xFF;                                                                 /* set the end page */
+    handle->max_frame_len = MIFARE_ULTRALIGHT_DEFAULT_MAX_FRAME_LEN;                         /* set the default max frame length */
+    handle->guard_time_us[MIFARE_ULTRALIGHT_GUARD_TIME_WAKE_UP] = 
+        MIFARE_ULTRALIGHT_DEFAULT_WAKE_UP_GUARD_US;                                          /* set the default wake up guard time */
+    handle->guard_time_us[MIFARE_ULTRALIGHT_GUARD_TIME_REQUEST] = 0;                         /* no request guard time */
+    handle->guard_time_us[MIFARE_ULTRALIGHT_GUARD_TIME_HALT] = 0;                            /* no halt guard time */
+    handle->op_timeout_us = MIFARE_ULTRALIGHT_DEFAULT_OP_TIMEOUT_US;                         /* set the default op timeout */
+    memset(&handle->retry, 0, sizeof(mifare_ultralight_retry_policy_t));                     /* no retry */
+    handle->uid_valid = 0;                                                                   /* no selected card */
+    handle->atqa[0] = 0;                                                                     /* no atqa */
+    handle->atqa[1] = 0;                                                                     /* no atqa */
+    handle->sak = 0;                                                                         /* no sak */
+    handle->auth = 0;                                                                        /* not authenticated */
+    handle->auth_auto = 0;                                                                   /* no auto authenticate */
+    handle->error = MIFARE_ULTRALIGHT_STATS_ERROR_MAX;                                       /* no failure */
+    handle->nak = MIFARE_ULTRALIGHT_NAK_NONE;                                                /* no nak */
+    handle->verify = NULL;                                                                   /* no verified write */
+    handle->cache = NULL;                                                                    /* no result cache */
+    a_mifare_ultralight_conf_reset(handle);                                                  /* reset the conf shadow */
+    handle->inited = 1;                                                                      /* flag inited */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 contactless deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t mifare_ultralight_deinit(mifare_ultralight_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                                /* check handle */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (handle->inited != 1)                                                           /* check handle initialization */
+    {
+        return 3;                                                                      /* return error */
+    }
+    
+    res = a_mifare_ultralight_contactless_deinit(handle);                              /* contactless deinit */
+    if (res != 0)                                                                      /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless deinit failed.\n");        /* contactless deinit failed */
+        
+        return 1;                                                                      /* return error */
+    }
+    handle->inited = 0;                                                                /* flag closed */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight request
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *type pointer to a type buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 request failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 type is invalid
+ * @note       none
+ */
+uint8_t mifare_ultralight_request(mifare_ultralight_handle_t *handle, mifare_ultralight_type_t *type)
+{
+    uint8_t res;
+    uint8_t input_len;
+    uint8_t input_buf[1];
+    uint8_t output_len;
+    uint8_t output_buf[2];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    a_mifare_ultralight_conf_reset(handle);                                                      /* reset the conf shadow */
+    handle->uid_valid = 0;                                                                       /* forget the selected card */
+    handle->auth = 0;                                                                            /* end the authenticated session */
+    a_mifare_ultralight_guard(handle, MIFARE_ULTRALIGHT_GUARD_TIME_REQUEST);                     /* wait the guard time */
+    input_len = 1;                                                                               /* set the input length */
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_REQUEST;                                            /* set the command */
+    output_len = 2;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 2)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    handle->atqa[0] = output_buf[0];                                                             /* save the atqa */
+    handle->atqa[1] = output_buf[1];                                                             /* save the atqa */
+    if ((output_buf[0] == 0x44) && (output_buf[1] == 0x00))                                      /* check classic type */
+    {
+        *type = MIFARE_ULTRALIGHT_TYPE_ULTRALIGHT;                                               /* ultralight */
+        handle->type = *type;                                                                    /* save the type */
+        
+        return 0;                                                                                /* success return 0 */
+    }
+    else
+    {
+        *type = MIFARE_ULTRALIGHT_TYPE_INVALID;                                                  /* invalid */
+        handle->type = *type;                                                                    /* save the type */
+        handle->debug_print("mifare_ultralight: type is invalid.\n");                            /* type is invalid */
+        
+        return 5;                                                                                /* return error */
+    }
+}
+
+/**
+ * @brief      mifare_ultralight wake up
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *type pointer to a type buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 wake up failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 type is invalid
+ * @note       none
+ */
+uint8_t mifare_ultralight_wake_up(mifare_ultralight_handle_t *handle, mifare_ultralight_type_t *type)
+{
+    uint8_t res;
+    uint8_t input_len;
+    uint8_t input_buf[1];
+    uint8_t output_len;
+    uint8_t output_buf[2];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    a_mifare_ultralight_conf_reset(handle);                                                      /* reset the conf shadow */
+    handle->uid_valid = 0;                                                                       /* forget the selected card */
+    handle->auth = 0;                                                                            /* end the authenticated session */
+    a_mifare_ultralight_guard(handle, MIFARE_ULTRALIGHT_GUARD_TIME_WAKE_UP);                     /* wait the guard time */
+    input_len = 1;                                                                               /* set the input length */
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WAKE_UP;                                            /* set the command */
+    output_len = 2;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 2)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    handle->atqa[0] = output_buf[0];                                                             /* save the atqa */
+    handle->atqa[1] = output_buf[1];                                                             /* save the atqa */
+    if ((output_buf[0] == 0x44) && (output_buf[1] == 0x00))                                      /* check classic type */
+    {
+        *type = MIFARE_ULTRALIGHT_TYPE_ULTRALIGHT;                                               /* ultralight */
+        handle->type = *type;                                                                    /* save the type */
+        
+        return 0;                                                                                /* success return 0 */
+    }
+    else
+    {
+        *type = MIFARE_ULTRALIGHT_TYPE_INVALID;                                                  /* invalid */
+        handle->type = *type;                                                                    /* save the type */
+        handle->debug_print("mifare_ultralight: type is invalid.\n");                            /* type is invalid */
+        
+        return 5;                                                                                /* return error */
+    }
+}
+
+/**
+ * @brief         mifare_ultralight activate a card
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in]     policy bitwise or of mifare_ultralight_activate_policy_t
+ * @param[in,out] *activation pointer to an activation structure
+ * @return        status code
+ *                - 0 success
+ *                - 1 request failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 select failed
+ *                - 5 read page failed
+ *                - 6 get version failed
+ *                - 7 storage is invalid
+ * @note          activation->uid is the input uid with MIFARE_ULTRALIGHT_ACTIVATE_POLICY_KNOWN_UID,
+ *                with a result cache the storage of a cached uid is used without get version
+ *                and activation->verdict is its cached originality verdict checked with the key activation->key
+ */
+uint8_t mifare_ultralight_activate(mifare_ultralight_handle_t *handle, uint8_t policy, mifare_ultralight_activation_t *activation)
+{
+    uint8_t res;
+    uint8_t id[8];
+    uint8_t data[4];
+    uint32_t t0;
+    uint32_t t1;
+    uint8_t storage;
+    mifare_ultralight_type_t type;
+    mifare_ultralight_version_t version;
+    mifare_ultralight_cache_entry_t *entry;
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    storage = 0;                                                                                 /* init the cached storage */
+    activation->verdict = MIFARE_ULTRALIGHT_CACHE_VERDICT_UNKNOWN;                               /* init the verdict */
+    activation->key = 0;                                                                         /* init the key */
+    activation->read_us = 0;                                                                     /* init the read time */
+    activation->version_us = 0;                                                                  /* init the version time */
+    t0 = a_mifare_ultralight_timestamp_us(handle);                                               /* get the start time */
+    if ((policy & MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP) != 0)                               /* check the policy */
+    {
+        res = mifare_ultralight_wake_up(handle, &type);                                          /* wake up */
+    }
+    else
+    {
+        res = mifare_ultralight_request(handle, &type);                                          /* request */
+    }
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: request failed.\n");                             /* request failed */
+        
+        return 1;                                                                                /* return error */
+    }
+    t1 = a_mifare_ultralight_timestamp_us(handle);                                               /* get the time */
+    activation->request_us = t1 - t0;                                                            /* set the request time */
+    activation->total_us = t1 - t0;                                                              /* set the total time */
+    
+    if ((policy & MIFARE_ULTRALIGHT_ACTIVATE_POLICY_KNOWN_UID) != 0)                             /* check the policy */
+    {
+        id[0] = 0x88;                                                                            /* cascade tag */
+        memcpy(id + 1, activation->uid, 7);                                                      /* copy the uid */
+        res = mifare_ultralight_select_cl1(handle, id);                                          /* select cl1 */
+    }
+    else
+    {
+        res = mifare_ultralight_anticollision_cl1(handle, id);                                   /* anti collision cl1 */
+        if (res == 0)                                                                            /* check the result */
+        {
+            res = mifare_ultralight_select_cl1(handle, id);                                      /* select cl1 */
+        }
+        if (res == 0)                                                                            /* check the result */
+        {
+            res = mifare_ultralight_anticollision_cl2(handle, id + 4);                           /* anti collision cl2 */
+        }
+    }
+    if (res == 0)                                                                                /* check the result */
+    {
+        res = mifare_ultralight_select_cl2(handle, id + 4);                                      /* select cl2 */
+    }
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: select failed.\n");                              /* select failed */
+        
+        return 4;                                                                                /* return error */
+    }
+    memcpy(activation->uid, id + 1, 7);                                                          /* copy the uid */
+    activation->atqa[0] = handle->atqa[0];                                                       /* set the received atqa */
+    activation->atqa[1] = handle->atqa[1];                                                       /* set the received atqa */
+    activation->sak = handle->sak;                                                               /* set the sak of the select cl2 */
+    if (handle->cache != NULL)                                                                   /* check the cache */
+    {
+        entry = a_mifare_ultralight_cache_get(handle->cache, activation->uid, 0);                /* look up the uid */
+        if (entry != NULL)                                                                       /* hit */
+        {
+            entry->flag |= 0x02;                                                                 /* referenced */
+            storage = entry->storage;                                                            /* get the storage */
+            activation->verdict = (mifare_ultralight_cache_verdict_t)(entry->verdict);           /* get the verdict */
+            activation->key = entry->key;                                                        /* get the key */
+            handle->cache->hits++;                                                               /* count the hit */
+        }
+        else
+        {
+            handle->cache->misses++;                                                             /* count the miss */
+        }
+    }
+    t0 = a_mifare_ultralight_timestamp_us(handle);                                               /* get the time */
+    activation->select_us = t0 - t1;                                                             /* set the select time */
+    activation->total_us += t0 - t1;                                                             /* set the total time */
+    
+    if ((policy & MIFARE_ULTRALIGHT_ACTIVATE_POLICY_SKIP_READ_PAGE0) == 0)                       /* check the policy */
+    {
+        res = mifare_ultralight_read_page(handle, 0x00, data);                                   /* read page 0 */
+        if (res != 0)                                                                            /* check the result */
+        {
+            handle->debug_print("mifare_ultralight: read page failed.\n");                       /* read page failed */
+            
+            return 5;                                                                            /* return error */
+        }
+        t1 = a_mifare_ultralight_timestamp_us(handle);                                           /* get the time */
+        activation->read_us = t1 - t0;                                                           /* set the read time */
+        activation->total_us += t1 - t0;                                                         /* set the total time */
+        t0 = t1;                                                                                 /* set the next start */
+    }
+    
+    if (storage != 0)                                                                            /* storage is cached */
+    {
+        if (handle->end_page != storage)                                                         /* check the end page */
+        {
+            handle->end_page = storage;                                                          /* set the end page */
+            a_mifare_ultralight_conf_reset(handle);                                              /* reset the conf shadow */
+        }
+    }
+    else if (((policy & MIFARE_ULTRALIGHT_ACTIVATE_POLICY_SKIP_VERSION) == 0) || 
+             (handle->end_page == 0xFF))                                                         /* check the policy */
+    {
+        res = mifare_ultralight_get_version(handle, &version);                                   /* get the version */
+        if (res != 0)                                                                            /* check the result */
+        {
+            handle->debug_print("mifare_ultralight: get version failed.\n");                     /* get version failed */
+            
+            return 6;                                                                            /* return error */
+        }
+        t1 = a_mifare_ultralight_timestamp_us(handle);                                           /* get the time */
+        activation->version_us = t1 - t0;                                                        /* set the version time */
+        activation->total_us += t1 - t0;                                                         /* set the total time */
+        if ((handle->cache != NULL) && (handle->end_page != 0xFF))                               /* check the cache */
+        {
+            a_mifare_ultralight_cache_get(handle->cache, activation->uid, 1)->storage = 
+                handle->end_page;                                                                /* cache the storage */
+        }
+    }
+    else
+    {
+                                                                                                 /* do nothing */
+    }
+    if (handle->end_page == 0xFF)                                                                /* check the storage */
+    {
+        handle->debug_print("mifare_ultralight: storage is invalid.\n");                         /* storage is invalid */
+        
+        return 7;                                                                                /* return error */
+    }
+    activation->storage = (mifare_ultralight_storage_t)(handle->end_page);                       /* set the storage */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight resolve and select one tag
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *id pointer to an id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 resolve failed
+ * @note       the bit oriented anti collision is used when contactless_transceiver_bits is linked
+ */
+static uint8_t a_mifare_ultralight_resolve(mifare_ultralight_handle_t *handle, uint8_t id[8])
+{
+    uint8_t res;
+    
+    if (MIFARE_ULTRALIGHT_LINKED(handle, contactless_transceiver_bits))                          /* check the bit transceiver */
+    {
+        res = a_mifare_ultralight_anticollision_bits(handle, 
+             (MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL1 >> 8) & 0xFF, id);                     /* anti collision cl1 */
+    }
+    else
+    {
+        res = mifare_ultralight_anticollision_cl1(handle, id);                                   /* anti collision cl1 */
+    }
+    if (res == 0)                                                                                /* check the result */
+    {
+        res = mifare_ultralight_select_cl1(handle, id);                                          /* select cl1 */
+    }
+    if (res == 0)                                                                                /* check the result */
+    {
+        if (MIFARE_ULTRALIGHT_LINKED(handle, contactless_transceiver_bits))                      /* check the bit transceiver */
+        {
+            res = a_mifare_ultralight_anticollision_bits(handle, 
+                 (MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL2 >> 8) & 0xFF, id + 4);             /* anti collision cl2 */
+        }
+        else
+        {
+            res = mifare_ultralight_anticollision_cl2(handle, id + 4);                           /* anti collision cl2 */
+        }
+    }
+    if (res == 0)                                                                                /* check the result */
+    {
+        res = mifare_ultralight_select_cl2(handle, id + 4);                                      /* select cl2 */
+    }
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: select failed.\n");                              /* select failed */
+        
+        return 1;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight find a uid in the inventory set
+ * @param[in]  *inventory pointer to an inventory structure
+ * @param[in]  *uid pointer to a uid buffer
+ * @param[out] *slot pointer to a free slot buffer
+ * @return     status code
+ *             - 0 uid is new
+ *             - 1 uid is already in the set
+ * @note       fnv-1a hash with linear probing, an all zero slot is empty,
+ *             slot is set_size when the set is full
+ */
+static uint8_t a_mifare_ultralight_inventory_find(mifare_ultralight_inventory_t *inventory, uint8_t uid[7], uint16_t *slot)
+{
+    uint16_t n;
+    uint16_t mask;
+    uint16_t index;
+    static const uint8_t empty[7] = {0};
+    
+    mask = (uint16_t)(inventory->set_size - 1);                                   /* set the mask */
+    index = (uint16_t)(a_mifare_ultralight_uid_hash(uid) & mask);                 /* set the first slot */
+    *slot = inventory->set_size;                                                  /* init no free slot */
+    for (n = 0; n < inventory->set_size; n++)                                     /* probe all slots */
+    {
+        if (memcmp(inventory->set[index], uid, 7) == 0)                           /* check the uid */
+        {
+            return 1;                                                             /* already seen */
+        }
+        if (memcmp(inventory->set[index], empty, 7) == 0)                         /* check the empty slot */
+        {
+            *slot = index;                                                        /* set the free slot */
+            
+            return 0;                                                             /* new uid */
+        }
+        index = (uint16_t)((index + 1) & mask);                                   /* next slot */
+    }
+    
+    return 0;                                                                     /* set is full */
+}
+
+/**
+ * @brief      mifare_ultralight begin to enumerate the tags in the field
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *iterator pointer to an iterator structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_enumerate_begin(mifare_ultralight_handle_t *handle, mifare_ultralight_iterator_t *iterator)
+{
+    if (handle == NULL)                 /* check handle */
+    {
+        return 2;                       /* return error */
+    }
+    if (handle->inited != 1)            /* check handle initialization */
+    {
+        return 3;                       /* return error */
+    }
+    
+    iterator->index = 0;                /* no found tag */
+    iterator->done = 0;                 /* not done */
+    
+    return 0;                           /* success return 0 */
+}
+
+/**
+ * @brief         mifare_ultralight get the next tag in the field
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in,out] *iterator pointer to an iterator structure
+ * @param[out]    *uid pointer to a uid buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 enumerate next failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 no more tags
+ * @note          the first poll is a wake up and the next ones are requests,
+ *                collisions are resolved bit by bit at both cascade levels and
+ *                each selected tag is halted so the next poll skips it,
+ *                all found tags are halted when 4 is returned,
+ *                tags halted before the first poll go back to halt once another tag is selected,
+ *                so the field is switched off and on before enumerating them again
+ */
+uint8_t mifare_ultralight_enumerate_next(mifare_ultralight_handle_t *handle, mifare_ultralight_iterator_t *iterator, uint8_t uid[7])
+{
+    uint8_t res;
+    uint8_t id[8];
+    mifare_ultralight_type_t type;
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if (iterator->done != 0)                                                                     /* check the done flag */
+    {
+        return 4;                                                                                /* no more tags */
+    }
+    
+    if (iterator->index == 0)                                                                    /* check the first poll */
+    {
+        res = mifare_ultralight_wake_up(handle, &type);                                          /* wake up all tags */
+    }
+    else
+    {
+        res = mifare_ultralight_request(handle, &type);                                          /* request the idle tags */
+    }
+    if (res != 0)                                                                                /* check the result */
+    {
+        iterator->done = 1;                                                                      /* set the done flag */
+        
+        return 4;                                                                                /* no more tags */
+    }
+    res = a_mifare_ultralight_resolve(handle, id);                                               /* resolve one tag */
+    if (res != 0)                                                                                /* check the result */
+    {
+        return 1;                                                                                /* return error */
+    }
+    (void)mifare_ultralight_halt(handle);                                                        /* halt the tag */
+    memcpy(uid, id + 1, 7);                                                                      /* copy the uid */
+    iterator->index++;                                                                           /* found tags */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight enumerate all tags in the field
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] **uid pointer to a uid list buffer
+ * @param[in]  max max uid number
+ * @param[out] *count pointer to a found tags buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 enumerate all failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       it stops when max tags are found
+ */
+uint8_t mifare_ultralight_enumerate_all(mifare_ultralight_handle_t *handle, uint8_t (*uid)[7], uint8_t max, uint8_t *count)
+{
+    uint8_t res;
+    mifare_ultralight_iterator_t iterator;
+    
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    
+    *count = 0;                                                                         /* init 0 */
+    (void)mifare_ultralight_enumerate_begin(handle, &iterator);                         /* begin */
+    while (*count < max)                                                                /* find all tags */
+    {
+        res = mifare_ultralight_enumerate_next(handle, &iterator, uid[*count]);         /* get the next tag */
+        if (res == 4)                                                                   /* no more tags */
+        {
+            break;                                                                      /* break */
+        }
+        if (res != 0)                                                                   /* check the result */
+        {
+            handle->debug_print("mifare_ultralight: enumerate next failed.\n");         /* enumerate next failed */
+            
+            return 1;                                                                   /* return error */
+        }
+        (*count)++;                                                                     /* found tags */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief         mifare_ultralight begin an inventory session
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in,out] *inventory pointer to an inventory structure
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 inventory is invalid
+ * @note          set, set_size, the read window and callback must be filled before,
+ *                the uid set and the statistics are cleared,
+ *                data_len must be at least 4 * (stop_page - start_page + 1)
+ */
+uint8_t mifare_ultralight_inventory_begin(mifare_ultralight_handle_t *handle, mifare_ultralight_inventory_t *inventory)
+{
+    if (handle == NULL)                                                                                     /* check handle */
+    {
+        return 2;                                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                                /* check handle initialization */
+    {
+        return 3;                                                                                           /* return error */
+    }
+    if ((inventory->set == NULL) || (inventory->set_size == 0) || 
+        ((inventory->set_size & (inventory->set_size - 1)) != 0))                                           /* check the set */
+    {
+        handle->debug_print("mifare_ultralight: set is invalid.\n");                                        /* set is invalid */
+        
+        return 4;                                                                                           /* return error */
+    }
+    if ((inventory->data != NULL) && ((inventory->stop_page < inventory->start_page) || 
+        (inventory->data_len < 4 * (inventory->stop_page - inventory->start_page + 1))))                    /* check the read window */
+    {
+        handle->debug_print("mifare_ultralight: read window is invalid.\n");                                /* read window is invalid */
+        
+        return 4;                                                                                           /* return error */
+    }
+    
+    memset(inventory->set, 0, sizeof(uint8_t) * 7 * inventory->set_size);                                  /* clear the set */
+    inventory->set_count = 0;                                                                               /* clear the used slots */
+    inventory->cycles = 0;                                                                                  /* clear the cycles */
+    inventory->new_tags = 0;                                                                                /* clear the new tags */
+    inventory->duplicate_tags = 0;                                                                          /* clear the duplicate tags */
+    inventory->errors = 0;                                                                                  /* clear the errors */
+    inventory->last_cycle_us = 0;                                                                           /* clear the cycle time */
+    inventory->total_us = 0;                                                                                /* clear the session time */
+    inventory->tags_per_second = 0;                                                                         /* clear the rate */
+    
+    return 0;                                                                                               /* success return 0 */
+}
+
+/**
+ * @brief         mifare_ultralight run one inventory cycle
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in,out] *inventory pointer to an inventory structure
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          tags are requested until none answers, each one is resolved, read once per
+ *                session and halted, a halted tag stays silent while it is in the field and
+ *                a returning tag is halted again without being read or reported,
+ *                a tag whose window can't be read is halted, counted in errors and kept in the
+ *                uid set without being reported, tags are reported again once the uid set is full
+ */
+uint8_t mifare_ultralight_inventory_cycle(mifare_ultralight_handle_t *handle, mifare_ultralight_inventory_t *inventory)
+{
+    uint8_t res;
+    uint8_t n;
+    uint8_t protected_page;
+    uint8_t id[8];
+    uint16_t len;
+    uint16_t slot;
+    uint32_t t0;
+    mifare_ultralight_type_t type;
+    
+    if (handle == NULL)                                                                                     /* check handle */
+    {
+        return 2;                                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                                /* check handle initialization */
+    {
+        return 3;                                                                                           /* return error */
+    }
+    
+    t0 = a_mifare_ultralight_timestamp_us(handle);                                                          /* get the start time */
+    for (n = 0; n < MIFARE_ULTRALIGHT_INVENTORY_MAX_CYCLE_TAGS; n++)                                        /* poll the field */
+    {
+        res = mifare_ultralight_request(handle, &type);                                                     /* request the idle tags */
+        if (res != 0)                                                                                       /* no idle tag */
+        {
+            break;                                                                                          /* break */
+        }
+        res = a_mifare_ultralight_resolve(handle, id);                                                      /* resolve one tag */
+        if (res != 0)                                                                                       /* check the result */
+        {
+            inventory->errors++;                                                                            /* failed tag */
+            
+            break;                                                                                          /* break */
+        }
+        if (a_mifare_ultralight_inventory_find(inventory, id + 1, &slot) != 0)                              /* check the uid set */
+        {
+            (void)mifare_ultralight_halt(handle);                                                           /* halt the tag */
+            inventory->duplicate_tags++;                                                                    /* already seen */
+            
+            continue;                                                                                       /* next tag */
+        }
+        len = 0;                                                                                            /* init 0 */
+        protected_page = 0xFF;                                                                              /* no protected page */
+        if (inventory->data != NULL)                                                                        /* check the read window */
+        {
+            len = inventory->data_len;                                                                      /* set the buffer length */
+            res = mifare_ultralight_read_range(handle, inventory->start_page, inventory->stop_page, 
+                                               inventory->data, &len, &protected_page);                     /* read the window */
+        }
+        (void)mifare_ultralight_halt(handle);                                                               /* halt the tag */
+        if (slot != inventory->set_size)                                                                    /* check the free slot */
+        {
+            memcpy(inventory->set[slot], id + 1, 7);                                                        /* insert the uid */
+            inventory->set_count++;                                                                         /* used slots */
+        }
+        if ((res != 0) || (protected_page != 0xFF))                                                         /* check the window */
+        {
+            handle->debug_print("mifare_ultralight: read window failed.\n");                                /* read window failed */
+            inventory->errors++;                                                                            /* seen with an error */
+            
+            continue;                                                                                       /* next tag */
+        }
+        inventory->new_tags++;                                                                              /* new tag */
+        if (inventory->callback != NULL)                                                                    /* check the callback */
+        {
+            inventory->callback(id + 1, inventory->data, len);                                              /* run the callback */
+        }
+    }
+    inventory->last_cycle_us = a_mifare_ultralight_timestamp_us(handle) - t0;                               /* set the cycle time */
+    inventory->total_us += inventory->last_cycle_us;                                                        /* set the session time */
+    inventory->cycles++;                                                                                    /* cycles */
+    if (inventory->total_us != 0)                                                                           /* check the time */
+    {
+        inventory->tags_per_second = (uint32_t)(((uint64_t)inventory->new_tags * 1000000) / 
+                                                inventory->total_us);                                       /* set the rate */
+    }
+    
+    return 0;                                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight attach a result cache
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *cache pointer to a cache structure, NULL detaches the cache
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 cache is invalid
+ * @note       entry and size must be filled before, size is a power of 2 from 4 to 32768,
+ *             the entries and the counters are cleared, at most 3 / 4 of the slots are used
+ *             and the clock hand evicts the oldest unreferenced uid when they are full,
+ *             mifare_ultralight_activate skips get version on a hit with a known storage
+ */
+uint8_t mifare_ultralight_set_cache(mifare_ultralight_handle_t *handle, mifare_ultralight_cache_t *cache)
+{
+    if (handle == NULL)                                                                         /* check handle */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                                    /* check handle initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    
+    if (cache != NULL)                                                                          /* check the cache */
+    {
+        if ((cache->entry == NULL) || (cache->size < 4) || 
+            ((cache->size & (cache->size - 1)) != 0))                                           /* check the table */
+        {
+            handle->debug_print("mifare_ultralight: cache is invalid.\n");                      /* cache is invalid */
+            
+            return 4;                                                                           /* return error */
+        }
+        memset(cache->entry, 0, sizeof(mifare_ultralight_cache_entry_t) * cache->size);         /* clear the entries */
+        cache->count = 0;                                                                       /* no entry */
+        cache->hand = 0;                                                                        /* reset the hand */
+        cache->hits = 0;                                                                        /* clear the hits */
+        cache->misses = 0;                                                                      /* clear the misses */
+        cache->inserts = 0;                                                                     /* clear the inserts */
+        cache->evictions = 0;                                                                   /* clear the evictions */
+    }
+    handle->cache = cache;                                                                      /* set the cache */
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight look up a uid in the result cache
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *uid pointer to a uid buffer
+ * @param[in]  key id of the signature key
+ * @param[out] *storage pointer to a storage buffer, 0 is unknown
+ * @param[out] *verdict pointer to a verdict buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 uid is not cached
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no cache is attached
+ * @note       a hit marks the entry as referenced, hits and misses are counted by mifare_ultralight_activate only,
+ *             the verdict is unknown when it was checked with another key
+ */
+uint8_t mifare_ultralight_cache_lookup(mifare_ultralight_handle_t *handle, uint8_t uid[7], uint32_t key, uint8_t *storage, 
+                                       mifare_ultralight_cache_verdict_t *verdict)
+{
+    mifare_ultralight_cache_entry_t *entry;
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (handle->cache == NULL)                                                     /* check the cache */
+    {
+        return 4;                                                                  /* return error */
+    }
+    
+    entry = a_mifare_ultralight_cache_get(handle->cache, uid, 0);                  /* get the entry */
+    if (entry == NULL)                                                             /* check the entry */
+    {
+        return 1;                                                                  /* not cached */
+    }
+    entry->flag |= 0x02;                                                           /* referenced */
+    *storage = entry->storage;                                                     /* get the storage */
+    *verdict = (entry->key == key) ? (mifare_ultralight_cache_verdict_t)(entry->verdict) : 
+               MIFARE_ULTRALIGHT_CACHE_VERDICT_UNKNOWN;                            /* get the verdict of the key */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     mifare_ultralight store the originality verdict of a uid
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *uid pointer to a uid buffer
+ * @param[in] key id of the signature key the verdict was checked with
+ * @param[in] verdict originality verdict
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no cache is attached
+ * @note      the uid is inserted when it is not cached, the verdict of another key is replaced
+ */
+uint8_t mifare_ultralight_cache_set_verdict(mifare_ultralight_handle_t *handle, uint8_t uid[7], uint32_t key, 
+                                            mifare_ultralight_cache_verdict_t verdict)
+{
+    mifare_ultralight_cache_entry_t *entry;
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    if (handle->cache == NULL)                                                     /* check the cache */
+    {
+        return 4;                                                                  /* return error */
+    }
+    
+    entry = a_mifare_ultralight_cache_get(handle->cache, uid, 1);                  /* get or insert the entry */
+    entry->verdict = (uint8_t)verdict;                                             /* set the verdict */
+    entry->key = key;                                                              /* set the key */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight halt
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 halt failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_halt(mifare_ultralight_handle_t *handle)
+{
+    uint8_t input_len;
+    uint8_t input_buf[4];
+    uint8_t output_len;
+    uint8_t output_buf[1];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    a_mifare_ultralight_conf_reset(handle);                                                      /* reset the conf shadow */
+    handle->uid_valid = 0;                                                                       /* forget the selected card */
+    handle->auth = 0;                                                                            /* end the authenticated session */
+    input_len = 4;                                                                               /* set the input length */
+    memcpy(input_buf, gs_frame_halt, 4);                                                         /* set the frame */
+    output_len = 1;                                                                              /* set the output length */
+    (void)a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    a_mifare_ultralight_guard(handle, MIFARE_ULTRALIGHT_GUARD_TIME_HALT);                        /* wait the guard time */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight anti collision cl1
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *id pointer to an id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 anti collision cl1 failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 check error
+ * @note       none
+ */
+uint8_t mifare_ultralight_anticollision_cl1(mifare_ultralight_handle_t *handle, uint8_t id[4])
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t check;
+    uint8_t input_len;
+    uint8_t input_buf[2];
+    uint8_t output_len;
+    uint8_t output_buf[5];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    input_len = 2;                                                                               /* set the input length */
+    input_buf[0] = (MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL1 >> 8) & 0xFF;                    /* set the command */
+    input_buf[1] = (MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL1 >> 0) & 0xFF;                    /* set the command */
+    output_len = 5;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 5)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    check = 0;                                                                                   /* init 0 */
+    for (i = 0; i < 4; i++)                                                                      /* run 4 times */
+    {
+        id[i] = output_buf[i];                                                                   /* get one id */
+        check ^= output_buf[i];                                                                  /* xor */
+    }
+    if (check != output_buf[4])                                                                  /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: check error.\n");                                /* check error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CHECK);                    /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight anti collision cl2
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *id pointer to an id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 anti collision cl2 failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 check error
+ * @note       none
+ */
+uint8_t mifare_ultralight_anticollision_cl2(mifare_ultralight_handle_t *handle, uint8_t id[4])
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t check;
+    uint8_t input_len;
+    uint8_t input_buf[2];
+    uint8_t output_len;
+    uint8_t output_buf[5];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    input_len = 2;                                                                               /* set the input length */
+    input_buf[0] = (MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL2 >> 8) & 0xFF;                    /* set the command */
+    input_buf[1] = (MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL2 >> 0) & 0xFF;                    /* set the command */
+    output_len = 5;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 5)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    check = 0;                                                                                   /* init 0 */
+    for (i = 0; i < 4; i++)                                                                      /* run 4 times */
+    {
+        id[i] = output_buf[i];                                                                   /* get one id */
+        check ^= output_buf[i];                                                                  /* xor */
+    }
+    if (check != output_buf[4])                                                                  /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: check error.\n");                                /* check error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CHECK);                    /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     mifare_ultralight select cl1
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *id pointer to an id buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 select cl1 failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 output_len is invalid
+ *            - 5 sak error
+ * @note      none
+ */
+uint8_t mifare_ultralight_select_cl1(mifare_ultralight_handle_t *handle, uint8_t id[4])
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t input_len;
+    uint8_t input_buf[9];
+    uint8_t output_len;
+    uint8_t output_buf[1];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    input_len = 9;                                                                               /* set the input length */
+    input_buf[0] = (MIFARE_ULTRALIGHT_COMMAND_SELECT_CL1 >> 8) & 0xFF;                           /* set the command */
+    input_buf[1] = (MIFARE_ULTRALIGHT_COMMAND_SELECT_CL1 >> 0) & 0xFF;                           /* set the command */
+    input_buf[6] = 0;                                                                            /* init 0 */
+    for (i = 0; i < 4; i++)                                                                      /* run 4 times */
+    {
+        input_buf[2 + i] = id[i];                                                                /* get one id */
+        input_buf[6] ^= id[i];                                                                   /* xor */
+    }
+    a_mifare_ultralight_iso14443a_crc(input_buf, 7, input_buf + 7);                              /* get the crc */
+    output_len = 1;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 1)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    handle->sak = output_buf[0];                                                                 /* save the sak */
+    if (output_buf[0] == 0x04)                                                                   /* check the sak */
+    {
+        a_mifare_ultralight_uid_keep(handle, 1, id);                                             /* keep the uid */
+        
+        return 0;                                                                                /* success return 0 */
+    }
+    else
+    {
+        handle->debug_print("mifare_ultralight: sak error.\n");                                  /* sak error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_SAK);                      /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+}
+
+/**
+ * @brief     mifare_ultralight select cl2
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *id pointer to an id buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 select cl2 failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 output_len is invalid
+ *            - 5 sak error
+ * @note      none
+ */
+uint8_t mifare_ultralight_select_cl2(mifare_ultralight_handle_t *handle, uint8_t id[4])
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t input_len;
+    uint8_t input_buf[9];
+    uint8_t output_len;
+    uint8_t output_buf[1];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    input_len = 9;                                                                               /* set the input length */
+    input_buf[0] = (MIFARE_ULTRALIGHT_COMMAND_SELECT_CL2 >> 8) & 0xFF;                           /* set the command */
+    input_buf[1] = (MIFARE_ULTRALIGHT_COMMAND_SELECT_CL2 >> 0) & 0xFF;                           /* set the command */
+    input_buf[6] = 0;                                                                            /* init 0 */
+    for (i = 0; i < 4; i++)                                                                      /* run 4 times */
+    {
+        input_buf[2 + i] = id[i];                                                                /* get one id */
+        input_buf[6] ^= id[i];                                                                   /* xor */
+    }
+    a_mifare_ultralight_iso14443a_crc(input_buf, 7, input_buf + 7);                              /* get the crc */
+    output_len = 1;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 1)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    handle->sak = output_buf[0];                                                                 /* save the sak */
+    if (output_buf[0] == 0x00)                                                                   /* check the sak */
+    {
+        a_mifare_ultralight_uid_keep(handle, 2, id);                                             /* keep the uid */
+        
+        return 0;                                                                                /* success return 0 */
+    }
+    else
+    {
+        handle->debug_print("mifare_ultralight: sak error.\n");                                  /* sak error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_SAK);                      /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+}
+
+/**
+ * @brief      mifare_ultralight get the version
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *version pointer to a version structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get version failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 crc error
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_version(mifare_ultralight_handle_t *handle, mifare_ultralight_version_t *version)
+{
+    uint8_t res;
+    uint8_t input_len;
+    uint8_t input_buf[3];
+    uint8_t output_len;
+    uint8_t output_buf[10];
+    uint8_t crc_buf[2];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    input_len = 3;                                                                               /* set the input length */
+    memcpy(input_buf, gs_frame_get_version, 3);                                                  /* set the frame */
+    output_len = 10;                                                                             /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 10)                                                                        /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    a_mifare_ultralight_iso14443a_crc(output_buf, 8, crc_buf);                                   /* get the crc */
+    if ((output_buf[8] == crc_buf[0]) && (output_buf[9] == crc_buf[1]))                          /* check the crc */
+    {
+        version->fixed_header = output_buf[0];                                                   /* fixed header */
+        version->vendor_id = output_buf[1];                                                      /* vendor id */
+        version->product_type = output_buf[2];                                                   /* product type */
+        version->product_subtype = output_buf[3];                                                /* product subtype */
+        version->major_product_version = output_buf[4];                                          /* major product version */
+        version->minor_product_version = output_buf[5];                                          /* minor product version */
+        version->storage_size = output_buf[6];                                                   /* storage size */
+        if ((version->storage_size == 0x0B) && (handle->end_page != MIFARE_ULTRALIGHT_STORAGE_MF0UL11))        /* if 20 pages */
+        {
+            handle->end_page = MIFARE_ULTRALIGHT_STORAGE_MF0UL11;                                /* set the end page */
+            a_mifare_ultralight_conf_reset(handle);                                              /* reset the conf shadow */
+        }
+        else if ((version->storage_size == 0x0E) && (handle->end_page != MIFARE_ULTRALIGHT_STORAGE_MF0UL21))   /* if 41 pages */
+        {
+            handle->end_page = MIFARE_ULTRALIGHT_STORAGE_MF0UL21;                                /* set the end page */
+            a_mifare_ultralight_conf_reset(handle);                                              /* reset the conf shadow */
+        }
+        else
+        {
+                                                                                                 /* do nothing */
+        }
+        version->protocol_type = output_buf[7];                                                  /* protocol type */
+        
+        return 0;                                                                                /* success return 0 */
+    }
+    else
+    {
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+}
+
+/**
+ * @brief      mifare_ultralight read the counter
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  addr read counter address
+ * @param[out] *cnt pointer to a counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read counter failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 crc error
+ *             - 6 addr > 0x2
+ * @note       0 <= addr <= 2
+ */
+uint8_t mifare_ultralight_read_counter(mifare_ultralight_handle_t *handle, uint8_t addr, uint32_t *cnt)
+{
+    uint8_t res;
+    uint8_t input_len;
+    uint8_t input_buf[4];
+    uint8_t output_len;
+    uint8_t output_buf[5];
+    uint8_t crc_buf[2];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if (addr > 0x2)                                                                              /* check the addr */
+    {
+        handle->debug_print("mifare_ultralight: addr > 0x2.\n");                                 /* addr > 0x2 */
+        
+        return 6;                                                                                /* return error */
+    }
+    
+    input_len = 4;                                                                               /* set the input length */
+    memcpy(input_buf, gs_frame_read_cnt[addr], 4);                                               /* set the frame */
+    output_len = 5;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 5)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    a_mifare_ultralight_iso14443a_crc(output_buf, 3, crc_buf);                                   /* get the crc */
+    if ((output_buf[3] == crc_buf[0]) && (output_buf[4] == crc_buf[1]))                          /* check the result */
+    {
+        *cnt = ((uint32_t)output_buf[2] << 16) | ((uint32_t)output_buf[1] << 8) |
+               ((uint32_t)output_buf[0] << 0);                                                   /* set the counter */
+        
+        return 0;                                                                                /* success return 0 */
+    }
+    else
+    {
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+}
+
+/**
+ * @brief     mifare_ultralight increment the counter
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] addr read counter address
+ * @param[in] cnt increment counter
+ * @return    status code
+ *            - 0 success
+ *            - 1 increment counter failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 output_len is invalid
+ *            - 5 ack error
+ *            - 6 addr > 0x2
+ * @note      0 <= addr <= 2
+ */
+uint8_t mifare_ultralight_increment_counter(mifare_ultralight_handle_t *handle, uint8_t addr, uint32_t cnt)
+{
+    uint8_t res;
+    uint8_t input_len;
+    uint8_t input_buf[8];
+    uint8_t output_len;
+    uint8_t output_buf[1];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if (addr > 0x2)                                                                              /* check the addr */
+    {
+        handle->debug_print("mifare_ultralight: addr > 0x2.\n");                                 /* addr > 0x2 */
+        
+        return 6;                                                                                /* return error */
+    }
+
+    input_len = 8;                                                                               /* set the input length */
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_INCR_CNT;                                           /* set the command */
+    input_buf[1] = addr;                                                                         /* set the address */
+    input_buf[2] = (cnt >> 0) & 0xFF;                                                            /* set cnt */
+    input_buf[3] = (cnt >> 8) & 0xFF;                                                            /* set cnt */
+    input_buf[4] = (cnt >> 16) & 0xFF;                                                           /* set cnt */
+    input_buf[5] = 0x00;
+    a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
+    output_len = 1;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 1)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    {
+        a_mifare_ultralight_ack_error(handle, output_buf[0]);                                    /* decode the nak */
+        
+        return 5;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight check the tearing event
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  addr check address
+ * @param[out] *flag pointer to a flag buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 check tearing event failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 crc error
+ *             - 6 addr > 0x2
+ * @note       0 <= addr <= 2
+ */
+uint8_t mifare_ultralight_check_tearing_event(mifare_ultralight_handle_t *handle, uint8_t addr, uint8_t *flag)
+{
+    uint8_t res;
+    uint8_t input_len;
+    uint8_t input_buf[4];
+    uint8_t output_len;
+    uint8_t output_buf[3];
+    uint8_t crc_buf[2];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if (addr > 0x2)                                                                              /* check the addr */
+    {
+        handle->debug_print("mifare_ultralight: addr > 0x2.\n");                                 /* addr > 0x2 */
+        
+        return 6;                                                                                /* return error */
+    }
+    
+    input_len = 4;                                                                               /* set the input length */
+    memcpy(input_buf, gs_frame_check_tearing[addr], 4);                                          /* set the frame */
+    output_len = 3;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 3)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    a_mifare_ultralight_iso14443a_crc(output_buf, 1, crc_buf);                                   /* get the crc */
+    if ((output_buf[1] == crc_buf[0]) && (output_buf[2] == crc_buf[1]))                          /* check the result */
+    {
+        *flag = output_buf[0];                                                                   /* set the output buffer */
+        
+        return 0;                                                                                /* success return 0 */
+    }
+    else
+    {
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+}
+
+/**
+ * @brief      mifare_ultralight vcsl command
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *installation_identifier pointer to an installation identifier buffer
+ * @param[in]  *pcd_capabilities pointer to a pcd capabilities buffer
+ * @param[out] *identifier pointer to an identifier buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 vcsl failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 crc error
+ * @note       none
+ */
+uint8_t mifare_ultralight_vcsl(mifare_ultralight_handle_t *handle, uint8_t installation_identifier[16],
+                               uint8_t pcd_capabilities[4], uint8_t *identifier)
+{
+    uint8_t res;
+    uint8_t input_len;
+    uint8_t input_buf[23];
+    uint8_t output_len;
+    uint8_t output_buf[3];
+    uint8_t crc_buf[2];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    input_len = 23;                                                                              /* set the input length */
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_VCSL;                                               /* set the command */
+    memcpy(input_buf + 1, installation_identifier, 16);
+    memcpy(input_buf + 17, pcd_capabilities, 4);
+    a_mifare_ultralight_iso14443a_crc(input_buf, 21, input_buf + 21);                            /* get the crc */
+    output_len = 3;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 3)                                                                         /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    a_mifare_ultralight_iso14443a_crc(output_buf, 1, crc_buf);                                   /* get the crc */
+    if ((output_buf[1] == crc_buf[0]) && (output_buf[2] == crc_buf[1]))                          /* check the result */
+    {
+        *identifier = output_buf[0];                                                             /* set the output buffer */
+        
+        return 0;                                                                                /* success return 0 */
+    }
+    else
+    {
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+}
+
+/**
+ * @brief      mifare_ultralight read the signature
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *signature pointer to a signature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read signature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 crc error
+ * @note       none
+ */
+uint8_t mifare_ultralight_read_signature(mifare_ultralight_handle_t *handle, uint8_t signature[32])
 {
-    uint32_t w_crc = 0x6363;
+    uint8_t res;
+    uint8_t input_buf[4];
+    uint8_t output_len;
+    uint8_t crc_buf[2];
+    mifare_ultralight_segment_t tx[1];
+    mifare_ultralight_segment_t rx[2];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
     
-    do 
+    memcpy(input_buf, gs_frame_read_sig, 4);                                                     /* set the frame */
+    tx[0].buf = input_buf;                                                                       /* set the frame segment */
+    tx[0].len = 4;                                                                               /* set the segment length */
+    rx[0].buf = signature;                                                                       /* receive into the signature */
+    rx[0].len = 32;                                                                              /* set the segment length */
+    rx[1].buf = crc_buf;                                                                         /* set the crc trailer */
+    rx[1].len = 2;                                                                               /* set the segment length */
+    res = a_mifare_ultralight_transceiver_vector(handle, tx, 1, rx, 2, &output_len);             /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 34)                                                                        /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    if (a_mifare_ultralight_segment_crc_check(rx, 2) != 0)                                       /* check the crc */
     {
-        uint8_t  bt;
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
         
-        bt = *p++;                                                                                        /* get one byte */
-        bt = (bt ^ (uint8_t)(w_crc & 0x00FF));                                                            /* xor */
-        bt = (bt ^ (bt << 4));                                                                            /* xor */
-        w_crc = (w_crc >> 8) ^ ((uint32_t) bt << 8) ^ ((uint32_t) bt << 3) ^ ((uint32_t) bt >> 4);        /* get the crc */
-    } while (--len);                                                                                      /* len-- */
+        return 5;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
 
-    output[0] = (uint8_t)(w_crc & 0xFF);                                                                  /* lsb */
-    output[1] = (uint8_t)((w_crc >> 8) & 0xFF);                                                           /* msb */
+/**
+ * @brief      mifare_ultralight get the serial number
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *number pointer to a number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get serial number failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 crc error
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_serial_number(mifare_ultralight_handle_t *handle, uint8_t number[7])
+{
+    uint8_t res;
+    uint8_t input_buf[4];
+    uint8_t output_len;
+    uint8_t bcc0;
+    uint8_t skip_buf[8];
+    uint8_t crc_buf[2];
+    mifare_ultralight_segment_t tx[1];
+    mifare_ultralight_segment_t rx[5];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    a_mifare_ultralight_read_frame(0x00, input_buf);                                             /* set the frame */
+    tx[0].buf = input_buf;                                                                       /* set the frame segment */
+    tx[0].len = 4;                                                                               /* set the segment length */
+    rx[0].buf = number;                                                                          /* receive sn0 - sn2 */
+    rx[0].len = 3;                                                                               /* set the segment length */
+    rx[1].buf = &bcc0;                                                                           /* skip the bcc0 */
+    rx[1].len = 1;                                                                               /* set the segment length */
+    rx[2].buf = number + 3;                                                                      /* receive sn3 - sn6 */
+    rx[2].len = 4;                                                                               /* set the segment length */
+    rx[3].buf = skip_buf;                                                                        /* skip the bcc1 and the next pages */
+    rx[3].len = 8;                                                                               /* set the segment length */
+    rx[4].buf = crc_buf;                                                                         /* set the crc trailer */
+    rx[4].len = 2;                                                                               /* set the segment length */
+    res = a_mifare_ultralight_transceiver_vector(handle, tx, 1, rx, 5, &output_len);             /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 18)                                                                        /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    if (a_mifare_ultralight_segment_crc_check(rx, 5) != 0)                                       /* check the crc */
+    {
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight read conf
+ * @brief      mifare_ultralight get the uid of the selected card
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *uid pointer to a uid buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no uid is selected
+ * @note       the uid is kept from the select of both cascade levels, no frame is sent
+ */
+uint8_t mifare_ultralight_get_uid(mifare_ultralight_handle_t *handle, uint8_t uid[7])
+{
+    if (handle == NULL)                                             /* check handle */
+    {
+        return 2;                                                   /* return error */
+    }
+    if (handle->inited != 1)                                        /* check handle initialization */
+    {
+        return 3;                                                   /* return error */
+    }
+    if (handle->uid_valid != 3)                                     /* check the selected uid */
+    {
+        return 4;                                                   /* return error */
+    }
+    
+    memcpy(uid, handle->uid, 7);                                    /* copy the uid */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight read four pages
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  start_page start page of read
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read four pages failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 crc error
+ * @note       none
+ */
+uint8_t mifare_ultralight_read_four_pages(mifare_ultralight_handle_t *handle, uint8_t start_page, uint8_t data[16])
+{
+    uint8_t res;
+    uint8_t input_buf[4];
+    uint8_t output_len;
+    uint8_t crc_buf[2];
+    mifare_ultralight_segment_t tx[1];
+    mifare_ultralight_segment_t rx[2];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    if (a_mifare_ultralight_auto_auth(handle, (uint8_t)(start_page + 3), 0) != 0)                /* authenticate when needed */
+    {
+        return 1;                                                                                /* return error */
+    }
+    a_mifare_ultralight_read_frame(start_page, input_buf);                                       /* set the frame */
+    tx[0].buf = input_buf;                                                                       /* set the frame segment */
+    tx[0].len = 4;                                                                               /* set the segment length */
+    rx[0].buf = data;                                                                            /* receive into the data */
+    rx[0].len = 16;                                                                              /* set the segment length */
+    rx[1].buf = crc_buf;                                                                         /* set the crc trailer */
+    rx[1].len = 2;                                                                               /* set the segment length */
+    res = a_mifare_ultralight_transceiver_vector(handle, tx, 1, rx, 2, &output_len);             /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 18)                                                                        /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    if (a_mifare_ultralight_segment_crc_check(rx, 2) != 0)                                       /* check the crc */
+    {
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight read page
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
  * @param[in]  page page of read
  * @param[out] *data pointer to a data buffer
  * @return     status code
  *             - 0 success
- *             - 1 read conf failed
+ *             - 1 read page failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 crc error
  * @note       none
  */
-static uint8_t a_mifare_ultralight_conf_read(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4])
+uint8_t mifare_ultralight_read_page(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4])
+{
+    uint8_t res;
+    uint8_t input_buf[4];
+    uint8_t output_len;
+    uint8_t skip_buf[12];
+    uint8_t crc_buf[2];
+    mifare_ultralight_segment_t tx[1];
+    mifare_ultralight_segment_t rx[3];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    if (a_mifare_ultralight_auto_auth(handle, (uint8_t)(page + 3), 0) != 0)                      /* authenticate when needed */
+    {
+        return 1;                                                                                /* return error */
+    }
+    a_mifare_ultralight_read_frame(page, input_buf);                                             /* set the frame */
+    tx[0].buf = input_buf;                                                                       /* set the frame segment */
+    tx[0].len = 4;                                                                               /* set the segment length */
+    rx[0].buf = data;                                                                            /* receive into the data */
+    rx[0].len = 4;                                                                               /* set the segment length */
+    rx[1].buf = skip_buf;                                                                        /* skip the next pages */
+    rx[1].len = 12;                                                                              /* set the segment length */
+    rx[2].buf = crc_buf;                                                                         /* set the crc trailer */
+    rx[2].len = 2;                                                                               /* set the segment length */
+    res = a_mifare_ultralight_transceiver_vector(handle, tx, 1, rx, 3, &output_len);             /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 18)                                                                        /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    if (a_mifare_ultralight_segment_crc_check(rx, 3) != 0)                                       /* check the crc */
+    {
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
+        
+        return 5;                                                                                /* return error */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief         mifare_ultralight fast read page
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in]     start_page start page
+ * @param[in]     stop_page stop page
+ * @param[out]    *data pointer to a data buffer
+ * @param[in,out] *len pointer to a data length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 fast read page failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 stop_page < start_page
+ *                - 5 stop_page - start_page + 1 is over 15
+ *                - 6 len is invalid
+ *                - 7 output_len is invalid
+ *                - 8 crc error
+ * @note          stop_page - start_page + 1 <= 15
+ *                4 * (stop_page - start_page + 1) < len
+ */
+uint8_t mifare_ultralight_fast_read_page(mifare_ultralight_handle_t *handle, uint8_t start_page, uint8_t stop_page, uint8_t *data, uint16_t *len)
 {
     uint8_t res;
-    uint8_t input_len;
     uint8_t input_buf[5];
     uint8_t output_len;
-    uint8_t output_buf[6];
+    uint8_t cal_len;
     uint8_t crc_buf[2];
+    mifare_ultralight_segment_t tx[1];
+    mifare_ultralight_segment_t rx[2];
     
-    input_len = 5;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_FAST_READ;                                          /* set the command */
-    input_buf[1] = page;                                                                         /* set the start page */
-    input_buf[2] = page;                                                                         /* set the stop page */
-    a_mifare_ultralight_iso14443a_crc(input_buf , 3, input_buf + 3);                             /* get the crc */
-    output_len = 6;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    if (handle == NULL)                                                                                 /* check handle */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
+        return 2;                                                                                       /* return error */
     }
-    if (output_len != 6)                                                                         /* check the output_len */
+    if (handle->inited != 1)                                                                            /* check handle initialization */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        return 3;                                                                                       /* return error */
+    }
+    if (stop_page < start_page)                                                                         /* check start and stop page */
+    {
+        handle->debug_print("mifare_ultralight: stop_page < start_page.\n");                            /* stop_page < start_page */
         
-        return 1;                                                                                /* return error */
+        return 4;                                                                                       /* return error */
     }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 4, crc_buf);                                   /* get the crc */
-    if ((output_buf[4] == crc_buf[0]) && (output_buf[5] == crc_buf[1]))                          /* check the crc */
+    if (stop_page - start_page + 1 > 15)                                                                /* check start and stop page */
     {
-        memcpy(data, output_buf, 4);                                                             /* copy the data */
+        handle->debug_print("mifare_ultralight: stop_page - start_page + 1 is over 15.\n");             /* stop_page - start_page + 1 is over 15 */
         
-        return 0;                                                                                /* success return 0 */
+        return 5;                                                                                       /* return error */
     }
-    else
+    if ((*len) < (4 * (stop_page - start_page + 1)))                                                    /* check the length */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        handle->debug_print("mifare_ultralight: len < %d.\n", 4 * (stop_page - start_page + 1));        /* len is invalid */
         
-        return 1;                                                                                /* return error */
+        return 6;                                                                                       /* return error */
     }
-}
-
-/**
- * @brief     mifare_ultralight write conf
- * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] page page of write
- * @param[in] *data pointer to a data buffer
- * @return    status code
- *            - 0 success
- *            - 1 write conf failed
- * @note      none
- */
-static uint8_t a_mifare_ultralight_conf_write(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4])
-{
-    uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[8];
-    uint8_t output_len;
-    uint8_t output_buf[1];
     
-    input_len = 8;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
-    input_buf[1] = page;                                                                         /* set the setting page */
-    input_buf[2] = data[0];                                                                      /* set data0 */
-    input_buf[3] = data[1];                                                                      /* set data1 */
-    input_buf[4] = data[2];                                                                      /* set data2 */
-    input_buf[5] = data[3];                                                                      /* set data3 */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
-    output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    if (a_mifare_ultralight_auto_auth(handle, stop_page, 0) != 0)                                       /* authenticate when needed */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        return 1;                                                                                       /* return error */
+    }
+    a_mifare_ultralight_fast_read_frame(start_page, stop_page, input_buf);                              /* set the frame */
+    cal_len = 4 * (stop_page - start_page + 1);                                                         /* set the cal length */
+    tx[0].buf = input_buf;                                                                              /* set the frame segment */
+    tx[0].len = 5;                                                                                      /* set the segment length */
+    rx[0].buf = data;                                                                                   /* receive into the data */
+    rx[0].len = cal_len;                                                                                /* set the segment length */
+    rx[1].buf = crc_buf;                                                                                /* set the crc trailer */
+    rx[1].len = 2;                                                                                      /* set the segment length */
+    res = a_mifare_ultralight_transceiver_vector(handle, tx, 1, rx, 2, &output_len);                    /* transceiver */
+    if (res != 0)                                                                                       /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");                    /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);                     /* record the error */
         
-        return 1;                                                                                /* return error */
+        return 1;                                                                                       /* return error */
     }
-    if (output_len != 1)                                                                         /* check the output_len */
+    if (output_len != (cal_len + 2))                                                                    /* check the output_len */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                             /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);                      /* record the error */
         
-        return 1;                                                                                /* return error */
+        return 7;                                                                                       /* return error */
     }
-    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    if (a_mifare_ultralight_segment_crc_check(rx, 2) != 0)                                              /* check the crc */
     {
-        handle->debug_print("mifare_ultralight: ack error.\n");                                  /* ack error */
+        handle->debug_print("mifare_ultralight: crc error.\n");                                         /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                             /* record the error */
         
-        return 1;                                                                                /* return error */
+        return 8;                                                                                       /* return error */
     }
+    *len = cal_len;                                                                                     /* set the length */
     
-    return 0;                                                                                    /* success return 0 */
+    return 0;                                                                                           /* success return 0 */
 }
 
 /**
- * @brief     set the storage
+ * @brief     mifare_ultralight reactivate the selected card
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] storage set storage
+ * @param[in] *uid pointer to the uid of the card
  * @return    status code
  *            - 0 success
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 1 reactivate failed
+ * @note      an active card drops the first wake up and goes idle, so wake up is sent twice at most
  */
-uint8_t mifare_ultralight_set_storage(mifare_ultralight_handle_t *handle, mifare_ultralight_storage_t storage)
+static uint8_t a_mifare_ultralight_reactivate(mifare_ultralight_handle_t *handle, uint8_t uid[7])
 {
-    if (handle == NULL)                         /* check handle */
-    {
-        return 2;                               /* return error */
-    }
-    if (handle->inited != 1)                    /* check handle initialization */
-    {
-        return 3;                               /* return error */
-    }
+    uint8_t i;
+    mifare_ultralight_activation_t activation;
     
-    handle->end_page = (uint8_t)storage;        /* set the storage */
+    for (i = 0; i < 2; i++)                                                                     /* 2 times */
+    {
+        memcpy(activation.uid, uid, 7);                                                         /* set the uid */
+        if (mifare_ultralight_activate(handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP | 
+                                       MIFARE_ULTRALIGHT_ACTIVATE_POLICY_KNOWN_UID | 
+                                       MIFARE_ULTRALIGHT_ACTIVATE_POLICY_SKIP_READ_PAGE0 | 
+                                       MIFARE_ULTRALIGHT_ACTIVATE_POLICY_SKIP_VERSION, 
+                                       &activation) == 0)                                       /* wake up and select */
+        {
+            return 0;                                                                           /* success return 0 */
+        }
+    }
     
-    return 0;                                   /* success return 0 */
+    return 1;                                                                                   /* return error */
 }
 
 /**
- * @brief      get the storage
+ * @brief      mifare_ultralight find the first protected page of a refused frame
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *storage pointer to a set storage buffer
+ * @param[in]  page first page of the refused frame
+ * @param[in]  stop_page last page of the refused frame
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  *len pointer to a data length buffer
+ * @param[out] *protected_page pointer to a protected page buffer
  * @return     status code
  *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 1 refused frame failed
+ * @note       auth0 of the conf shadow is used when it is known, otherwise the frame is narrowed
+ *             with one page reads and the card is reactivated after each refused read,
+ *             the pages before the protected page are read into data and len is set to their length,
+ *             without a selected uid the card can't be reactivated, no page is read and the
+ *             protected page is auth0 when it is known, otherwise page
  */
-uint8_t mifare_ultralight_get_storage(mifare_ultralight_handle_t *handle, mifare_ultralight_storage_t *storage)
+static uint8_t a_mifare_ultralight_read_refused(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t stop_page,
+                                                uint8_t *data, uint16_t *len, uint8_t *protected_page)
 {
-    if (handle == NULL)                                                /* check handle */
+    uint8_t res;
+    uint8_t lo;
+    uint8_t hi;
+    uint8_t mid;
+    uint8_t idle;
+    uint8_t refused;
+    uint8_t uid[7];
+    uint8_t input_buf[5];
+    uint8_t output_len;
+    uint8_t output_buf[6];
+    uint8_t crc_buf[2];
+    
+    lo = page;                                                                                          /* first candidate */
+    hi = stop_page;                                                                                     /* the last page is refused */
+    if (((handle->conf_valid & (1 << 0)) != 0) && (handle->conf[0][3] <= stop_page))                    /* auth0 is known */
     {
-        return 2;                                                      /* return error */
+        lo = (handle->conf[0][3] > page) ? handle->conf[0][3] : page;                                   /* the first protected page */
+        hi = lo;                                                                                        /* no narrowing */
     }
-    if (handle->inited != 1)                                           /* check handle initialization */
+    if (handle->uid_valid != 3)                                                                         /* check the selected uid */
     {
-        return 3;                                                      /* return error */
+        handle->debug_print("mifare_ultralight: refused frame can't be narrowed.\n");                  /* refused frame can't be narrowed */
+        *protected_page = lo;                                                                           /* auth0 or the first page of the frame */
+        *len = 0;                                                                                       /* no page */
+        
+        return 0;                                                                                       /* success return 0 */
     }
     
-    *storage = (mifare_ultralight_storage_t)(handle->end_page);        /* get the storage */
+    memcpy(uid, handle->uid, 7);                                                                        /* save the uid */
+    idle = 1;                                                                                           /* the nak sent the card to idle */
+    while (lo < hi)                                                                                     /* narrow the frame */
+    {
+        if ((idle != 0) && (a_mifare_ultralight_reactivate(handle, uid) != 0))                          /* reactivate the card */
+        {
+            handle->debug_print("mifare_ultralight: reactivate failed.\n");                             /* reactivate failed */
+            
+            return 1;                                                                                   /* return error */
+        }
+        idle = 0;                                                                                       /* the card is active */
+        mid = (uint8_t)(lo + (hi - lo) / 2);                                                            /* probe page */
+        a_mifare_ultralight_fast_read_frame(mid, mid, input_buf);                                       /* set the frame */
+        output_len = 6;                                                                                 /* set the output length */
+        res = a_mifare_ultralight_transceiver(handle, input_buf, 5, output_buf, &output_len);           /* transceiver */
+        refused = ((res == 0) && (output_len == 1) && (handle->nak != MIFARE_ULTRALIGHT_NAK_NONE)) ? 1 : 0;     /* check the nak */
+        if (refused != 0)                                                                               /* protected page */
+        {
+            hi = mid;                                                                                   /* the boundary is at or before mid */
+            idle = 1;                                                                                   /* the card is idle */
+            
+            continue;                                                                                   /* next probe */
+        }
+        if ((res != 0) || (output_len != 6))                                                            /* check the result */
+        {
+            handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");                /* contactless transceiver failed */
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);                 /* record the error */
+            
+            return 1;                                                                                   /* return error */
+        }
+        a_mifare_ultralight_iso14443a_crc(output_buf, 4, crc_buf);                                      /* get the crc */
+        if ((output_buf[4] != crc_buf[0]) || (output_buf[5] != crc_buf[1]))                             /* check the crc */
+        {
+            handle->debug_print("mifare_ultralight: crc error.\n");                                     /* crc error */
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                         /* record the error */
+            
+            return 1;                                                                                   /* return error */
+        }
+        lo = (uint8_t)(mid + 1);                                                                        /* the boundary is after mid */
+    }
+    if ((idle != 0) && (a_mifare_ultralight_reactivate(handle, uid) != 0))                              /* leave the card active */
+    {
+        handle->debug_print("mifare_ultralight: reactivate failed.\n");                                 /* reactivate failed */
+        
+        return 1;                                                                                       /* return error */
+    }
     
-    return 0;                                                          /* success return 0 */
+    *protected_page = lo;                                                                               /* set the protected page */
+    if (lo == page)                                                                                     /* no readable page */
+    {
+        *len = 0;                                                                                       /* no page */
+        
+        return 0;                                                                                       /* success return 0 */
+    }
+    res = mifare_ultralight_read_range(handle, page, (uint8_t)(lo - 1), data, len, &stop_page);         /* read the readable pages */
+    if ((res != 0) || (stop_page != 0xFF))                                                              /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: read range failed.\n");                                 /* read range failed */
+        
+        return 1;                                                                                       /* return error */
+    }
+    
+    return 0;                                                                                           /* success return 0 */
 }
 
 /**
- * @brief     initialize the chip
- * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @return    status code
- *            - 0 success
- *            - 1 contactless initialization failed
- *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- * @note      none
+ * @brief         mifare_ultralight read range
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in]     start_page start page
+ * @param[in]     stop_page stop page
+ * @param[out]    *data pointer to a data buffer
+ * @param[in,out] *len pointer to a data length buffer
+ * @param[out]    *protected_page pointer to a protected page buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read range failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 stop_page < start_page
+ *                - 5 len is invalid
+ *                - 6 output_len is invalid
+ *                - 7 crc error
+ * @note          4 * (stop_page - start_page + 1) <= len
+ *                the range is split into the fewest fast read frames the max frame length allows
+ *                and every frame is received straight into data, 2 spare bytes in data let the
+ *                last frame land in place too, with contactless_transceiver_vector the crc is
+ *                received aside and no spare bytes are needed
+ *                protected_page is 0xFF when every page is read, otherwise it is the first page the
+ *                card refuses and len covers the pages before it, the page is auth0 of the conf shadow
+ *                or it is found by narrowing the refused frame, the card is selected again after a
+ *                refused frame, without a selected uid the pages of the refused frame are not read and
+ *                auth0 or the first page of the refused frame when auth0 is unknown is returned,
+ *                1 is returned and protected_page is 0xFF when a frame is lost
  */
-uint8_t mifare_ultralight_init(mifare_ultralight_handle_t *handle)
+uint8_t mifare_ultralight_read_range(mifare_ultralight_handle_t *handle, uint8_t start_page, uint8_t stop_page,
+                                     uint8_t *data, uint16_t *len, uint8_t *protected_page)
 {
     uint8_t res;
+    uint8_t input_buf[5];
+    uint8_t output_len;
+    uint8_t output_buf[64];
+    uint8_t crc_buf[2];
+    uint8_t frame_pages;
+    uint8_t last_pages;
+    uint8_t pages;
+    uint8_t page;
+    uint8_t in_place;
+    uint8_t *p;
+    uint16_t remain;
+    uint16_t offset;
+    uint16_t cal_len;
+    mifare_ultralight_segment_t tx[1];
+    mifare_ultralight_segment_t rx[2];
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                                 /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                                       /* return error */
     }
-    if (handle->debug_print == NULL)                                                         /* check debug_print */
+    if (handle->inited != 1)                                                                            /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                                       /* return error */
     }
-    if (handle->contactless_init == NULL)                                                    /* check contactless_init */
+    if (stop_page < start_page)                                                                         /* check start and stop page */
     {
-        handle->debug_print("mifare_ultralight: contactless_init is null.\n");               /* contactless_init is null */
+        handle->debug_print("mifare_ultralight: stop_page < start_page.\n");                            /* stop_page < start_page */
         
-        return 3;                                                                            /* return error */
+        return 4;                                                                                       /* return error */
     }
-    if (handle->contactless_deinit == NULL)                                                  /* check contactless_deinit */
+    remain = (uint16_t)(stop_page - start_page + 1);                                                    /* set the page number */
+    if ((*len) < (4 * remain))                                                                          /* check the length */
     {
-        handle->debug_print("mifare_ultralight: contactless_deinit is null.\n");             /* contactless_deinit is null */
+        handle->debug_print("mifare_ultralight: len < %d.\n", 4 * remain);                              /* len is invalid */
         
-        return 3;                                                                            /* return error */
+        return 5;                                                                                       /* return error */
     }
-    if (handle->contactless_transceiver == NULL)                                             /* check contactless_transceiver */
+    
+    if (a_mifare_ultralight_auto_auth(handle, stop_page, 0) != 0)                                       /* authenticate when needed */
     {
-        handle->debug_print("mifare_ultralight: contactless_transceiver is null.\n");        /* contactless_transceiver is null */
-        
-        return 3;                                                                            /* return error */
+        return 1;                                                                                       /* return error */
     }
-    if (handle->delay_ms == NULL)                                                            /* check delay_ms */
+    frame_pages = (uint8_t)((handle->max_frame_len - 2) / 4);                                           /* pages of one frame */
+    in_place = ((*len) >= (4 * remain + 2)) ? 1 : 0;                                                    /* check the spare bytes */
+    if (MIFARE_ULTRALIGHT_LINKED(handle, contactless_transceiver_vector))                               /* check the vector transceiver */
     {
-        handle->debug_print("mifare_ultralight: delay_ms is null.\n");                       /* delay_ms is null */
-        
-        return 3;                                                                            /* return error */
+        in_place = 1;                                                                                   /* the crc lands on crc_buf */
     }
-    
-    res = handle->contactless_init();                                                        /* contactless init */
-    if (res != 0)                                                                            /* check the result */
+    last_pages = frame_pages;                                                                           /* set the last frame pages */
+    if ((in_place == 0) && (last_pages > MIFARE_ULTRALIGHT_SCRATCH_FRAME_PAGES))                        /* check the scratch buffer */
     {
-        handle->debug_print("mifare_ultralight: contactless init failed.\n");                /* contactless init failed */
+        last_pages = MIFARE_ULTRALIGHT_SCRATCH_FRAME_PAGES;                                             /* limit to the scratch buffer */
+    }
+    *protected_page = 0xFF;                                                                             /* init the protected page */
+    page = start_page;                                                                                  /* set the first page */
+    offset = 0;                                                                                         /* init the offset */
+    tx[0].buf = input_buf;                                                                              /* set the frame segment */
+    tx[0].len = 5;                                                                                      /* set the segment length */
+    while (remain != 0)                                                                                 /* read all frames */
+    {
+        if (remain > last_pages)                                                                        /* not the last frame */
+        {
+            pages = (remain - last_pages > frame_pages) ? frame_pages : (uint8_t)(remain - last_pages); /* set the frame pages */
+            p = data + offset;                                                                          /* crc lands on the next frame */
+        }
+        else
+        {
+            pages = (uint8_t)remain;                                                                    /* set the frame pages */
+            p = (in_place != 0) ? (data + offset) : output_buf;                                         /* crc lands on the spare bytes */
+        }
         
-        return 1;                                                                            /* return error */
+        a_mifare_ultralight_fast_read_frame(page, (uint8_t)(page + pages - 1), input_buf);             /* set the frame */
+        cal_len = (uint16_t)(4 * pages);                                                                /* set the cal length */
+        rx[0].buf = p;                                                                                  /* receive into the frame buffer */
+        rx[0].len = (uint8_t)cal_len;                                                                   /* set the segment length */
+        rx[1].buf = (MIFARE_ULTRALIGHT_LINKED(handle, contactless_transceiver_vector)) ? 
+                     crc_buf : (p + cal_len);                                                           /* set the crc trailer */
+        rx[1].len = 2;                                                                                  /* set the segment length */
+        res = a_mifare_ultralight_transceiver_vector(handle, tx, 1, rx, 2, &output_len);                /* transceiver */
+        if ((res == 0) && (output_len == 1) && (handle->nak != MIFARE_ULTRALIGHT_NAK_NONE))             /* the card refused the frame */
+        {
+            cal_len = (uint16_t)((*len) - offset);                                                      /* spare length */
+            res = a_mifare_ultralight_read_refused(handle, page, (uint8_t)(page + pages - 1), 
+                                                   data + offset, &cal_len, protected_page);            /* find the protected page */
+            *len = (uint16_t)(offset + ((res == 0) ? cal_len : 0));                                     /* set the length */
+            if (res != 0)                                                                               /* check the result */
+            {
+                *protected_page = 0xFF;                                                                 /* unknown */
+                
+                return 1;                                                                               /* return error */
+            }
+            
+            return 0;                                                                                   /* success return 0 */
+        }
+        if (res != 0)                                                                                   /* check the result */
+        {
+            *len = offset;                                                                              /* set the length */
+            handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");                /* contactless transceiver failed */
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);                 /* record the error */
+            
+            return 1;                                                                                   /* return error */
+        }
+        if (output_len != (cal_len + 2))                                                                /* check the output_len */
+        {
+            handle->debug_print("mifare_ultralight: output_len is invalid.\n");                         /* output_len is invalid */
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);                  /* record the error */
+            
+            return 6;                                                                                   /* return error */
+        }
+        if (a_mifare_ultralight_segment_crc_check(rx, 2) != 0)                                          /* check the crc */
+        {
+            handle->debug_print("mifare_ultralight: crc error.\n");                                     /* crc error */
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                         /* record the error */
+            
+            return 7;                                                                                   /* return error */
+        }
+        if (p == output_buf)                                                                            /* check the scratch buffer */
+        {
+            memcpy(data + offset, output_buf, cal_len);                                                 /* copy the data */
+        }
+        offset += cal_len;                                                                              /* next offset */
+        page = (uint8_t)(page + pages);                                                                 /* next page */
+        remain -= pages;                                                                                /* remain pages */
     }
-    handle->type = (uint8_t)MIFARE_ULTRALIGHT_TYPE_INVALID;                                  /* set the invalid type */
-    handle->end_page = 0xFF;                                                                 /* set the end page */
-    handle->inited = 1;                                                                      /* flag inited */
+    *len = offset;                                                                                      /* set the length */
     
-    return 0;                                                                                /* success return 0 */
+    return 0;                                                                                           /* success return 0 */
 }
 
 /**
- * @brief     close the chip
- * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @return    status code
- *            - 0 success
- *            - 1 contactless deinit failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief         mifare_ultralight read all pages
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[out]    *data pointer to a data buffer
+ * @param[in,out] *len pointer to a data length buffer
+ * @param[out]    *protected_page pointer to a protected page buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read all failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 storage is invalid
+ *                - 5 len is invalid
+ *                - 6 output_len is invalid
+ *                - 7 crc error
+ * @note          the storage must be set or got before,
+ *                see mifare_ultralight_read_range for the protected page report
  */
-uint8_t mifare_ultralight_deinit(mifare_ultralight_handle_t *handle)
+uint8_t mifare_ultralight_read_all(mifare_ultralight_handle_t *handle, uint8_t *data, uint16_t *len, uint8_t *protected_page)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                /* check handle */
+    if (handle == NULL)                                                                          /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (handle->inited != 1)                                                                     /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                                                                /* return error */
     }
-    
-    res = handle->contactless_deinit();                                                /* contactless deinit */
-    if (res != 0)                                                                      /* check the result */
+    if (handle->end_page == 0xFF)                                                                /* check the storage */
     {
-        handle->debug_print("mifare_ultralight: contactless deinit failed.\n");        /* contactless deinit failed */
+        handle->debug_print("mifare_ultralight: storage is invalid.\n");                         /* storage is invalid */
         
-        return 1;                                                                      /* return error */
+        return 4;                                                                                /* return error */
     }
-    handle->inited = 0;                                                                /* flag closed */
     
-    return 0;                                                                          /* success return 0 */
+    return mifare_ultralight_read_range(handle, 0x00, handle->end_page,
+                                        data, len, protected_page);                              /* read the range */
 }
 
 /**
- * @brief      mifare_ultralight request
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *type pointer to a type buffer
- * @return     status code
- *             - 0 success
- *             - 1 request failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 type is invalid
- * @note       none
+ * @brief     mifare_ultralight compatibility write page
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] page page of write
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 compatibility write page failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 output_len is invalid
+ *            - 5 ack error
+ * @note      none
  */
-uint8_t mifare_ultralight_request(mifare_ultralight_handle_t *handle, mifare_ultralight_type_t *type)
+uint8_t mifare_ultralight_compatibility_write_page(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4])
 {
     uint8_t res;
+    uint8_t i;
     uint8_t input_len;
-    uint8_t input_buf[1];
+    uint8_t input_buf[18];
     uint8_t output_len;
-    uint8_t output_buf[2];
+    uint8_t output_buf[1];
     
     if (handle == NULL)                                                                          /* check handle */
     {
@@ -375,59 +4541,96 @@ uint8_t mifare_ultralight_request(mifare_ultralight_handle_t *handle, mifare_ult
         return 3;                                                                                /* return error */
     }
     
-    input_len = 1;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_REQUEST;                                            /* set the command */
-    output_len = 2;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
+    if ((page == handle->end_page - 3) || (page == handle->end_page - 2))                        /* check the conf pages */
+    {
+        handle->conf_valid &= (uint8_t)(~(1 << (page - (handle->end_page - 3))));                /* invalidate the conf shadow */
+        handle->conf_dirty &= (uint8_t)(~(1 << (page - (handle->end_page - 3))));                /* drop the pending change */
+    }
+    if (a_mifare_ultralight_auto_auth(handle, page, 1) != 0)                                     /* authenticate when needed */
+    {
+        return 1;                                                                                /* return error */
+    }
+    input_len = 4;                                                                               /* set the input length */
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_COMP_WRITE;                                         /* set the command */
+    input_buf[1] = page;                                                                         /* set the page */
+    a_mifare_ultralight_iso14443a_crc(input_buf, 2, input_buf + 2);                              /* get the crc */
+    output_len = 1;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
     if (res != 0)                                                                                /* check the result */
     {
         handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
         
         return 1;                                                                                /* return error */
     }
-    if (output_len != 2)                                                                         /* check the output_len */
+    if (output_len != 1)                                                                         /* check the output_len */
     {
         handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
         
         return 4;                                                                                /* return error */
     }
-    if ((output_buf[0] == 0x44) && (output_buf[1] == 0x00))                                      /* check classic type */
+    if (output_buf[0] != 0xA)                                                                    /* check the result */
     {
-        *type = MIFARE_ULTRALIGHT_TYPE_ULTRALIGHT;                                               /* ultralight */
-        handle->type = *type;                                                                    /* save the type */
+        a_mifare_ultralight_ack_error(handle, output_buf[0]);                                    /* decode the nak */
         
-        return 0;                                                                                /* success return 0 */
+        return 5;                                                                                /* return error */
     }
-    else
+    
+    for (i = 0; i < 4; i ++)                                                                     /* 4 times */
     {
-        *type = MIFARE_ULTRALIGHT_TYPE_INVALID;                                                  /* invalid */
-        handle->type = *type;                                                                    /* save the type */
-        handle->debug_print("mifare_ultralight: type is invalid.\n");                            /* type is invalid */
+        input_buf[i] = data[i];                                                                  /* copy data */
+    }
+    for (i = 0; i < 12; i ++)                                                                    /* 12 times */
+    {
+        input_buf[4 + i] = 0x00;                                                                 /* copy data */
+    }
+    a_mifare_ultralight_iso14443a_crc(input_buf, 16, input_buf + 16);                            /* get the crc */
+    input_len = 18;                                                                              /* set the input length */
+    output_len = 1;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
+    }
+    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    {
+        a_mifare_ultralight_ack_error(handle, output_buf[0]);                                    /* decode the nak */
         
         return 5;                                                                                /* return error */
     }
+    
+    a_mifare_ultralight_verify_queue(handle, page, data);                                        /* queue the page */
+    
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight wake up
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *type pointer to a type buffer
- * @return     status code
- *             - 0 success
- *             - 1 wake up failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 type is invalid
- * @note       none
+ * @brief     mifare_ultralight write page
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] page page of write
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write page failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 output_len is invalid
+ *            - 5 ack error
+ * @note      none
  */
-uint8_t mifare_ultralight_wake_up(mifare_ultralight_handle_t *handle, mifare_ultralight_type_t *type)
+uint8_t mifare_ultralight_write_page(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4])
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[1];
+    uint8_t input_buf[2];
     uint8_t output_len;
-    uint8_t output_buf[2];
+    uint8_t output_buf[1];
+    uint8_t crc_buf[2];
+    mifare_ultralight_segment_t tx[3];
+    mifare_ultralight_segment_t rx[1];
     
     if (handle == NULL)                                                                          /* check handle */
     {
@@ -438,227 +4641,454 @@ uint8_t mifare_ultralight_wake_up(mifare_ultralight_handle_t *handle, mifare_ult
         return 3;                                                                                /* return error */
     }
     
-    handle->delay_ms(1);                                                                         /* delay 1ms */
-    input_len = 1;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WAKE_UP;                                            /* set the command */
-    output_len = 2;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
+    if ((page == handle->end_page - 3) || (page == handle->end_page - 2))                        /* check the conf pages */
+    {
+        handle->conf_valid &= (uint8_t)(~(1 << (page - (handle->end_page - 3))));                /* invalidate the conf shadow */
+        handle->conf_dirty &= (uint8_t)(~(1 << (page - (handle->end_page - 3))));                /* drop the pending change */
+    }
+    if (a_mifare_ultralight_auto_auth(handle, page, 1) != 0)                                     /* authenticate when needed */
+    {
+        return 1;                                                                                /* return error */
+    }
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
+    input_buf[1] = page;                                                                         /* set the page */
+    tx[0].buf = input_buf;                                                                       /* set the header segment */
+    tx[0].len = 2;                                                                               /* set the segment length */
+    tx[1].buf = data;                                                                            /* send the data in place */
+    tx[1].len = 4;                                                                               /* set the segment length */
+    tx[2].buf = crc_buf;                                                                         /* set the crc trailer */
+    tx[2].len = 2;                                                                               /* set the segment length */
+    a_mifare_ultralight_segment_crc_set(tx, 3);                                                  /* get the crc */
+    rx[0].buf = output_buf;                                                                      /* set the ack segment */
+    rx[0].len = 1;                                                                               /* set the segment length */
+    res = a_mifare_ultralight_transceiver_vector(handle, tx, 3, rx, 1, &output_len);             /* transceiver */
     if (res != 0)                                                                                /* check the result */
     {
         handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
         
         return 1;                                                                                /* return error */
     }
-    if (output_len != 2)                                                                         /* check the output_len */
+    if (output_len != 1)                                                                         /* check the output_len */
     {
         handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
         
         return 4;                                                                                /* return error */
     }
-    if ((output_buf[0] == 0x44) && (output_buf[1] == 0x00))                                      /* check classic type */
-    {
-        *type = MIFARE_ULTRALIGHT_TYPE_ULTRALIGHT;                                               /* ultralight */
-        handle->type = *type;                                                                    /* save the type */
-        
-        return 0;                                                                                /* success return 0 */
-    }
-    else
+    if (output_buf[0] != 0xA)                                                                    /* check the result */
     {
-        *type = MIFARE_ULTRALIGHT_TYPE_INVALID;                                                  /* invalid */
-        handle->type = *type;                                                                    /* save the type */
-        handle->debug_print("mifare_ultralight: type is invalid.\n");                            /* type is invalid */
+        a_mifare_ultralight_ack_error(handle, output_buf[0]);                                    /* decode the nak */
         
         return 5;                                                                                /* return error */
     }
-}
-
-/**
- * @brief      mifare_ultralight halt
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @return     status code
- *             - 0 success
- *             - 1 halt failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
- */
-uint8_t mifare_ultralight_halt(mifare_ultralight_handle_t *handle)
-{
-    uint8_t input_len;
-    uint8_t input_buf[4];
-    uint8_t output_len;
-    uint8_t output_buf[1];
-    
-    if (handle == NULL)                                                                          /* check handle */
-    {
-        return 2;                                                                                /* return error */
-    }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
-    {
-        return 3;                                                                                /* return error */
-    }
     
-    input_len = 4;                                                                               /* set the input length */
-    input_buf[0] = (MIFARE_ULTRALIGHT_COMMAND_HALT >> 8) & 0xFF;                                 /* set the command */
-    input_buf[1] = (MIFARE_ULTRALIGHT_COMMAND_HALT >> 0) & 0xFF;                                 /* set the command */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 2, input_buf + 2);                              /* get the crc */
-    output_len = 1;                                                                              /* set the output length */
-    (void)handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
+    a_mifare_ultralight_verify_queue(handle, page, data);                                        /* queue the page */
     
     return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight anti collision cl1
+ * @brief      mifare_ultralight write the pages that differ from an image
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *id pointer to an id buffer
+ * @param[in]  start_page start page
+ * @param[in]  stop_page stop page
+ * @param[in]  *image pointer to an image buffer
+ * @param[in]  *mask pointer to a mask buffer
+ * @param[in]  allow bitwise or of mifare_ultralight_write_allow_t
+ * @param[out] *written pointer to a written pages buffer
  * @return     status code
  *             - 0 success
- *             - 1 anti collision cl1 failed
+ *             - 1 write diff failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 check error
- * @note       none
+ *             - 4 storage is invalid
+ *             - 5 page range is invalid
+ *             - 6 page is not allowed
+ *             - 7 otp or lock bits can't be cleared
+ * @note       image and mask hold 4 * (stop_page - start_page + 1) bytes,
+ *             only the mask bits set to 1 are taken from the image
+ *             the masked pages are read back with the fewest fast read frames and
+ *             only the pages whose content changes are written,
+ *             the uid pages are never written and pwd or pack pages are always written
+ *             because they can't be read back,
+ *             every page is checked before the first write,
+ *             user pages are written first, then pwd, pack, cfg1 and cfg0 and at last otp and lock,
+ *             so a new lock bit or a lower auth0 doesn't refuse the rest of the image
  */
-uint8_t mifare_ultralight_anticollision_cl1(mifare_ultralight_handle_t *handle, uint8_t id[4])
+uint8_t mifare_ultralight_write_diff(mifare_ultralight_handle_t *handle, uint8_t start_page, uint8_t stop_page,
+                                     uint8_t *image, uint8_t *mask, uint8_t allow, uint8_t *written)
 {
     uint8_t res;
+    uint8_t page;
+    uint8_t cls;
+    uint8_t first;
+    uint8_t last;
+    uint8_t protected_page;
+    uint8_t changed;
+    uint8_t cleared;
+    uint8_t rank;
     uint8_t i;
-    uint8_t check;
-    uint8_t input_len;
-    uint8_t input_buf[2];
-    uint8_t output_len;
-    uint8_t output_buf[5];
+    uint8_t *img;
+    uint8_t *msk;
+    uint8_t *cur;
+    uint8_t data[4];
+    uint8_t dirty[6];
+    uint8_t buf[4 * ((uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21 + 1) + 2];
+    uint16_t len;
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                                               /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                                          /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                                     /* return error */
     }
-    
-    input_len = 2;                                                                               /* set the input length */
-    input_buf[0] = (MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL1 >> 8) & 0xFF;                    /* set the command */
-    input_buf[1] = (MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL1 >> 0) & 0xFF;                    /* set the command */
-    output_len = 5;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    if (handle->end_page > (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21)                                /* check the storage */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        handle->debug_print("mifare_ultralight: storage is invalid.\n");                              /* storage is invalid */
         
-        return 1;                                                                                /* return error */
+        return 4;                                                                                     /* return error */
     }
-    if (output_len != 5)                                                                         /* check the output_len */
+    if ((stop_page < start_page) || (stop_page > handle->end_page))                                   /* check start and stop page */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        handle->debug_print("mifare_ultralight: page range is invalid.\n");                           /* page range is invalid */
         
-        return 4;                                                                                /* return error */
+        return 5;                                                                                     /* return error */
     }
-    check = 0;                                                                                   /* init 0 */
-    for (i = 0; i < 4; i++)                                                                      /* run 4 times */
+    
+    *written = 0;                                                                                     /* init the written pages */
+    memset(dirty, 0, sizeof(dirty));                                                                  /* init the dirty pages */
+    first = 0xFF;                                                                                     /* init the first read page */
+    last = 0;                                                                                         /* init the last read page */
+    for (page = start_page; page <= stop_page; page++)                                                /* check all pages */
+    {
+        msk = mask + 4 * (page - start_page);                                                         /* set the page mask */
+        if ((msk[0] | msk[1] | msk[2] | msk[3]) == 0)                                                 /* check the mask */
+        {
+            continue;                                                                                 /* untouched page */
+        }
+        cls = a_mifare_ultralight_page_class(handle, page);                                           /* get the page class */
+        if ((cls == MIFARE_ULTRALIGHT_PAGE_CLASS_UID) || ((page == 2) && ((msk[0] | msk[1]) != 0)) ||
+            ((cls == MIFARE_ULTRALIGHT_PAGE_CLASS_OTP) && ((allow & MIFARE_ULTRALIGHT_WRITE_ALLOW_OTP) == 0)) ||
+            ((cls == MIFARE_ULTRALIGHT_PAGE_CLASS_LOCK) && ((allow & MIFARE_ULTRALIGHT_WRITE_ALLOW_LOCK) == 0)) ||
+            (((cls == MIFARE_ULTRALIGHT_PAGE_CLASS_CONF) || (cls == MIFARE_ULTRALIGHT_PAGE_CLASS_KEY)) &&
+            ((allow & MIFARE_ULTRALIGHT_WRITE_ALLOW_CONF) == 0)))                                     /* check the allowed pages */
+        {
+            handle->debug_print("mifare_ultralight: page 0x%02X is not allowed.\n", page);            /* page is not allowed */
+            
+            return 6;                                                                                 /* return error */
+        }
+        if (cls != MIFARE_ULTRALIGHT_PAGE_CLASS_KEY)                                                  /* readable page */
+        {
+            if (first == 0xFF)                                                                        /* first readable page */
+            {
+                first = page;                                                                         /* set the first page */
+            }
+            last = page;                                                                              /* set the last page */
+        }
+    }
+    if (first != 0xFF)                                                                                /* check the read range */
     {
-        id[i] = output_buf[i];                                                                   /* get one id */
-        check ^= output_buf[i];                                                                  /* xor */
+        len = sizeof(buf);                                                                            /* set the buffer length */
+        res = mifare_ultralight_read_range(handle, first, last, buf, &len, &protected_page);          /* read the current content */
+        if ((res != 0) || (protected_page != 0xFF))                                                   /* check the result */
+        {
+            handle->debug_print("mifare_ultralight: read range failed.\n");                           /* read range failed */
+            
+            return 1;                                                                                 /* return error */
+        }
     }
-    if (check != output_buf[4])                                                                  /* check the result */
+    
+    for (page = start_page; page <= stop_page; page++)                                                /* merge all pages */
     {
-        handle->debug_print("mifare_ultralight: check error.\n");                                /* check error */
+        img = image + 4 * (page - start_page);                                                        /* set the page image */
+        msk = mask + 4 * (page - start_page);                                                         /* set the page mask */
+        cls = a_mifare_ultralight_page_class(handle, page);                                           /* get the page class */
+        if (((msk[0] | msk[1] | msk[2] | msk[3]) == 0) || (cls == MIFARE_ULTRALIGHT_PAGE_CLASS_KEY))  /* check the page */
+        {
+            continue;                                                                                 /* not read page */
+        }
+        cur = buf + 4 * (page - first);                                                               /* set the current content */
+        changed = 0;                                                                                  /* init the changed flag */
+        cleared = 0;                                                                                  /* init the cleared bits */
+        for (i = 0; i < 4; i++)                                                                       /* merge all bytes */
+        {
+            data[i] = (uint8_t)((cur[i] & (~msk[i])) | (img[i] & msk[i]));                            /* merge the image */
+            changed |= (uint8_t)(data[i] ^ cur[i]);                                                   /* check the changed bits */
+            cleared |= (uint8_t)(cur[i] & (~data[i]));                                                /* check the cleared bits */
+        }
+        if ((cleared != 0) && 
+            ((cls == MIFARE_ULTRALIGHT_PAGE_CLASS_OTP) || (cls == MIFARE_ULTRALIGHT_PAGE_CLASS_LOCK)))       /* check the one-time bits */
+        {
+            handle->debug_print("mifare_ultralight: otp or lock bits can't be cleared.\n");           /* otp or lock bits can't be cleared */
+            
+            return 7;                                                                                 /* return error */
+        }
+        memcpy(cur, data, 4);                                                                         /* save the merged page */
+        if (changed != 0)                                                                             /* check the changed flag */
+        {
+            dirty[(page - first) / 8] |= (uint8_t)(1 << ((page - first) % 8));                       /* mark the page */
+        }
+    }
+    for (rank = 0; rank < MIFARE_ULTRALIGHT_WRITE_RANK_MAX; rank++)                                   /* write all changed pages rank by rank */
+    {
+        for (page = start_page; page <= stop_page; page++)                                            /* write the pages of the rank */
+        {
+            img = image + 4 * (page - start_page);                                                    /* set the page image */
+            msk = mask + 4 * (page - start_page);                                                     /* set the page mask */
+            if ((msk[0] | msk[1] | msk[2] | msk[3]) == 0)                                             /* check the mask */
+            {
+                continue;                                                                             /* untouched page */
+            }
+            if (a_mifare_ultralight_write_rank(handle, page) != rank)                                 /* check the rank */
+            {
+                continue;                                                                             /* other rank */
+            }
+            if (a_mifare_ultralight_page_class(handle, page) == MIFARE_ULTRALIGHT_PAGE_CLASS_KEY)     /* write only page */
+            {
+                for (i = 0; i < 4; i++)                                                               /* set all bytes */
+                {
+                    data[i] = img[i] & msk[i];                                                        /* unmasked bits are written as 0 */
+                }
+            }
+            else if ((dirty[(page - first) / 8] & (1 << ((page - first) % 8))) != 0)                  /* changed page */
+            {
+                memcpy(data, buf + 4 * (page - first), 4);                                            /* copy the merged page */
+            }
+            else
+            {
+                continue;                                                                             /* unchanged page */
+            }
+            res = mifare_ultralight_write_page(handle, page, data);                                   /* write the page */
+            if (res != 0)                                                                             /* check the result */
+            {
+                handle->debug_print("mifare_ultralight: write page failed.\n");                       /* write page failed */
+                
+                return 1;                                                                             /* return error */
+            }
+            (*written)++;                                                                             /* written pages */
+        }
+    }
+    
+    return 0;                                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     mifare_ultralight begin a verified write
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *verify pointer to a verify structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or verify is NULL
+ *            - 3 handle is not initialized
+ *            - 4 storage is invalid
+ * @note      the storage must be set or got before,
+ *            every page acked after begin is queued with its content, pwd and pack pages
+ *            are never queued because they can't be read back,
+ *            the otp and lock bits are checked as set bits because the card ors them
+ */
+uint8_t mifare_ultralight_verify_begin(mifare_ultralight_handle_t *handle, mifare_ultralight_verify_t *verify)
+{
+    if ((handle == NULL) || (verify == NULL))                                        /* check handle and verify */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if (handle->end_page > (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21)               /* check the storage */
+    {
+        handle->debug_print("mifare_ultralight: storage is invalid.\n");             /* storage is invalid */
         
-        return 5;                                                                                /* return error */
+        return 4;                                                                    /* return error */
     }
     
-    return 0;                                                                                    /* success return 0 */
+    memset(verify, 0, sizeof(mifare_ultralight_verify_t));                           /* clear the queue */
+    handle->verify = verify;                                                         /* open the queue */
+    
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight anti collision cl2
+ * @brief      mifare_ultralight commit a verified write
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *id pointer to an id buffer
+ * @param[in]  retry rewrite rounds of the mismatched pages
+ * @param[out] *mismatched pointer to a mismatched pages buffer
  * @return     status code
  *             - 0 success
- *             - 1 anti collision cl2 failed
+ *             - 1 verify commit failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 check error
- * @note       none
+ *             - 4 verify is not begun
+ * @note       the queued pages are read back with the fewest fast read frames the max frame length
+ *             allows, the mismatched pages are left in verify->mismatch,
+ *             each retry round rewrites only the mismatched pages and reads back only them,
+ *             the queue stays open when a frame fails so the commit can be run again
  */
-uint8_t mifare_ultralight_anticollision_cl2(mifare_ultralight_handle_t *handle, uint8_t id[4])
+uint8_t mifare_ultralight_verify_commit(mifare_ultralight_handle_t *handle, uint8_t retry, uint8_t *mismatched)
 {
     uint8_t res;
-    uint8_t i;
-    uint8_t check;
-    uint8_t input_len;
-    uint8_t input_buf[2];
-    uint8_t output_len;
-    uint8_t output_buf[5];
+    uint8_t page;
+    uint8_t first;
+    uint8_t last;
+    uint8_t end;
+    uint8_t frame_pages;
+    uint8_t protected_page;
+    uint8_t round;
+    uint8_t count;
+    uint8_t data[4];
+    uint8_t pending[6];
+    uint8_t buf[4 * ((uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21 + 1) + 2];
+    uint16_t len;
+    mifare_ultralight_verify_t *verify;
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                                               /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                                          /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                                     /* return error */
     }
-    
-    input_len = 2;                                                                               /* set the input length */
-    input_buf[0] = (MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL2 >> 8) & 0xFF;                    /* set the command */
-    input_buf[1] = (MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL2 >> 0) & 0xFF;                    /* set the command */
-    output_len = 5;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    if (handle->verify == NULL)                                                                       /* check the queue */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        handle->debug_print("mifare_ultralight: verify is not begun.\n");                             /* verify is not begun */
         
-        return 1;                                                                                /* return error */
+        return 4;                                                                                     /* return error */
     }
-    if (output_len != 5)                                                                         /* check the output_len */
-    {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+    
+    verify = handle->verify;                                                                          /* get the queue */
+    memcpy(pending, verify->queued, sizeof(pending));                                                 /* check all queued pages */
+    verify->frames = 0;                                                                               /* init the frames */
+    verify->rewritten = 0;                                                                            /* init the rewritten pages */
+    frame_pages = (uint8_t)((handle->max_frame_len - 2) / 4);                                         /* pages of one frame */
+    round = 0;                                                                                        /* init the round */
+    while (1)                                                                                         /* check and rewrite */
+    {
+        memset(verify->mismatch, 0, sizeof(verify->mismatch));                                        /* clear the mismatched pages */
+        count = 0;                                                                                    /* init the mismatched count */
+        page = 0;                                                                                     /* start from page 0 */
+        while (page <= handle->end_page)                                                              /* cover all pending pages */
+        {
+            if ((pending[page / 8] & (1 << (page % 8))) == 0)                                         /* check the page */
+            {
+                page++;                                                                               /* next page */
+                
+                continue;                                                                             /* not pending */
+            }
+            first = page;                                                                             /* a frame starts at the first pending page */
+            last = page;                                                                              /* init the last page */
+            end = ((uint16_t)first + frame_pages - 1 > handle->end_page) ? 
+                   handle->end_page : (uint8_t)(first + frame_pages - 1);                             /* last page the frame can reach */
+            for (page = (uint8_t)(first + 1); page <= end; page++)                                    /* find the last pending page */
+            {
+                if ((pending[page / 8] & (1 << (page % 8))) != 0)                                     /* check the page */
+                {
+                    last = page;                                                                      /* extend the frame */
+                }
+            }
+            len = sizeof(buf);                                                                        /* set the buffer length */
+            res = mifare_ultralight_read_range(handle, first, last, buf, &len, &protected_page);      /* read one frame */
+            if ((res != 0) || (protected_page != 0xFF))                                               /* check the result */
+            {
+                handle->debug_print("mifare_ultralight: read range failed.\n");                       /* read range failed */
+                
+                return 1;                                                                             /* return error */
+            }
+            verify->frames++;                                                                         /* count the frame */
+            for (page = first; page <= last; page++)                                                  /* check all pending pages */
+            {
+                if (((pending[page / 8] & (1 << (page % 8))) != 0) && 
+                    (a_mifare_ultralight_verify_check(handle, page, buf + 4 * (page - first)) != 0))  /* check the content */
+                {
+                    verify->mismatch[page / 8] |= (uint8_t)(1 << (page % 8));                         /* mark the page */
+                    count++;                                                                          /* count the page */
+                }
+            }
+            page = (uint8_t)(last + 1);                                                               /* next page */
+        }
+        if ((count == 0) || (round >= retry))                                                         /* check the round */
+        {
+            break;                                                                                    /* done */
+        }
         
-        return 4;                                                                                /* return error */
+        for (page = 0; page <= handle->end_page; page++)                                              /* rewrite the mismatched pages */
+        {
+            if ((verify->mismatch[page / 8] & (1 << (page % 8))) != 0)                                /* check the page */
+            {
+                handle->debug_print("mifare_ultralight: rewrite page 0x%02X.\n", page);               /* rewrite the page */
+                memcpy(data, verify->data + 4 * page, 4);                                             /* copy the expected content */
+                res = mifare_ultralight_write_page(handle, page, data);                               /* write the page */
+                if (res != 0)                                                                         /* check the result */
+                {
+                    handle->debug_print("mifare_ultralight: write page failed.\n");                   /* write page failed */
+                    
+                    return 1;                                                                         /* return error */
+                }
+                verify->rewritten++;                                                                  /* count the page */
+            }
+        }
+        memcpy(pending, verify->mismatch, sizeof(pending));                                           /* only check them again */
+        round++;                                                                                      /* next round */
     }
-    check = 0;                                                                                   /* init 0 */
-    for (i = 0; i < 4; i++)                                                                      /* run 4 times */
+    handle->verify = NULL;                                                                            /* close the queue */
+    *mismatched = count;                                                                              /* set the mismatched pages */
+    
+    return 0;                                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     mifare_ultralight abort a verified write
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the queued pages are dropped
+ */
+uint8_t mifare_ultralight_verify_abort(mifare_ultralight_handle_t *handle)
+{
+    if (handle == NULL)                               /* check handle */
     {
-        id[i] = output_buf[i];                                                                   /* get one id */
-        check ^= output_buf[i];                                                                  /* xor */
+        return 2;                                     /* return error */
     }
-    if (check != output_buf[4])                                                                  /* check the result */
+    if (handle->inited != 1)                          /* check handle initialization */
     {
-        handle->debug_print("mifare_ultralight: check error.\n");                                /* check error */
-        
-        return 5;                                                                                /* return error */
+        return 3;                                     /* return error */
     }
     
-    return 0;                                                                                    /* success return 0 */
+    handle->verify = NULL;                            /* close the queue */
+    
+    return 0;                                         /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight select cl1
+ * @brief     mifare_ultralight authenticate
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] *id pointer to an id buffer
+ * @param[in] *pwd pointer to a pwd buffer
+ * @param[in] *pack pointer to a pack buffer
  * @return    status code
  *            - 0 success
- *            - 1 select cl1 failed
+ *            - 1 authenticate failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 output_len is invalid
- *            - 5 sak error
- * @note      none
+ *            - 5 crc error
+ *            - 6 pack check failed
+ * @note      the session is authenticated after a matching pack, it is lost by
+ *            request, wake up, halt, a nak and a transport failure
  */
-uint8_t mifare_ultralight_select_cl1(mifare_ultralight_handle_t *handle, uint8_t id[4])
+uint8_t mifare_ultralight_authenticate(mifare_ultralight_handle_t *handle, uint8_t pwd[4], uint8_t pack[2])
 {
     uint8_t res;
-    uint8_t i;
     uint8_t input_len;
-    uint8_t input_buf[9];
+    uint8_t input_buf[7];
     uint8_t output_len;
-    uint8_t output_buf[1];
+    uint8_t output_buf[4];
+    uint8_t crc_buf[2];
     
     if (handle == NULL)                                                                          /* check handle */
     {
@@ -669,214 +5099,144 @@ uint8_t mifare_ultralight_select_cl1(mifare_ultralight_handle_t *handle, uint8_t
         return 3;                                                                                /* return error */
     }
     
-    input_len = 9;                                                                               /* set the input length */
-    input_buf[0] = (MIFARE_ULTRALIGHT_COMMAND_SELECT_CL1 >> 8) & 0xFF;                           /* set the command */
-    input_buf[1] = (MIFARE_ULTRALIGHT_COMMAND_SELECT_CL1 >> 0) & 0xFF;                           /* set the command */
-    input_buf[6] = 0;                                                                            /* init 0 */
-    for (i = 0; i < 4; i++)                                                                      /* run 4 times */
-    {
-        input_buf[2 + i] = id[i];                                                                /* get one id */
-        input_buf[6] ^= id[i];                                                                   /* xor */
-    }
-    a_mifare_ultralight_iso14443a_crc(input_buf, 7, input_buf + 7);                              /* get the crc */
-    output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
+    handle->auth = 0;                                                                            /* a new session */
+    input_len = 7;                                                                               /* set the input length */
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_PWD_AUTH;                                           /* set the command */
+    input_buf[1] = pwd[0];                                                                       /* set pwd0 */
+    input_buf[2] = pwd[1];                                                                       /* set pwd1 */
+    input_buf[3] = pwd[2];                                                                       /* set pwd2 */
+    input_buf[4] = pwd[3];                                                                       /* set pwd3 */
+    a_mifare_ultralight_iso14443a_crc(input_buf, 5, input_buf + 5);                              /* get the crc */
+    output_len = 4;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
     if (res != 0)                                                                                /* check the result */
     {
         handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
         
         return 1;                                                                                /* return error */
     }
-    if (output_len != 1)                                                                         /* check the output_len */
+    if (output_len != 4)                                                                         /* check the output_len */
     {
         handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
         
         return 4;                                                                                /* return error */
     }
-    if (output_buf[0] == 0x04)                                                                   /* check the sak */
+    a_mifare_ultralight_iso14443a_crc(output_buf, 2, crc_buf);                                   /* get the crc */
+    if ((output_buf[2] == crc_buf[0]) && (output_buf[3] == crc_buf[1]))                          /* check the crc */
     {
+        if ((output_buf[0] != pack[0]) || (output_buf[1] != pack[1]))                            /* check the pack */
+        {
+            handle->debug_print("mifare_ultralight: pack check failed.\n");                      /* pack check failed. */
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_PACK);                 /* record the error */
+            
+            return 6;                                                                            /* return error */
+        }
+        handle->auth = 1;                                                                        /* authenticated */
+        
         return 0;                                                                                /* success return 0 */
     }
     else
     {
-        handle->debug_print("mifare_ultralight: sak error.\n");                                  /* sak error */
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
         
         return 5;                                                                                /* return error */
     }
 }
 
 /**
- * @brief     mifare_ultralight select cl2
+ * @brief     mifare_ultralight set the auto authenticate
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] *id pointer to an id buffer
+ * @param[in] *pwd pointer to a pwd buffer, NULL turns auto authenticate off
+ * @param[in] *pack pointer to a pack buffer
  * @return    status code
  *            - 0 success
- *            - 1 select cl2 failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 output_len is invalid
- *            - 5 sak error
- * @note      none
+ *            - 4 pack is NULL
+ * @note      page reads and writes, otp, lock, key and conf access send PWD_AUTH first when
+ *            the session is not authenticated and the page is protected, every user page is
+ *            taken as protected while auth0 is not in the conf shadow, the async operations
+ *            do not authenticate by themselves
  */
-uint8_t mifare_ultralight_select_cl2(mifare_ultralight_handle_t *handle, uint8_t id[4])
+uint8_t mifare_ultralight_set_auto_authenticate(mifare_ultralight_handle_t *handle, uint8_t pwd[4], uint8_t pack[2])
 {
-    uint8_t res;
-    uint8_t i;
-    uint8_t input_len;
-    uint8_t input_buf[9];
-    uint8_t output_len;
-    uint8_t output_buf[1];
-    
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                      /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                           /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                      /* return error */
     }
     
-    input_len = 9;                                                                               /* set the input length */
-    input_buf[0] = (MIFARE_ULTRALIGHT_COMMAND_SELECT_CL2 >> 8) & 0xFF;                           /* set the command */
-    input_buf[1] = (MIFARE_ULTRALIGHT_COMMAND_SELECT_CL2 >> 0) & 0xFF;                           /* set the command */
-    input_buf[6] = 0;                                                                            /* init 0 */
-    for (i = 0; i < 4; i++)                                                                      /* run 4 times */
-    {
-        input_buf[2 + i] = id[i];                                                                /* get one id */
-        input_buf[6] ^= id[i];                                                                   /* xor */
-    }
-    a_mifare_ultralight_iso14443a_crc(input_buf, 7, input_buf + 7);                              /* get the crc */
-    output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
-    }
-    if (output_len != 1)                                                                         /* check the output_len */
+    if (pwd == NULL)                                                   /* turn off */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        handle->auth_auto = 0;                                         /* no auto authenticate */
         
-        return 4;                                                                                /* return error */
-    }
-    if (output_buf[0] == 0x00)                                                                   /* check the sak */
-    {
-        return 0;                                                                                /* success return 0 */
+        return 0;                                                      /* success return 0 */
     }
-    else
+    if (pack == NULL)                                                  /* check pack */
     {
-        handle->debug_print("mifare_ultralight: sak error.\n");                                  /* sak error */
+        handle->debug_print("mifare_ultralight: pack is null.\n");     /* pack is null */
         
-        return 5;                                                                                /* return error */
+        return 4;                                                      /* return error */
     }
+    memcpy(handle->auth_pwd, pwd, 4);                                  /* copy the pwd */
+    memcpy(handle->auth_pack, pack, 2);                                /* copy the pack */
+    handle->auth_auto = 1;                                             /* auto authenticate */
+    
+    return 0;                                                          /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight get the version
+ * @brief      mifare_ultralight get the authenticated session
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *version pointer to a version structure
+ * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get version failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 crc error
  * @note       none
  */
-uint8_t mifare_ultralight_get_version(mifare_ultralight_handle_t *handle, mifare_ultralight_version_t *version)
+uint8_t mifare_ultralight_get_authenticated(mifare_ultralight_handle_t *handle, mifare_ultralight_bool_t *enable)
 {
-    uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[3];
-    uint8_t output_len;
-    uint8_t output_buf[10];
-    uint8_t crc_buf[2];
-    
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                      /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                           /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                      /* return error */
     }
     
-    input_len = 3;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_GET_VERSION;                                        /* set the command */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 1, input_buf + 1);                              /* get the crc */
-    output_len = 10;                                                                             /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
-    }
-    if (output_len != 10)                                                                        /* check the output_len */
-    {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
-        
-        return 4;                                                                                /* return error */
-    }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 8, crc_buf);                                   /* get the crc */
-    if ((output_buf[8] == crc_buf[0]) && (output_buf[9] == crc_buf[1]))                          /* check the crc */
-    {
-        version->fixed_header = output_buf[0];                                                   /* fixed header */
-        version->vendor_id = output_buf[1];                                                      /* vendor id */
-        version->product_type = output_buf[2];                                                   /* product type */
-        version->product_subtype = output_buf[3];                                                /* product subtype */
-        version->major_product_version = output_buf[4];                                          /* major product version */
-        version->minor_product_version = output_buf[5];                                          /* minor product version */
-        version->storage_size = output_buf[6];                                                   /* storage size */
-        if (version->storage_size == 0x0B)                                                       /* if 20 pages */
-        {
-            handle->end_page = MIFARE_ULTRALIGHT_STORAGE_MF0UL11;                                /* set the end page */
-        }
-        else if (version->storage_size == 0x0E)                                                  /* if 41 pages */
-        {
-            handle->end_page = MIFARE_ULTRALIGHT_STORAGE_MF0UL21;                                /* set the end page */
-        }
-        else
-        {
-                                                                                                 /* do nothing */
-        }
-        version->protocol_type = output_buf[7];                                                  /* protocol type */
-        
-        return 0;                                                                                /* success return 0 */
-    }
-    else
-    {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
-        
-        return 5;                                                                                /* return error */
-    }
+    *enable = (handle->auth != 0) ? MIFARE_ULTRALIGHT_BOOL_TRUE : MIFARE_ULTRALIGHT_BOOL_FALSE;    /* get the session */
+    
+    return 0;                                                          /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight read the counter
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[in]  addr read counter address
- * @param[out] *cnt pointer to a counter buffer
- * @return     status code
- *             - 0 success
- *             - 1 read counter failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 crc error
- *             - 6 addr > 0x2
- * @note       0 <= addr <= 2
+ * @brief     mifare_ultralight set the password
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *pwd pointer to a password buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 set pwd failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 output_len is invalid
+ *            - 5 ack error
+ * @note      none
  */
-uint8_t mifare_ultralight_read_counter(mifare_ultralight_handle_t *handle, uint8_t addr, uint32_t *cnt)
+uint8_t mifare_ultralight_set_password(mifare_ultralight_handle_t *handle, uint8_t pwd[4])
 {
     uint8_t res;
     uint8_t input_len;
-    uint8_t input_buf[4];
+    uint8_t input_buf[8];
     uint8_t output_len;
-    uint8_t output_buf[5];
-    uint8_t crc_buf[2];
+    uint8_t output_buf[1];
     
     if (handle == NULL)                                                                          /* check handle */
     {
@@ -886,63 +5246,59 @@ uint8_t mifare_ultralight_read_counter(mifare_ultralight_handle_t *handle, uint8
     {
         return 3;                                                                                /* return error */
     }
-    if (addr > 0x2)                                                                              /* check the addr */
+    
+    if (a_mifare_ultralight_auto_auth(handle, handle->end_page - 1, 1) != 0)                     /* authenticate when needed */
     {
-        handle->debug_print("mifare_ultralight: addr > 0x2.\n");                                 /* addr > 0x2 */
-        
-        return 6;                                                                                /* return error */
+        return 1;                                                                                /* return error */
     }
-    
-    input_len = 4;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_READ_CNT;                                           /* set the command */
-    input_buf[1] = addr;                                                                         /* set the address */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 2, input_buf + 2);                              /* get the crc */
-    output_len = 5;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
+    input_len = 8;                                                                               /* set the input length */
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
+    input_buf[1] = handle->end_page - 1;                                                         /* set the last page */
+    input_buf[2] = pwd[0];                                                                       /* set pwd0 */
+    input_buf[3] = pwd[1];                                                                       /* set pwd1 */
+    input_buf[4] = pwd[2];                                                                       /* set pwd2 */
+    input_buf[5] = pwd[3];                                                                       /* set pwd3 */
+    a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
+    output_len = 1;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
     if (res != 0)                                                                                /* check the result */
     {
         handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
         
         return 1;                                                                                /* return error */
     }
-    if (output_len != 5)                                                                         /* check the output_len */
+    if (output_len != 1)                                                                         /* check the output_len */
     {
         handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
         
         return 4;                                                                                /* return error */
     }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 3, crc_buf);                                   /* get the crc */
-    if ((output_buf[3] == crc_buf[0]) && (output_buf[4] == crc_buf[1]))                          /* check the result */
-    {
-        *cnt = ((uint32_t)output_buf[2] << 16) | ((uint32_t)output_buf[1] << 8) |
-               ((uint32_t)output_buf[0] << 0);                                                   /* set the counter */
-        
-        return 0;                                                                                /* success return 0 */
-    }
-    else
+    if (output_buf[0] != 0xA)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        a_mifare_ultralight_ack_error(handle, output_buf[0]);                                    /* decode the nak */
         
         return 5;                                                                                /* return error */
     }
+    
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight increment the counter
+ * @brief     mifare_ultralight set the pack
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] addr read counter address
- * @param[in] cnt increment counter
+ * @param[in] *pack pointer to a pack buffer
  * @return    status code
  *            - 0 success
- *            - 1 increment counter failed
+ *            - 1 set pack failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 output_len is invalid
  *            - 5 ack error
- *            - 6 addr > 0x2
- * @note      0 <= addr <= 2
+ * @note      none
  */
-uint8_t mifare_ultralight_increment_counter(mifare_ultralight_handle_t *handle, uint8_t addr, uint32_t cnt)
+uint8_t mifare_ultralight_set_pack(mifare_ultralight_handle_t *handle, uint8_t pack[2])
 {
     uint8_t res;
     uint8_t input_len;
@@ -958,38 +5314,38 @@ uint8_t mifare_ultralight_increment_counter(mifare_ultralight_handle_t *handle,
     {
         return 3;                                                                                /* return error */
     }
-    if (addr > 0x2)                                                                              /* check the addr */
+    
+    if (a_mifare_ultralight_auto_auth(handle, handle->end_page, 1) != 0)                         /* authenticate when needed */
     {
-        handle->debug_print("mifare_ultralight: addr > 0x2.\n");                                 /* addr > 0x2 */
-        
-        return 6;                                                                                /* return error */
+        return 1;                                                                                /* return error */
     }
-
     input_len = 8;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_INCR_CNT;                                           /* set the command */
-    input_buf[1] = addr;                                                                         /* set the address */
-    input_buf[2] = (cnt >> 0) & 0xFF;                                                            /* set cnt */
-    input_buf[3] = (cnt >> 8) & 0xFF;                                                            /* set cnt */
-    input_buf[4] = (cnt >> 16) & 0xFF;                                                           /* set cnt */
-    input_buf[5] = 0x00;
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
+    input_buf[1] = handle->end_page;                                                             /* set the last page */
+    input_buf[2] = pack[0];                                                                      /* set pack0 */
+    input_buf[3] = pack[1];                                                                      /* set pack1 */
+    input_buf[4] = 0x00;                                                                         /* set 0x00 */
+    input_buf[5] = 0x00;                                                                         /* set 0x00 */
     a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
     output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
     if (res != 0)                                                                                /* check the result */
     {
         handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
         
         return 1;                                                                                /* return error */
     }
     if (output_len != 1)                                                                         /* check the output_len */
     {
         handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
         
         return 4;                                                                                /* return error */
     }
     if (output_buf[0] != 0xA)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: ack error.\n");                                  /* ack error */
+        a_mifare_ultralight_ack_error(handle, output_buf[0]);                                    /* decode the nak */
         
         return 5;                                                                                /* return error */
     }
@@ -998,738 +5354,645 @@ uint8_t mifare_ultralight_increment_counter(mifare_ultralight_handle_t *handle,
 }
 
 /**
- * @brief      mifare_ultralight check the tearing event
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[in]  addr check address
- * @param[out] *flag pointer to a flag buffer
- * @return     status code
- *             - 0 success
- *             - 1 check tearing event failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 crc error
- *             - 6 addr > 0x2
- * @note       0 <= addr <= 2
+ * @brief     mifare_ultralight begin a configuration transaction
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the configuration setters only change the shadow until commit,
+ *            request, wake up, halt and set storage drop an open transaction,
+ *            a raw write of a configuration page drops the pending change of that page
  */
-uint8_t mifare_ultralight_check_tearing_event(mifare_ultralight_handle_t *handle, uint8_t addr, uint8_t *flag)
+uint8_t mifare_ultralight_conf_begin(mifare_ultralight_handle_t *handle)
 {
-    uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[4];
-    uint8_t output_len;
-    uint8_t output_buf[3];
-    uint8_t crc_buf[2];
-    
-    if (handle == NULL)                                                                          /* check handle */
-    {
-        return 2;                                                                                /* return error */
-    }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle == NULL)                         /* check handle */
     {
-        return 3;                                                                                /* return error */
+        return 2;                               /* return error */
     }
-    if (addr > 0x2)                                                                              /* check the addr */
+    if (handle->inited != 1)                    /* check handle initialization */
     {
-        handle->debug_print("mifare_ultralight: addr > 0x2.\n");                                 /* addr > 0x2 */
-        
-        return 6;                                                                                /* return error */
+        return 3;                               /* return error */
     }
     
-    input_len = 4;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_CHECK_TEARING_EVENT;                                /* set the command */
-    input_buf[1] = addr;                                                                         /* set the address */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 2, input_buf + 2);                              /* get the crc */
-    output_len = 3;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
-    }
-    if (output_len != 3)                                                                         /* check the output_len */
-    {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
-        
-        return 4;                                                                                /* return error */
-    }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 1, crc_buf);                                   /* get the crc */
-    if ((output_buf[1] == crc_buf[0]) && (output_buf[2] == crc_buf[1]))                          /* check the result */
-    {
-        *flag = output_buf[0];                                                                   /* set the output buffer */
-        
-        return 0;                                                                                /* success return 0 */
-    }
-    else
-    {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
-        
-        return 5;                                                                                /* return error */
-    }
+    handle->conf_transaction = 1;               /* open the transaction */
+    
+    return 0;                                   /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight vcsl command
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[in]  *installation_identifier pointer to an installation identifier buffer
- * @param[in]  *pcd_capabilities pointer to a pcd capabilities buffer
- * @param[out] *identifier pointer to an identifier buffer
- * @return     status code
- *             - 0 success
- *             - 1 vcsl failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 crc error
- * @note       none
+ * @brief     mifare_ultralight commit a configuration transaction
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 conf commit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      each dirty configuration page is written once
  */
-uint8_t mifare_ultralight_vcsl(mifare_ultralight_handle_t *handle, uint8_t installation_identifier[16],
-                               uint8_t pcd_capabilities[4], uint8_t *identifier)
+uint8_t mifare_ultralight_conf_commit(mifare_ultralight_handle_t *handle)
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[23];
-    uint8_t output_len;
-    uint8_t output_buf[3];
-    uint8_t crc_buf[2];
+    uint8_t i;
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                                             /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                                   /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                                        /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                                   /* return error */
     }
     
-    input_len = 23;                                                                              /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_CHECK_TEARING_EVENT;                                /* set the command */
-    memcpy(input_buf + 1, installation_identifier, 16);
-    memcpy(input_buf + 17, pcd_capabilities, 4);
-    a_mifare_ultralight_iso14443a_crc(input_buf, 21, input_buf + 21);                            /* get the crc */
-    output_len = 3;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
-    }
-    if (output_len != 3)                                                                         /* check the output_len */
+    handle->conf_transaction = 0;                                                                   /* close the transaction */
+    for (i = 0; i < 2; i++)                                                                         /* write all dirty pages */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
-        
-        return 4;                                                                                /* return error */
+        if ((handle->conf_dirty & (1 << i)) != 0)                                                   /* check the dirty flag */
+        {
+            handle->conf_dirty &= (uint8_t)(~(1 << i));                                             /* clear the dirty flag */
+            res = a_mifare_ultralight_conf_store(handle, i, handle->conf[i]);                       /* store conf */
+            if (res != 0)                                                                           /* check the result */
+            {
+                handle->conf_valid &= (uint8_t)(~handle->conf_dirty);                               /* drop the other dirty page */
+                handle->conf_dirty = 0;                                                             /* clear the dirty flag */
+                handle->debug_print("mifare_ultralight: conf write failed.\n");                     /* conf write failed */
+                
+                return 1;                                                                           /* return error */
+            }
+        }
     }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 1, crc_buf);                                   /* get the crc */
-    if ((output_buf[1] == crc_buf[0]) && (output_buf[2] == crc_buf[1]))                          /* check the result */
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     mifare_ultralight abort a configuration transaction
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the dirty pages are dropped from the shadow
+ */
+uint8_t mifare_ultralight_conf_abort(mifare_ultralight_handle_t *handle)
+{
+    if (handle == NULL)                                                   /* check handle */
     {
-        *identifier = output_buf[0];                                                             /* set the output buffer */
-        
-        return 0;                                                                                /* success return 0 */
+        return 2;                                                         /* return error */
     }
-    else
+    if (handle->inited != 1)                                              /* check handle initialization */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
-        
-        return 5;                                                                                /* return error */
+        return 3;                                                         /* return error */
     }
+    
+    handle->conf_valid &= (uint8_t)(~handle->conf_dirty);                 /* drop the dirty pages */
+    handle->conf_dirty = 0;                                               /* clear the dirty flag */
+    handle->conf_transaction = 0;                                         /* close the transaction */
+    
+    return 0;                                                             /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight read the signature
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *signature pointer to a signature buffer
- * @return     status code
- *             - 0 success
- *             - 1 read signature failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 crc error
- * @note       none
+ * @brief     mifare_ultralight set the modulation mode
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] mode modulation mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set modulation mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t mifare_ultralight_read_signature(mifare_ultralight_handle_t *handle, uint8_t signature[32])
+uint8_t mifare_ultralight_set_modulation_mode(mifare_ultralight_handle_t *handle, mifare_ultralight_modulation_mode_t mode)
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[4];
-    uint8_t output_len;
-    uint8_t output_buf[34];
-    uint8_t crc_buf[2];
-    
-    if (handle == NULL)                                                                          /* check handle */
-    {
-        return 2;                                                                                /* return error */
-    }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
-    {
-        return 3;                                                                                /* return error */
-    }
+    uint8_t conf[4];
     
-    input_len = 4;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_READ_SIG;                                           /* set the command */
-    input_buf[1] = 0x00;                                                                         /* set the address */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 2, input_buf + 2);                              /* get the crc */
-    output_len = 34;                                                                             /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
     }
-    if (output_len != 34)                                                                        /* check the output_len */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
-        
-        return 4;                                                                                /* return error */
+        return 3;                                                                    /* return error */
     }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 32, crc_buf);                                  /* get the crc */
-    if ((output_buf[32] == crc_buf[0]) && (output_buf[33] == crc_buf[1]))                        /* check the result */
+    
+    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
+    res = a_mifare_ultralight_conf_load(handle, 0, conf);                            /* load conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        memcpy(signature, output_buf, 32);                                                       /* copy the data */
+        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
         
-        return 0;                                                                                /* success return 0 */
+        return 1;                                                                    /* return error */
     }
-    else
+    conf[0] &= ~(1 << 2);                                                            /* clear the settings */
+    conf[0] |= mode << 2;                                                            /* set the mode */
+    res = a_mifare_ultralight_conf_store(handle, 0, conf);                           /* store conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        handle->debug_print("mifare_ultralight: conf write failed.\n");              /* conf write failed */
         
-        return 5;                                                                                /* return error */
+        return 1;                                                                    /* return error */
     }
+    
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight get the serial number
+ * @brief      mifare_ultralight get the modulation mode
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *number pointer to a number buffer
+ * @param[out] *mode pointer to a modulation mode buffer
  * @return     status code
  *             - 0 success
- *             - 1 get serial number failed
+ *             - 1 get modulation mode failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 crc error
  * @note       none
  */
-uint8_t mifare_ultralight_get_serial_number(mifare_ultralight_handle_t *handle, uint8_t number[7])
+uint8_t mifare_ultralight_get_modulation_mode(mifare_ultralight_handle_t *handle, mifare_ultralight_modulation_mode_t *mode)
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[4];
-    uint8_t output_len;
-    uint8_t output_buf[18];
-    uint8_t crc_buf[2];
+    uint8_t conf[4];
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    input_len = 4;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_READ;                                               /* set the command */
-    input_buf[1] = 0x00;                                                                         /* set the read page */
-    a_mifare_ultralight_iso14443a_crc(input_buf , 2, input_buf + 2);                             /* get the crc */
-    output_len = 18;                                                                             /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
-    }
-    if (output_len != 18)                                                                        /* check the output_len */
-    {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
-        
-        return 4;                                                                                /* return error */
-    }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 16, crc_buf);                                  /* get the crc */
-    if ((output_buf[16] == crc_buf[0]) && (output_buf[17] == crc_buf[1]))                        /* check the crc */
-    {
-        number[0] = output_buf[0];                                                               /* set the number 0 */
-        number[1] = output_buf[1];                                                               /* set the number 1 */
-        number[2] = output_buf[2];                                                               /* set the number 2 */
-        number[3] = output_buf[4];                                                               /* set the number 3 */
-        number[4] = output_buf[5];                                                               /* set the number 4 */
-        number[5] = output_buf[6];                                                               /* set the number 5 */
-        number[6] = output_buf[7];                                                               /* set the number 6 */
-        
-        return 0;                                                                                /* success return 0 */
-    }
-    else
+    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
+    res = a_mifare_ultralight_conf_load(handle, 0, conf);                            /* load conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
         
-        return 5;                                                                                /* return error */
+        return 1;                                                                    /* return error */
     }
+    *mode = (mifare_ultralight_modulation_mode_t)((conf[0] >> 2) & 0x1);             /* get the conf */
+    
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight read four pages
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[in]  start_page start page of read
- * @param[out] *data pointer to a data buffer
- * @return     status code
- *             - 0 success
- *             - 1 read four pages failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 crc error
- * @note       none
+ * @brief     mifare_ultralight set the start page of protection
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] page start page
+ * @return    status code
+ *            - 0 success
+ *            - 1 set protect start page failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t mifare_ultralight_read_four_pages(mifare_ultralight_handle_t *handle, uint8_t start_page, uint8_t data[16])
+uint8_t mifare_ultralight_set_protect_start_page(mifare_ultralight_handle_t *handle, uint8_t page)
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[4];
-    uint8_t output_len;
-    uint8_t output_buf[18];
-    uint8_t crc_buf[2];
+    uint8_t conf[4];
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    input_len = 4;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_READ;                                               /* set the command */
-    input_buf[1] = start_page;                                                                   /* set the page */
-    a_mifare_ultralight_iso14443a_crc(input_buf , 2, input_buf + 2);                             /* get the crc */
-    output_len = 18;                                                                             /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
-    }
-    if (output_len != 18)                                                                        /* check the output_len */
-    {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
-        
-        return 4;                                                                                /* return error */
-    }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 16, crc_buf);                                  /* get the crc */
-    if ((output_buf[16] == crc_buf[0]) && (output_buf[17] == crc_buf[1]))                        /* check the crc */
+    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
+    res = a_mifare_ultralight_conf_load(handle, 0, conf);                            /* load conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        memcpy(data, output_buf, 16);                                                            /* copy the data */
+        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
         
-        return 0;                                                                                /* success return 0 */
+        return 1;                                                                    /* return error */
     }
-    else
+    conf[3] = page;                                                                  /* set the page */
+    res = a_mifare_ultralight_conf_store(handle, 0, conf);                           /* store conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        handle->debug_print("mifare_ultralight: conf write failed.\n");              /* conf write failed */
         
-        return 5;                                                                                /* return error */
+        return 1;                                                                    /* return error */
     }
+    
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight read page
+ * @brief      mifare_ultralight get the start page of protection
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[in]  page page of read
- * @param[out] *data pointer to a data buffer
+ * @param[out] *page pointer to a start page buffer
  * @return     status code
  *             - 0 success
- *             - 1 read page failed
+ *             - 1 get protect start page failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 crc error
  * @note       none
  */
-uint8_t mifare_ultralight_read_page(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4])
+uint8_t mifare_ultralight_get_protect_start_page(mifare_ultralight_handle_t *handle, uint8_t *page)
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[4];
-    uint8_t output_len;
-    uint8_t output_buf[18];
-    uint8_t crc_buf[2];
+    uint8_t conf[4];
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    input_len = 4;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_READ;                                               /* set the command */
-    input_buf[1] = page;                                                                         /* set the page */
-    a_mifare_ultralight_iso14443a_crc(input_buf , 2, input_buf + 2);                             /* get the crc */
-    output_len = 18;                                                                             /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
-    }
-    if (output_len != 18)                                                                        /* check the output_len */
-    {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
-        
-        return 4;                                                                                /* return error */
-    }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 16, crc_buf);                                  /* get the crc */
-    if ((output_buf[16] == crc_buf[0]) && (output_buf[17] == crc_buf[1]))                        /* check the crc */
-    {
-        memcpy(data, output_buf, 4);                                                             /* copy the data */
-        
-        return 0;                                                                                /* success return 0 */
-    }
-    else
+    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
+    res = a_mifare_ultralight_conf_load(handle, 0, conf);                            /* load conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
         
-        return 5;                                                                                /* return error */
+        return 1;                                                                    /* return error */
     }
+    *page = conf[3];                                                                 /* get the page */
+    
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief         mifare_ultralight fast read page
- * @param[in]     *handle pointer to a mifare_ultralight handle structure
- * @param[in]     start_page start page
- * @param[in]     stop_page stop page
- * @param[out]    *data pointer to a data buffer
- * @param[in,out] *len pointer to a data length buffer
- * @return        status code
- *                - 0 success
- *                - 1 fast read page failed
- *                - 2 handle is NULL
- *                - 3 handle is not initialized
- *                - 4 stop_page < start_page
- *                - 5 stop_page - start_page + 1 is over 15
- *                - 6 len is invalid
- *                - 7 output_len is invalid
- *                - 8 crc error
- * @note          stop_page - start_page + 1 <= 15
- *                4 * (stop_page - start_page + 1) < len
+ * @brief     mifare_ultralight enable or disable access
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] access set access
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set access failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t mifare_ultralight_fast_read_page(mifare_ultralight_handle_t *handle, uint8_t start_page, uint8_t stop_page, uint8_t *data, uint16_t *len)
+uint8_t mifare_ultralight_set_access(mifare_ultralight_handle_t *handle, mifare_ultralight_access_t access, mifare_ultralight_bool_t enable)
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[5];
-    uint8_t output_len;
-    uint8_t cal_len;
-    uint8_t output_buf[64];
-    uint8_t crc_buf[2];
+    uint8_t conf[4];
     
-    if (handle == NULL)                                                                                 /* check handle */
-    {
-        return 2;                                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                                            /* check handle initialization */
-    {
-        return 3;                                                                                       /* return error */
-    }
-    if (stop_page < start_page)                                                                         /* check start and stop page */
-    {
-        handle->debug_print("mifare_ultralight: stop_page < start_page.\n");                            /* stop_page < start_page */
-        
-        return 4;                                                                                       /* return error */
-    }
-    if (stop_page - start_page + 1 > 15)                                                                /* check start and stop page */
+    if (handle == NULL)                                                              /* check handle */
     {
-        handle->debug_print("mifare_ultralight: stop_page - start_page + 1 is over 15.\n");             /* stop_page - start_page + 1 is over 15 */
-        
-        return 5;                                                                                       /* return error */
+        return 2;                                                                    /* return error */
     }
-    if ((*len) < (4 * (stop_page - start_page + 1)))                                                    /* check the length */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        handle->debug_print("mifare_ultralight: len < %d.\n", 4 * (stop_page - start_page + 1));        /* len is invalid */
-        
-        return 6;                                                                                       /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    input_len = 5;                                                                                      /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_FAST_READ;                                                 /* set the command */
-    input_buf[1] = start_page;                                                                          /* set the start page */
-    input_buf[2] = stop_page;                                                                           /* set the stop page */
-    a_mifare_ultralight_iso14443a_crc(input_buf , 3, input_buf + 3);                                    /* get the crc */
-    cal_len = 4 * (stop_page - start_page + 1);                                                         /* set the cal length */
-    output_len = (uint8_t)(cal_len + 2);                                                                /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);               /* transceiver */
-    if (res != 0)                                                                                       /* check the result */
+    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
+    res = a_mifare_ultralight_conf_load(handle, 1, conf);                            /* load conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");                    /* contactless transceiver failed */
+        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
         
-        return 1;                                                                                       /* return error */
+        return 1;                                                                    /* return error */
     }
-    if (output_len != (cal_len + 2))                                                                    /* check the output_len */
+    conf[0] &= ~(1 << access);                                                       /* clear the settings */
+    conf[0] |= enable << access;                                                     /* set the access */
+    res = a_mifare_ultralight_conf_store(handle, 1, conf);                           /* store conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                             /* output_len is invalid */
+        handle->debug_print("mifare_ultralight: conf write failed.\n");              /* conf write failed */
         
-        return 7;                                                                                       /* return error */
+        return 1;                                                                    /* return error */
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight get the access status
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  access set access
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get access failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_access(mifare_ultralight_handle_t *handle, mifare_ultralight_access_t access, mifare_ultralight_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t conf[4];
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
     }
-    a_mifare_ultralight_iso14443a_crc(output_buf, (uint8_t)cal_len, crc_buf);                           /* get the crc */
-    if ((output_buf[cal_len] == crc_buf[0]) && (output_buf[cal_len + 1] == crc_buf[1]))                 /* check the crc */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        memcpy(data, output_buf, cal_len);                                                              /* copy the data */
-        *len = cal_len;                                                                                 /* set the length */
-        
-        return 0;                                                                                       /* success return 0 */
+        return 3;                                                                    /* return error */
     }
-    else
+    
+    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
+    res = a_mifare_ultralight_conf_load(handle, 1, conf);                            /* load conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                         /* crc error */
+        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
         
-        return 8;                                                                                       /* return error */
+        return 1;                                                                    /* return error */
     }
+    *enable = (mifare_ultralight_bool_t)((conf[0] >> access) & 0x1);                 /* get the bool */
+    
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight compatibility write page
+ * @brief     mifare_ultralight set the authenticate limitation
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] page page of write
- * @param[in] *data pointer to a data buffer
+ * @param[in] limit authenticate limitation
  * @return    status code
  *            - 0 success
- *            - 1 compatibility write page failed
+ *            - 1 set authenticate limitation failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 output_len is invalid
- *            - 5 ack error
+ *            - 4 limit > 7
  * @note      none
  */
-uint8_t mifare_ultralight_compatibility_write_page(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4])
+uint8_t mifare_ultralight_set_authenticate_limitation(mifare_ultralight_handle_t *handle, uint8_t limit)
 {
     uint8_t res;
-    uint8_t i;
-    uint8_t input_len;
-    uint8_t input_buf[18];
-    uint8_t output_len;
-    uint8_t output_buf[1];
+    uint8_t conf[4];
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                    /* return error */
     }
-    
-    input_len = 4;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_COMP_WRITE;                                         /* set the command */
-    input_buf[1] = page;                                                                         /* set the page */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 2, input_buf + 2);                              /* get the crc */
-    output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    if (limit > 7)                                                                   /* check the limit */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        handle->debug_print("mifare_ultralight: limit > 7.\n");                      /* limit > 7 */
         
-        return 1;                                                                                /* return error */
+        return 4;                                                                    /* return error */
     }
-    if (output_len != 1)                                                                         /* check the output_len */
+    
+    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
+    res = a_mifare_ultralight_conf_load(handle, 1, conf);                            /* load conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
         
-        return 4;                                                                                /* return error */
+        return 1;                                                                    /* return error */
     }
-    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    conf[0] &= ~(7 << 0);                                                            /* clear the settings */
+    conf[0] |= limit << 0;                                                           /* set the limit */
+    res = a_mifare_ultralight_conf_store(handle, 1, conf);                           /* store conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: ack error.\n");                                  /* ack error */
+        handle->debug_print("mifare_ultralight: conf write failed.\n");              /* conf write failed */
         
-        return 5;                                                                                /* return error */
+        return 1;                                                                    /* return error */
     }
     
-    for (i = 0; i < 4; i ++)                                                                     /* 4 times */
-    {
-        input_buf[i] = data[i];                                                                  /* copy data */
-    }
-    for (i = 0; i < 12; i ++)                                                                    /* 12 times */
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight get the authenticate limitation
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *limit pointer to an authenticate limitation buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get authenticate limitation failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_authenticate_limitation(mifare_ultralight_handle_t *handle, uint8_t *limit)
+{
+    uint8_t res;
+    uint8_t conf[4];
+    
+    if (handle == NULL)                                                              /* check handle */
     {
-        input_buf[4 + i] = 0x00;                                                                 /* copy data */
+        return 2;                                                                    /* return error */
     }
-    a_mifare_ultralight_iso14443a_crc(input_buf, 16, input_buf + 16);                            /* get the crc */
-    input_len = 18;                                                                              /* set the input length */
-    output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
+        return 3;                                                                    /* return error */
     }
-    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    
+    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
+    res = a_mifare_ultralight_conf_load(handle, 1, conf);                            /* load conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: ack error.\n");                                  /* ack error */
+        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
         
-        return 5;                                                                                /* return error */
+        return 1;                                                                    /* return error */
     }
+    *limit = conf[0] & 0x7;                                                          /* set the limit */
     
-    return 0;                                                                                    /* success return 0 */
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight write page
+ * @brief     mifare_ultralight set the virtual card type identifier
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] page page of write
- * @param[in] *data pointer to a data buffer
+ * @param[in] identifier virtual card type identifier
  * @return    status code
  *            - 0 success
- *            - 1 write page failed
+ *            - 1 set virtual card type identifier failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 output_len is invalid
- *            - 5 ack error
  * @note      none
  */
-uint8_t mifare_ultralight_write_page(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4])
+uint8_t mifare_ultralight_set_virtual_card_type_identifier(mifare_ultralight_handle_t *handle, uint8_t identifier)
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[8];
-    uint8_t output_len;
-    uint8_t output_buf[1];
+    uint8_t conf[4];
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    input_len = 8;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
-    input_buf[1] = page;                                                                         /* set the page */
-    input_buf[2] = data[0];                                                                      /* set data0 */
-    input_buf[3] = data[1];                                                                      /* set data1 */
-    input_buf[4] = data[2];                                                                      /* set data2 */
-    input_buf[5] = data[3];                                                                      /* set data3 */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
-    output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
+    res = a_mifare_ultralight_conf_load(handle, 1, conf);                            /* load conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
         
-        return 1;                                                                                /* return error */
+        return 1;                                                                    /* return error */
     }
-    if (output_len != 1)                                                                         /* check the output_len */
+    conf[1] = identifier;                                                            /* set the identifier */
+    res = a_mifare_ultralight_conf_store(handle, 1, conf);                           /* store conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        handle->debug_print("mifare_ultralight: conf write failed.\n");              /* conf write failed */
         
-        return 4;                                                                                /* return error */
+        return 1;                                                                    /* return error */
     }
-    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      mifare_ultralight get the virtual card type identifier
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *identifier pointer to a virtual card type identifier buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get virtual card type identifier failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_virtual_card_type_identifier(mifare_ultralight_handle_t *handle, uint8_t *identifier)
+{
+    uint8_t res;
+    uint8_t conf[4];
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
+    res = a_mifare_ultralight_conf_load(handle, 1, conf);                            /* load conf */
+    if (res != 0)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: ack error.\n");                                  /* ack error */
+        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
         
-        return 5;                                                                                /* return error */
+        return 1;                                                                    /* return error */
     }
+    *identifier = conf[1];                                                           /* get the identifier */
     
-    return 0;                                                                                    /* success return 0 */
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight authenticate
- * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] *pwd pointer to a pwd buffer
- * @param[in] *pack pointer to a pack buffer
- * @return    status code
- *            - 0 success
- *            - 1 authenticate failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 output_len is invalid
- *            - 5 crc error
- *            - 6 pack check failed
- * @note      none
+ * @brief      mifare_ultralight get the configuration snapshot
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *snapshot pointer to a snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get snapshot failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 storage is invalid
+ *             - 5 pages are protected
+ * @note       pages 2 to the end page are read with the fewest fast read frames,
+ *             lock[2] - lock[4] are only valid on the MF0UL21,
+ *             the ultralight ev1 has no mirror, cfg0 keeps the raw bytes
  */
-uint8_t mifare_ultralight_authenticate(mifare_ultralight_handle_t *handle, uint8_t pwd[4], uint8_t pack[2])
+uint8_t mifare_ultralight_get_snapshot(mifare_ultralight_handle_t *handle, mifare_ultralight_snapshot_t *snapshot)
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[7];
-    uint8_t output_len;
-    uint8_t output_buf[4];
-    uint8_t crc_buf[2];
+    uint8_t protected_page;
+    uint8_t *cfg;
+    uint8_t buf[4 * ((uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21 - 1) + 2];
+    uint16_t len;
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                                           /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                                 /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                                      /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                                 /* return error */
     }
-    
-    input_len = 7;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_PWD_AUTH;                                           /* set the command */
-    input_buf[1] = pwd[0];                                                                       /* set pwd0 */
-    input_buf[2] = pwd[1];                                                                       /* set pwd1 */
-    input_buf[3] = pwd[2];                                                                       /* set pwd2 */
-    input_buf[4] = pwd[3];                                                                       /* set pwd3 */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 5, input_buf + 5);                              /* get the crc */
-    output_len = 4;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    if (handle->end_page > (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21)                            /* check the storage */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        handle->debug_print("mifare_ultralight: storage is invalid.\n");                          /* storage is invalid */
         
-        return 1;                                                                                /* return error */
+        return 4;                                                                                 /* return error */
     }
-    if (output_len != 4)                                                                         /* check the output_len */
+    
+    len = sizeof(buf);                                                                            /* set the buffer length */
+    res = mifare_ultralight_read_range(handle, 0x02, handle->end_page, buf, &len, &protected_page);        /* read page 2 - end page */
+    if (res != 0)                                                                                 /* check the result */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        handle->debug_print("mifare_ultralight: read range failed.\n");                           /* read range failed */
         
-        return 4;                                                                                /* return error */
+        return 1;                                                                                 /* return error */
     }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 2, crc_buf);                                   /* get the crc */
-    if ((output_buf[2] == crc_buf[0]) && (output_buf[3] == crc_buf[1]))                          /* check the crc */
+    if (protected_page != 0xFF)                                                                   /* check the protected page */
     {
-        if ((output_buf[0] != pack[0]) || (output_buf[1] != pack[1]))                            /* check the pack */
-        {
-            handle->debug_print("mifare_ultralight: pack check failed.\n");                      /* pack check failed. */
-            
-            return 6;                                                                            /* return error */
-        }
+        handle->debug_print("mifare_ultralight: pages are protected.\n");                         /* pages are protected */
         
-        return 0;                                                                                /* success return 0 */
+        return 5;                                                                                 /* return error */
     }
-    else
-    {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
-        
-        return 5;                                                                                /* return error */
+    
+    memset(snapshot, 0, sizeof(mifare_ultralight_snapshot_t));                                    /* clear the snapshot */
+    memcpy(snapshot->lock, buf + 2, 2);                                                           /* copy the static lock */
+    if (handle->end_page == (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21)                           /* check the dynamic lock */
+    {
+        memcpy(snapshot->lock + 2, buf + 4 * (handle->end_page - 4 - 2), 3);                      /* copy the dynamic lock */
+    }
+    memcpy(snapshot->otp, buf + 4, 4);                                                            /* copy the otp */
+    cfg = buf + 4 * (handle->end_page - 3 - 2);                                                   /* set the cfg0 */
+    memcpy(snapshot->cfg0, cfg, 4);                                                               /* copy the cfg0 */
+    memcpy(snapshot->cfg1, cfg + 4, 4);                                                           /* copy the cfg1 */
+    snapshot->mode = (mifare_ultralight_modulation_mode_t)((cfg[0] >> 2) & 0x1);                  /* get the modulation mode */
+    snapshot->protect_start_page = cfg[3];                                                        /* get the auth0 */
+    snapshot->access = cfg[4];                                                                    /* get the access */
+    snapshot->read_protection = (mifare_ultralight_bool_t)((cfg[4] >> 
+                                (uint8_t)MIFARE_ULTRALIGHT_ACCESS_READ_PROTECTION) & 0x1);        /* get the prot */
+    snapshot->user_conf_protection = (mifare_ultralight_bool_t)((cfg[4] >> 
+                                     (uint8_t)MIFARE_ULTRALIGHT_ACCESS_USER_CONF_PROTECTION) & 0x1);       /* get the cfglck */
+    snapshot->authenticate_limitation = cfg[4] & 0x7;                                             /* get the authlim */
+    snapshot->virtual_card_type_identifier = cfg[5];                                              /* get the vctid */
+    if ((handle->conf_dirty & (1 << 0)) == 0)                                                     /* check the cfg0 shadow */
+    {
+        memcpy(handle->conf[0], cfg, 4);                                                          /* fill the cfg0 shadow */
+        handle->conf_valid |= (1 << 0);                                                           /* set the valid flag */
+    }
+    if ((handle->conf_dirty & (1 << 1)) == 0)                                                     /* check the cfg1 shadow */
+    {
+        memcpy(handle->conf[1], cfg + 4, 4);                                                      /* fill the cfg1 shadow */
+        handle->conf_valid |= (1 << 1);                                                           /* set the valid flag */
     }
+    
+    return 0;                                                                                     /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight set the password
+ * @brief     mifare_ultralight set the lock
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] *pwd pointer to a password buffer
+ * @param[in] *lock pointer to a lock buffer
  * @return    status code
  *            - 0 success
- *            - 1 set pwd failed
+ *            - 1 set lock failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 output_len is invalid
  *            - 5 ack error
- * @note      none
+ * @note                                                      byte0                                                                               
+ *            bit7            bit6            bit5            bit4             bit3             bit2             bit1             bit0            
+ *            lock_page_7     lock_page_6     lock_page_5     lock_page_4      lock_otp         block_page_15_10 block_page_9_4   bock_otp        
+ *                                                            byte1                                                                               
+ *            bit7            bit6            bit5            bit4             bit3             bit2             bit1             bit0            
+ *            lock_page_15    lock_page_14    lock_page_13    lock_page_12     lock_page_11     lock_page_10     lock_page_9      lock_page_8     
+ *                                                            byte2                                                                               
+ *            bit7            bit6            bit5            bit4             bit3             bit2             bit1             bit0            
+ *            lock_page_30-31 lock_page_28-29 lock_page_26-27 lock_page_24-25  lock_page_22-23  lock_page_20-21  lock_page_18-19  lock_page_16-17 
+ *                                                            byte3                                                                               
+ *            bit7            bit6            bit5            bit4             bit3             bit2             bit1             bit0            
+ *            rfui            rfui            rfui            rfui             rfui             rfui             lock_page_34-35  lock_page_32-22 
+ *                                                            byte4                                                                               
+ *            bit7            bit6            bit5            bit4             bit3             bit2             bit1             bit0            
+ *            rfui            rfui            rfui            block_page_32_35 block_page_28_31 block_page_24_27 block_page_20_23 block_page_16_19
  */
-uint8_t mifare_ultralight_set_password(mifare_ultralight_handle_t *handle, uint8_t pwd[4])
+uint8_t mifare_ultralight_set_lock(mifare_ultralight_handle_t *handle, uint8_t lock[5])
 {
     uint8_t res;
     uint8_t input_len;
@@ -1746,853 +6009,1539 @@ uint8_t mifare_ultralight_set_password(mifare_ultralight_handle_t *handle, uint8
         return 3;                                                                                /* return error */
     }
     
+    if (a_mifare_ultralight_auto_auth(handle, handle->end_page - 4, 1) != 0)                     /* authenticate when needed */
+    {
+        return 1;                                                                                /* return error */
+    }
     input_len = 8;                                                                               /* set the input length */
     input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
-    input_buf[1] = handle->end_page - 1;                                                         /* set the last page */
-    input_buf[2] = pwd[0];                                                                       /* set pwd0 */
-    input_buf[3] = pwd[1];                                                                       /* set pwd1 */
-    input_buf[4] = pwd[2];                                                                       /* set pwd2 */
-    input_buf[5] = pwd[3];                                                                       /* set pwd3 */
+    input_buf[1] = 0x02;                                                                         /* set the setting page */
+    input_buf[2] = 0x00;                                                                         /* set 0x00 */
+    input_buf[3] = 0x00;                                                                         /* set 0x00 */
+    input_buf[4] = lock[0];                                                                      /* set lock0 */
+    input_buf[5] = lock[1];                                                                      /* set lock1 */
     a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
     output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
     if (res != 0)                                                                                /* check the result */
     {
         handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
         
         return 1;                                                                                /* return error */
     }
     if (output_len != 1)                                                                         /* check the output_len */
     {
         handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
         
         return 4;                                                                                /* return error */
     }
     if (output_buf[0] != 0xA)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: ack error.\n");                                  /* ack error */
+        a_mifare_ultralight_ack_error(handle, output_buf[0]);                                    /* decode the nak */
         
         return 5;                                                                                /* return error */
     }
     
-    return 0;                                                                                    /* success return 0 */
-}
-
-/**
- * @brief     mifare_ultralight set the pack
- * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] *pack pointer to a pack buffer
- * @return    status code
- *            - 0 success
- *            - 1 set pack failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 output_len is invalid
- *            - 5 ack error
- * @note      none
- */
-uint8_t mifare_ultralight_set_pack(mifare_ultralight_handle_t *handle, uint8_t pack[2])
-{
-    uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[8];
-    uint8_t output_len;
-    uint8_t output_buf[1];
-    
-    if (handle == NULL)                                                                          /* check handle */
-    {
-        return 2;                                                                                /* return error */
-    }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
-    {
-        return 3;                                                                                /* return error */
-    }
+    a_mifare_ultralight_verify_queue(handle, input_buf[1], input_buf + 2);                       /* queue the page */
     
     input_len = 8;                                                                               /* set the input length */
     input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
-    input_buf[1] = handle->end_page;                                                             /* set the last page */
-    input_buf[2] = pack[0];                                                                      /* set pack0 */
-    input_buf[3] = pack[1];                                                                      /* set pack1 */
-    input_buf[4] = 0x00;                                                                         /* set 0x00 */
+    input_buf[1] = handle->end_page - 4;                                                         /* set the setting page */
+    input_buf[2] = lock[2];                                                                      /* set lock2 */
+    input_buf[3] = lock[3];                                                                      /* set lock3 */
+    input_buf[4] = lock[4];                                                                      /* set lock4 */
     input_buf[5] = 0x00;                                                                         /* set 0x00 */
     a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
     output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
     if (res != 0)                                                                                /* check the result */
     {
         handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
         
         return 1;                                                                                /* return error */
     }
     if (output_len != 1)                                                                         /* check the output_len */
     {
         handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
         
         return 4;                                                                                /* return error */
     }
     if (output_buf[0] != 0xA)                                                                    /* check the result */
     {
-        handle->debug_print("mifare_ultralight: ack error.\n");                                  /* ack error */
+        a_mifare_ultralight_ack_error(handle, output_buf[0]);                                    /* decode the nak */
         
         return 5;                                                                                /* return error */
     }
     
+    a_mifare_ultralight_verify_queue(handle, input_buf[1], input_buf + 2);                       /* queue the page */
+    
     return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight set the modulation mode
- * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] mode modulation mode
- * @return    status code
- *            - 0 success
- *            - 1 set modulation mode failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      mifare_ultralight get the lock
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *lock pointer to a lock buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get lock failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 crc error
+ * @note       none
  */
-uint8_t mifare_ultralight_set_modulation_mode(mifare_ultralight_handle_t *handle, mifare_ultralight_modulation_mode_t mode)
+uint8_t mifare_ultralight_get_lock(mifare_ultralight_handle_t *handle, uint8_t lock[5])
 {
     uint8_t res;
-    uint8_t conf[4];
+    uint8_t input_len;
+    uint8_t input_buf[5];
+    uint8_t output_len;
+    uint8_t output_buf[6];
+    uint8_t crc_buf[2];
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                          /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                                     /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                                /* return error */
     }
     
-    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
-    res = a_mifare_ultralight_conf_read(handle, handle->end_page - 3, conf);         /* read conf */
-    if (res != 0)                                                                    /* check the result */
+    if (a_mifare_ultralight_auto_auth(handle, handle->end_page - 4, 0) != 0)                     /* authenticate when needed */
     {
-        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
-        
-        return 1;                                                                    /* return error */
+        return 1;                                                                                /* return error */
     }
-    conf[0] &= ~(1 << 2);                                                            /* clear the settings */
-    conf[0] |= mode << 2;                                                            /* set the mode */
-    res = a_mifare_ultralight_conf_write(handle, handle->end_page - 3, conf);        /* write conf */
-    if (res != 0)                                                                    /* check the result */
+    input_len = 5;                                                                               /* set the input length */
+    a_mifare_ultralight_fast_read_frame(0x02, 0x02, input_buf);                                  /* set the frame */
+    output_len = 6;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
     {
-        handle->debug_print("mifare_ultralight: conf write failed.\n");              /* conf write failed */
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
         
-        return 1;                                                                    /* return error */
+        return 1;                                                                                /* return error */
     }
-    
-    return 0;                                                                        /* success return 0 */
-}
-
-/**
- * @brief      mifare_ultralight get the modulation mode
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *mode pointer to a modulation mode buffer
- * @return     status code
- *             - 0 success
- *             - 1 get modulation mode failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
- */
-uint8_t mifare_ultralight_get_modulation_mode(mifare_ultralight_handle_t *handle, mifare_ultralight_modulation_mode_t *mode)
-{
-    uint8_t res;
-    uint8_t conf[4];
-    
-    if (handle == NULL)                                                              /* check handle */
+    if (output_len != 6)                                                                         /* check the output_len */
     {
-        return 2;                                                                    /* return error */
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    a_mifare_ultralight_iso14443a_crc(output_buf, 4, crc_buf);                                   /* get the crc */
+    if ((output_buf[4] == crc_buf[0]) && (output_buf[5] == crc_buf[1]))                          /* check the crc */
     {
-        return 3;                                                                    /* return error */
+        memcpy(lock, output_buf + 2, 2);                                                         /* copy the data */
     }
-    
-    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
-    res = a_mifare_ultralight_conf_read(handle, handle->end_page - 3, conf);         /* read conf */
-    if (res != 0)                                                                    /* check the result */
+    else
     {
-        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
         
-        return 1;                                                                    /* return error */
+        return 5;                                                                                /* return error */
     }
-    *mode = (mifare_ultralight_modulation_mode_t)((conf[0] >> 2) & 0x1);             /* get the conf */
-    
-    return 0;                                                                        /* success return 0 */
-}
-
-/**
- * @brief     mifare_ultralight set the start page of protection
- * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] page start page
- * @return    status code
- *            - 0 success
- *            - 1 set protect start page failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t mifare_ultralight_set_protect_start_page(mifare_ultralight_handle_t *handle, uint8_t page)
-{
-    uint8_t res;
-    uint8_t conf[4];
     
-    if (handle == NULL)                                                              /* check handle */
+    input_len = 5;                                                                               /* set the input length */
+    a_mifare_ultralight_fast_read_frame(handle->end_page - 4, handle->end_page - 4, input_buf);  /* set the frame */
+    output_len = 6;                                                                              /* set the output length */
+    res = a_mifare_ultralight_transceiver(handle, input_buf, input_len, output_buf, &output_len); /* transceiver */
+    if (res != 0)                                                                                /* check the result */
     {
-        return 2;                                                                    /* return error */
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
+        
+        return 1;                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (output_len != 6)                                                                         /* check the output_len */
     {
-        return 3;                                                                    /* return error */
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
     }
-    
-    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
-    res = a_mifare_ultralight_conf_read(handle, handle->end_page - 3, conf);         /* read conf */
-    if (res != 0)                                                                    /* check the result */
+    a_mifare_ultralight_iso14443a_crc(output_buf, 4, crc_buf);                                   /* get the crc */
+    if ((output_buf[4] == crc_buf[0]) && (output_buf[5] == crc_buf[1]))                          /* check the crc */
     {
-        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
+        memcpy(lock + 2, output_buf, 3);                                                         /* copy the data */
         
-        return 1;                                                                    /* return error */
-    }
-    conf[3] = page;                                                                  /* set the page */
-    res = a_mifare_ultralight_conf_write(handle, handle->end_page - 3, conf);        /* write conf */
-    if (res != 0)                                                                    /* check the result */
+        return 0;                                                                                /* success return 0 */
+    }
+    else
     {
-        handle->debug_print("mifare_ultralight: conf write failed.\n");              /* conf write failed */
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
         
-        return 1;                                                                    /* return error */
+        return 5;                                                                                /* return error */
     }
-    
-    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight get the start page of protection
+ * @brief      mifare_ultralight read otp page
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *page pointer to a start page buffer
+ * @param[out] *data pointer to a data buffer
  * @return     status code
  *             - 0 success
- *             - 1 get protect start page failed
+ *             - 1 read otp page failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 output_len is invalid
+ *             - 5 crc error
  * @note       none
  */
-uint8_t mifare_ultralight_get_protect_start_page(mifare_ultralight_handle_t *handle, uint8_t *page)
+uint8_t mifare_ultralight_read_otp(mifare_ultralight_handle_t *handle, uint8_t data[4])
 {
     uint8_t res;
-    uint8_t conf[4];
+    uint8_t input_buf[4];
+    uint8_t output_len;
+    uint8_t skip_buf[12];
+    uint8_t crc_buf[2];
+    mifare_ultralight_segment_t tx[1];
+    mifare_ultralight_segment_t rx[3];
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                          /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                                     /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                                /* return error */
     }
     
-    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
-    res = a_mifare_ultralight_conf_read(handle, handle->end_page - 3, conf);         /* read conf */
-    if (res != 0)                                                                    /* check the result */
+    if (a_mifare_ultralight_auto_auth(handle, 0x06, 0) != 0)                                     /* authenticate when needed */
     {
-        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
+        return 1;                                                                                /* return error */
+    }
+    a_mifare_ultralight_read_frame(0x03, input_buf);                                             /* set the frame */
+    tx[0].buf = input_buf;                                                                       /* set the frame segment */
+    tx[0].len = 4;                                                                               /* set the segment length */
+    rx[0].buf = data;                                                                            /* receive into the data */
+    rx[0].len = 4;                                                                               /* set the segment length */
+    rx[1].buf = skip_buf;                                                                        /* skip the next pages */
+    rx[1].len = 12;                                                                              /* set the segment length */
+    rx[2].buf = crc_buf;                                                                         /* set the crc trailer */
+    rx[2].len = 2;                                                                               /* set the segment length */
+    res = a_mifare_ultralight_transceiver_vector(handle, tx, 1, rx, 3, &output_len);             /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
         
-        return 1;                                                                    /* return error */
+        return 1;                                                                                /* return error */
+    }
+    if (output_len != 18)                                                                        /* check the output_len */
+    {
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
+        
+        return 4;                                                                                /* return error */
+    }
+    if (a_mifare_ultralight_segment_crc_check(rx, 3) != 0)                                       /* check the crc */
+    {
+        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CRC);                      /* record the error */
+        
+        return 5;                                                                                /* return error */
     }
-    *page = conf[3];                                                                 /* get the page */
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight enable or disable access
+ * @brief     mifare_ultralight write otp page
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] access set access
- * @param[in] enable bool value
+ * @param[in] *data pointer to a data buffer
  * @return    status code
  *            - 0 success
- *            - 1 set access failed
+ *            - 1 write otp page failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 output_len is invalid
+ *            - 5 ack error
  * @note      none
  */
-uint8_t mifare_ultralight_set_access(mifare_ultralight_handle_t *handle, mifare_ultralight_access_t access, mifare_ultralight_bool_t enable)
+uint8_t mifare_ultralight_write_otp(mifare_ultralight_handle_t *handle, uint8_t data[4])
 {
     uint8_t res;
-    uint8_t conf[4];
+    uint8_t input_buf[2];
+    uint8_t output_len;
+    uint8_t output_buf[1];
+    uint8_t crc_buf[2];
+    mifare_ultralight_segment_t tx[3];
+    mifare_ultralight_segment_t rx[1];
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                          /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                                     /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                                /* return error */
     }
     
-    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
-    res = a_mifare_ultralight_conf_read(handle, handle->end_page - 2, conf);         /* read conf */
-    if (res != 0)                                                                    /* check the result */
+    if (a_mifare_ultralight_auto_auth(handle, 0x03, 1) != 0)                                     /* authenticate when needed */
     {
-        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
+        return 1;                                                                                /* return error */
+    }
+    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
+    input_buf[1] = 0x03;                                                                         /* set the page */
+    tx[0].buf = input_buf;                                                                       /* set the header segment */
+    tx[0].len = 2;                                                                               /* set the segment length */
+    tx[1].buf = data;                                                                            /* send the data in place */
+    tx[1].len = 4;                                                                               /* set the segment length */
+    tx[2].buf = crc_buf;                                                                         /* set the crc trailer */
+    tx[2].len = 2;                                                                               /* set the segment length */
+    a_mifare_ultralight_segment_crc_set(tx, 3);                                                  /* get the crc */
+    rx[0].buf = output_buf;                                                                      /* set the ack segment */
+    rx[0].len = 1;                                                                               /* set the segment length */
+    res = a_mifare_ultralight_transceiver_vector(handle, tx, 3, rx, 1, &output_len);             /* transceiver */
+    if (res != 0)                                                                                /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);              /* record the error */
         
-        return 1;                                                                    /* return error */
+        return 1;                                                                                /* return error */
     }
-    conf[0] &= ~(1 << access);                                                       /* clear the settings */
-    conf[0] |= enable << access;                                                     /* set the access */
-    res = a_mifare_ultralight_conf_write(handle, handle->end_page - 2, conf);        /* write conf */
-    if (res != 0)                                                                    /* check the result */
+    if (output_len != 1)                                                                         /* check the output_len */
     {
-        handle->debug_print("mifare_ultralight: conf write failed.\n");              /* conf write failed */
+        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);               /* record the error */
         
-        return 1;                                                                    /* return error */
+        return 4;                                                                                /* return error */
+    }
+    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    {
+        a_mifare_ultralight_ack_error(handle, output_buf[0]);                                    /* decode the nak */
+        
+        return 5;                                                                                /* return error */
     }
     
-    return 0;                                                                        /* success return 0 */
+    a_mifare_ultralight_verify_queue(handle, 0x03, data);                                        /* queue the page */
+    
+    return 0;                                                                                    /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight get the access status
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[in]  access set access
- * @param[out] *enable pointer to a bool value buffer
- * @return     status code
- *             - 0 success
- *             - 1 get access failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     mifare_ultralight merge the conf update of an op into the shadow
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *op pointer to a mifare_ultralight op structure
+ * @note      data[0..3] is the value and data[4..7] is the mask
  */
-uint8_t mifare_ultralight_get_access(mifare_ultralight_handle_t *handle, mifare_ultralight_access_t access, mifare_ultralight_bool_t *enable)
+static void a_mifare_ultralight_op_conf_merge(mifare_ultralight_handle_t *handle, mifare_ultralight_op_t *op)
 {
-    uint8_t res;
-    uint8_t conf[4];
+    uint8_t i;
     
-    if (handle == NULL)                                                              /* check handle */
+    for (i = 0; i < 4; i++)                                                                          /* 4 bytes */
     {
-        return 2;                                                                    /* return error */
+        handle->conf[op->page][i] = (uint8_t)((handle->conf[op->page][i] & (~op->data[4 + i])) |
+                                              (op->data[i] & op->data[4 + i]));                      /* merge the byte */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->conf_transaction != 0)                                                               /* check the transaction */
     {
-        return 3;                                                                    /* return error */
+        handle->conf_dirty |= (uint8_t)(1 << op->page);                                              /* set the dirty flag */
     }
+}
+
+/**
+ * @brief     mifare_ultralight build the frame of the current op step
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *op pointer to a mifare_ultralight op structure
+ * @note      none
+ */
+static void a_mifare_ultralight_op_frame(mifare_ultralight_handle_t *handle, mifare_ultralight_op_t *op)
+{
+    uint8_t i;
+    uint8_t *p;
     
-    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
-    res = a_mifare_ultralight_conf_read(handle, handle->end_page - 2, conf);         /* read conf */
-    if (res != 0)                                                                    /* check the result */
+    p = op->in_buf;                                                                                  /* set the frame buffer */
+    op->out_len = 1;                                                                                 /* ack by default */
+    switch (op->type)
     {
-        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
-        
-        return 1;                                                                    /* return error */
+        case MIFARE_ULTRALIGHT_OP_REQUEST :
+        case MIFARE_ULTRALIGHT_OP_WAKE_UP :
+        {
+            p[0] = (op->type == MIFARE_ULTRALIGHT_OP_REQUEST) ? MIFARE_ULTRALIGHT_COMMAND_REQUEST :
+                                                                MIFARE_ULTRALIGHT_COMMAND_WAKE_UP;   /* set the command */
+            op->in_len = 1;                                                                          /* set the frame length */
+            op->out_len = 2;                                                                         /* atqa */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_HALT :
+        {
+            memcpy(p, gs_frame_halt, 4);                                                             /* set the frame */
+            op->in_len = 4;                                                                          /* set the frame length */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_ANTICOLLISION_CL1 :
+        case MIFARE_ULTRALIGHT_OP_ANTICOLLISION_CL2 :
+        {
+            p[0] = (op->type == MIFARE_ULTRALIGHT_OP_ANTICOLLISION_CL1) ? 
+                   ((MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL1 >> 8) & 0xFF) :
+                   ((MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL2 >> 8) & 0xFF);                      /* set the command */
+            p[1] = MIFARE_ULTRALIGHT_COMMAND_ANTICOLLISION_CL1 & 0xFF;                               /* set the nvb */
+            op->in_len = 2;                                                                          /* set the frame length */
+            op->out_len = 5;                                                                         /* id and bcc */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_SELECT_CL1 :
+        case MIFARE_ULTRALIGHT_OP_SELECT_CL2 :
+        {
+            p[0] = (op->type == MIFARE_ULTRALIGHT_OP_SELECT_CL1) ? 
+                   ((MIFARE_ULTRALIGHT_COMMAND_SELECT_CL1 >> 8) & 0xFF) :
+                   ((MIFARE_ULTRALIGHT_COMMAND_SELECT_CL2 >> 8) & 0xFF);                             /* set the command */
+            p[1] = MIFARE_ULTRALIGHT_COMMAND_SELECT_CL1 & 0xFF;                                      /* set the nvb */
+            p[6] = 0;                                                                                /* init 0 */
+            for (i = 0; i < 4; i++)                                                                  /* 4 times */
+            {
+                p[2 + i] = op->data[i];                                                              /* set the id */
+                p[6] ^= op->data[i];                                                                 /* xor */
+            }
+            a_mifare_ultralight_iso14443a_crc(p, 7, p + 7);                                          /* get the crc */
+            op->in_len = 9;                                                                          /* set the frame length */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_GET_VERSION :
+        {
+            memcpy(p, gs_frame_get_version, 3);                                                      /* set the frame */
+            op->in_len = 3;                                                                          /* set the frame length */
+            op->out_len = 10;                                                                        /* version and crc */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_READ_PAGE :
+        case MIFARE_ULTRALIGHT_OP_READ_FOUR_PAGES :
+        {
+            a_mifare_ultralight_read_frame(op->page, p);                                             /* set the frame */
+            op->in_len = 4;                                                                          /* set the frame length */
+            op->out_len = 18;                                                                        /* 4 pages and crc */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_FAST_READ_PAGE :
+        {
+            a_mifare_ultralight_fast_read_frame(op->page, op->stop_page, p);                         /* set the frame */
+            op->in_len = 5;                                                                          /* set the frame length */
+            op->out_len = (uint8_t)(4 * (op->stop_page - op->page + 1) + 2);                         /* pages and crc */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_WRITE_PAGE :
+        {
+            p[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                                  /* set the command */
+            p[1] = op->page;                                                                         /* set the page */
+            memcpy(p + 2, op->data, 4);                                                              /* set the data */
+            a_mifare_ultralight_iso14443a_crc(p, 6, p + 6);                                          /* get the crc */
+            op->in_len = 8;                                                                          /* set the frame length */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_COMPATIBILITY_WRITE_PAGE :
+        {
+            if (op->step == 0)                                                                       /* address phase */
+            {
+                p[0] = MIFARE_ULTRALIGHT_COMMAND_COMP_WRITE;                                         /* set the command */
+                p[1] = op->page;                                                                     /* set the page */
+                a_mifare_ultralight_iso14443a_crc(p, 2, p + 2);                                      /* get the crc */
+                op->in_len = 4;                                                                      /* set the frame length */
+            }
+            else                                                                                     /* data phase */
+            {
+                memcpy(p, op->data, 4);                                                              /* set the data */
+                memset(p + 4, 0, 12);                                                                /* pad 12 bytes */
+                a_mifare_ultralight_iso14443a_crc(p, 16, p + 16);                                    /* get the crc */
+                op->in_len = 18;                                                                     /* set the frame length */
+            }
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_READ_COUNTER :
+        {
+            memcpy(p, gs_frame_read_cnt[op->page], 4);                                               /* set the frame */
+            op->in_len = 4;                                                                          /* set the frame length */
+            op->out_len = 5;                                                                         /* counter and crc */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_INCREMENT_COUNTER :
+        {
+            p[0] = MIFARE_ULTRALIGHT_COMMAND_INCR_CNT;                                               /* set the command */
+            p[1] = op->page;                                                                         /* set the address */
+            memcpy(p + 2, op->data, 3);                                                              /* set cnt */
+            p[5] = 0x00;                                                                             /* rfui */
+            a_mifare_ultralight_iso14443a_crc(p, 6, p + 6);                                          /* get the crc */
+            op->in_len = 8;                                                                          /* set the frame length */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_CHECK_TEARING_EVENT :
+        {
+            memcpy(p, gs_frame_check_tearing[op->page], 4);                                          /* set the frame */
+            op->in_len = 4;                                                                          /* set the frame length */
+            op->out_len = 3;                                                                         /* flag and crc */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_READ_SIGNATURE :
+        {
+            memcpy(p, gs_frame_read_sig, 4);                                                         /* set the frame */
+            op->in_len = 4;                                                                          /* set the frame length */
+            op->out_len = 34;                                                                        /* signature and crc */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_AUTHENTICATE :
+        {
+            p[0] = MIFARE_ULTRALIGHT_COMMAND_PWD_AUTH;                                               /* set the command */
+            memcpy(p + 1, op->data, 4);                                                              /* set the pwd */
+            a_mifare_ultralight_iso14443a_crc(p, 5, p + 5);                                          /* get the crc */
+            op->in_len = 7;                                                                          /* set the frame length */
+            op->out_len = 4;                                                                         /* pack and crc */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_GET_LOCK :
+        {
+            a_mifare_ultralight_fast_read_frame((op->step == 0) ? 0x02 : (uint8_t)(handle->end_page - 4),
+                                                (op->step == 0) ? 0x02 : (uint8_t)(handle->end_page - 4),
+                                                p);                                                  /* set the frame */
+            op->in_len = 5;                                                                          /* set the frame length */
+            op->out_len = 6;                                                                         /* page and crc */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_SET_LOCK :
+        {
+            p[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                                  /* set the command */
+            if (op->step == 0)                                                                       /* static lock */
+            {
+                p[1] = 0x02;                                                                         /* set the page */
+                p[2] = 0x00;                                                                         /* set 0x00 */
+                p[3] = 0x00;                                                                         /* set 0x00 */
+                p[4] = op->data[0];                                                                  /* set lock0 */
+                p[5] = op->data[1];                                                                  /* set lock1 */
+            }
+            else                                                                                     /* dynamic lock */
+            {
+                p[1] = (uint8_t)(handle->end_page - 4);                                              /* set the page */
+                p[2] = op->data[2];                                                                  /* set lock2 */
+                p[3] = op->data[3];                                                                  /* set lock3 */
+                p[4] = op->data[4];                                                                  /* set lock4 */
+                p[5] = 0x00;                                                                         /* set 0x00 */
+            }
+            a_mifare_ultralight_iso14443a_crc(p, 6, p + 6);                                          /* get the crc */
+            op->in_len = 8;                                                                          /* set the frame length */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_VCSL :
+        {
+            p[0] = MIFARE_ULTRALIGHT_COMMAND_VCSL;                                                   /* set the command */
+            memcpy(p + 1, op->data, 20);                                                             /* set the iid and pcd capabilities */
+            a_mifare_ultralight_iso14443a_crc(p, 21, p + 21);                                        /* get the crc */
+            op->in_len = 23;                                                                         /* set the frame length */
+            op->out_len = 3;                                                                         /* identifier and crc */
+            
+            break;
+        }
+        default :
+        {
+            if (op->step == 0)                                                                       /* read the conf */
+            {
+                a_mifare_ultralight_fast_read_frame((uint8_t)(handle->end_page - 3 + op->page),
+                                                    (uint8_t)(handle->end_page - 3 + op->page), p);  /* set the frame */
+                op->in_len = 5;                                                                      /* set the frame length */
+                op->out_len = 6;                                                                     /* page and crc */
+            }
+            else                                                                                     /* write the conf */
+            {
+                p[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
+                p[1] = (uint8_t)(handle->end_page - 3 + op->page);                                   /* set the page */
+                memcpy(p + 2, handle->conf[op->page], 4);                                            /* set the shadow */
+                a_mifare_ultralight_iso14443a_crc(p, 6, p + 6);                                      /* get the crc */
+                op->in_len = 8;                                                                      /* set the frame length */
+            }
+            
+            break;
+        }
     }
-    *enable = (mifare_ultralight_bool_t)((conf[0] >> access) & 0x1);                 /* get the bool */
-    
-    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight set the authenticate limitation
+ * @brief     mifare_ultralight check the response of the current op step
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] limit authenticate limitation
- * @return    status code
- *            - 0 success
- *            - 1 set authenticate limitation failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 limit > 7
+ * @param[in] *op pointer to a mifare_ultralight op structure
+ * @param[in] len response length
+ * @return    op result, see mifare_ultralight_op_t
  * @note      none
  */
-uint8_t mifare_ultralight_set_authenticate_limitation(mifare_ultralight_handle_t *handle, uint8_t limit)
+static uint8_t a_mifare_ultralight_op_response(mifare_ultralight_handle_t *handle, mifare_ultralight_op_t *op, uint8_t len)
 {
-    uint8_t res;
-    uint8_t conf[4];
+    uint8_t i;
+    uint8_t check;
+    uint8_t crc_buf[2];
+    uint8_t *p;
     
-    if (handle == NULL)                                                              /* check handle */
-    {
-        return 2;                                                                    /* return error */
-    }
-    if (handle->inited != 1)                                                         /* check handle initialization */
-    {
-        return 3;                                                                    /* return error */
-    }
-    if (limit > 7)                                                                   /* check the limit */
+    p = op->out_buf;                                                                                 /* set the response */
+    if (len != op->out_len)                                                                          /* check the length */
     {
-        handle->debug_print("mifare_ultralight: limit > 7.\n");                      /* limit > 7 */
-        
-        return 4;                                                                    /* return error */
+        return 4;                                                                                    /* output_len is invalid */
     }
-    
-    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
-    res = a_mifare_ultralight_conf_read(handle, handle->end_page - 2, conf);         /* read conf */
-    if (res != 0)                                                                    /* check the result */
+    if (op->out_len > 2)                                                                             /* responses with crc */
     {
-        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
-        
-        return 1;                                                                    /* return error */
+        if ((op->type != MIFARE_ULTRALIGHT_OP_ANTICOLLISION_CL1) &&
+            (op->type != MIFARE_ULTRALIGHT_OP_ANTICOLLISION_CL2))                                    /* anti collision has bcc */
+        {
+            a_mifare_ultralight_iso14443a_crc(p, (uint8_t)(len - 2), crc_buf);                       /* get the crc */
+            if ((p[len - 2] != crc_buf[0]) || (p[len - 1] != crc_buf[1]))                            /* check the crc */
+            {
+                return 5;                                                                            /* crc error */
+            }
+        }
     }
-    conf[0] &= ~(7 << 0);                                                            /* clear the settings */
-    conf[0] |= limit << 0;                                                           /* set the limit */
-    res = a_mifare_ultralight_conf_write(handle, handle->end_page - 2, conf);        /* write conf */
-    if (res != 0)                                                                    /* check the result */
+    switch (op->type)
     {
-        handle->debug_print("mifare_ultralight: conf write failed.\n");              /* conf write failed */
-        
-        return 1;                                                                    /* return error */
+        case MIFARE_ULTRALIGHT_OP_REQUEST :
+        case MIFARE_ULTRALIGHT_OP_WAKE_UP :
+        {
+            if (op->data != NULL)                                                                    /* check the data */
+            {
+                memcpy(op->data, p, 2);                                                              /* copy the atqa */
+            }
+            handle->atqa[0] = p[0];                                                                  /* save the atqa */
+            handle->atqa[1] = p[1];                                                                  /* save the atqa */
+            if ((p[0] != 0x44) || (p[1] != 0x00))                                                    /* check the atqa */
+            {
+                handle->type = (uint8_t)MIFARE_ULTRALIGHT_TYPE_INVALID;                              /* invalid */
+                
+                return 5;                                                                            /* type is invalid */
+            }
+            handle->type = (uint8_t)MIFARE_ULTRALIGHT_TYPE_ULTRALIGHT;                               /* ultralight */
+            
+            return 0;                                                                                /* success return 0 */
+        }
+        case MIFARE_ULTRALIGHT_OP_ANTICOLLISION_CL1 :
+        case MIFARE_ULTRALIGHT_OP_ANTICOLLISION_CL2 :
+        {
+            check = 0;                                                                               /* init 0 */
+            for (i = 0; i < 4; i++)                                                                  /* 4 times */
+            {
+                check ^= p[i];                                                                       /* xor */
+            }
+            if (check != p[4])                                                                       /* check the bcc */
+            {
+                return 5;                                                                            /* bcc error */
+            }
+            memcpy(op->data, p, 4);                                                                  /* copy the id */
+            
+            return 0;                                                                                /* success return 0 */
+        }
+        case MIFARE_ULTRALIGHT_OP_SELECT_CL1 :
+        case MIFARE_ULTRALIGHT_OP_SELECT_CL2 :
+        {
+            handle->sak = p[0];                                                                      /* save the sak */
+            if (p[0] != ((op->type == MIFARE_ULTRALIGHT_OP_SELECT_CL1) ? 0x04 : 0x00))               /* check the sak */
+            {
+                return 5;                                                                            /* sak error */
+            }
+            a_mifare_ultralight_uid_keep(handle, (op->type == MIFARE_ULTRALIGHT_OP_SELECT_CL1) ? 1 : 2, 
+                                         op->data);                                                  /* keep the uid */
+            
+            return 0;                                                                                /* success return 0 */
+        }
+        case MIFARE_ULTRALIGHT_OP_GET_VERSION :
+        {
+            memcpy(op->data, p, 8);                                                                  /* copy the version */
+            if ((p[6] == 0x0B) && (handle->end_page != MIFARE_ULTRALIGHT_STORAGE_MF0UL11))           /* if 20 pages */
+            {
+                handle->end_page = MIFARE_ULTRALIGHT_STORAGE_MF0UL11;                                /* set the end page */
+                a_mifare_ultralight_conf_reset(handle);                                              /* reset the conf shadow */
+            }
+            else if ((p[6] == 0x0E) && (handle->end_page != MIFARE_ULTRALIGHT_STORAGE_MF0UL21))      /* if 41 pages */
+            {
+                handle->end_page = MIFARE_ULTRALIGHT_STORAGE_MF0UL21;                                /* set the end page */
+                a_mifare_ultralight_conf_reset(handle);                                              /* reset the conf shadow */
+            }
+            else
+            {
+                                                                                                     /* do nothing */
+            }
+            
+            return 0;                                                                                /* success return 0 */
+        }
+        case MIFARE_ULTRALIGHT_OP_READ_PAGE :
+        {
+            memcpy(op->data, p, 4);                                                                  /* copy the page */
+            
+            return 0;                                                                                /* success return 0 */
+        }
+        case MIFARE_ULTRALIGHT_OP_READ_FOUR_PAGES :
+        case MIFARE_ULTRALIGHT_OP_FAST_READ_PAGE :
+        case MIFARE_ULTRALIGHT_OP_READ_COUNTER :
+        case MIFARE_ULTRALIGHT_OP_CHECK_TEARING_EVENT :
+        case MIFARE_ULTRALIGHT_OP_READ_SIGNATURE :
+        {
+            memcpy(op->data, p, len - 2);                                                            /* copy the data */
+            
+            return 0;                                                                                /* success return 0 */
+        }
+        case MIFARE_ULTRALIGHT_OP_AUTHENTICATE :
+        {
+            if ((p[0] != op->data[4]) || (p[1] != op->data[5]))                                      /* check the pack */
+            {
+                handle->auth = 0;                                                                    /* not authenticated */
+                
+                return 7;                                                                            /* pack check failed */
+            }
+            handle->auth = 1;                                                                        /* authenticated */
+            
+            return 0;                                                                                /* success return 0 */
+        }
+        case MIFARE_ULTRALIGHT_OP_GET_LOCK :
+        {
+            if (op->step == 0)                                                                       /* static lock */
+            {
+                memcpy(op->data, p + 2, 2);                                                          /* copy lock0 and lock1 */
+            }
+            else                                                                                     /* dynamic lock */
+            {
+                memcpy(op->data + 2, p, 3);                                                          /* copy lock2 - lock4 */
+            }
+            
+            return 0;                                                                                /* success return 0 */
+        }
+        case MIFARE_ULTRALIGHT_OP_VCSL :
+        {
+            op->data[20] = p[0];                                                                     /* copy the identifier */
+            
+            return 0;                                                                                /* success return 0 */
+        }
+        case MIFARE_ULTRALIGHT_OP_CONF_UPDATE :
+        {
+            if (op->step == 0)                                                                       /* read the conf */
+            {
+                memcpy(handle->conf[op->page], p, 4);                                                /* fill the shadow */
+                handle->conf_valid |= (uint8_t)(1 << op->page);                                      /* set the valid flag */
+                a_mifare_ultralight_op_conf_merge(handle, op);                                       /* merge the update */
+                
+                return 0;                                                                            /* success return 0 */
+            }
+            if (p[0] != 0xA)                                                                         /* check the ack */
+            {
+                handle->conf_valid &= (uint8_t)(~(1 << op->page));                                   /* the card content is unknown */
+                
+                return 6;                                                                            /* ack error */
+            }
+            
+            return 0;                                                                                /* success return 0 */
+        }
+        default :
+        {
+            if (p[0] != 0xA)                                                                         /* check the ack */
+            {
+                return 6;                                                                            /* ack error */
+            }
+            if (((op->type == MIFARE_ULTRALIGHT_OP_WRITE_PAGE) || 
+                 (op->type == MIFARE_ULTRALIGHT_OP_COMPATIBILITY_WRITE_PAGE)) && 
+                (op->step == op->steps - 1))                                                         /* check the data phase */
+            {
+                a_mifare_ultralight_verify_queue(handle, op->page, op->data);                        /* queue the page */
+            }
+            
+            return 0;                                                                                /* success return 0 */
+        }
     }
-    
-    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight get the authenticate limitation
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *limit pointer to an authenticate limitation buffer
- * @return     status code
- *             - 0 success
- *             - 1 get authenticate limitation failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     mifare_ultralight move an op to a state
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *op pointer to a mifare_ultralight op structure
+ * @param[in] state next state
+ * @param[in] res op result
+ * @note      none
  */
-uint8_t mifare_ultralight_get_authenticate_limitation(mifare_ultralight_handle_t *handle, uint8_t *limit)
+static void a_mifare_ultralight_op_enter(mifare_ultralight_handle_t *handle, mifare_ultralight_op_t *op, 
+                                         mifare_ultralight_op_state_t state, uint8_t res)
 {
-    uint8_t res;
-    uint8_t conf[4];
-    
-    if (handle == NULL)                                                              /* check handle */
-    {
-        return 2;                                                                    /* return error */
-    }
-    if (handle->inited != 1)                                                         /* check handle initialization */
-    {
-        return 3;                                                                    /* return error */
-    }
-    
-    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
-    res = a_mifare_ultralight_conf_read(handle, handle->end_page - 2, conf);         /* read conf */
-    if (res != 0)                                                                    /* check the result */
+    op->state = (uint8_t)state;                                                                      /* set the state */
+    op->res = res;                                                                                   /* set the result */
+    op->timestamp = a_mifare_ultralight_timestamp_us(handle);                                        /* save the entry time */
+    if (state == MIFARE_ULTRALIGHT_OP_STATE_ERROR)                                                   /* check the error */
     {
-        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
-        
-        return 1;                                                                    /* return error */
+        if ((op->type == MIFARE_ULTRALIGHT_OP_CONF_UPDATE) && (op->step != 0))                       /* conf write failed */
+        {
+            handle->conf_valid &= (uint8_t)(~(1 << op->page));                                       /* the card content is unknown */
+        }
+        handle->debug_print("mifare_ultralight: op 0x%02X failed with %d.\n", op->type, res);       /* op failed */
+        if (res == 1)                                                                                /* transport failed */
+        {
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER);             /* record the error */
+        }
+        else if (res == 4)                                                                           /* output_len is invalid */
+        {
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN);              /* record the error */
+        }
+        else if (res == 5)                                                                           /* check error */
+        {
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_CHECK);                   /* record the error */
+        }
+        else if (res == 6)                                                                           /* ack error */
+        {
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_ACK);                     /* record the error */
+        }
+        else if (res == 7)                                                                           /* pack check failed */
+        {
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_PACK);                    /* record the error */
+        }
+        else if (res == 8)                                                                           /* timeout */
+        {
+            MIFARE_ULTRALIGHT_ERROR(handle, MIFARE_ULTRALIGHT_STATS_ERROR_TIMEOUT);                 /* record the error */
+        }
+        else
+        {
+            
+        }
     }
-    *limit = conf[0] & 0x7;                                                          /* set the limit */
-    
-    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight set the virtual card type identifier
+ * @brief     set the op response timeout
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] identifier virtual card type identifier
+ * @param[in] us timeout in us
  * @return    status code
  *            - 0 success
- *            - 1 set virtual card type identifier failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the default timeout is 10000us, 0 waits for the transport forever,
+ *            the timeout needs the timestamp_us function
  */
-uint8_t mifare_ultralight_set_virtual_card_type_identifier(mifare_ultralight_handle_t *handle, uint8_t identifier)
+uint8_t mifare_ultralight_set_op_timeout(mifare_ultralight_handle_t *handle, uint32_t us)
 {
-    uint8_t res;
-    uint8_t conf[4];
-    
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                 /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                       /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                            /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                       /* return error */
     }
     
-    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
-    res = a_mifare_ultralight_conf_read(handle, handle->end_page - 2, conf);         /* read conf */
-    if (res != 0)                                                                    /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
-        
-        return 1;                                                                    /* return error */
-    }
-    conf[1] = identifier;                                                            /* set the identifier */
-    res = a_mifare_ultralight_conf_write(handle, handle->end_page - 2, conf);        /* write conf */
-    if (res != 0)                                                                    /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: conf write failed.\n");              /* conf write failed */
-        
-        return 1;                                                                    /* return error */
-    }
+    handle->op_timeout_us = us;                         /* set the timeout */
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                           /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight get the virtual card type identifier
+ * @brief      get the op response timeout
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *identifier pointer to a virtual card type identifier buffer
+ * @param[out] *us pointer to a timeout buffer
  * @return     status code
  *             - 0 success
- *             - 1 get virtual card type identifier failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t mifare_ultralight_get_virtual_card_type_identifier(mifare_ultralight_handle_t *handle, uint8_t *identifier)
+uint8_t mifare_ultralight_get_op_timeout(mifare_ultralight_handle_t *handle, uint32_t *us)
 {
-    uint8_t res;
-    uint8_t conf[4];
-    
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                 /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                       /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                            /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                       /* return error */
     }
     
-    memset(conf, 0, sizeof(uint8_t) * 4);                                            /* clear the conf */
-    res = a_mifare_ultralight_conf_read(handle, handle->end_page - 2, conf);         /* read conf */
-    if (res != 0)                                                                    /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: conf read failed.\n");               /* conf read failed */
-        
-        return 1;                                                                    /* return error */
-    }
-    *identifier = conf[1];                                                           /* get the identifier */
+    *us = handle->op_timeout_us;                        /* get the timeout */
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                           /* success return 0 */
 }
 
 /**
- * @brief     mifare_ultralight set the lock
+ * @brief     start a non blocking op
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] *lock pointer to a lock buffer
+ * @param[in] *op pointer to a mifare_ultralight op structure
+ * @param[in] type op type
+ * @param[in] page page, counter addr or conf index
+ * @param[in] stop_page stop page of the fast read
+ * @param[in] *data pointer to a data buffer
  * @return    status code
  *            - 0 success
- *            - 1 set lock failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 output_len is invalid
- *            - 5 ack error
- * @note                                                      byte0                                                                               
- *            bit7            bit6            bit5            bit4             bit3             bit2             bit1             bit0            
- *            lock_page_7     lock_page_6     lock_page_5     lock_page_4      lock_otp         block_page_15_10 block_page_9_4   bock_otp        
- *                                                            byte1                                                                               
- *            bit7            bit6            bit5            bit4             bit3             bit2             bit1             bit0            
- *            lock_page_15    lock_page_14    lock_page_13    lock_page_12     lock_page_11     lock_page_10     lock_page_9      lock_page_8     
- *                                                            byte2                                                                               
- *            bit7            bit6            bit5            bit4             bit3             bit2             bit1             bit0            
- *            lock_page_30-31 lock_page_28-29 lock_page_26-27 lock_page_24-25  lock_page_22-23  lock_page_20-21  lock_page_18-19  lock_page_16-17 
- *                                                            byte3                                                                               
- *            bit7            bit6            bit5            bit4             bit3             bit2             bit1             bit0            
- *            rfui            rfui            rfui            rfui             rfui             rfui             lock_page_34-35  lock_page_32-22 
- *                                                            byte4                                                                               
- *            bit7            bit6            bit5            bit4             bit3             bit2             bit1             bit0            
- *            rfui            rfui            rfui            block_page_32_35 block_page_28_31 block_page_24_27 block_page_20_23 block_page_16_19
+ *            - 4 contactless_submit or contactless_poll is NULL
+ *            - 5 type is invalid
+ *            - 6 param is invalid
+ *            - 7 op is busy
+ * @note      data must stay valid until the op is finished,
+ *            see mifare_ultralight_op_type_t for the data layout
  */
-uint8_t mifare_ultralight_set_lock(mifare_ultralight_handle_t *handle, uint8_t lock[5])
+uint8_t mifare_ultralight_op_start(mifare_ultralight_handle_t *handle, mifare_ultralight_op_t *op,
+                                   mifare_ultralight_op_type_t type, uint8_t page, uint8_t stop_page, uint8_t *data)
 {
-    uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[8];
-    uint8_t output_len;
-    uint8_t output_buf[1];
+    uint8_t param_ok;
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                                                  /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                                             /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                                        /* return error */
     }
-    
-    input_len = 8;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
-    input_buf[1] = 0x02;                                                                         /* set the setting page */
-    input_buf[2] = 0x00;                                                                         /* set 0x00 */
-    input_buf[3] = 0x00;                                                                         /* set 0x00 */
-    input_buf[4] = lock[0];                                                                      /* set lock0 */
-    input_buf[5] = lock[1];                                                                      /* set lock1 */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
-    output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    if ((!MIFARE_ULTRALIGHT_LINKED(handle, contactless_submit)) || 
+        (!MIFARE_ULTRALIGHT_LINKED(handle, contactless_poll)))                                           /* check the async transport */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        handle->debug_print("mifare_ultralight: contactless_submit or contactless_poll is null.\n");     /* transport is null */
         
-        return 1;                                                                                /* return error */
+        return 4;                                                                                        /* return error */
     }
-    if (output_len != 1)                                                                         /* check the output_len */
+    if (type > MIFARE_ULTRALIGHT_OP_VCSL)                                                                /* check the type */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        handle->debug_print("mifare_ultralight: type is invalid.\n");                                    /* type is invalid */
         
-        return 4;                                                                                /* return error */
+        return 5;                                                                                        /* return error */
     }
-    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    if (op == NULL)                                                                                      /* check the op */
     {
-        handle->debug_print("mifare_ultralight: ack error.\n");                                  /* ack error */
+        handle->debug_print("mifare_ultralight: param is invalid.\n");                                   /* param is invalid */
         
-        return 5;                                                                                /* return error */
+        return 6;                                                                                        /* return error */
     }
-    
-    input_len = 8;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
-    input_buf[1] = handle->end_page - 4;                                                         /* set the setting page */
-    input_buf[2] = lock[2];                                                                      /* set lock2 */
-    input_buf[3] = lock[3];                                                                      /* set lock3 */
-    input_buf[4] = lock[4];                                                                      /* set lock4 */
-    input_buf[5] = 0x00;                                                                         /* set 0x00 */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
-    output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    if ((op->state == MIFARE_ULTRALIGHT_OP_STATE_GUARD) || (op->state == MIFARE_ULTRALIGHT_OP_STATE_SUBMIT) ||
+        (op->state == MIFARE_ULTRALIGHT_OP_STATE_WAIT))                                                  /* check the state */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+        handle->debug_print("mifare_ultralight: op is busy.\n");                                         /* op is busy */
         
-        return 1;                                                                                /* return error */
+        return 7;                                                                                        /* return error */
     }
-    if (output_len != 1)                                                                         /* check the output_len */
+    
+    param_ok = 1;                                                                                        /* init 1 */
+    switch (type)
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        case MIFARE_ULTRALIGHT_OP_REQUEST :
+        case MIFARE_ULTRALIGHT_OP_WAKE_UP :
+        case MIFARE_ULTRALIGHT_OP_HALT :
+        {
+            break;                                                                                       /* data is optional */
+        }
+        case MIFARE_ULTRALIGHT_OP_FAST_READ_PAGE :
+        {
+            param_ok = ((data != NULL) && (stop_page >= page) && (stop_page - page + 1 <= 15)) ? 1 : 0;  /* check the pages */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_READ_COUNTER :
+        case MIFARE_ULTRALIGHT_OP_INCREMENT_COUNTER :
+        case MIFARE_ULTRALIGHT_OP_CHECK_TEARING_EVENT :
+        {
+            param_ok = ((data != NULL) && (page <= 0x2)) ? 1 : 0;                                        /* check the addr */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_GET_LOCK :
+        case MIFARE_ULTRALIGHT_OP_SET_LOCK :
+        {
+            param_ok = ((data != NULL) && (handle->end_page != 0xFF)) ? 1 : 0;                           /* check the storage */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_CONF_UPDATE :
+        {
+            param_ok = ((data != NULL) && (handle->end_page != 0xFF) && (page <= 1)) ? 1 : 0;            /* check the conf index */
+            
+            break;
+        }
+        default :
+        {
+            param_ok = (data != NULL) ? 1 : 0;                                                           /* check the data */
+            
+            break;
+        }
+    }
+    if (param_ok == 0)                                                                                   /* check the param */
+    {
+        handle->debug_print("mifare_ultralight: param is invalid.\n");                                   /* param is invalid */
         
-        return 4;                                                                                /* return error */
+        return 6;                                                                                        /* return error */
     }
-    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    
+    op->type = (uint8_t)type;                                                                            /* set the type */
+    op->page = page;                                                                                     /* set the page */
+    op->stop_page = stop_page;                                                                           /* set the stop page */
+    op->data = data;                                                                                     /* set the data */
+    op->step = 0;                                                                                        /* first frame */
+    op->steps = 1;                                                                                       /* one frame */
+    op->guard_us = 0;                                                                                    /* no guard time */
+    op->next = (uint8_t)MIFARE_ULTRALIGHT_OP_STATE_SUBMIT;                                               /* submit after the guard */
+    switch (type)
+    {
+        case MIFARE_ULTRALIGHT_OP_REQUEST :
+        case MIFARE_ULTRALIGHT_OP_WAKE_UP :
+        case MIFARE_ULTRALIGHT_OP_HALT :
+        {
+            a_mifare_ultralight_conf_reset(handle);                                                      /* reset the conf shadow */
+            handle->uid_valid = 0;                                                                       /* forget the selected card */
+            handle->auth = 0;                                                                            /* end the authenticated session */
+            if (type != MIFARE_ULTRALIGHT_OP_HALT)                                                       /* guard before the frame */
+            {
+                op->guard_us = handle->guard_time_us[(type == MIFARE_ULTRALIGHT_OP_REQUEST) ? 
+                                                     MIFARE_ULTRALIGHT_GUARD_TIME_REQUEST :
+                                                     MIFARE_ULTRALIGHT_GUARD_TIME_WAKE_UP];              /* set the guard time */
+            }
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_WRITE_PAGE :
+        case MIFARE_ULTRALIGHT_OP_COMPATIBILITY_WRITE_PAGE :
+        {
+            if ((page == handle->end_page - 3) || (page == handle->end_page - 2))                        /* check the conf pages */
+            {
+                handle->conf_valid &= (uint8_t)(~(1 << (page - (handle->end_page - 3))));                /* invalidate the conf shadow */
+                handle->conf_dirty &= (uint8_t)(~(1 << (page - (handle->end_page - 3))));                /* drop the pending change */
+            }
+            op->steps = (type == MIFARE_ULTRALIGHT_OP_WRITE_PAGE) ? 1 : 2;                               /* address and data phase */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_GET_LOCK :
+        case MIFARE_ULTRALIGHT_OP_SET_LOCK :
+        {
+            op->steps = 2;                                                                               /* static and dynamic lock */
+            
+            break;
+        }
+        case MIFARE_ULTRALIGHT_OP_CONF_UPDATE :
+        {
+            op->steps = (handle->conf_transaction != 0) ? 1 : 2;                                         /* read and write */
+            if ((handle->conf_valid & (1 << page)) != 0)                                                 /* check the shadow */
+            {
+                op->step = 1;                                                                            /* skip the read */
+                a_mifare_ultralight_op_conf_merge(handle, op);                                           /* merge the update */
+            }
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+    if (op->step >= op->steps)                                                                           /* nothing to send */
     {
-        handle->debug_print("mifare_ultralight: ack error.\n");                                  /* ack error */
+        a_mifare_ultralight_op_enter(handle, op, MIFARE_ULTRALIGHT_OP_STATE_DONE, 0);                    /* done */
         
-        return 5;                                                                                /* return error */
+        return 0;                                                                                        /* success return 0 */
     }
+    a_mifare_ultralight_op_frame(handle, op);                                                            /* build the first frame */
+    a_mifare_ultralight_op_enter(handle, op, MIFARE_ULTRALIGHT_OP_STATE_GUARD, 0);                       /* wait the guard time */
     
-    return 0;                                                                                    /* success return 0 */
+    return 0;                                                                                            /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight get the lock
- * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *lock pointer to a lock buffer
- * @return     status code
- *             - 0 success
- *             - 1 get lock failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 crc error
- * @note       none
+ * @brief     run a non blocking op
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *op pointer to a mifare_ultralight op structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 op is not started
+ * @note      every call moves the op as far as the transport allows and never blocks,
+ *            the op is finished when its state is done or error
  */
-uint8_t mifare_ultralight_get_lock(mifare_ultralight_handle_t *handle, uint8_t lock[5])
+uint8_t mifare_ultralight_op_step(mifare_ultralight_handle_t *handle, mifare_ultralight_op_t *op)
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[5];
-    uint8_t output_len;
-    uint8_t output_buf[6];
-    uint8_t crc_buf[2];
-    
-    if (handle == NULL)                                                                          /* check handle */
-    {
-        return 2;                                                                                /* return error */
-    }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
-    {
-        return 3;                                                                                /* return error */
-    }
-    
-    input_len = 5;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_FAST_READ;                                          /* set the command */
-    input_buf[1] = 2;                                                                            /* set the start page */
-    input_buf[2] = 2;                                                                            /* set the stop page */
-    a_mifare_ultralight_iso14443a_crc(input_buf , 3, input_buf + 3);                             /* get the crc */
-    output_len = 6;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
-    }
-    if (output_len != 6)                                                                         /* check the output_len */
+    uint8_t len;
+    uint32_t now;
+    
+    if (handle == NULL)                                                                                  /* check handle */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
-        
-        return 4;                                                                                /* return error */
+        return 2;                                                                                        /* return error */
     }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 4, crc_buf);                                   /* get the crc */
-    if ((output_buf[4] == crc_buf[0]) && (output_buf[5] == crc_buf[1]))                          /* check the crc */
+    if (handle->inited != 1)                                                                             /* check handle initialization */
     {
-        memcpy(lock, output_buf + 2, 2);                                                         /* copy the data */
+        return 3;                                                                                        /* return error */
     }
-    else
+    if ((op == NULL) || (op->state == MIFARE_ULTRALIGHT_OP_STATE_IDLE))                                  /* check the op */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
+        handle->debug_print("mifare_ultralight: op is not started.\n");                                  /* op is not started */
         
-        return 5;                                                                                /* return error */
+        return 4;                                                                                        /* return error */
     }
     
-    input_len = 5;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_FAST_READ;                                          /* set the command */
-    input_buf[1] = handle->end_page - 4;                                                         /* set the start page */
-    input_buf[2] = handle->end_page - 4;                                                         /* set the stop page */
-    a_mifare_ultralight_iso14443a_crc(input_buf , 3, input_buf + 3);                             /* get the crc */
-    output_len = 6;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    while (1)                                                                                            /* run until it would block */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
+        switch (op->state)
+        {
+            case MIFARE_ULTRALIGHT_OP_STATE_GUARD :
+            {
+                if ((op->guard_us != 0) && MIFARE_ULTRALIGHT_LINKED(handle, timestamp_us))               /* check the guard time */
+                {
+                    now = a_mifare_ultralight_timestamp_us(handle);                                      /* get the time */
+                    if ((uint32_t)(now - op->timestamp) < op->guard_us)                                  /* check the time */
+                    {
+                        return 0;                                                                        /* wait more */
+                    }
+                }
+                a_mifare_ultralight_op_enter(handle, op, (mifare_ultralight_op_state_t)op->next, 0);     /* next state */
+                
+                break;
+            }
+            case MIFARE_ULTRALIGHT_OP_STATE_SUBMIT :
+            {
+                res = a_mifare_ultralight_submit(handle, op->in_buf, op->in_len);                        /* queue the frame */
+                if (res == 2)                                                                            /* transport busy */
+                {
+                    return 0;                                                                            /* try again */
+                }
+                if ((res != 0) && (op->type != MIFARE_ULTRALIGHT_OP_HALT))                               /* check the result */
+                {
+                    a_mifare_ultralight_op_enter(handle, op, MIFARE_ULTRALIGHT_OP_STATE_ERROR, 1);       /* transport failed */
+                    
+                    break;
+                }
+                a_mifare_ultralight_op_enter(handle, op, MIFARE_ULTRALIGHT_OP_STATE_WAIT, 0);            /* wait the response */
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+                a_mifare_ultralight_trace_buf(handle, MIFARE_ULTRALIGHT_TRACE_DIR_TX, 0, op->timestamp, 
+                                              op->in_buf, op->in_len);                                   /* trace the sent frame */
+#endif
+                
+                break;
+            }
+            case MIFARE_ULTRALIGHT_OP_STATE_WAIT :
+            {
+                len = op->out_len;                                                                       /* set the capacity */
+                res = a_mifare_ultralight_poll(handle, op->out_buf, &len);                               /* poll the response */
+                if (res == 2)                                                                            /* pending */
+                {
+                    if ((handle->op_timeout_us == 0) || !MIFARE_ULTRALIGHT_LINKED(handle, timestamp_us)) /* no timeout */
+                    {
+                        return 0;                                                                        /* wait more */
+                    }
+                    now = a_mifare_ultralight_timestamp_us(handle);                                      /* get the time */
+                    if ((uint32_t)(now - op->timestamp) < handle->op_timeout_us)                         /* check the time */
+                    {
+                        return 0;                                                                        /* wait more */
+                    }
+                }
+                a_mifare_ultralight_nak_keep(handle, op->in_buf[0], res, op->out_buf, len);              /* keep the nak */
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+                a_mifare_ultralight_trace_buf(handle, MIFARE_ULTRALIGHT_TRACE_DIR_RX, res, a_mifare_ultralight_timestamp_us(handle), 
+                                              op->out_buf, (res == 0) ? len : 0);                        /* trace the received frame */
+#endif
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+                a_mifare_ultralight_stats_frame(handle, op->in_buf, op->in_len, (res == 0) ? len : 0, 
+                                                a_mifare_ultralight_timestamp_us(handle) - op->timestamp); /* record the frame */
+#endif
+                if (op->type == MIFARE_ULTRALIGHT_OP_HALT)                                               /* halt has no response */
+                {
+                    op->guard_us = handle->guard_time_us[MIFARE_ULTRALIGHT_GUARD_TIME_HALT];             /* set the guard time */
+                    op->next = (uint8_t)MIFARE_ULTRALIGHT_OP_STATE_DONE;                                 /* done after the guard */
+                    a_mifare_ultralight_op_enter(handle, op, MIFARE_ULTRALIGHT_OP_STATE_GUARD, 0);       /* wait the guard time */
+                    
+                    break;
+                }
+                if (res == 2)                                                                            /* timeout */
+                {
+                    a_mifare_ultralight_op_enter(handle, op, MIFARE_ULTRALIGHT_OP_STATE_ERROR, 8);       /* timeout */
+                    
+                    break;
+                }
+                if (res != 0)                                                                            /* check the result */
+                {
+                    a_mifare_ultralight_op_enter(handle, op, MIFARE_ULTRALIGHT_OP_STATE_ERROR, 1);       /* transport failed */
+                    
+                    break;
+                }
+                res = a_mifare_ultralight_op_response(handle, op, len);                                  /* check the response */
+                if (res != 0)                                                                            /* check the result */
+                {
+                    a_mifare_ultralight_op_enter(handle, op, MIFARE_ULTRALIGHT_OP_STATE_ERROR, res);     /* response error */
+                    
+                    break;
+                }
+                op->step++;                                                                              /* next frame */
+                if (op->step >= op->steps)                                                               /* check the sequence */
+                {
+                    a_mifare_ultralight_op_enter(handle, op, MIFARE_ULTRALIGHT_OP_STATE_DONE, 0);        /* done */
+                    
+                    break;
+                }
+                a_mifare_ultralight_op_frame(handle, op);                                                /* build the next frame */
+                a_mifare_ultralight_op_enter(handle, op, MIFARE_ULTRALIGHT_OP_STATE_SUBMIT, 0);          /* submit it */
+                
+                break;
+            }
+            default :
+            {
+                return 0;                                                                                /* finished */
+            }
+        }
     }
-    if (output_len != 6)                                                                         /* check the output_len */
+}
+
+/**
+ * @brief     mifare_ultralight classify the last failure
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    failure class
+ * @note      a wrong length answer may be a nak, the card sends 4 bits instead of the data
+ */
+static mifare_ultralight_failure_t a_mifare_ultralight_failure(mifare_ultralight_handle_t *handle)
+{
+    switch (handle->error)
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
-        
-        return 4;                                                                                /* return error */
+        case MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER :
+        case MIFARE_ULTRALIGHT_STATS_ERROR_TIMEOUT :
+        {
+            return MIFARE_ULTRALIGHT_FAILURE_NO_RESPONSE;                                       /* no response */
+        }
+        case MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN :
+        case MIFARE_ULTRALIGHT_STATS_ERROR_ACK :
+        {
+            if ((handle->nak == MIFARE_ULTRALIGHT_NAK_CRC) || 
+                (handle->nak == MIFARE_ULTRALIGHT_NAK_EEPROM))                                  /* check the nak */
+            {
+                return MIFARE_ULTRALIGHT_FAILURE_NAK_TRANSIENT;                                 /* transient nak */
+            }
+            if (handle->nak != MIFARE_ULTRALIGHT_NAK_NONE)                                      /* check the nak */
+            {
+                return MIFARE_ULTRALIGHT_FAILURE_NAK_PERMANENT;                                 /* permanent nak */
+            }
+            
+            return MIFARE_ULTRALIGHT_FAILURE_CORRUPT;                                           /* truncated or garbled */
+        }
+        case MIFARE_ULTRALIGHT_STATS_ERROR_CRC :
+        case MIFARE_ULTRALIGHT_STATS_ERROR_SAK :
+        case MIFARE_ULTRALIGHT_STATS_ERROR_CHECK :
+        {
+            return MIFARE_ULTRALIGHT_FAILURE_CORRUPT;                                           /* corrupted response */
+        }
+        case MIFARE_ULTRALIGHT_STATS_ERROR_PACK :
+        {
+            return MIFARE_ULTRALIGHT_FAILURE_REJECTED;                                          /* refused response */
+        }
+        default :
+        {
+            return MIFARE_ULTRALIGHT_FAILURE_NONE;                                              /* no failure */
+        }
     }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 4, crc_buf);                                   /* get the crc */
-    if ((output_buf[4] == crc_buf[0]) && (output_buf[5] == crc_buf[1]))                          /* check the crc */
+}
+
+/**
+ * @brief     set the retry policy
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *policy pointer to a retry policy structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      init sets a policy without any retry
+ */
+uint8_t mifare_ultralight_set_retry_policy(mifare_ultralight_handle_t *handle, const mifare_ultralight_retry_policy_t *policy)
+{
+    if (handle == NULL)                                                            /* check handle */
     {
-        memcpy(lock + 2, output_buf, 3);                                                         /* copy the data */
-        
-        return 0;                                                                                /* success return 0 */
+        return 2;                                                                  /* return error */
     }
-    else
+    
+    memcpy(&handle->retry, policy, sizeof(mifare_ultralight_retry_policy_t));      /* set the policy */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the retry policy
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *policy pointer to a retry policy structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_retry_policy(mifare_ultralight_handle_t *handle, mifare_ultralight_retry_policy_t *policy)
+{
+    if (handle == NULL)                                                            /* check handle */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
-        
-        return 5;                                                                                /* return error */
+        return 2;                                                                  /* return error */
     }
+    
+    memcpy(policy, &handle->retry, sizeof(mifare_ultralight_retry_policy_t));      /* get the policy */
+    
+    return 0;                                                                      /* success return 0 */
 }
 
 /**
- * @brief      mifare_ultralight read otp page
+ * @brief      classify the last failure
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
- * @param[out] *data pointer to a data buffer
+ * @param[out] *failure pointer to a failure class buffer
+ * @param[out] *nak pointer to a nak buffer
  * @return     status code
  *             - 0 success
- *             - 1 read otp page failed
  *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 output_len is invalid
- *             - 5 crc error
- * @note       none
+ * @note       nak is MIFARE_ULTRALIGHT_NAK_NONE when the card did not answer with a nak
  */
-uint8_t mifare_ultralight_read_otp(mifare_ultralight_handle_t *handle, uint8_t data[4])
+uint8_t mifare_ultralight_get_failure(mifare_ultralight_handle_t *handle, mifare_ultralight_failure_t *failure, uint8_t *nak)
+{
+    if (handle == NULL)                                          /* check handle */
+    {
+        return 2;                                                /* return error */
+    }
+    
+    *failure = a_mifare_ultralight_failure(handle);              /* classify the failure */
+    *nak = handle->nak;                                          /* get the nak */
+    
+    return 0;                                                    /* success return 0 */
+}
+
+/**
+ * @brief     run a job with the retry policy
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *run pointer to a job function address
+ * @param[in] *arg job argument
+ * @param[in] flags bitwise or of mifare_ultralight_retry_flag_t
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or run is NULL
+ *            - 3 handle is not initialized
+ *            - others the result of the last run
+ * @note      a corrupted response is retried at once, no response and a transient nak
+ *            reactivate the selected card with wake up and its uid before the retry,
+ *            a permanent nak or a refused response returns at once
+ */
+uint8_t mifare_ultralight_retry(mifare_ultralight_handle_t *handle, uint8_t (*run)(mifare_ultralight_handle_t *handle, void *arg),
+                                void *arg, uint8_t flags)
 {
     uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[4];
-    uint8_t output_len;
-    uint8_t output_buf[18];
-    uint8_t crc_buf[2];
+    uint8_t uid[7];
+    uint8_t selected;
+    uint8_t reactivate;
+    uint8_t total;
+    uint8_t count[MIFARE_ULTRALIGHT_FAILURE_MAX];
+    uint32_t backoff;
+    uint8_t i;
+    mifare_ultralight_failure_t failure;
     
-    if (handle == NULL)                                                                          /* check handle */
+    if ((handle == NULL) || (run == NULL))                                                      /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                               /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                                    /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                               /* return error */
     }
     
-    input_len = 4;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_READ;                                               /* set the command */
-    input_buf[1] = 0x03;                                                                         /* set the page */
-    a_mifare_ultralight_iso14443a_crc(input_buf , 2, input_buf + 2);                             /* get the crc */
-    output_len = 18;                                                                             /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
-    {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
+    selected = (handle->uid_valid == 3) ? 1 : 0;                                                /* check the selected card */
+    memcpy(uid, handle->uid, 7);                                                                /* save the uid */
+    memset(count, 0, sizeof(count));                                                            /* clear the retries */
+    total = 0;                                                                                  /* init 0 */
+    reactivate = 0;                                                                             /* init 0 */
+    res = 1;                                                                                    /* init 1 */
+    while (1)                                                                                   /* until done */
+    {
+        if ((reactivate != 0) && (a_mifare_ultralight_reactivate(handle, uid) != 0))            /* reactivate the card */
+        {
+            failure = MIFARE_ULTRALIGHT_FAILURE_NO_RESPONSE;                                    /* the card is gone */
+        }
+        else
+        {
+            handle->error = MIFARE_ULTRALIGHT_STATS_ERROR_MAX;                                  /* clear the failure */
+            handle->nak = MIFARE_ULTRALIGHT_NAK_NONE;                                           /* clear the nak */
+            res = run(handle, arg);                                                             /* run the job */
+            if (res == 0)                                                                       /* check the result */
+            {
+                return 0;                                                                       /* success return 0 */
+            }
+            failure = a_mifare_ultralight_failure(handle);                                      /* classify the failure */
+        }
         
-        return 1;                                                                                /* return error */
-    }
-    if (output_len != 18)                                                                        /* check the output_len */
-    {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        if ((failure == MIFARE_ULTRALIGHT_FAILURE_NONE) || 
+            (failure == MIFARE_ULTRALIGHT_FAILURE_NAK_PERMANENT) || 
+            (failure == MIFARE_ULTRALIGHT_FAILURE_REJECTED))                                    /* retrying is pointless */
+        {
+            return res;                                                                         /* return the result */
+        }
+        if (((flags & MIFARE_ULTRALIGHT_RETRY_FLAG_NOT_IDEMPOTENT) != 0) && 
+            (failure != MIFARE_ULTRALIGHT_FAILURE_NAK_TRANSIENT))                               /* the job may have run */
+        {
+            return res;                                                                         /* return the result */
+        }
+        reactivate = (failure != MIFARE_ULTRALIGHT_FAILURE_CORRUPT) ? 1 : 0;                    /* the card went idle */
+        if ((reactivate != 0) && 
+            ((((flags & MIFARE_ULTRALIGHT_RETRY_FLAG_NO_REACTIVATE) != 0) && (handle->auth_auto == 0)) || 
+             (selected == 0)))                                                                  /* check the reactivation */
+        {
+            return res;                                                                         /* return the result */
+        }
+        if ((count[failure] >= handle->retry.failure[failure].budget) || 
+            (total >= handle->retry.max_retry))                                                 /* check the budget */
+        {
+            return res;                                                                         /* return the result */
+        }
         
-        return 4;                                                                                /* return error */
+        backoff = handle->retry.failure[failure].backoff_us;                                    /* get the backoff */
+        for (i = 0; (i < count[failure]) && (backoff < 0x80000000U); i++)                       /* double it for every retry */
+        {
+            backoff <<= 1;                                                                      /* double */
+        }
+        if ((handle->retry.max_backoff_us != 0) && (backoff > handle->retry.max_backoff_us))    /* check the limit */
+        {
+            backoff = handle->retry.max_backoff_us;                                             /* limit the backoff */
+        }
+        count[failure]++;                                                                       /* count the retry */
+        total++;                                                                                /* count the retry */
+        handle->debug_print("mifare_ultralight: retry %d after failure %d.\n", total, failure);  /* retry */
+        if (backoff != 0)                                                                       /* check the backoff */
+        {
+            a_mifare_ultralight_wait_us(handle, backoff);                                       /* wait the backoff */
+        }
     }
-    a_mifare_ultralight_iso14443a_crc(output_buf, 16, crc_buf);                                  /* get the crc */
-    if ((output_buf[16] == crc_buf[0]) && (output_buf[17] == crc_buf[1]))                        /* check the crc */
+}
+
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+/**
+ * @brief      get the statistics
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *stats pointer to a statistics structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       the latency needs the timestamp_us function, otherwise every frame is in bucket 0
+ */
+uint8_t mifare_ultralight_get_stats(mifare_ultralight_handle_t *handle, mifare_ultralight_stats_t *stats)
+{
+    if ((handle == NULL) || (stats == NULL))                           /* check handle */
     {
-        memcpy(data, output_buf, 4);                                                             /* copy the data */
-        
-        return 0;                                                                                /* success return 0 */
+        return 2;                                                      /* return error */
     }
-    else
+    
+    memcpy(stats, &handle->stats, sizeof(mifare_ultralight_stats_t));  /* copy the statistics */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     reset the statistics
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      init and deinit keep the statistics
+ */
+uint8_t mifare_ultralight_reset_stats(mifare_ultralight_handle_t *handle)
+{
+    if (handle == NULL)                                                /* check handle */
     {
-        handle->debug_print("mifare_ultralight: crc error.\n");                                  /* crc error */
-        
-        return 5;                                                                                /* return error */
+        return 2;                                                      /* return error */
     }
+    
+    memset(&handle->stats, 0, sizeof(mifare_ultralight_stats_t));      /* clear the statistics */
+    handle->stats_comp_write = 0;                                      /* clear the comp write flag */
+    
+    return 0;                                                          /* success return 0 */
 }
+#endif
 
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
 /**
- * @brief     mifare_ultralight write otp page
+ * @brief     set the trace ring
  * @param[in] *handle pointer to a mifare_ultralight handle structure
- * @param[in] *data pointer to a data buffer
+ * @param[in] *trace pointer to a trace structure or NULL to stop the trace
  * @return    status code
  *            - 0 success
- *            - 1 write otp page failed
  *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 output_len is invalid
- *            - 5 ack error
- * @note      none
+ * @note      the ring is cleared, every sent and received frame is then recorded with one copy
+ *            and an index bump, the oldest entries are overwritten when the reader is late
  */
-uint8_t mifare_ultralight_write_otp(mifare_ultralight_handle_t *handle, uint8_t data[4])
+uint8_t mifare_ultralight_set_trace(mifare_ultralight_handle_t *handle, mifare_ultralight_trace_t *trace)
 {
-    uint8_t res;
-    uint8_t input_len;
-    uint8_t input_buf[8];
-    uint8_t output_len;
-    uint8_t output_buf[1];
-    
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                      /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    
+    if (trace != NULL)                                                 /* check the ring */
     {
-        return 3;                                                                                /* return error */
+        trace->head = 0;                                               /* clear the head */
+        trace->tail = 0;                                               /* clear the tail */
+        trace->lost = 0;                                               /* clear the lost */
     }
+    handle->trace = trace;                                             /* set the ring */
+    handle->trace_command = 0;                                         /* clear the command */
     
-    input_len = 8;                                                                               /* set the input length */
-    input_buf[0] = MIFARE_ULTRALIGHT_COMMAND_WRITE;                                              /* set the command */
-    input_buf[1] = 0x03;                                                                         /* set the page */
-    input_buf[2] = data[0];                                                                      /* set data0 */
-    input_buf[3] = data[1];                                                                      /* set data1 */
-    input_buf[4] = data[2];                                                                      /* set data2 */
-    input_buf[5] = data[3];                                                                      /* set data3 */
-    a_mifare_ultralight_iso14443a_crc(input_buf, 6, input_buf + 6);                              /* get the crc */
-    output_len = 1;                                                                              /* set the output length */
-    res = handle->contactless_transceiver(input_buf, input_len, output_buf, &output_len);        /* transceiver */
-    if (res != 0)                                                                                /* check the result */
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      read the oldest trace entry
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *entry pointer to a trace entry structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no entry
+ *             - 2 handle is NULL
+ *             - 4 trace is not set
+ * @note       one reader may run beside the driver without a lock, the slot the driver
+ *             writes next is never read, so at most MIFARE_ULTRALIGHT_TRACE_DEPTH - 1 entries
+ *             are kept, the overwritten entries are counted in lost
+ */
+uint8_t mifare_ultralight_read_trace(mifare_ultralight_handle_t *handle, mifare_ultralight_trace_entry_t *entry)
+{
+    mifare_ultralight_trace_t *trace;
+    uint32_t head;
+    uint32_t tail;
+    
+    if (handle == NULL)                                                                        /* check handle */
     {
-        handle->debug_print("mifare_ultralight: contactless transceiver failed.\n");             /* contactless transceiver failed */
-        
-        return 1;                                                                                /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (output_len != 1)                                                                         /* check the output_len */
+    trace = handle->trace;                                                                     /* get the ring */
+    if ((trace == NULL) || (entry == NULL))                                                    /* check the ring */
     {
-        handle->debug_print("mifare_ultralight: output_len is invalid.\n");                      /* output_len is invalid */
+        handle->debug_print("mifare_ultralight: trace is not set.\n");                         /* trace is not set */
         
-        return 4;                                                                                /* return error */
+        return 4;                                                                              /* return error */
     }
-    if (output_buf[0] != 0xA)                                                                    /* check the result */
+    
+    tail = trace->tail;                                                                        /* get the tail */
+    while (1)                                                                                  /* until a whole entry */
     {
-        handle->debug_print("mifare_ultralight: ack error.\n");                                  /* ack error */
-        
-        return 5;                                                                                /* return error */
+        head = trace->head;                                                                    /* get the head */
+        if (head - tail >= MIFARE_ULTRALIGHT_TRACE_DEPTH)                                      /* check the overrun */
+        {
+            trace->lost += head - tail - (MIFARE_ULTRALIGHT_TRACE_DEPTH - 1);                  /* count the lost entries */
+            tail = head - (MIFARE_ULTRALIGHT_TRACE_DEPTH - 1);                                 /* skip to the oldest whole entry */
+        }
+        if (tail == head)                                                                      /* check the ring */
+        {
+            trace->tail = tail;                                                                /* save the tail */
+            
+            return 1;                                                                          /* no entry */
+        }
+        MIFARE_ULTRALIGHT_TRACE_BARRIER();                                                     /* head before entry */
+        memcpy(entry, &trace->entry[tail & (MIFARE_ULTRALIGHT_TRACE_DEPTH - 1)], 
+               sizeof(mifare_ultralight_trace_entry_t));                                       /* copy the entry */
+        MIFARE_ULTRALIGHT_TRACE_BARRIER();                                                     /* entry before head */
+        if (trace->head - tail < MIFARE_ULTRALIGHT_TRACE_DEPTH)                                /* check the entry is still valid */
+        {
+            trace->tail = tail + 1;                                                            /* take the entry */
+            
+            return 0;                                                                          /* success return 0 */
+        }
     }
-    
-    return 0;                                                                                    /* success return 0 */
 }
+#endif
 
 /**
  * @brief         transceiver data
@@ -2617,7 +7566,7 @@ uint8_t mifare_ultralight_transceiver(mifare_ultralight_handle_t *handle, uint8_
         return 3;                                                      /* return error */
     }
     
-    if (handle->contactless_transceiver(in_buf, in_len, 
+    if (a_mifare_ultralight_transceiver(handle, in_buf, in_len, 
                                         out_buf, out_len) != 0)        /* transceiver data */
     {
         return 1;                                                      /* return error */
@@ -2628,6 +7577,63 @@ uint8_t mifare_ultralight_transceiver(mifare_ultralight_handle_t *handle, uint8_
     }
 }
 
+/**
+ * @brief     get the timestamp of the handle
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    timestamp in us
+ * @note      0 is returned when handle is NULL or without the timestamp_us function,
+ *            the _ctx function is used when it is linked
+ */
+uint32_t mifare_ultralight_timestamp_us(mifare_ultralight_handle_t *handle)
+{
+    if (handle == NULL)                                   /* check handle */
+    {
+        return 0;                                         /* no timestamp */
+    }
+    
+    return a_mifare_ultralight_timestamp_us(handle);      /* get the timestamp */
+}
+
+/**
+ * @brief  start a crc_a calculation
+ * @return crc preset
+ * @note   none
+ */
+uint16_t mifare_ultralight_crc_init(void)
+{
+    return MIFARE_ULTRALIGHT_CRC_INIT;                                  /* return the preset */
+}
+
+/**
+ * @brief     update a crc_a calculation
+ * @param[in] crc current crc
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    updated crc
+ * @note      none
+ */
+uint16_t mifare_ultralight_crc_update(uint16_t crc, const uint8_t *buf, uint16_t len)
+{
+    if ((buf == NULL) || (len == 0))                                    /* check the buffer */
+    {
+        return crc;                                                     /* nothing to do */
+    }
+    
+    return a_mifare_ultralight_crc_update(crc, buf, len);               /* update the crc */
+}
+
+/**
+ * @brief      finish a crc_a calculation
+ * @param[in]  crc current crc
+ * @param[out] *output pointer to a crc buffer
+ * @note       output[0] is lsb and output[1] is msb as they are sent on air
+ */
+void mifare_ultralight_crc_final(uint16_t crc, uint8_t output[2])
+{
+    output[0] = (uint8_t)(crc & 0xFF);                                  /* lsb */
+    output[1] = (uint8_t)((crc >> 8) & 0xFF);                           /* msb */
+}
+
 /**
  * @brief      get chip information
  * @param[out] *info pointer to a mifare_ultralight info structure
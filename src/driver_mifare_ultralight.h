@@ -45,6 +45,68 @@
 extern "C"{
 #endif
 
+/**
+ * @brief crc engine definition
+ */
+#define MIFARE_ULTRALIGHT_CRC_ENGINE_BITWISE           0        /**< bit serial, no table */
+#define MIFARE_ULTRALIGHT_CRC_ENGINE_TABLE             1        /**< one byte per step, 512 bytes table */
+#define MIFARE_ULTRALIGHT_CRC_ENGINE_SLICE_BY_4        2        /**< four bytes per step, 2048 bytes table */
+
+/**
+ * @brief crc engine selection, define MIFARE_ULTRALIGHT_CRC_ENGINE before including this file to override
+ */
+#ifndef MIFARE_ULTRALIGHT_CRC_ENGINE
+    #define MIFARE_ULTRALIGHT_CRC_ENGINE MIFARE_ULTRALIGHT_CRC_ENGINE_SLICE_BY_4
+#endif
+
+/**
+ * @brief statistics selection, define MIFARE_ULTRALIGHT_STATS as 1 before including this file to enable,
+ *        with 0 every statistics field and function is compiled out
+ */
+#ifndef MIFARE_ULTRALIGHT_STATS
+    #define MIFARE_ULTRALIGHT_STATS 0
+#endif
+
+/**
+ * @brief trace selection, define MIFARE_ULTRALIGHT_TRACE as 1 before including this file to enable,
+ *        with 0 every trace field and function is compiled out
+ */
+#ifndef MIFARE_ULTRALIGHT_TRACE
+    #define MIFARE_ULTRALIGHT_TRACE 0
+#endif
+
+/**
+ * @brief trace ring depth, it must be a power of 2
+ */
+#ifndef MIFARE_ULTRALIGHT_TRACE_DEPTH
+    #define MIFARE_ULTRALIGHT_TRACE_DEPTH 32
+#endif
+
+/**
+ * @brief trace frame length, longer frames keep their first bytes
+ */
+#ifndef MIFARE_ULTRALIGHT_TRACE_FRAME_LEN
+    #define MIFARE_ULTRALIGHT_TRACE_FRAME_LEN 20
+#endif
+
+/**
+ * @brief trace memory barrier, the default only stops the compiler from moving the entry
+ *        accesses across the index accesses, define it as __sync_synchronize() or similar
+ *        when the producer and the consumer run on different cores
+ */
+#ifndef MIFARE_ULTRALIGHT_TRACE_BARRIER
+    #if defined(__GNUC__) || defined(__clang__)
+        #define MIFARE_ULTRALIGHT_TRACE_BARRIER() __asm__ __volatile__("" : : : "memory")
+    #elif defined(_MSC_VER)
+        #include <intrin.h>
+        #define MIFARE_ULTRALIGHT_TRACE_BARRIER() _ReadWriteBarrier()
+    #elif (MIFARE_ULTRALIGHT_TRACE != 0)
+        #error "define MIFARE_ULTRALIGHT_TRACE_BARRIER for this compiler"
+    #else
+        #define MIFARE_ULTRALIGHT_TRACE_BARRIER()
+    #endif
+#endif
+
 /**
  * @defgroup mifare_ultralight_driver mifare ultralight driver function
  * @brief    mifare ultralight driver modules
@@ -101,6 +163,81 @@ typedef enum
     MIFARE_ULTRALIGHT_MODULATION_MODE_STRONG = 0x01,        /**< strong */
 } mifare_ultralight_modulation_mode_t;
 
+/**
+ * @brief mifare ultralight write allow enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_WRITE_ALLOW_NONE = 0x00,        /**< only user pages */
+    MIFARE_ULTRALIGHT_WRITE_ALLOW_OTP  = 0x01,        /**< allow the otp page */
+    MIFARE_ULTRALIGHT_WRITE_ALLOW_LOCK = 0x02,        /**< allow the lock pages */
+    MIFARE_ULTRALIGHT_WRITE_ALLOW_CONF = 0x04,        /**< allow the configuration pages */
+} mifare_ultralight_write_allow_t;
+
+/**
+ * @brief mifare ultralight guard time enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_GUARD_TIME_WAKE_UP = 0x00,        /**< wait before wake up */
+    MIFARE_ULTRALIGHT_GUARD_TIME_REQUEST = 0x01,        /**< wait before request */
+    MIFARE_ULTRALIGHT_GUARD_TIME_HALT    = 0x02,        /**< wait after halt */
+} mifare_ultralight_guard_time_t;
+
+/**
+ * @brief mifare ultralight activate policy enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_ACTIVATE_POLICY_NONE            = 0x00,        /**< request, anti collision, select, read page 0 and get version */
+    MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP         = 0x01,        /**< wake up instead of request */
+    MIFARE_ULTRALIGHT_ACTIVATE_POLICY_KNOWN_UID       = 0x02,        /**< select the given uid without anti collision */
+    MIFARE_ULTRALIGHT_ACTIVATE_POLICY_SKIP_READ_PAGE0 = 0x04,        /**< skip the page 0 read */
+    MIFARE_ULTRALIGHT_ACTIVATE_POLICY_SKIP_VERSION    = 0x08,        /**< skip get version if the storage is known */
+} mifare_ultralight_activate_policy_t;
+
+/**
+ * @brief mifare ultralight op enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_OP_REQUEST                  = 0x00,        /**< request, data is NULL or atqa[2] out */
+    MIFARE_ULTRALIGHT_OP_WAKE_UP                  = 0x01,        /**< wake up, data is NULL or atqa[2] out */
+    MIFARE_ULTRALIGHT_OP_HALT                     = 0x02,        /**< halt, data is NULL */
+    MIFARE_ULTRALIGHT_OP_ANTICOLLISION_CL1        = 0x03,        /**< anti collision cl1, data is id[4] out */
+    MIFARE_ULTRALIGHT_OP_ANTICOLLISION_CL2        = 0x04,        /**< anti collision cl2, data is id[4] out */
+    MIFARE_ULTRALIGHT_OP_SELECT_CL1               = 0x05,        /**< select cl1, data is id[4] in */
+    MIFARE_ULTRALIGHT_OP_SELECT_CL2               = 0x06,        /**< select cl2, data is id[4] in */
+    MIFARE_ULTRALIGHT_OP_GET_VERSION              = 0x07,        /**< get version, data is version[8] out */
+    MIFARE_ULTRALIGHT_OP_READ_PAGE                = 0x08,        /**< read page, data is page[4] out */
+    MIFARE_ULTRALIGHT_OP_READ_FOUR_PAGES          = 0x09,        /**< read four pages, data is pages[16] out */
+    MIFARE_ULTRALIGHT_OP_FAST_READ_PAGE           = 0x0A,        /**< fast read page, data is pages[4 * n] out */
+    MIFARE_ULTRALIGHT_OP_WRITE_PAGE               = 0x0B,        /**< write page, data is page[4] in */
+    MIFARE_ULTRALIGHT_OP_COMPATIBILITY_WRITE_PAGE = 0x0C,        /**< compatibility write page, data is page[4] in */
+    MIFARE_ULTRALIGHT_OP_READ_COUNTER             = 0x0D,        /**< read counter, data is cnt[3] out lsb first */
+    MIFARE_ULTRALIGHT_OP_INCREMENT_COUNTER        = 0x0E,        /**< increment counter, data is cnt[3] in lsb first */
+    MIFARE_ULTRALIGHT_OP_CHECK_TEARING_EVENT      = 0x0F,        /**< check tearing event, data is flag[1] out */
+    MIFARE_ULTRALIGHT_OP_READ_SIGNATURE           = 0x10,        /**< read signature, data is signature[32] out */
+    MIFARE_ULTRALIGHT_OP_AUTHENTICATE             = 0x11,        /**< authenticate, data is pwd[4] and pack[2] in */
+    MIFARE_ULTRALIGHT_OP_GET_LOCK                 = 0x12,        /**< get lock, data is lock[5] out */
+    MIFARE_ULTRALIGHT_OP_SET_LOCK                 = 0x13,        /**< set lock, data is lock[5] in */
+    MIFARE_ULTRALIGHT_OP_CONF_UPDATE              = 0x14,        /**< conf read modify write, data is value[4] and mask[4] in */
+    MIFARE_ULTRALIGHT_OP_VCSL                     = 0x15,        /**< vcsl, data is iid[16] and pcd_capabilities[4] in, identifier[1] out */
+} mifare_ultralight_op_type_t;
+
+/**
+ * @brief mifare ultralight op state enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_OP_STATE_IDLE   = 0x00,        /**< not started */
+    MIFARE_ULTRALIGHT_OP_STATE_GUARD  = 0x01,        /**< waiting the guard time */
+    MIFARE_ULTRALIGHT_OP_STATE_SUBMIT = 0x02,        /**< frame ready to be queued */
+    MIFARE_ULTRALIGHT_OP_STATE_WAIT   = 0x03,        /**< frame queued, waiting the response */
+    MIFARE_ULTRALIGHT_OP_STATE_DONE   = 0x04,        /**< finished, res is 0 */
+    MIFARE_ULTRALIGHT_OP_STATE_ERROR  = 0x05,        /**< finished, res is the error */
+} mifare_ultralight_op_state_t;
+
 /**
  * @brief mifare ultralight version structure definition
  */
@@ -116,6 +253,307 @@ typedef struct mifare_ultralight_version_s
     uint8_t protocol_type;                /**< protocol type */
 } mifare_ultralight_version_t;
 
+/**
+ * @brief mifare ultralight snapshot structure definition
+ */
+typedef struct mifare_ultralight_snapshot_s
+{
+    uint8_t lock[5];                                          /**< lock bytes in the mifare_ultralight_get_lock layout */
+    uint8_t otp[4];                                           /**< otp page */
+    uint8_t cfg0[4];                                          /**< raw cfg0 page */
+    uint8_t cfg1[4];                                          /**< raw cfg1 page */
+    mifare_ultralight_modulation_mode_t mode;                 /**< modulation mode */
+    uint8_t protect_start_page;                               /**< auth0 */
+    uint8_t access;                                           /**< raw access byte */
+    mifare_ultralight_bool_t read_protection;                 /**< prot */
+    mifare_ultralight_bool_t user_conf_protection;            /**< cfglck */
+    uint8_t authenticate_limitation;                          /**< authlim */
+    uint8_t virtual_card_type_identifier;                     /**< vctid */
+} mifare_ultralight_snapshot_t;
+
+/**
+ * @brief mifare ultralight cache verdict enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_CACHE_VERDICT_UNKNOWN     = 0x00,        /**< not verified yet */
+    MIFARE_ULTRALIGHT_CACHE_VERDICT_GENUINE     = 0x01,        /**< originality signature is valid */
+    MIFARE_ULTRALIGHT_CACHE_VERDICT_NOT_GENUINE = 0x02,        /**< originality signature is invalid */
+} mifare_ultralight_cache_verdict_t;
+
+/**
+ * @brief mifare ultralight activation structure definition
+ */
+typedef struct mifare_ultralight_activation_s
+{
+    uint8_t uid[7];                                  /**< uid */
+    uint8_t atqa[2];                                 /**< atqa */
+    uint8_t sak;                                     /**< sak */
+    mifare_ultralight_storage_t storage;             /**< storage */
+    uint32_t request_us;                             /**< request or wake up time in us */
+    uint32_t select_us;                              /**< anti collision and select time in us */
+    uint32_t read_us;                                /**< page 0 read time in us */
+    uint32_t version_us;                             /**< get version time in us */
+    uint32_t total_us;                               /**< total time in us */
+    mifare_ultralight_cache_verdict_t verdict;       /**< cached originality verdict, unknown without a cache hit */
+    uint32_t key;                                    /**< id of the signature key the verdict was checked with */
+} mifare_ultralight_activation_t;
+
+/**
+ * @brief mifare ultralight iterator structure definition
+ */
+typedef struct mifare_ultralight_iterator_s
+{
+    uint8_t index;        /**< found tags */
+    uint8_t done;         /**< done flag */
+} mifare_ultralight_iterator_t;
+
+/**
+ * @brief mifare ultralight inventory structure definition
+ */
+typedef struct mifare_ultralight_inventory_s
+{
+    uint8_t (*set)[7];                                                  /**< uid hash set buffer */
+    uint16_t set_size;                                                  /**< uid hash set slots, power of 2 */
+    uint16_t set_count;                                                 /**< used slots */
+    uint8_t start_page;                                                 /**< start page of the read window */
+    uint8_t stop_page;                                                  /**< stop page of the read window */
+    uint8_t *data;                                                      /**< read window buffer, NULL disables the read */
+    uint16_t data_len;                                                  /**< read window buffer length */
+    void (*callback)(uint8_t uid[7], uint8_t *data, uint16_t len);      /**< new tag callback */
+    uint32_t cycles;                                                    /**< poll cycles */
+    uint32_t new_tags;                                                  /**< new tags */
+    uint32_t duplicate_tags;                                            /**< tags already seen */
+    uint32_t errors;                                                    /**< failed tags */
+    uint32_t last_cycle_us;                                             /**< last cycle time in us */
+    uint32_t total_us;                                                  /**< session time in us */
+    uint32_t tags_per_second;                                           /**< new tags per second */
+} mifare_ultralight_inventory_t;
+
+/**
+ * @brief mifare ultralight verify structure definition
+ */
+typedef struct mifare_ultralight_verify_s
+{
+    uint8_t queued[6];                                                      /**< queued pages, bit n % 8 of byte n / 8 is page n */
+    uint8_t mismatch[6];                                                    /**< mismatched pages of the last commit */
+    uint8_t data[4 * ((uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21 + 1)];     /**< expected content of every queued page */
+    uint8_t frames;                                                         /**< fast read frames of the last commit */
+    uint8_t rewritten;                                                      /**< rewritten pages of the last commit */
+} mifare_ultralight_verify_t;
+
+/**
+ * @brief mifare ultralight cache entry structure definition
+ */
+typedef struct mifare_ultralight_cache_entry_s
+{
+    uint8_t uid[7];         /**< uid */
+    uint8_t storage;        /**< mifare_ultralight_storage_t, 0 is unknown */
+    uint8_t verdict;        /**< mifare_ultralight_cache_verdict_t */
+    uint8_t flag;           /**< bit 0 used, bit 1 referenced since the last clock sweep */
+    uint32_t key;           /**< id of the signature key the verdict was checked with */
+} mifare_ultralight_cache_entry_t;
+
+/**
+ * @brief mifare ultralight cache structure definition
+ */
+typedef struct mifare_ultralight_cache_s
+{
+    mifare_ultralight_cache_entry_t *entry;        /**< entry table */
+    uint16_t size;                                 /**< entry table slots, power of 2 */
+    uint16_t count;                                /**< used slots */
+    uint16_t hand;                                 /**< clock hand */
+    uint32_t hits;                                 /**< lookups that found the uid */
+    uint32_t misses;                               /**< lookups that did not find the uid */
+    uint32_t inserts;                              /**< new uids */
+    uint32_t evictions;                            /**< uids evicted to make room */
+} mifare_ultralight_cache_t;
+
+/**
+ * @brief mifare ultralight op structure definition
+ */
+typedef struct mifare_ultralight_op_s
+{
+    uint8_t type;                  /**< op type */
+    uint8_t state;                 /**< op state */
+    uint8_t res;                   /**< 0 success, 1 transport failed, 4 output_len invalid, 5 check error, 6 ack error, 7 pack check failed, 8 timeout */
+    uint8_t step;                  /**< frame index of the sequence */
+    uint8_t steps;                 /**< frame number of the sequence */
+    uint8_t page;                  /**< page, counter addr or conf index */
+    uint8_t stop_page;             /**< stop page */
+    uint8_t *data;                 /**< data buffer */
+    uint8_t next;                  /**< state after the guard time */
+    uint32_t guard_us;             /**< guard time in us */
+    uint32_t timestamp;            /**< state entry timestamp in us */
+    uint8_t in_buf[23];            /**< frame buffer */
+    uint8_t in_len;                /**< frame length */
+    uint8_t out_buf[62];           /**< response buffer */
+    uint8_t out_len;               /**< expected response length */
+} mifare_ultralight_op_t;
+
+/**
+ * @brief mifare ultralight segment structure definition
+ */
+typedef struct mifare_ultralight_segment_s
+{
+    uint8_t *buf;        /**< segment buffer */
+    uint8_t len;         /**< segment length */
+} mifare_ultralight_segment_t;
+
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+/**
+ * @brief mifare ultralight statistics command enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_STATS_COMMAND_REQUEST             = 0x00,        /**< request */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_WAKE_UP             = 0x01,        /**< wake up */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_CL1                 = 0x02,        /**< anti collision or select cl1 */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_CL2                 = 0x03,        /**< anti collision or select cl2 */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_HALT                = 0x04,        /**< halt */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_GET_VERSION         = 0x05,        /**< get version */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_READ                = 0x06,        /**< read */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_FAST_READ           = 0x07,        /**< fast read */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_WRITE               = 0x08,        /**< write */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_COMP_WRITE          = 0x09,        /**< comp write */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_READ_CNT            = 0x0A,        /**< read cnt */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_INCR_CNT            = 0x0B,        /**< incr cnt */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_PWD_AUTH            = 0x0C,        /**< pwd auth */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_READ_SIG            = 0x0D,        /**< read sig */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_CHECK_TEARING_EVENT = 0x0E,        /**< check tearing event */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_VCSL                = 0x0F,        /**< vcsl */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_OTHER               = 0x10,        /**< raw frames of other commands */
+    MIFARE_ULTRALIGHT_STATS_COMMAND_MAX                 = 0x11,        /**< command number */
+} mifare_ultralight_stats_command_t;
+#endif
+
+/**
+ * @brief mifare ultralight error enumeration definition, the kind of the last failure is kept for the retry policy
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_STATS_ERROR_TRANSCEIVER = 0x00,        /**< transceiver failed */
+    MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN  = 0x01,        /**< output_len or output_bits is invalid */
+    MIFARE_ULTRALIGHT_STATS_ERROR_CRC         = 0x02,        /**< crc error */
+    MIFARE_ULTRALIGHT_STATS_ERROR_ACK         = 0x03,        /**< ack error, the card sent a nak */
+    MIFARE_ULTRALIGHT_STATS_ERROR_SAK         = 0x04,        /**< sak error */
+    MIFARE_ULTRALIGHT_STATS_ERROR_CHECK       = 0x05,        /**< check error */
+    MIFARE_ULTRALIGHT_STATS_ERROR_PACK        = 0x06,        /**< pack check failed */
+    MIFARE_ULTRALIGHT_STATS_ERROR_TIMEOUT     = 0x07,        /**< op response timeout */
+    MIFARE_ULTRALIGHT_STATS_ERROR_MAX         = 0x08,        /**< error number */
+} mifare_ultralight_stats_error_t;
+
+/**
+ * @brief mifare ultralight failure class enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_FAILURE_NONE          = 0x00,        /**< no failure */
+    MIFARE_ULTRALIGHT_FAILURE_CORRUPT       = 0x01,        /**< crc error, truncated frame or collision, the card is still selected */
+    MIFARE_ULTRALIGHT_FAILURE_NO_RESPONSE   = 0x02,        /**< no response, the card went idle or left the field */
+    MIFARE_ULTRALIGHT_FAILURE_NAK_TRANSIENT = 0x03,        /**< crc or eeprom nak, the card went idle */
+    MIFARE_ULTRALIGHT_FAILURE_NAK_PERMANENT = 0x04,        /**< invalid argument or authentication counter nak */
+    MIFARE_ULTRALIGHT_FAILURE_REJECTED      = 0x05,        /**< the response was refused or no frame was sent */
+    MIFARE_ULTRALIGHT_FAILURE_MAX           = 0x06,        /**< failure class number */
+} mifare_ultralight_failure_t;
+
+/**
+ * @brief mifare ultralight nak enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_NAK_INVALID_ARGUMENT = 0x00,        /**< invalid argument or page address */
+    MIFARE_ULTRALIGHT_NAK_CRC              = 0x01,        /**< parity or crc error */
+    MIFARE_ULTRALIGHT_NAK_AUTH_COUNTER     = 0x04,        /**< invalid authentication counter overflow */
+    MIFARE_ULTRALIGHT_NAK_EEPROM           = 0x05,        /**< eeprom write error */
+    MIFARE_ULTRALIGHT_NAK_NONE             = 0xFF,        /**< the last response was not a nak */
+} mifare_ultralight_nak_t;
+
+/**
+ * @brief mifare ultralight retry flag enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_RETRY_FLAG_NONE           = 0x00,        /**< idempotent job, the card may be reactivated */
+    MIFARE_ULTRALIGHT_RETRY_FLAG_NOT_IDEMPOTENT = 0x01,        /**< only retry after a nak, the job may have run when no ack came */
+    MIFARE_ULTRALIGHT_RETRY_FLAG_NO_REACTIVATE  = 0x02,        /**< keep the session, the authentication is lost by a reactivation unless auto authenticate is set */
+} mifare_ultralight_retry_flag_t;
+
+/**
+ * @brief mifare ultralight retry class structure definition
+ */
+typedef struct mifare_ultralight_retry_class_s
+{
+    uint8_t budget;             /**< retries of this class in one run */
+    uint32_t backoff_us;        /**< delay before the first retry, doubled for every next retry of this class */
+} mifare_ultralight_retry_class_t;
+
+/**
+ * @brief mifare ultralight retry policy structure definition
+ */
+typedef struct mifare_ultralight_retry_policy_s
+{
+    mifare_ultralight_retry_class_t failure[MIFARE_ULTRALIGHT_FAILURE_MAX];        /**< settings of every failure class, none and the permanent classes are never retried */
+    uint8_t max_retry;                                                             /**< retries of all classes in one run */
+    uint32_t max_backoff_us;                                                       /**< backoff limit */
+} mifare_ultralight_retry_policy_t;
+
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+/**
+ * @brief mifare ultralight statistics histogram definition
+ */
+#define MIFARE_ULTRALIGHT_STATS_BUCKET        16        /**< bucket n counts [2^n, 2^(n + 1)) us, bucket 0 also counts 0us and the last one counts the rest */
+
+/**
+ * @brief mifare ultralight statistics structure definition
+ */
+typedef struct mifare_ultralight_stats_s
+{
+    uint32_t command[MIFARE_ULTRALIGHT_STATS_COMMAND_MAX];                                  /**< frames of every command */
+    uint32_t error[MIFARE_ULTRALIGHT_STATS_ERROR_MAX];                                      /**< errors of every kind */
+    uint32_t tx_bytes;                                                                      /**< sent bytes */
+    uint32_t rx_bytes;                                                                      /**< received bytes */
+    uint32_t latency[MIFARE_ULTRALIGHT_STATS_COMMAND_MAX][MIFARE_ULTRALIGHT_STATS_BUCKET];  /**< frame latency histogram of every command */
+} mifare_ultralight_stats_t;
+#endif
+
+/**
+ * @brief mifare ultralight trace direction enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_TRACE_DIR_TX      = 0x00,        /**< sent frame, len in bytes */
+    MIFARE_ULTRALIGHT_TRACE_DIR_RX      = 0x01,        /**< received frame, len in bytes */
+    MIFARE_ULTRALIGHT_TRACE_DIR_TX_BITS = 0x02,        /**< sent bit oriented frame, len in bits */
+    MIFARE_ULTRALIGHT_TRACE_DIR_RX_BITS = 0x03,        /**< received bit oriented frame, len in bits */
+} mifare_ultralight_trace_dir_t;
+
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+/**
+ * @brief mifare ultralight trace entry structure definition
+ */
+typedef struct mifare_ultralight_trace_entry_s
+{
+    uint32_t timestamp;                                    /**< timestamp in us */
+    uint8_t dir;                                           /**< mifare_ultralight_trace_dir_t */
+    uint8_t command;                                       /**< first byte of the sent frame of this exchange */
+    uint8_t res;                                           /**< transceiver result of a received frame */
+    uint8_t len;                                           /**< frame length */
+    uint8_t data[MIFARE_ULTRALIGHT_TRACE_FRAME_LEN];       /**< first bytes of the frame */
+} mifare_ultralight_trace_entry_t;
+
+/**
+ * @brief mifare ultralight trace structure definition
+ */
+typedef struct mifare_ultralight_trace_s
+{
+    volatile uint32_t head;                                              /**< entries written by the driver */
+    volatile uint32_t tail;                                              /**< entries taken by the reader */
+    uint32_t lost;                                                       /**< entries overwritten before they were read */
+    mifare_ultralight_trace_entry_t entry[MIFARE_ULTRALIGHT_TRACE_DEPTH];  /**< ring of entries */
+} mifare_ultralight_trace_t;
+#endif
+
 /**
  * @brief mifare ultralight handle structure definition
  */
@@ -125,11 +563,66 @@ typedef struct mifare_ultralight_handle_s
     uint8_t (*contactless_deinit)(void);                                           /**< point to a contactless_deinit function address */
     uint8_t (*contactless_transceiver)(uint8_t *in_buf, uint8_t in_len, 
                                        uint8_t *out_buf, uint8_t *out_len);        /**< point to a contactless_transceiver function address */
+    uint8_t (*contactless_transceiver_bits)(uint8_t *in_buf, uint8_t in_bits, 
+                                            uint8_t *out_buf, uint8_t *out_bits, 
+                                            uint8_t *collision);                   /**< point to an optional contactless_transceiver_bits function address */
+    uint8_t (*contactless_transceiver_vector)(mifare_ultralight_segment_t *tx, uint8_t tx_count, 
+                                              mifare_ultralight_segment_t *rx, uint8_t rx_count, 
+                                              uint8_t *out_len);                   /**< point to an optional contactless_transceiver_vector function address */
+    uint8_t (*contactless_submit)(uint8_t *in_buf, uint8_t in_len);               /**< point to an optional contactless_submit function address */
+    uint8_t (*contactless_poll)(uint8_t *out_buf, uint8_t *out_len);               /**< point to an optional contactless_poll function address */
     void (*delay_ms)(uint32_t ms);                                                 /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                                 /**< point to an optional delay_us function address */
     void (*debug_print)(const char *const fmt, ...);                               /**< point to a debug_print function address */
+    uint32_t (*timestamp_us)(void);                                                /**< point to an optional timestamp_us function address */
+    void *user;                                                                    /**< user context passed to the _ctx functions */
+    uint8_t (*contactless_init_ctx)(void *user);                                   /**< point to a contactless_init_ctx function address */
+    uint8_t (*contactless_deinit_ctx)(void *user);                                 /**< point to a contactless_deinit_ctx function address */
+    uint8_t (*contactless_transceiver_ctx)(void *user, uint8_t *in_buf, uint8_t in_len, 
+                                           uint8_t *out_buf, uint8_t *out_len);    /**< point to a contactless_transceiver_ctx function address */
+    uint8_t (*contactless_transceiver_bits_ctx)(void *user, uint8_t *in_buf, uint8_t in_bits, 
+                                                uint8_t *out_buf, uint8_t *out_bits, 
+                                                uint8_t *collision);               /**< point to a contactless_transceiver_bits_ctx function address */
+    uint8_t (*contactless_transceiver_vector_ctx)(void *user, 
+                                                  mifare_ultralight_segment_t *tx, uint8_t tx_count, 
+                                                  mifare_ultralight_segment_t *rx, uint8_t rx_count, 
+                                                  uint8_t *out_len);               /**< point to a contactless_transceiver_vector_ctx function address */
+    uint8_t (*contactless_submit_ctx)(void *user, uint8_t *in_buf, uint8_t in_len);            /**< point to a contactless_submit_ctx function address */
+    uint8_t (*contactless_poll_ctx)(void *user, uint8_t *out_buf, uint8_t *out_len);           /**< point to a contactless_poll_ctx function address */
+    void (*delay_ms_ctx)(void *user, uint32_t ms);                                 /**< point to a delay_ms_ctx function address */
+    void (*delay_us_ctx)(void *user, uint32_t us);                                 /**< point to a delay_us_ctx function address */
+    uint32_t (*timestamp_us_ctx)(void *user);                                      /**< point to a timestamp_us_ctx function address */
     uint8_t end_page;                                                              /**< end page */
+    uint8_t max_frame_len;                                                         /**< max frame length */
+    uint32_t guard_time_us[3];                                                     /**< guard time in us */
+    uint32_t op_timeout_us;                                                        /**< op response timeout in us */
+    uint8_t conf[2][4];                                                            /**< cfg0 and cfg1 shadow */
+    uint8_t conf_valid;                                                            /**< conf shadow valid flag */
+    uint8_t conf_dirty;                                                            /**< conf shadow dirty flag */
+    uint8_t conf_transaction;                                                      /**< conf transaction flag */
     uint8_t type;                                                                  /**< type */
     uint8_t inited;                                                                /**< inited flag */
+    uint8_t uid[7];                                                                /**< uid of the selected card */
+    uint8_t uid_valid;                                                             /**< selected cascade levels, bit 0 cl1 and bit 1 cl2 */
+    uint8_t atqa[2];                                                               /**< atqa of the last request or wake up */
+    uint8_t sak;                                                                   /**< sak of the last select */
+    uint8_t error;                                                                 /**< kind of the last failure */
+    uint8_t nak;                                                                   /**< last 4 bits nak or MIFARE_ULTRALIGHT_NAK_NONE */
+    uint8_t auth;                                                                  /**< authenticated session flag */
+    uint8_t auth_auto;                                                             /**< auto authenticate flag */
+    uint8_t auth_pwd[4];                                                           /**< auto authenticate password */
+    uint8_t auth_pack[2];                                                          /**< auto authenticate pack */
+    mifare_ultralight_retry_policy_t retry;                                        /**< retry policy */
+    mifare_ultralight_verify_t *verify;                                            /**< verified write queue, NULL when closed */
+    mifare_ultralight_cache_t *cache;                                              /**< uid keyed result cache, NULL when off */
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+    mifare_ultralight_stats_t stats;                                               /**< statistics */
+    uint8_t stats_comp_write;                                                      /**< comp write data frame follows flag */
+#endif
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+    mifare_ultralight_trace_t *trace;                                              /**< trace ring */
+    uint8_t trace_command;                                                         /**< command of the current exchange */
+#endif
 } mifare_ultralight_handle_t;
 
 /**
@@ -191,6 +684,47 @@ typedef struct mifare_ultralight_info_s
  */
 #define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(HANDLE, FUC)    (HANDLE)->contactless_transceiver = FUC
 
+/**
+ * @brief     link contactless_transceiver_bits function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_transceiver_bits function address
+ * @note      optional, FUC sends in_bits bits of in_buf without crc and stores the first
+ *            received bit at bit (in_bits % 8) of out_buf[0], out_bits is the received
+ *            bit number and collision is the received bit index of the first collision
+ *            or 0xFF, without it only one tag in the field can be enumerated
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER_BITS(HANDLE, FUC)    (HANDLE)->contactless_transceiver_bits = FUC
+
+/**
+ * @brief     link contactless_transceiver_vector function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_transceiver_vector function address
+ * @note      optional, FUC sends the tx segments back to back as one frame and spreads the
+ *            received bytes over the rx segments in order, out_len is the received byte
+ *            number, the crc is part of the segments, without it contactless_transceiver
+ *            is used through a bounce buffer
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER_VECTOR(HANDLE, FUC)    (HANDLE)->contactless_transceiver_vector = FUC
+
+/**
+ * @brief     link contactless_submit function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_submit function address
+ * @note      optional, FUC queues one frame with crc and returns at once, 0 means queued,
+ *            1 means failed and 2 means busy, in_buf stays valid until the response is polled
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_SUBMIT(HANDLE, FUC)         (HANDLE)->contactless_submit = FUC
+
+/**
+ * @brief     link contactless_poll function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_poll function address
+ * @note      optional, FUC returns at once, 0 means the response is in out_buf, 1 means the
+ *            frame failed or got no response and 2 means pending, out_len is the capacity
+ *            on input and the received length on output
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_POLL(HANDLE, FUC)           (HANDLE)->contactless_poll = FUC
+
 /**
  * @brief     link delay_ms function
  * @param[in] HANDLE pointer to a mifare_ultralight handle structure
@@ -199,6 +733,14 @@ typedef struct mifare_ultralight_info_s
  */
 #define DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(HANDLE, FUC)                   (HANDLE)->delay_ms = FUC
 
+/**
+ * @brief     link delay_us function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a delay_us function address
+ * @note      optional, the guard time is rounded up to delay_ms without it
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(HANDLE, FUC)                   (HANDLE)->delay_us = FUC
+
 /**
  * @brief     link debug_print function
  * @param[in] HANDLE pointer to a mifare_ultralight handle structure
@@ -207,6 +749,102 @@ typedef struct mifare_ultralight_info_s
  */
 #define DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(HANDLE, FUC)                (HANDLE)->debug_print = FUC
 
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a timestamp_us function address
+ * @note      optional, the activation timing is 0 without it
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(HANDLE, FUC)               (HANDLE)->timestamp_us = FUC
+
+/**
+ * @brief     link the user context
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] USER pointer to a user context
+ * @note      USER is passed as the first argument of every _ctx function
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_USER(HANDLE, USER)                           (HANDLE)->user = USER
+
+/**
+ * @brief     link contactless_init_ctx function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_init_ctx function address
+ * @note      a _ctx function is used instead of the plain one when both are linked
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT_CTX(HANDLE, FUC)            (HANDLE)->contactless_init_ctx = FUC
+
+/**
+ * @brief     link contactless_deinit_ctx function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_deinit_ctx function address
+ * @note      none
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT_CTX(HANDLE, FUC)          (HANDLE)->contactless_deinit_ctx = FUC
+
+/**
+ * @brief     link contactless_transceiver_ctx function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_transceiver_ctx function address
+ * @note      none
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER_CTX(HANDLE, FUC)     (HANDLE)->contactless_transceiver_ctx = FUC
+
+/**
+ * @brief     link contactless_transceiver_bits_ctx function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_transceiver_bits_ctx function address
+ * @note      optional
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER_BITS_CTX(HANDLE, FUC)      (HANDLE)->contactless_transceiver_bits_ctx = FUC
+
+/**
+ * @brief     link contactless_transceiver_vector_ctx function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_transceiver_vector_ctx function address
+ * @note      optional
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER_VECTOR_CTX(HANDLE, FUC)    (HANDLE)->contactless_transceiver_vector_ctx = FUC
+
+/**
+ * @brief     link contactless_submit_ctx function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_submit_ctx function address
+ * @note      optional
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_SUBMIT_CTX(HANDLE, FUC)          (HANDLE)->contactless_submit_ctx = FUC
+
+/**
+ * @brief     link contactless_poll_ctx function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a contactless_poll_ctx function address
+ * @note      optional
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_POLL_CTX(HANDLE, FUC)            (HANDLE)->contactless_poll_ctx = FUC
+
+/**
+ * @brief     link delay_ms_ctx function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a delay_ms_ctx function address
+ * @note      none
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS_CTX(HANDLE, FUC)                    (HANDLE)->delay_ms_ctx = FUC
+
+/**
+ * @brief     link delay_us_ctx function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a delay_us_ctx function address
+ * @note      optional
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US_CTX(HANDLE, FUC)                    (HANDLE)->delay_us_ctx = FUC
+
+/**
+ * @brief     link timestamp_us_ctx function
+ * @param[in] HANDLE pointer to a mifare_ultralight handle structure
+ * @param[in] FUC pointer to a timestamp_us_ctx function address
+ * @note      optional
+ */
+#define DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US_CTX(HANDLE, FUC)                (HANDLE)->timestamp_us_ctx = FUC
+
 /**
  * @}
  */
@@ -236,7 +874,7 @@ uint8_t mifare_ultralight_info(mifare_ultralight_info_t *info);
  *            - 1 contactless initialization failed
  *            - 2 handle is NULL
  *            - 3 linked functions is NULL
- * @note      none
+ * @note      every required function may be linked as the plain or the _ctx version
  */
 uint8_t mifare_ultralight_init(mifare_ultralight_handle_t *handle);
 
@@ -276,6 +914,59 @@ uint8_t mifare_ultralight_set_storage(mifare_ultralight_handle_t *handle, mifare
  */
 uint8_t mifare_ultralight_get_storage(mifare_ultralight_handle_t *handle, mifare_ultralight_storage_t *storage);
 
+/**
+ * @brief     set the max frame length
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] len max frame length of the transceiver
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 len < 6
+ * @note      the default max frame length is 64
+ */
+uint8_t mifare_ultralight_set_max_frame_length(mifare_ultralight_handle_t *handle, uint8_t len);
+
+/**
+ * @brief      get the max frame length
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *len pointer to a max frame length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_max_frame_length(mifare_ultralight_handle_t *handle, uint8_t *len);
+
+/**
+ * @brief     set the guard time
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] guard guard time type
+ * @param[in] us guard time in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 guard is invalid
+ * @note      the default wake up guard time is 1000us, the others are 0
+ */
+uint8_t mifare_ultralight_set_guard_time(mifare_ultralight_handle_t *handle, mifare_ultralight_guard_time_t guard, uint32_t us);
+
+/**
+ * @brief      get the guard time
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  guard guard time type
+ * @param[out] *us pointer to a guard time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 guard is invalid
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_guard_time(mifare_ultralight_handle_t *handle, mifare_ultralight_guard_time_t guard, uint32_t *us);
+
 /**
  * @brief      mifare_ultralight request
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
@@ -304,7 +995,156 @@ uint8_t mifare_ultralight_request(mifare_ultralight_handle_t *handle, mifare_ult
  *             - 5 type is invalid
  * @note       none
  */
-uint8_t mifare_ultralight_wake_up(mifare_ultralight_handle_t *handle, mifare_ultralight_type_t *type);
+uint8_t mifare_ultralight_wake_up(mifare_ultralight_handle_t *handle, mifare_ultralight_type_t *type);
+
+/**
+ * @brief         mifare_ultralight activate a card
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in]     policy bitwise or of mifare_ultralight_activate_policy_t
+ * @param[in,out] *activation pointer to an activation structure
+ * @return        status code
+ *                - 0 success
+ *                - 1 request failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 select failed
+ *                - 5 read page failed
+ *                - 6 get version failed
+ *                - 7 storage is invalid
+ * @note          activation->uid is the input uid with MIFARE_ULTRALIGHT_ACTIVATE_POLICY_KNOWN_UID,
+ *                with a result cache the storage of a cached uid is used without get version
+ *                and activation->verdict is its cached originality verdict checked with the key activation->key
+ */
+uint8_t mifare_ultralight_activate(mifare_ultralight_handle_t *handle, uint8_t policy, mifare_ultralight_activation_t *activation);
+
+/**
+ * @brief      mifare_ultralight begin to enumerate the tags in the field
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *iterator pointer to an iterator structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_enumerate_begin(mifare_ultralight_handle_t *handle, mifare_ultralight_iterator_t *iterator);
+
+/**
+ * @brief         mifare_ultralight get the next tag in the field
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in,out] *iterator pointer to an iterator structure
+ * @param[out]    *uid pointer to a uid buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 enumerate next failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 no more tags
+ * @note          the first poll is a wake up and the next ones are requests,
+ *                collisions are resolved bit by bit at both cascade levels and
+ *                each selected tag is halted so the next poll skips it,
+ *                all found tags are halted when 4 is returned,
+ *                tags halted before the first poll go back to halt once another tag is selected,
+ *                so the field is switched off and on before enumerating them again
+ */
+uint8_t mifare_ultralight_enumerate_next(mifare_ultralight_handle_t *handle, mifare_ultralight_iterator_t *iterator, uint8_t uid[7]);
+
+/**
+ * @brief      mifare_ultralight enumerate all tags in the field
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] **uid pointer to a uid list buffer
+ * @param[in]  max max uid number
+ * @param[out] *count pointer to a found tags buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 enumerate all failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       it stops when max tags are found
+ */
+uint8_t mifare_ultralight_enumerate_all(mifare_ultralight_handle_t *handle, uint8_t (*uid)[7], uint8_t max, uint8_t *count);
+
+/**
+ * @brief         mifare_ultralight begin an inventory session
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in,out] *inventory pointer to an inventory structure
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 inventory is invalid
+ * @note          set, set_size, the read window and callback must be filled before,
+ *                the uid set and the statistics are cleared,
+ *                data_len must be at least 4 * (stop_page - start_page + 1)
+ */
+uint8_t mifare_ultralight_inventory_begin(mifare_ultralight_handle_t *handle, mifare_ultralight_inventory_t *inventory);
+
+/**
+ * @brief         mifare_ultralight run one inventory cycle
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in,out] *inventory pointer to an inventory structure
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          tags are requested until none answers, each one is resolved, read once per
+ *                session and halted, a halted tag stays silent while it is in the field and
+ *                a returning tag is halted again without being read or reported,
+ *                a tag whose window can't be read is halted, counted in errors and kept in the
+ *                uid set without being reported, tags are reported again once the uid set is full
+ */
+uint8_t mifare_ultralight_inventory_cycle(mifare_ultralight_handle_t *handle, mifare_ultralight_inventory_t *inventory);
+
+/**
+ * @brief      mifare_ultralight attach a result cache
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *cache pointer to a cache structure, NULL detaches the cache
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 cache is invalid
+ * @note       entry and size must be filled before, size is a power of 2 from 4 to 32768,
+ *             the entries and the counters are cleared, at most 3 / 4 of the slots are used
+ *             and the clock hand evicts the oldest unreferenced uid when they are full,
+ *             mifare_ultralight_activate skips get version on a hit with a known storage
+ */
+uint8_t mifare_ultralight_set_cache(mifare_ultralight_handle_t *handle, mifare_ultralight_cache_t *cache);
+
+/**
+ * @brief      mifare_ultralight look up a uid in the result cache
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *uid pointer to a uid buffer
+ * @param[in]  key id of the signature key
+ * @param[out] *storage pointer to a storage buffer, 0 is unknown
+ * @param[out] *verdict pointer to a verdict buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 uid is not cached
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no cache is attached
+ * @note       a hit marks the entry as referenced, hits and misses are counted,
+ *             the verdict is unknown when it was checked with another key
+ */
+uint8_t mifare_ultralight_cache_lookup(mifare_ultralight_handle_t *handle, uint8_t uid[7], uint32_t key, uint8_t *storage, 
+                                       mifare_ultralight_cache_verdict_t *verdict);
+
+/**
+ * @brief     mifare_ultralight store the originality verdict of a uid
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *uid pointer to a uid buffer
+ * @param[in] key id of the signature key the verdict was checked with
+ * @param[in] verdict originality verdict
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 no cache is attached
+ * @note      the uid is inserted when it is not cached, the verdict of another key is replaced
+ */
+uint8_t mifare_ultralight_cache_set_verdict(mifare_ultralight_handle_t *handle, uint8_t uid[7], uint32_t key, 
+                                            mifare_ultralight_cache_verdict_t verdict);
 
 /**
  * @brief      mifare_ultralight halt
@@ -492,6 +1332,19 @@ uint8_t mifare_ultralight_read_signature(mifare_ultralight_handle_t *handle, uin
  */
 uint8_t mifare_ultralight_get_serial_number(mifare_ultralight_handle_t *handle, uint8_t number[7]);
 
+/**
+ * @brief      mifare_ultralight get the uid of the selected card
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *uid pointer to a uid buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 no uid is selected
+ * @note       the uid is kept from the select of both cascade levels, no frame is sent
+ */
+uint8_t mifare_ultralight_get_uid(mifare_ultralight_handle_t *handle, uint8_t uid[7]);
+
 /**
  * @brief      mifare_ultralight read four pages
  * @param[in]  *handle pointer to a mifare_ultralight handle structure
@@ -546,6 +1399,57 @@ uint8_t mifare_ultralight_read_page(mifare_ultralight_handle_t *handle, uint8_t
  */
 uint8_t mifare_ultralight_fast_read_page(mifare_ultralight_handle_t *handle, uint8_t start_page, uint8_t stop_page, uint8_t *data, uint16_t *len);
 
+/**
+ * @brief         mifare_ultralight read range
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[in]     start_page start page
+ * @param[in]     stop_page stop page
+ * @param[out]    *data pointer to a data buffer
+ * @param[in,out] *len pointer to a data length buffer
+ * @param[out]    *protected_page pointer to a protected page buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read range failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 stop_page < start_page
+ *                - 5 len is invalid
+ *                - 6 output_len is invalid
+ *                - 7 crc error
+ * @note          4 * (stop_page - start_page + 1) <= len
+ *                the range is split into the fewest fast read frames the max frame length allows
+ *                and every frame is received straight into data, 2 spare bytes in data let the
+ *                last frame land in place too
+ *                protected_page is 0xFF when every page is read, otherwise it is the first page the
+ *                card refuses and len covers the pages before it, the page is auth0 of the conf shadow
+ *                or it is found by narrowing the refused frame, the card is selected again after a
+ *                refused frame, without a selected uid the pages of the refused frame are not read and
+ *                auth0 or the first page of the refused frame when auth0 is unknown is returned,
+ *                1 is returned and protected_page is 0xFF when a frame is lost
+ */
+uint8_t mifare_ultralight_read_range(mifare_ultralight_handle_t *handle, uint8_t start_page, uint8_t stop_page,
+                                     uint8_t *data, uint16_t *len, uint8_t *protected_page);
+
+/**
+ * @brief         mifare_ultralight read all pages
+ * @param[in]     *handle pointer to a mifare_ultralight handle structure
+ * @param[out]    *data pointer to a data buffer
+ * @param[in,out] *len pointer to a data length buffer
+ * @param[out]    *protected_page pointer to a protected page buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read all failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 storage is invalid
+ *                - 5 len is invalid
+ *                - 6 output_len is invalid
+ *                - 7 crc error
+ * @note          the storage must be set or got before,
+ *                see mifare_ultralight_read_range for the protected page report
+ */
+uint8_t mifare_ultralight_read_all(mifare_ultralight_handle_t *handle, uint8_t *data, uint16_t *len, uint8_t *protected_page);
+
 /**
  * @brief     mifare_ultralight compatibility write page
  * @param[in] *handle pointer to a mifare_ultralight handle structure
@@ -578,6 +1482,82 @@ uint8_t mifare_ultralight_compatibility_write_page(mifare_ultralight_handle_t *h
  */
 uint8_t mifare_ultralight_write_page(mifare_ultralight_handle_t *handle, uint8_t page, uint8_t data[4]);
 
+/**
+ * @brief      mifare_ultralight write the pages that differ from an image
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  start_page start page
+ * @param[in]  stop_page stop page
+ * @param[in]  *image pointer to an image buffer
+ * @param[in]  *mask pointer to a mask buffer
+ * @param[in]  allow bitwise or of mifare_ultralight_write_allow_t
+ * @param[out] *written pointer to a written pages buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 write diff failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 storage is invalid
+ *             - 5 page range is invalid
+ *             - 6 page is not allowed
+ *             - 7 otp or lock bits can't be cleared
+ * @note       image and mask hold 4 * (stop_page - start_page + 1) bytes,
+ *             only the mask bits set to 1 are taken from the image
+ *             the masked pages are read back with the fewest fast read frames and
+ *             only the pages whose content changes are written,
+ *             the uid pages are never written and pwd or pack pages are always written
+ *             because they can't be read back,
+ *             every page is checked before the first write,
+ *             user pages are written first, then pwd, pack, cfg1 and cfg0 and at last otp and lock,
+ *             so a new lock bit or a lower auth0 doesn't refuse the rest of the image
+ */
+uint8_t mifare_ultralight_write_diff(mifare_ultralight_handle_t *handle, uint8_t start_page, uint8_t stop_page,
+                                     uint8_t *image, uint8_t *mask, uint8_t allow, uint8_t *written);
+
+/**
+ * @brief     mifare_ultralight begin a verified write
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *verify pointer to a verify structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or verify is NULL
+ *            - 3 handle is not initialized
+ *            - 4 storage is invalid
+ * @note      the storage must be set or got before,
+ *            every page acked after begin is queued with its content, pwd and pack pages
+ *            are never queued because they can't be read back,
+ *            the otp and lock bits are checked as set bits because the card ors them
+ */
+uint8_t mifare_ultralight_verify_begin(mifare_ultralight_handle_t *handle, mifare_ultralight_verify_t *verify);
+
+/**
+ * @brief      mifare_ultralight commit a verified write
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  retry rewrite rounds of the mismatched pages
+ * @param[out] *mismatched pointer to a mismatched pages buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 verify commit failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 verify is not begun
+ * @note       the queued pages are read back with the fewest fast read frames the max frame length
+ *             allows, the mismatched pages are left in verify->mismatch,
+ *             each retry round rewrites only the mismatched pages and reads back only them,
+ *             the queue stays open when a frame fails so the commit can be run again
+ */
+uint8_t mifare_ultralight_verify_commit(mifare_ultralight_handle_t *handle, uint8_t retry, uint8_t *mismatched);
+
+/**
+ * @brief     mifare_ultralight abort a verified write
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the queued pages are dropped
+ */
+uint8_t mifare_ultralight_verify_abort(mifare_ultralight_handle_t *handle);
+
 /**
  * @brief     mifare_ultralight authenticate
  * @param[in] *handle pointer to a mifare_ultralight handle structure
@@ -591,10 +1571,40 @@ uint8_t mifare_ultralight_write_page(mifare_ultralight_handle_t *handle, uint8_t
  *            - 4 output_len is invalid
  *            - 5 crc error
  *            - 6 pack check failed
- * @note      none
+ * @note      the session is authenticated after a matching pack, it is lost by
+ *            request, wake up, halt, a nak and a transport failure
  */
 uint8_t mifare_ultralight_authenticate(mifare_ultralight_handle_t *handle, uint8_t pwd[4], uint8_t pack[2]);
 
+/**
+ * @brief     mifare_ultralight set the auto authenticate
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *pwd pointer to a pwd buffer, NULL turns auto authenticate off
+ * @param[in] *pack pointer to a pack buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 pack is NULL
+ * @note      page reads and writes, otp, lock, key and conf access send PWD_AUTH first when
+ *            the session is not authenticated and the page is protected, every user page is
+ *            taken as protected while auth0 is not in the conf shadow, the async operations
+ *            do not authenticate by themselves
+ */
+uint8_t mifare_ultralight_set_auto_authenticate(mifare_ultralight_handle_t *handle, uint8_t pwd[4], uint8_t pack[2]);
+
+/**
+ * @brief      mifare_ultralight get the authenticated session
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *enable pointer to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_authenticated(mifare_ultralight_handle_t *handle, mifare_ultralight_bool_t *enable);
+
 /**
  * @brief     mifare_ultralight set the password
  * @param[in] *handle pointer to a mifare_ultralight handle structure
@@ -625,6 +1635,42 @@ uint8_t mifare_ultralight_set_password(mifare_ultralight_handle_t *handle, uint8
  */
 uint8_t mifare_ultralight_set_pack(mifare_ultralight_handle_t *handle, uint8_t pack[2]);
 
+/**
+ * @brief     mifare_ultralight begin a configuration transaction
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the configuration setters only change the shadow until commit,
+ *            request, wake up, halt and set storage drop an open transaction,
+ *            a raw write of a configuration page drops the pending change of that page
+ */
+uint8_t mifare_ultralight_conf_begin(mifare_ultralight_handle_t *handle);
+
+/**
+ * @brief     mifare_ultralight commit a configuration transaction
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 conf commit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      each dirty configuration page is written once
+ */
+uint8_t mifare_ultralight_conf_commit(mifare_ultralight_handle_t *handle);
+
+/**
+ * @brief     mifare_ultralight abort a configuration transaction
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the dirty pages are dropped from the shadow
+ */
+uint8_t mifare_ultralight_conf_abort(mifare_ultralight_handle_t *handle);
+
 /**
  * @brief     mifare_ultralight set the modulation mode
  * @param[in] *handle pointer to a mifare_ultralight handle structure
@@ -758,6 +1804,23 @@ uint8_t mifare_ultralight_set_virtual_card_type_identifier(mifare_ultralight_han
  */
 uint8_t mifare_ultralight_get_virtual_card_type_identifier(mifare_ultralight_handle_t *handle, uint8_t *identifier);
 
+/**
+ * @brief      mifare_ultralight get the configuration snapshot
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *snapshot pointer to a snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get snapshot failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 storage is invalid
+ *             - 5 pages are protected
+ * @note       pages 2 to the end page are read with the fewest fast read frames,
+ *             lock[2] - lock[4] are only valid on the MF0UL21,
+ *             the ultralight ev1 has no mirror, cfg0 keeps the raw bytes
+ */
+uint8_t mifare_ultralight_get_snapshot(mifare_ultralight_handle_t *handle, mifare_ultralight_snapshot_t *snapshot);
+
 /**
  * @brief     mifare_ultralight set the lock
  * @param[in] *handle pointer to a mifare_ultralight handle structure
@@ -836,6 +1899,215 @@ uint8_t mifare_ultralight_write_otp(mifare_ultralight_handle_t *handle, uint8_t
  * @}
  */
 
+/**
+ * @defgroup mifare_ultralight_async_driver mifare ultralight async driver function
+ * @brief    mifare ultralight async driver modules
+ * @ingroup  mifare_ultralight_driver
+ * @{
+ */
+
+/**
+ * @brief     set the op response timeout
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] us timeout in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the default timeout is 10000us, 0 waits for the transport forever,
+ *            the timeout needs the timestamp_us function
+ */
+uint8_t mifare_ultralight_set_op_timeout(mifare_ultralight_handle_t *handle, uint32_t us);
+
+/**
+ * @brief      get the op response timeout
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *us pointer to a timeout buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_op_timeout(mifare_ultralight_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief     start a non blocking op
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *op pointer to a mifare_ultralight op structure
+ * @param[in] type op type
+ * @param[in] page page, counter addr or conf index
+ * @param[in] stop_page stop page of the fast read
+ * @param[in] *data pointer to a data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 contactless_submit or contactless_poll is NULL
+ *            - 5 type is invalid
+ *            - 6 param is invalid
+ *            - 7 op is busy
+ * @note      data must stay valid until the op is finished,
+ *            see mifare_ultralight_op_type_t for the data layout
+ */
+uint8_t mifare_ultralight_op_start(mifare_ultralight_handle_t *handle, mifare_ultralight_op_t *op,
+                                   mifare_ultralight_op_type_t type, uint8_t page, uint8_t stop_page, uint8_t *data);
+
+/**
+ * @brief     run a non blocking op
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *op pointer to a mifare_ultralight op structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 op is not started
+ * @note      every call moves the op as far as the transport allows and never blocks,
+ *            the op is finished when its state is done or error
+ */
+uint8_t mifare_ultralight_op_step(mifare_ultralight_handle_t *handle, mifare_ultralight_op_t *op);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup mifare_ultralight_retry_driver mifare ultralight retry driver function
+ * @brief    mifare ultralight retry driver modules
+ * @ingroup  mifare_ultralight_driver
+ * @{
+ */
+
+/**
+ * @brief     set the retry policy
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *policy pointer to a retry policy structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      init sets a policy without any retry
+ */
+uint8_t mifare_ultralight_set_retry_policy(mifare_ultralight_handle_t *handle, const mifare_ultralight_retry_policy_t *policy);
+
+/**
+ * @brief      get the retry policy
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *policy pointer to a retry policy structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t mifare_ultralight_get_retry_policy(mifare_ultralight_handle_t *handle, mifare_ultralight_retry_policy_t *policy);
+
+/**
+ * @brief      classify the last failure
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *failure pointer to a failure class buffer
+ * @param[out] *nak pointer to a nak buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       nak is MIFARE_ULTRALIGHT_NAK_NONE when the card did not answer with a nak
+ */
+uint8_t mifare_ultralight_get_failure(mifare_ultralight_handle_t *handle, mifare_ultralight_failure_t *failure, uint8_t *nak);
+
+/**
+ * @brief     run a job with the retry policy
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *run pointer to a job function address
+ * @param[in] *arg job argument
+ * @param[in] flags bitwise or of mifare_ultralight_retry_flag_t
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or run is NULL
+ *            - 3 handle is not initialized
+ *            - others the result of the last run
+ * @note      a corrupted response is retried at once, no response and a transient nak
+ *            reactivate the selected card with wake up and its uid before the retry,
+ *            a permanent nak or a refused response returns at once
+ */
+uint8_t mifare_ultralight_retry(mifare_ultralight_handle_t *handle, uint8_t (*run)(mifare_ultralight_handle_t *handle, void *arg),
+                                void *arg, uint8_t flags);
+
+/**
+ * @}
+ */
+
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+/**
+ * @defgroup mifare_ultralight_stats_driver mifare ultralight stats driver function
+ * @brief    mifare ultralight stats driver modules
+ * @ingroup  mifare_ultralight_driver
+ * @{
+ */
+
+/**
+ * @brief      get the statistics
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *stats pointer to a statistics structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       the latency needs the timestamp_us function, otherwise every frame is in bucket 0
+ */
+uint8_t mifare_ultralight_get_stats(mifare_ultralight_handle_t *handle, mifare_ultralight_stats_t *stats);
+
+/**
+ * @brief     reset the statistics
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      init and deinit keep the statistics
+ */
+uint8_t mifare_ultralight_reset_stats(mifare_ultralight_handle_t *handle);
+
+/**
+ * @}
+ */
+#endif
+
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+/**
+ * @defgroup mifare_ultralight_trace_driver mifare ultralight trace driver function
+ * @brief    mifare ultralight trace driver modules
+ * @ingroup  mifare_ultralight_driver
+ * @{
+ */
+
+/**
+ * @brief     set the trace ring
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *trace pointer to a trace structure or NULL to stop the trace
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      the ring is cleared, every sent and received frame is then recorded with one copy
+ *            and an index bump, the oldest entries are overwritten when the reader is late
+ */
+uint8_t mifare_ultralight_set_trace(mifare_ultralight_handle_t *handle, mifare_ultralight_trace_t *trace);
+
+/**
+ * @brief      read the oldest trace entry
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *entry pointer to a trace entry structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 no entry
+ *             - 2 handle is NULL
+ *             - 4 trace is not set
+ * @note       one reader may run beside the driver without a lock, the slot the driver
+ *             writes next is never read, so at most MIFARE_ULTRALIGHT_TRACE_DEPTH - 1 entries
+ *             are kept, the overwritten entries are counted in lost
+ */
+uint8_t mifare_ultralight_read_trace(mifare_ultralight_handle_t *handle, mifare_ultralight_trace_entry_t *entry);
+
+/**
+ * @}
+ */
+#endif
+
 /**
  * @defgroup mifare_ultralight_extern_driver mifare ultralight extern driver function
  * @brief    mifare ultralight extern driver modules
@@ -857,6 +2129,40 @@ uint8_t mifare_ultralight_write_otp(mifare_ultralight_handle_t *handle, uint8_t
  */
 uint8_t mifare_ultralight_transceiver(mifare_ultralight_handle_t *handle, uint8_t *in_buf, uint8_t in_len, uint8_t *out_buf, uint8_t *out_len);
 
+/**
+ * @brief     get the timestamp of the handle
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @return    timestamp in us
+ * @note      0 is returned when handle is NULL or without the timestamp_us function,
+ *            the _ctx function is used when it is linked
+ */
+uint32_t mifare_ultralight_timestamp_us(mifare_ultralight_handle_t *handle);
+
+/**
+ * @brief  start a crc_a calculation
+ * @return crc preset
+ * @note   none
+ */
+uint16_t mifare_ultralight_crc_init(void);
+
+/**
+ * @brief     update a crc_a calculation
+ * @param[in] crc current crc
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    updated crc
+ * @note      none
+ */
+uint16_t mifare_ultralight_crc_update(uint16_t crc, const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      finish a crc_a calculation
+ * @param[in]  crc current crc
+ * @param[out] *output pointer to a crc buffer
+ * @note       output[0] is lsb and output[1] is msb as they are sent on air
+ */
+void mifare_ultralight_crc_final(uint16_t crc, uint8_t output[2]);
+
 /**
  * @}
  */
@@ -0,0 +1,539 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_diversify.c
+ * @brief     driver mifare_ultralight diversify source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_diversify.h"
+
+/**
+ * @brief rotate a column word right
+ */
+#define MIFARE_ULTRALIGHT_DIVERSIFY_ROR(x, n)        (((x) >> (n)) | ((x) << (32 - (n))))        /**< rotate right by n bits */
+
+/**
+ * @brief aes s-box
+ */
+static const uint8_t gs_sbox[256] =
+{
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16,
+};
+
+/**
+ * @brief aes round table, 2s, s, s and 3s most significant byte first,
+ *        the other three tables are its byte rotations
+ */
+static const uint32_t gs_te[256] =
+{
+    0xC66363A5U, 0xF87C7C84U, 0xEE777799U, 0xF67B7B8DU, 0xFFF2F20DU, 0xD66B6BBDU, 0xDE6F6FB1U, 0x91C5C554U,
+    0x60303050U, 0x02010103U, 0xCE6767A9U, 0x562B2B7DU, 0xE7FEFE19U, 0xB5D7D762U, 0x4DABABE6U, 0xEC76769AU,
+    0x8FCACA45U, 0x1F82829DU, 0x89C9C940U, 0xFA7D7D87U, 0xEFFAFA15U, 0xB25959EBU, 0x8E4747C9U, 0xFBF0F00BU,
+    0x41ADADECU, 0xB3D4D467U, 0x5FA2A2FDU, 0x45AFAFEAU, 0x239C9CBFU, 0x53A4A4F7U, 0xE4727296U, 0x9BC0C05BU,
+    0x75B7B7C2U, 0xE1FDFD1CU, 0x3D9393AEU, 0x4C26266AU, 0x6C36365AU, 0x7E3F3F41U, 0xF5F7F702U, 0x83CCCC4FU,
+    0x6834345CU, 0x51A5A5F4U, 0xD1E5E534U, 0xF9F1F108U, 0xE2717193U, 0xABD8D873U, 0x62313153U, 0x2A15153FU,
+    0x0804040CU, 0x95C7C752U, 0x46232365U, 0x9DC3C35EU, 0x30181828U, 0x379696A1U, 0x0A05050FU, 0x2F9A9AB5U,
+    0x0E070709U, 0x24121236U, 0x1B80809BU, 0xDFE2E23DU, 0xCDEBEB26U, 0x4E272769U, 0x7FB2B2CDU, 0xEA75759FU,
+    0x1209091BU, 0x1D83839EU, 0x582C2C74U, 0x341A1A2EU, 0x361B1B2DU, 0xDC6E6EB2U, 0xB45A5AEEU, 0x5BA0A0FBU,
+    0xA45252F6U, 0x763B3B4DU, 0xB7D6D661U, 0x7DB3B3CEU, 0x5229297BU, 0xDDE3E33EU, 0x5E2F2F71U, 0x13848497U,
+    0xA65353F5U, 0xB9D1D168U, 0x00000000U, 0xC1EDED2CU, 0x40202060U, 0xE3FCFC1FU, 0x79B1B1C8U, 0xB65B5BEDU,
+    0xD46A6ABEU, 0x8DCBCB46U, 0x67BEBED9U, 0x7239394BU, 0x944A4ADEU, 0x984C4CD4U, 0xB05858E8U, 0x85CFCF4AU,
+    0xBBD0D06BU, 0xC5EFEF2AU, 0x4FAAAAE5U, 0xEDFBFB16U, 0x864343C5U, 0x9A4D4DD7U, 0x66333355U, 0x11858594U,
+    0x8A4545CFU, 0xE9F9F910U, 0x04020206U, 0xFE7F7F81U, 0xA05050F0U, 0x783C3C44U, 0x259F9FBAU, 0x4BA8A8E3U,
+    0xA25151F3U, 0x5DA3A3FEU, 0x804040C0U, 0x058F8F8AU, 0x3F9292ADU, 0x219D9DBCU, 0x70383848U, 0xF1F5F504U,
+    0x63BCBCDFU, 0x77B6B6C1U, 0xAFDADA75U, 0x42212163U, 0x20101030U, 0xE5FFFF1AU, 0xFDF3F30EU, 0xBFD2D26DU,
+    0x81CDCD4CU, 0x180C0C14U, 0x26131335U, 0xC3ECEC2FU, 0xBE5F5FE1U, 0x359797A2U, 0x884444CCU, 0x2E171739U,
+    0x93C4C457U, 0x55A7A7F2U, 0xFC7E7E82U, 0x7A3D3D47U, 0xC86464ACU, 0xBA5D5DE7U, 0x3219192BU, 0xE6737395U,
+    0xC06060A0U, 0x19818198U, 0x9E4F4FD1U, 0xA3DCDC7FU, 0x44222266U, 0x542A2A7EU, 0x3B9090ABU, 0x0B888883U,
+    0x8C4646CAU, 0xC7EEEE29U, 0x6BB8B8D3U, 0x2814143CU, 0xA7DEDE79U, 0xBC5E5EE2U, 0x160B0B1DU, 0xADDBDB76U,
+    0xDBE0E03BU, 0x64323256U, 0x743A3A4EU, 0x140A0A1EU, 0x924949DBU, 0x0C06060AU, 0x4824246CU, 0xB85C5CE4U,
+    0x9FC2C25DU, 0xBDD3D36EU, 0x43ACACEFU, 0xC46262A6U, 0x399191A8U, 0x319595A4U, 0xD3E4E437U, 0xF279798BU,
+    0xD5E7E732U, 0x8BC8C843U, 0x6E373759U, 0xDA6D6DB7U, 0x018D8D8CU, 0xB1D5D564U, 0x9C4E4ED2U, 0x49A9A9E0U,
+    0xD86C6CB4U, 0xAC5656FAU, 0xF3F4F407U, 0xCFEAEA25U, 0xCA6565AFU, 0xF47A7A8EU, 0x47AEAEE9U, 0x10080818U,
+    0x6FBABAD5U, 0xF0787888U, 0x4A25256FU, 0x5C2E2E72U, 0x381C1C24U, 0x57A6A6F1U, 0x73B4B4C7U, 0x97C6C651U,
+    0xCBE8E823U, 0xA1DDDD7CU, 0xE874749CU, 0x3E1F1F21U, 0x964B4BDDU, 0x61BDBDDCU, 0x0D8B8B86U, 0x0F8A8A85U,
+    0xE0707090U, 0x7C3E3E42U, 0x71B5B5C4U, 0xCC6666AAU, 0x904848D8U, 0x06030305U, 0xF7F6F601U, 0x1C0E0E12U,
+    0xC26161A3U, 0x6A35355FU, 0xAE5757F9U, 0x69B9B9D0U, 0x17868691U, 0x99C1C158U, 0x3A1D1D27U, 0x279E9EB9U,
+    0xD9E1E138U, 0xEBF8F813U, 0x2B9898B3U, 0x22111133U, 0xD26969BBU, 0xA9D9D970U, 0x078E8E89U, 0x339494A7U,
+    0x2D9B9BB6U, 0x3C1E1E22U, 0x15878792U, 0xC9E9E920U, 0x87CECE49U, 0xAA5555FFU, 0x50282878U, 0xA5DFDF7AU,
+    0x038C8C8FU, 0x59A1A1F8U, 0x09898980U, 0x1A0D0D17U, 0x65BFBFDAU, 0xD7E6E631U, 0x844242C6U, 0xD06868B8U,
+    0x824141C3U, 0x299999B0U, 0x5A2D2D77U, 0x1E0F0F11U, 0x7BB0B0CBU, 0xA85454FCU, 0x6DBBBBD6U, 0x2C16163AU,
+};
+
+/**
+ * @brief aes round constants
+ */
+static const uint8_t gs_rcon[10] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+/**
+ * @brief     load a big endian word
+ * @param[in] *buf pointer to a 4 bytes buffer
+ * @return    word
+ * @note      none
+ */
+static uint32_t a_mifare_ultralight_diversify_load(const uint8_t *buf)
+{
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | (uint32_t)buf[3];
+}
+
+/**
+ * @brief      store a big endian word
+ * @param[out] *buf pointer to a 4 bytes buffer
+ * @param[in]  w word
+ * @note       none
+ */
+static void a_mifare_ultralight_diversify_store(uint8_t *buf, uint32_t w)
+{
+    buf[0] = (uint8_t)(w >> 24);        /* byte 0 */
+    buf[1] = (uint8_t)(w >> 16);        /* byte 1 */
+    buf[2] = (uint8_t)(w >> 8);         /* byte 2 */
+    buf[3] = (uint8_t)(w >> 0);         /* byte 3 */
+}
+
+/**
+ * @brief     substitute the bytes of a word
+ * @param[in] w word
+ * @return    substituted word
+ * @note      none
+ */
+static uint32_t a_mifare_ultralight_diversify_sub_word(uint32_t w)
+{
+    return ((uint32_t)gs_sbox[(w >> 24) & 0xFF] << 24) | ((uint32_t)gs_sbox[(w >> 16) & 0xFF] << 16) |
+           ((uint32_t)gs_sbox[(w >> 8) & 0xFF] << 8) | (uint32_t)gs_sbox[w & 0xFF];
+}
+
+/**
+ * @brief     one aes round of a column
+ * @param[in] a column word of row 0
+ * @param[in] b column word of row 1
+ * @param[in] c column word of row 2
+ * @param[in] d column word of row 3
+ * @param[in] k round key word
+ * @return    column word
+ * @note      sub bytes, shift rows and mix columns with one table
+ */
+static uint32_t a_mifare_ultralight_diversify_round(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t k)
+{
+    return gs_te[a >> 24] ^
+           MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[(b >> 16) & 0xFF], 8) ^
+           MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[(c >> 8) & 0xFF], 16) ^
+           MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[d & 0xFF], 24) ^ k;
+}
+
+/**
+ * @brief     the last aes round of a column
+ * @param[in] a column word of row 0
+ * @param[in] b column word of row 1
+ * @param[in] c column word of row 2
+ * @param[in] d column word of row 3
+ * @param[in] k round key word
+ * @return    column word
+ * @note      sub bytes and shift rows
+ */
+static uint32_t a_mifare_ultralight_diversify_last(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t k)
+{
+    return (((uint32_t)gs_sbox[a >> 24] << 24) | ((uint32_t)gs_sbox[(b >> 16) & 0xFF] << 16) |
+            ((uint32_t)gs_sbox[(c >> 8) & 0xFF] << 8) | (uint32_t)gs_sbox[d & 0xFF]) ^ k;
+}
+
+/**
+ * @brief         run the full aes rounds
+ * @param[in]     *rk pointer to the round keys
+ * @param[in,out] *s pointer to the state
+ * @param[in]     first first round to run
+ * @note          rounds first to 9 are run, the last round is left to the caller
+ */
+static void a_mifare_ultralight_diversify_rounds(const uint32_t *rk, uint32_t s[4], uint8_t first)
+{
+    uint8_t r;
+    uint32_t t[4];
+    
+    for (r = first; r < 10; r++)                                                             /* full rounds */
+    {
+        t[0] = a_mifare_ultralight_diversify_round(s[0], s[1], s[2], s[3], rk[4 * r + 0]);    /* column 0 */
+        t[1] = a_mifare_ultralight_diversify_round(s[1], s[2], s[3], s[0], rk[4 * r + 1]);    /* column 1 */
+        t[2] = a_mifare_ultralight_diversify_round(s[2], s[3], s[0], s[1], rk[4 * r + 2]);    /* column 2 */
+        t[3] = a_mifare_ultralight_diversify_round(s[3], s[0], s[1], s[2], rk[4 * r + 3]);    /* column 3 */
+        s[0] = t[0];                                                                         /* save column 0 */
+        s[1] = t[1];                                                                         /* save column 1 */
+        s[2] = t[2];                                                                         /* save column 2 */
+        s[3] = t[3];                                                                         /* save column 3 */
+    }
+}
+
+/**
+ * @brief      run the first aes round of a uid
+ * @param[in]  *key pointer to a diversify key structure
+ * @param[in]  *uid pointer to a 7 bytes uid
+ * @param[out] *s pointer to the state
+ * @note       only the 7 lookups of the uid bytes are left, the other 9 are in key->first
+ */
+static void a_mifare_ultralight_diversify_first(const mifare_ultralight_diversify_key_t *key, const uint8_t *uid, uint32_t s[4])
+{
+    uint32_t a;
+    uint32_t b;
+    
+    a = key->block[0] ^ ((uint32_t)uid[0] << 16) ^ ((uint32_t)uid[1] << 8) ^ uid[2];                   /* uid bytes 0 to 2 */
+    b = key->block[1] ^ a_mifare_ultralight_diversify_load(uid + 3);                                   /* uid bytes 3 to 6 */
+    s[0] = key->first[0] ^ MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[(b >> 16) & 0xFF], 8);                /* column 0 */
+    s[1] = key->first[1] ^ gs_te[b >> 24] ^ MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[a & 0xFF], 24);      /* column 1 */
+    s[2] = key->first[2] ^ MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[(a >> 8) & 0xFF], 16) ^
+           MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[b & 0xFF], 24);                                       /* column 2 */
+    s[3] = key->first[3] ^ MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[(a >> 16) & 0xFF], 8) ^
+           MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[(b >> 8) & 0xFF], 16);                                /* column 3 */
+}
+
+/**
+ * @brief         double a cmac subkey
+ * @param[in,out] *k pointer to a subkey
+ * @note          gf(2^128) doubling with the 0x87 reduction
+ */
+static void a_mifare_ultralight_diversify_double(uint32_t k[4])
+{
+    uint32_t msb;
+    
+    msb = k[0] >> 31;                                                  /* top bit */
+    k[0] = (k[0] << 1) | (k[1] >> 31);                                 /* shift word 0 */
+    k[1] = (k[1] << 1) | (k[2] >> 31);                                 /* shift word 1 */
+    k[2] = (k[2] << 1) | (k[3] >> 31);                                 /* shift word 2 */
+    k[3] = (k[3] << 1) ^ (msb * 0x87U);                                /* shift word 3 and reduce */
+}
+
+/**
+ * @brief     init a diversify key
+ * @param[in] *key pointer to a diversify key structure
+ * @param[in] *master pointer to a 16 bytes aes-128 master key
+ * @param[in] *system pointer to a system identifier, it can be NULL when system_len is 0
+ * @param[in] system_len system identifier length
+ * @return    status code
+ *            - 0 success
+ *            - 2 key or master is NULL
+ *            - 4 system_len > 8
+ * @note      the diversified key is aes-cmac(master, 0x01 || uid || system),
+ *            pwd is its bytes 0 to 3 and pack is its bytes 4 and 5,
+ *            the round keys, the cmac subkey and the uid independent part of
+ *            the first round are computed here once
+ */
+uint8_t mifare_ultralight_diversify_init(mifare_ultralight_diversify_key_t *key, const uint8_t master[16], 
+                                         const uint8_t *system, uint8_t system_len)
+{
+    uint8_t i;
+    uint8_t m[16];
+    uint32_t w;
+    uint32_t a;
+    uint32_t b;
+    uint32_t k[4];
+    uint32_t s[4];
+    
+    if ((key == NULL) || (master == NULL))                                                  /* check key and master */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (system_len > 8)                                                                     /* check the system length */
+    {
+        return 4;                                                                           /* return error */
+    }
+    
+    key->inited = 0;                                                                        /* not inited */
+    for (i = 0; i < 4; i++)                                                                 /* master key words */
+    {
+        key->rk[i] = a_mifare_ultralight_diversify_load(master + 4 * i);                    /* load the word */
+    }
+    for (i = 4; i < 44; i++)                                                                /* expand the key */
+    {
+        w = key->rk[i - 1];                                                                 /* previous word */
+        if ((i % 4) == 0)                                                                   /* first word of a round */
+        {
+            w = a_mifare_ultralight_diversify_sub_word(MIFARE_ULTRALIGHT_DIVERSIFY_ROR(w, 24)) ^
+                ((uint32_t)gs_rcon[i / 4 - 1] << 24);                                       /* rot word, sub word and rcon */
+        }
+        key->rk[i] = key->rk[i - 4] ^ w;                                                    /* set the round key */
+    }
+    
+    memcpy(s, key->rk, sizeof(uint32_t) * 4);                                               /* encrypt the zero block */
+    a_mifare_ultralight_diversify_rounds(key->rk, s, 1);                                    /* full rounds */
+    k[0] = a_mifare_ultralight_diversify_last(s[0], s[1], s[2], s[3], key->rk[40]);         /* l column 0 */
+    k[1] = a_mifare_ultralight_diversify_last(s[1], s[2], s[3], s[0], key->rk[41]);         /* l column 1 */
+    k[2] = a_mifare_ultralight_diversify_last(s[2], s[3], s[0], s[1], key->rk[42]);         /* l column 2 */
+    k[3] = a_mifare_ultralight_diversify_last(s[3], s[0], s[1], s[2], key->rk[43]);         /* l column 3 */
+    a_mifare_ultralight_diversify_double(k);                                                /* k1 */
+    memset(m, 0, 16);                                                                       /* clear the block */
+    m[0] = 0x01;                                                                            /* diversification constant */
+    if (system_len > 0)                                                                     /* check the system identifier */
+    {
+        memcpy(m + 8, system, system_len);                                                  /* copy the system identifier */
+    }
+    if (system_len < 8)                                                                     /* not a complete block */
+    {
+        m[8 + system_len] = 0x80;                                                           /* padding */
+        a_mifare_ultralight_diversify_double(k);                                            /* k2 */
+    }
+    for (i = 0; i < 4; i++)                                                                 /* block words */
+    {
+        key->block[i] = a_mifare_ultralight_diversify_load(m + 4 * i) ^ k[i] ^ key->rk[i];  /* apply the subkey and the round key */
+    }
+    
+    /* the first round of a zero uid without the lookups of the uid bytes */
+    a = key->block[0];                                                                      /* uid bytes 0 to 2 are zero */
+    b = key->block[1];                                                                      /* uid bytes 3 to 6 are zero */
+    key->first[0] = a_mifare_ultralight_diversify_round(a, b, key->block[2], key->block[3], key->rk[4]) ^
+                    MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[(b >> 16) & 0xFF], 8);            /* column 0 */
+    key->first[1] = a_mifare_ultralight_diversify_round(b, key->block[2], key->block[3], a, key->rk[5]) ^
+                    gs_te[b >> 24] ^ MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[a & 0xFF], 24);  /* column 1 */
+    key->first[2] = a_mifare_ultralight_diversify_round(key->block[2], key->block[3], a, b, key->rk[6]) ^
+                    MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[(a >> 8) & 0xFF], 16) ^
+                    MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[b & 0xFF], 24);                   /* column 2 */
+    key->first[3] = a_mifare_ultralight_diversify_round(key->block[3], a, b, key->block[2], key->rk[7]) ^
+                    MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[(a >> 16) & 0xFF], 8) ^
+                    MIFARE_ULTRALIGHT_DIVERSIFY_ROR(gs_te[(b >> 8) & 0xFF], 16);            /* column 3 */
+    key->inited = 1;                                                                        /* flag finish initialization */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      derive the password and the pack of a uid
+ * @param[in]  *key pointer to a diversify key structure
+ * @param[in]  *uid pointer to a 7 bytes uid
+ * @param[out] *pwd pointer to a password buffer
+ * @param[out] *pack pointer to a pack buffer
+ * @note       only the two output columns of the last round are computed
+ */
+static void a_mifare_ultralight_diversify_derive(const mifare_ultralight_diversify_key_t *key, const uint8_t *uid, 
+                                                 uint8_t *pwd, uint8_t *pack)
+{
+    uint32_t s[4];
+    uint32_t w;
+    
+    a_mifare_ultralight_diversify_first(key, uid, s);                                 /* first round */
+    a_mifare_ultralight_diversify_rounds(key->rk, s, 2);                              /* full rounds */
+    w = a_mifare_ultralight_diversify_last(s[0], s[1], s[2], s[3], key->rk[40]);      /* bytes 0 to 3 */
+    a_mifare_ultralight_diversify_store(pwd, w);                                      /* set the password */
+    w = a_mifare_ultralight_diversify_last(s[1], s[2], s[3], s[0], key->rk[41]);      /* bytes 4 to 7 */
+    pack[0] = (uint8_t)(w >> 24);                                                     /* byte 4 */
+    pack[1] = (uint8_t)(w >> 16);                                                     /* byte 5 */
+}
+
+/**
+ * @brief      derive the password and the pack of a uid
+ * @param[in]  *key pointer to a diversify key structure
+ * @param[in]  *uid pointer to a 7 bytes uid
+ * @param[out] *pwd pointer to a password buffer
+ * @param[out] *pack pointer to a pack buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 key is NULL
+ *             - 3 key is not initialized
+ * @note       one block cipher call
+ */
+uint8_t mifare_ultralight_diversify(const mifare_ultralight_diversify_key_t *key, const uint8_t uid[7], 
+                                    uint8_t pwd[4], uint8_t pack[2])
+{
+    if (key == NULL)                                                   /* check key */
+    {
+        return 2;                                                      /* return error */
+    }
+    if (key->inited != 1)                                              /* check key initialization */
+    {
+        return 3;                                                      /* return error */
+    }
+    
+    a_mifare_ultralight_diversify_derive(key, uid, pwd, pack);         /* derive */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief      derive the passwords and the packs of many uids
+ * @param[in]  *key pointer to a diversify key structure
+ * @param[in]  *uid pointer to a uid array
+ * @param[in]  count number of uids
+ * @param[out] *pwd pointer to a password array
+ * @param[out] *pack pointer to a pack array
+ * @return     status code
+ *             - 0 success
+ *             - 2 key is NULL
+ *             - 3 key is not initialized
+ * @note       the passwords and the packs are written to two packed arrays,
+ *             the round keys and the uid independent part of the first round are shared by all uids,
+ *             the uids are derived one by one, the table rounds are bound by the lookups and
+ *             consecutive uids are independent, so an interleaved layout of the state is not used
+ */
+uint8_t mifare_ultralight_diversify_batch(const mifare_ultralight_diversify_key_t *key, const uint8_t (*uid)[7], uint32_t count, 
+                                          uint8_t (*pwd)[4], uint8_t (*pack)[2])
+{
+    uint32_t i;
+    
+    if (key == NULL)                                                        /* check key */
+    {
+        return 2;                                                           /* return error */
+    }
+    if (key->inited != 1)                                                   /* check key initialization */
+    {
+        return 3;                                                           /* return error */
+    }
+    
+    for (i = 0; i < count; i++)                                             /* every uid */
+    {
+        a_mifare_ultralight_diversify_derive(key, uid[i], pwd[i], pack[i]); /* derive */
+    }
+    
+    return 0;                                                               /* success return 0 */
+}
+
+/**
+ * @brief      derive the password and the pack of the selected card
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *key pointer to a diversify key structure
+ * @param[out] *pwd pointer to a password buffer
+ * @param[out] *pack pointer to a pack buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get serial number failed
+ * @note       none
+ */
+static uint8_t a_mifare_ultralight_diversify_card(mifare_ultralight_handle_t *handle, const mifare_ultralight_diversify_key_t *key, 
+                                                  uint8_t pwd[4], uint8_t pack[2])
+{
+    uint8_t uid[7];
+    
+    if ((mifare_ultralight_get_uid(handle, uid) != 0) &&                                /* the uid is not known from the select */
+        (mifare_ultralight_get_serial_number(handle, uid) != 0))                        /* get the serial number */
+    {
+        handle->debug_print("mifare_ultralight: get serial number failed.\n");          /* get serial number failed */
+        
+        return 1;                                                                       /* return error */
+    }
+    
+    return mifare_ultralight_diversify(key, uid, pwd, pack);                            /* derive */
+}
+
+/**
+ * @brief     authenticate the selected card with its diversified password
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *key pointer to a diversify key structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 authenticate failed
+ *            - 2 handle or key is NULL
+ *            - 3 handle or key is not initialized
+ *            - 6 pack check failed
+ * @note      the uid of the select is used, otherwise it is read from the card
+ */
+uint8_t mifare_ultralight_diversify_authenticate(mifare_ultralight_handle_t *handle, const mifare_ultralight_diversify_key_t *key)
+{
+    uint8_t res;
+    uint8_t pwd[4];
+    uint8_t pack[2];
+    
+    if ((handle == NULL) || (key == NULL))                                        /* check handle and key */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if ((handle->inited != 1) || (key->inited != 1))                              /* check handle and key initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    if (a_mifare_ultralight_diversify_card(handle, key, pwd, pack) != 0)          /* derive */
+    {
+        return 1;                                                                 /* return error */
+    }
+    res = mifare_ultralight_authenticate(handle, pwd, pack);                      /* authenticate */
+    if (res == 6)                                                                 /* check the pack */
+    {
+        return 6;                                                                 /* return error */
+    }
+    
+    return (res == 0) ? 0 : 1;                                                    /* return the result */
+}
+
+/**
+ * @brief     write the diversified password and pack to the selected card
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *key pointer to a diversify key structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle or key is NULL
+ *            - 3 handle or key is not initialized
+ * @note      the uid of the select is used, otherwise it is read from the card,
+ *            the card must be authenticated when its configuration is protected
+ */
+uint8_t mifare_ultralight_diversify_provision(mifare_ultralight_handle_t *handle, const mifare_ultralight_diversify_key_t *key)
+{
+    uint8_t pwd[4];
+    uint8_t pack[2];
+    
+    if ((handle == NULL) || (key == NULL))                                        /* check handle and key */
+    {
+        return 2;                                                                 /* return error */
+    }
+    if ((handle->inited != 1) || (key->inited != 1))                              /* check handle and key initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    
+    if (a_mifare_ultralight_diversify_card(handle, key, pwd, pack) != 0)          /* derive */
+    {
+        return 1;                                                                 /* return error */
+    }
+    if (mifare_ultralight_set_password(handle, pwd) != 0)                         /* set the password */
+    {
+        handle->debug_print("mifare_ultralight: set password failed.\n");         /* set password failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    if (mifare_ultralight_set_pack(handle, pack) != 0)                            /* set the pack */
+    {
+        handle->debug_print("mifare_ultralight: set pack failed.\n");             /* set pack failed */
+        
+        return 1;                                                                 /* return error */
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_diversify.h
+ * @brief     driver mifare_ultralight diversify header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MIFARE_ULTRALIGHT_DIVERSIFY_H
+#define DRIVER_MIFARE_ULTRALIGHT_DIVERSIFY_H
+
+#include "driver_mifare_ultralight.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup mifare_ultralight_diversify_driver mifare ultralight diversify driver function
+ * @brief    mifare ultralight password and pack diversification driver modules
+ * @ingroup  mifare_ultralight_driver
+ * @{
+ */
+
+/**
+ * @brief mifare ultralight diversify key structure definition
+ */
+typedef struct mifare_ultralight_diversify_key_s
+{
+    uint32_t rk[44];         /**< aes-128 round keys */
+    uint32_t block[4];       /**< cmac input block without the uid, with the subkey and the first round key applied */
+    uint32_t first[4];       /**< first round output of the bytes that do not depend on the uid */
+    uint8_t inited;          /**< inited flag */
+} mifare_ultralight_diversify_key_t;
+
+/**
+ * @brief     init a diversify key
+ * @param[in] *key pointer to a diversify key structure
+ * @param[in] *master pointer to a 16 bytes aes-128 master key
+ * @param[in] *system pointer to a system identifier, it can be NULL when system_len is 0
+ * @param[in] system_len system identifier length
+ * @return    status code
+ *            - 0 success
+ *            - 2 key or master is NULL
+ *            - 4 system_len > 8
+ * @note      the diversified key is aes-cmac(master, 0x01 || uid || system),
+ *            pwd is its bytes 0 to 3 and pack is its bytes 4 and 5,
+ *            the round keys, the cmac subkey and the uid independent part of
+ *            the first round are computed here once
+ */
+uint8_t mifare_ultralight_diversify_init(mifare_ultralight_diversify_key_t *key, const uint8_t master[16], 
+                                         const uint8_t *system, uint8_t system_len);
+
+/**
+ * @brief      derive the password and the pack of a uid
+ * @param[in]  *key pointer to a diversify key structure
+ * @param[in]  *uid pointer to a 7 bytes uid
+ * @param[out] *pwd pointer to a password buffer
+ * @param[out] *pack pointer to a pack buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 key is NULL
+ *             - 3 key is not initialized
+ * @note       one block cipher call
+ */
+uint8_t mifare_ultralight_diversify(const mifare_ultralight_diversify_key_t *key, const uint8_t uid[7], 
+                                    uint8_t pwd[4], uint8_t pack[2]);
+
+/**
+ * @brief      derive the passwords and the packs of many uids
+ * @param[in]  *key pointer to a diversify key structure
+ * @param[in]  *uid pointer to a uid array
+ * @param[in]  count number of uids
+ * @param[out] *pwd pointer to a password array
+ * @param[out] *pack pointer to a pack array
+ * @return     status code
+ *             - 0 success
+ *             - 2 key is NULL
+ *             - 3 key is not initialized
+ * @note       the passwords and the packs are written to two packed arrays,
+ *             the round keys and the uid independent part of the first round are shared by all uids,
+ *             the uids are derived one by one, the table rounds are bound by the lookups and
+ *             consecutive uids are independent, so an interleaved layout of the state is not used
+ */
+uint8_t mifare_ultralight_diversify_batch(const mifare_ultralight_diversify_key_t *key, const uint8_t (*uid)[7], uint32_t count, 
+                                          uint8_t (*pwd)[4], uint8_t (*pack)[2]);
+
+/**
+ * @brief     authenticate the selected card with its diversified password
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *key pointer to a diversify key structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 authenticate failed
+ *            - 2 handle or key is NULL
+ *            - 3 handle or key is not initialized
+ *            - 6 pack check failed
+ * @note      the uid of the select is used, otherwise it is read from the card
+ */
+uint8_t mifare_ultralight_diversify_authenticate(mifare_ultralight_handle_t *handle, const mifare_ultralight_diversify_key_t *key);
+
+/**
+ * @brief     write the diversified password and pack to the selected card
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *key pointer to a diversify key structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle or key is NULL
+ *            - 3 handle or key is not initialized
+ * @note      the uid of the select is used, otherwise it is read from the card,
+ *            the card must be authenticated when its configuration is protected
+ */
+uint8_t mifare_ultralight_diversify_provision(mifare_ultralight_handle_t *handle, const mifare_ultralight_diversify_key_t *key);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
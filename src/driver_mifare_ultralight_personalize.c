@@ -0,0 +1,619 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_personalize.c
+ * @brief     driver mifare_ultralight personalize source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_personalize.h"
+
+/**
+ * @brief      get the uid of the selected card
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[out] *uid pointer to a uid buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get serial number failed
+ * @note       the uid of the select is used, otherwise it is read from the card
+ */
+static uint8_t a_mifare_ultralight_personalize_uid(mifare_ultralight_handle_t *handle, uint8_t uid[7])
+{
+    if ((mifare_ultralight_get_uid(handle, uid) != 0) &&                                /* the uid is not known from the select */
+        (mifare_ultralight_get_serial_number(handle, uid) != 0))                        /* get the serial number */
+    {
+        handle->debug_print("mifare_ultralight: get serial number failed.\n");          /* get serial number failed */
+        
+        return 1;                                                                       /* return error */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     check the lock bit of a user page
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *lock pointer to a lock buffer in the mifare_ultralight_get_lock layout
+ * @param[in] page user page
+ * @return    1 if the page is locked, otherwise 0
+ * @note      pages 4 to 15 have one static lock bit, the MF0UL21 pages 16 to 35 have one
+ *            dynamic lock bit per two pages
+ */
+static uint8_t a_mifare_ultralight_personalize_locked(mifare_ultralight_handle_t *handle, const uint8_t lock[5], uint8_t page)
+{
+    uint8_t bit;
+    
+    if (page < 16)                                                                      /* static lock */
+    {
+        bit = page;                                                                     /* lock_page_4 is bit 4 of lock0 */
+    }
+    else if (handle->end_page == (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21)            /* dynamic lock */
+    {
+        bit = (uint8_t)(16 + (page - 16) / 2);                                          /* lock_page_16-17 is bit 0 of lock2 */
+    }
+    else
+    {
+        return 0;                                                                       /* no lock bit */
+    }
+    
+    return (uint8_t)((lock[bit / 8] >> (bit % 8)) & 0x1);                               /* get the lock bit */
+}
+
+/**
+ * @brief     add a step to a program
+ * @param[in] *program pointer to a program structure
+ * @param[in] stage step stage
+ * @param[in] page written page
+ * @param[in] *data pointer to a page content
+ * @note      none
+ */
+static void a_mifare_ultralight_personalize_add(mifare_ultralight_personalize_program_t *program, 
+                                                mifare_ultralight_personalize_stage_t stage, uint8_t page, const uint8_t data[4])
+{
+    mifare_ultralight_personalize_step_t *step;
+    
+    step = &program->step[program->count];                                              /* get the step */
+    step->stage = stage;                                                                /* set the stage */
+    step->page = page;                                                                  /* set the page */
+    memcpy(step->data, data, 4);                                                        /* set the content */
+    step->us = 0;                                                                       /* not run */
+    program->count++;                                                                   /* one more step */
+}
+
+/**
+ * @brief     authenticate before a resumed program
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *program pointer to a program structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 authenticate failed
+ * @note      inside the key steps the new pwd is tried first, a refused pwd sends the card
+ *            back to idle, so it is reactivated before the current pwd is tried
+ */
+static uint8_t a_mifare_ultralight_personalize_resume(mifare_ultralight_handle_t *handle, mifare_ultralight_personalize_program_t *program)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t session;
+    uint8_t current;
+    mifare_ultralight_activation_t activation;
+    
+    session = 0;                                                                                   /* init 0 */
+    current = 0;                                                                                   /* init 0 */
+    for (i = 0; i < program->next; i++)                                                            /* check the done steps */
+    {
+        if (program->step[i].stage == MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_AUTHENTICATE)            /* authenticate step */
+        {
+            session = 1;                                                                           /* the session is needed */
+        }
+        if (program->step[i].stage == MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CURRENT)                 /* current pwd step */
+        {
+            current = 1;                                                                           /* the current session is needed */
+        }
+    }
+    if ((program->key_stop != 0) && (program->next >= program->key_stop))                          /* after the key */
+    {
+        session = 1;                                                                               /* the new pwd is in force */
+    }
+    if ((program->key_stop != 0) && (program->next + 2 >= program->key_stop) && 
+        (program->next < program->key_stop))                                                      /* inside the key */
+    {
+        res = mifare_ultralight_authenticate(handle, program->pwd, program->pack);                 /* try the new pwd */
+        if ((res == 0) || (res == 6))                                                              /* the new pwd is in force */
+        {
+            return 0;                                                                              /* the pack may be the old one */
+        }
+        for (i = 0; i < 2; i++)                                                                    /* 2 times */
+        {
+            memcpy(activation.uid, program->uid, 7);                                               /* set the uid */
+            res = mifare_ultralight_activate(handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP | 
+                                             MIFARE_ULTRALIGHT_ACTIVATE_POLICY_KNOWN_UID | 
+                                             MIFARE_ULTRALIGHT_ACTIVATE_POLICY_SKIP_READ_PAGE0 | 
+                                             MIFARE_ULTRALIGHT_ACTIVATE_POLICY_SKIP_VERSION, 
+                                             &activation);                                         /* wake up and select */
+            if (res == 0)                                                                          /* check the result */
+            {
+                break;                                                                             /* break */
+            }
+        }
+        if (res != 0)                                                                              /* check the result */
+        {
+            handle->debug_print("mifare_ultralight: reactivate failed.\n");                        /* reactivate failed */
+            
+            return 1;                                                                              /* return error */
+        }
+        if ((program->flags & MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CURRENT_KEY) == 0)                /* no current pwd */
+        {
+            return 0;                                                                              /* write the key without a session */
+        }
+        if (mifare_ultralight_authenticate(handle, program->current_pwd, program->current_pack) != 0)      /* try the current pwd */
+        {
+            handle->debug_print("mifare_ultralight: authenticate failed.\n");                      /* authenticate failed */
+            
+            return 1;                                                                              /* return error */
+        }
+        
+        return 0;                                                                                  /* success return 0 */
+    }
+    if (session != 0)                                                                              /* check the session */
+    {
+        if (mifare_ultralight_authenticate(handle, program->pwd, program->pack) != 0)              /* authenticate */
+        {
+            handle->debug_print("mifare_ultralight: authenticate failed.\n");                      /* authenticate failed */
+            
+            return 1;                                                                              /* return error */
+        }
+    }
+    else if (current != 0)                                                                         /* check the current session */
+    {
+        if (mifare_ultralight_authenticate(handle, program->current_pwd, program->current_pack) != 0)      /* authenticate */
+        {
+            handle->debug_print("mifare_ultralight: authenticate failed.\n");                      /* authenticate failed */
+            
+            return 1;                                                                              /* return error */
+        }
+    }
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      compile a personalization plan for the selected card
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *plan pointer to a plan structure
+ * @param[out] *program pointer to a program structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 compile failed
+ *             - 2 handle, plan or program is NULL
+ *             - 3 handle is not initialized
+ *             - 4 storage is invalid
+ *             - 5 plan is invalid
+ *             - 6 pages are protected
+ *             - 7 page is locked
+ *             - 8 otp or lock bits can't be cleared
+ * @note       the plan describes the final card state, pages 2 to cfg1 are read once with the
+ *             fewest fast read frames and only the pages whose content changes become steps,
+ *             pwd and pack are always written because they can't be read back,
+ *             the steps are ordered user pages, pwd and pack, configuration, otp and lock bits,
+ *             so a torn issue never protects the card with an unknown pwd and the one-time bits
+ *             are set last, cfg0 is written after cfg1 so auth0 turns the protection on with
+ *             the last configuration write, unless cfglck is set by the plan,
+ *             an authenticate step is put before the first step protected by auth0, it uses the
+ *             new pwd or the current pwd of a plan without the key, with the key and the current
+ *             pwd another authenticate step with the current pwd is put before the first step
+ *             protected by the current auth0, 6 is returned when a step is protected by the new
+ *             auth0 and the plan gives no pwd, without the current pwd the card must be
+ *             authenticated before when its current auth0 protects the steps before the
+ *             authenticate step
+ */
+uint8_t mifare_ultralight_personalize_compile(mifare_ultralight_handle_t *handle, const mifare_ultralight_personalize_plan_t *plan, 
+                                              mifare_ultralight_personalize_program_t *program)
+{
+    uint8_t res;
+    uint8_t page;
+    uint8_t user_stop;
+    uint8_t protected_page;
+    uint8_t auth0;
+    uint8_t i;
+    uint8_t order[2];
+    uint8_t lock[5];
+    uint8_t data[4];
+    uint8_t cfg0[4];
+    uint8_t cfg1[4];
+    uint8_t *cur;
+    uint8_t *cfg;
+    uint8_t buf[4 * ((uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21 - 3) + 2];
+    uint16_t len;
+    
+    if ((handle == NULL) || (plan == NULL) || (program == NULL))                                   /* check handle, plan and program */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    if ((handle->end_page != (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL11) && 
+        (handle->end_page != (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21))                          /* check the storage */
+    {
+        handle->debug_print("mifare_ultralight: storage is invalid.\n");                           /* storage is invalid */
+        
+        return 4;                                                                                  /* return error */
+    }
+    user_stop = (uint8_t)(handle->end_page - 
+                ((handle->end_page == (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21) ? 5 : 4));       /* last user page */
+    if (((plan->flags & MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_USER) != 0) && 
+        ((plan->start_page < 4) || (plan->stop_page < plan->start_page) || (plan->stop_page > user_stop)))   /* check the user pages */
+    {
+        handle->debug_print("mifare_ultralight: user page range is invalid.\n");                   /* user page range is invalid */
+        
+        return 5;                                                                                  /* return error */
+    }
+    if (((plan->flags & MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CONF) != 0) && 
+        (plan->authenticate_limitation > 7))                                                       /* check the authlim */
+    {
+        handle->debug_print("mifare_ultralight: authenticate limitation is invalid.\n");           /* authenticate limitation is invalid */
+        
+        return 5;                                                                                  /* return error */
+    }
+    
+    memset(program, 0, sizeof(mifare_ultralight_personalize_program_t));                           /* clear the program */
+    if (a_mifare_ultralight_personalize_uid(handle, program->uid) != 0)                            /* get the uid */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    len = sizeof(buf);                                                                             /* set the buffer length */
+    res = mifare_ultralight_read_range(handle, 0x02, handle->end_page - 2, buf, &len, &protected_page);    /* read page 2 - cfg1 */
+    if (res != 0)                                                                                  /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: read range failed.\n");                            /* read range failed */
+        
+        return 1;                                                                                  /* return error */
+    }
+    if (protected_page != 0xFF)                                                                    /* check the protected page */
+    {
+        handle->debug_print("mifare_ultralight: pages are protected.\n");                          /* pages are protected */
+        
+        return 6;                                                                                  /* return error */
+    }
+    memset(lock, 0, sizeof(lock));                                                                 /* clear the lock */
+    memcpy(lock, buf + 2, 2);                                                                      /* copy the static lock */
+    if (handle->end_page == (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21)                            /* check the dynamic lock */
+    {
+        memcpy(lock + 2, buf + 4 * (handle->end_page - 4 - 2), 3);                                 /* copy the dynamic lock */
+    }
+    cfg = buf + 4 * (handle->end_page - 3 - 2);                                                    /* set the cfg0 */
+    
+    if ((plan->flags & MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_USER) != 0)                              /* user pages */
+    {
+        for (page = plan->start_page; page <= plan->stop_page; page++)                             /* check all pages */
+        {
+            cur = buf + 4 * (page - 2);                                                            /* set the current content */
+            if (memcmp(cur, plan->user + 4 * (page - plan->start_page), 4) == 0)                   /* unchanged page */
+            {
+                program->skipped++;                                                                /* skip the page */
+                
+                continue;                                                                          /* next page */
+            }
+            if (a_mifare_ultralight_personalize_locked(handle, lock, page) != 0)                   /* check the lock bit */
+            {
+                handle->debug_print("mifare_ultralight: page 0x%02X is locked.\n", page);          /* page is locked */
+                
+                return 7;                                                                          /* return error */
+            }
+            a_mifare_ultralight_personalize_add(program, MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_USER, 
+                                                page, plan->user + 4 * (page - plan->start_page)); /* write the page */
+        }
+    }
+    if ((plan->flags & MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_KEY) != 0)                               /* pwd and pack */
+    {
+        a_mifare_ultralight_personalize_add(program, MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_KEY, 
+                                            handle->end_page - 1, plan->pwd);                      /* write the pwd */
+        data[0] = plan->pack[0];                                                                   /* set pack0 */
+        data[1] = plan->pack[1];                                                                   /* set pack1 */
+        data[2] = 0x00;                                                                            /* set 0x00 */
+        data[3] = 0x00;                                                                            /* set 0x00 */
+        a_mifare_ultralight_personalize_add(program, MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_KEY, 
+                                            handle->end_page, data);                               /* write the pack */
+        program->key_stop = program->count;                                                        /* first step after the key */
+        memcpy(program->pwd, plan->pwd, 4);                                                        /* copy the pwd */
+        memcpy(program->pack, plan->pack, 2);                                                      /* copy the pack */
+    }
+    if ((plan->flags & MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CONF) != 0)                              /* configuration */
+    {
+        memcpy(cfg0, cfg, 4);                                                                      /* keep the mode */
+        cfg0[3] = plan->protect_start_page;                                                        /* set the auth0 */
+        memcpy(cfg1, cfg + 4, 4);                                                                  /* keep the vctid */
+        cfg1[0] = (uint8_t)((cfg[4] & 0x38) | 
+                  ((plan->read_protection != MIFARE_ULTRALIGHT_BOOL_FALSE) ? 0x80 : 0x00) | 
+                  ((plan->user_conf_protection != MIFARE_ULTRALIGHT_BOOL_FALSE) ? 0x40 : 0x00) | 
+                  plan->authenticate_limitation);                                                  /* set the access */
+        if (((memcmp(cfg0, cfg, 4) != 0) || (memcmp(cfg1, cfg + 4, 4) != 0)) && 
+            ((cfg[4] & 0x40) != 0))                                                                /* check the cfglck */
+        {
+            handle->debug_print("mifare_ultralight: configuration is locked.\n");                  /* configuration is locked */
+            
+            return 7;                                                                              /* return error */
+        }
+        if ((cfg1[0] & 0x40) != 0)                                                                 /* cfglck freezes cfg0 */
+        {
+            order[0] = handle->end_page - 3;                                                       /* cfg0 first */
+            order[1] = handle->end_page - 2;                                                       /* cfg1 with the cfglck last */
+        }
+        else
+        {
+            order[0] = handle->end_page - 2;                                                       /* cfg1 first */
+            order[1] = handle->end_page - 3;                                                       /* auth0 last */
+        }
+        for (i = 0; i < 2; i++)                                                                    /* write the changed pages */
+        {
+            page = order[i];                                                                       /* get the page */
+            cur = (page == handle->end_page - 3) ? cfg0 : cfg1;                                    /* set the page content */
+            if (memcmp(cur, buf + 4 * (page - 2), 4) == 0)                                         /* unchanged page */
+            {
+                program->skipped++;                                                                /* skip the page */
+            }
+            else
+            {
+                a_mifare_ultralight_personalize_add(program, MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CONF, 
+                                                    page, cur);                                    /* write the page */
+            }
+        }
+    }
+    if ((plan->flags & MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_OTP) != 0)                               /* otp */
+    {
+        cur = buf + 4;                                                                             /* set the current otp */
+        for (i = 0; i < 4; i++)                                                                    /* check all bytes */
+        {
+            if ((cur[i] & (~plan->otp[i])) != 0)                                                   /* check the cleared bits */
+            {
+                handle->debug_print("mifare_ultralight: otp or lock bits can't be cleared.\n");    /* otp or lock bits can't be cleared */
+                
+                return 8;                                                                          /* return error */
+            }
+        }
+        if (memcmp(cur, plan->otp, 4) == 0)                                                        /* unchanged page */
+        {
+            program->skipped++;                                                                    /* skip the page */
+        }
+        else if ((lock[0] & (1 << 3)) != 0)                                                        /* check the lock_otp */
+        {
+            handle->debug_print("mifare_ultralight: page 0x03 is locked.\n");                      /* page is locked */
+            
+            return 7;                                                                              /* return error */
+        }
+        else
+        {
+            a_mifare_ultralight_personalize_add(program, MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_OTP, 
+                                                0x03, plan->otp);                                  /* write the page */
+        }
+    }
+    if ((plan->flags & MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_LOCK) != 0)                              /* lock bits */
+    {
+        for (i = 0; i < 5; i++)                                                                    /* check all bytes */
+        {
+            if ((lock[i] & (~plan->lock[i])) != 0)                                                 /* check the cleared bits */
+            {
+                handle->debug_print("mifare_ultralight: otp or lock bits can't be cleared.\n");    /* otp or lock bits can't be cleared */
+                
+                return 8;                                                                          /* return error */
+            }
+        }
+        if ((lock[0] == plan->lock[0]) && (lock[1] == plan->lock[1]))                              /* unchanged static lock */
+        {
+            program->skipped++;                                                                    /* skip the page */
+        }
+        else
+        {
+            data[0] = 0x00;                                                                        /* set 0x00 */
+            data[1] = 0x00;                                                                        /* set 0x00 */
+            data[2] = plan->lock[0];                                                               /* set lock0 */
+            data[3] = plan->lock[1];                                                               /* set lock1 */
+            a_mifare_ultralight_personalize_add(program, MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_LOCK, 
+                                                0x02, data);                                       /* write the page */
+        }
+        if (handle->end_page == (uint8_t)MIFARE_ULTRALIGHT_STORAGE_MF0UL21)                        /* dynamic lock */
+        {
+            if (memcmp(lock + 2, plan->lock + 2, 3) == 0)                                          /* unchanged dynamic lock */
+            {
+                program->skipped++;                                                                /* skip the page */
+            }
+            else
+            {
+                memcpy(data, plan->lock + 2, 3);                                                   /* set lock2 - lock4 */
+                data[3] = 0x00;                                                                    /* set 0x00 */
+                a_mifare_ultralight_personalize_add(program, MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_LOCK, 
+                                                    handle->end_page - 4, data);                   /* write the page */
+            }
+        }
+    }
+    
+    program->flags = plan->flags;                                                                  /* save the flags */
+    if ((plan->flags & MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CURRENT_KEY) != 0)                       /* the pwd in force is given */
+    {
+        memcpy(program->current_pwd, plan->current_pwd, 4);                                        /* copy the current pwd */
+        memcpy(program->current_pack, plan->current_pack, 2);                                      /* copy the current pack */
+        if (program->key_stop == 0)                                                                /* no new pwd */
+        {
+            memcpy(program->pwd, plan->current_pwd, 4);                                            /* authenticate with the current pwd */
+            memcpy(program->pack, plan->current_pack, 2);                                          /* check the current pack */
+        }
+        for (i = 0; i < program->key_stop; i++)                                                    /* find the first step protected now */
+        {
+            if (program->step[i].page >= cfg[3])                                                   /* protected by the current auth0 */
+            {
+                memmove(&program->step[i + 1], &program->step[i], 
+                        sizeof(mifare_ultralight_personalize_step_t) * (program->count - i));      /* make room */
+                memset(&program->step[i], 0, sizeof(mifare_ultralight_personalize_step_t));        /* clear the step */
+                program->step[i].stage = MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CURRENT;              /* authenticate with the current pwd */
+                program->count++;                                                                  /* one more step */
+                program->key_stop++;                                                               /* the key moves */
+                
+                break;                                                                             /* the session covers the key */
+            }
+        }
+    }
+    if (program->count != 0)                                                                       /* authenticate before the protected steps */
+    {
+        auth0 = cfg[3];                                                                            /* auth0 of the card */
+        for (i = program->key_stop; i < program->count; i++)                                       /* find the first protected step */
+        {
+            if (program->step[i].page >= auth0)                                                    /* protected step */
+            {
+                if ((plan->flags & (MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_KEY | 
+                     MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CURRENT_KEY)) == 0)                        /* no pwd */
+                {
+                    if (program->step[i].page < cfg[3])                                            /* protected by the new auth0 */
+                    {
+                        handle->debug_print("mifare_ultralight: page 0x%02X is protected without a pwd.\n", 
+                                            program->step[i].page);                                /* page is protected without a pwd */
+                        
+                        return 6;                                                                  /* return error */
+                    }
+                    
+                    break;                                                                         /* the session of the caller covers the rest */
+                }
+                memmove(&program->step[i + 1], &program->step[i], 
+                        sizeof(mifare_ultralight_personalize_step_t) * (program->count - i));      /* make room */
+                memset(&program->step[i], 0, sizeof(mifare_ultralight_personalize_step_t));        /* clear the step */
+                program->step[i].stage = MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_AUTHENTICATE;         /* authenticate */
+                program->count++;                                                                  /* one more step */
+                
+                break;                                                                             /* the session covers the rest */
+            }
+            if (program->step[i].page == handle->end_page - 3)                                     /* cfg0 step */
+            {
+                auth0 = program->step[i].data[3];                                                  /* the new auth0 */
+            }
+        }
+    }
+    program->inited = 1;                                                                           /* set inited */
+    
+    return 0;                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     execute or resume a compiled personalization program
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *program pointer to a program structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 execute failed
+ *            - 2 handle or program is NULL
+ *            - 3 handle or program is not initialized
+ *            - 4 card is not the compiled card
+ * @note      the steps run from program->next, which is moved after each acked step and
+ *            stays on the failed step, so calling it again after a reactivation resumes the issue,
+ *            the run time of each step is kept in its us field,
+ *            the authenticate steps are skipped in an authenticated session and a resume out of a
+ *            session authenticates first, after the key steps with the new pwd, before them after
+ *            the current pwd step or after an authenticate step of a plan without the key with
+ *            the current pwd, inside the key
+ *            steps the torn write may have left either pwd in force, so the new pwd is tried,
+ *            then the card is reactivated and the current pwd is tried when the plan gives it,
+ *            otherwise the key pages are written without a session, a refused pwd counts
+ *            against authlim,
+ *            the written pages are queued when a verified write is begun
+ */
+uint8_t mifare_ultralight_personalize_execute(mifare_ultralight_handle_t *handle, mifare_ultralight_personalize_program_t *program)
+{
+    uint8_t res;
+    uint8_t uid[7];
+    uint32_t timestamp;
+    mifare_ultralight_bool_t auth;
+    mifare_ultralight_personalize_step_t *step;
+    
+    if ((handle == NULL) || (program == NULL))                                                     /* check handle and program */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if ((handle->inited != 1) || (program->inited != 1))                                           /* check handle and program initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    
+    if (program->next >= program->count)                                                           /* check the resume point */
+    {
+        return 0;                                                                                  /* success return 0 */
+    }
+    if (a_mifare_ultralight_personalize_uid(handle, uid) != 0)                                     /* get the uid */
+    {
+        return 1;                                                                                  /* return error */
+    }
+    if (memcmp(uid, program->uid, 7) != 0)                                                         /* check the uid */
+    {
+        handle->debug_print("mifare_ultralight: card is not the compiled card.\n");                /* card is not the compiled card */
+        
+        return 4;                                                                                  /* return error */
+    }
+    (void)mifare_ultralight_get_authenticated(handle, &auth);                                      /* get the session */
+    if ((program->started != 0) && (auth == MIFARE_ULTRALIGHT_BOOL_FALSE))                         /* resume out of a session */
+    {
+        if (a_mifare_ultralight_personalize_resume(handle, program) != 0)                          /* authenticate */
+        {
+            return 1;                                                                              /* return error */
+        }
+    }
+    program->started = 1;                                                                          /* a step is sent */
+    
+    while (program->next < program->count)                                                         /* run all steps */
+    {
+        step = &program->step[program->next];                                                      /* get the step */
+        timestamp = mifare_ultralight_timestamp_us(handle);                                        /* save the start time */
+        if (step->stage == MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_AUTHENTICATE)                       /* authenticate step */
+        {
+            (void)mifare_ultralight_get_authenticated(handle, &auth);                              /* get the session */
+            res = (auth == MIFARE_ULTRALIGHT_BOOL_FALSE) ? 
+                  mifare_ultralight_authenticate(handle, program->pwd, program->pack) : 0;         /* authenticate out of a session */
+        }
+        else if (step->stage == MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CURRENT)                       /* current pwd step */
+        {
+            (void)mifare_ultralight_get_authenticated(handle, &auth);                              /* get the session */
+            res = (auth == MIFARE_ULTRALIGHT_BOOL_FALSE) ? 
+                  mifare_ultralight_authenticate(handle, program->current_pwd, program->current_pack) : 0;    /* authenticate out of a session */
+        }
+        else
+        {
+            res = mifare_ultralight_write_page(handle, step->page, step->data);                    /* write the page */
+        }
+        step->us = mifare_ultralight_timestamp_us(handle) - timestamp;                             /* save the run time */
+        if (res != 0)                                                                              /* check the result */
+        {
+            handle->debug_print("mifare_ultralight: step %d failed.\n", program->next);            /* step failed */
+            
+            return 1;                                                                              /* return error */
+        }
+        program->next++;                                                                           /* the step is done */
+    }
+    
+    return 0;                                                                                      /* success return 0 */
+}
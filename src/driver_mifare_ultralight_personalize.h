@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_personalize.h
+ * @brief     driver mifare_ultralight personalize header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MIFARE_ULTRALIGHT_PERSONALIZE_H
+#define DRIVER_MIFARE_ULTRALIGHT_PERSONALIZE_H
+
+#include "driver_mifare_ultralight.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup mifare_ultralight_personalize_driver mifare ultralight personalize driver function
+ * @brief    mifare ultralight personalization plan driver modules
+ * @ingroup  mifare_ultralight_driver
+ * @{
+ */
+
+/**
+ * @brief mifare ultralight personalize definition
+ */
+#define MIFARE_ULTRALIGHT_PERSONALIZE_MAX_USER_PAGE        32        /**< user pages of the MF0UL21 */
+#define MIFARE_ULTRALIGHT_PERSONALIZE_MAX_STEP             41        /**< user pages, pwd, pack, two authenticates, cfg0, cfg1, otp and two lock pages */
+
+/**
+ * @brief mifare ultralight personalize flag enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_NONE        = 0x00,        /**< nothing to personalize */
+    MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_USER        = 0x01,        /**< user pages */
+    MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_KEY         = 0x02,        /**< pwd and pack */
+    MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CONF        = 0x04,        /**< auth0, access and authlim */
+    MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_OTP         = 0x08,        /**< otp page */
+    MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_LOCK        = 0x10,        /**< lock bits */
+    MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CURRENT_KEY = 0x20,        /**< pwd and pack in force on the card are given */
+} mifare_ultralight_personalize_flag_t;
+
+/**
+ * @brief mifare ultralight personalize stage enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_USER         = 0x00,        /**< write a user page */
+    MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_KEY          = 0x01,        /**< write the pwd or the pack page */
+    MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_AUTHENTICATE = 0x02,        /**< authenticate with the new pwd */
+    MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CONF         = 0x03,        /**< write a configuration page */
+    MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_OTP          = 0x04,        /**< write the otp page */
+    MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_LOCK         = 0x05,        /**< write a lock page */
+    MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CURRENT      = 0x06,        /**< authenticate with the current pwd */
+} mifare_ultralight_personalize_stage_t;
+
+/**
+ * @brief mifare ultralight personalize plan structure definition
+ */
+typedef struct mifare_ultralight_personalize_plan_s
+{
+    uint8_t flags;                                                       /**< bitwise or of mifare_ultralight_personalize_flag_t */
+    uint8_t start_page;                                                  /**< first user page of the image */
+    uint8_t stop_page;                                                   /**< last user page of the image */
+    uint8_t user[4 * MIFARE_ULTRALIGHT_PERSONALIZE_MAX_USER_PAGE];       /**< user page image from start_page */
+    uint8_t pwd[4];                                                      /**< pwd */
+    uint8_t pack[2];                                                     /**< pack */
+    uint8_t protect_start_page;                                          /**< auth0 */
+    mifare_ultralight_bool_t read_protection;                            /**< prot */
+    mifare_ultralight_bool_t user_conf_protection;                       /**< cfglck */
+    uint8_t authenticate_limitation;                                     /**< authlim */
+    uint8_t otp[4];                                                      /**< otp page */
+    uint8_t lock[5];                                                     /**< lock bytes in the mifare_ultralight_get_lock layout */
+    uint8_t current_pwd[4];                                              /**< pwd in force on the card */
+    uint8_t current_pack[2];                                             /**< pack in force on the card */
+} mifare_ultralight_personalize_plan_t;
+
+/**
+ * @brief mifare ultralight personalize step structure definition
+ */
+typedef struct mifare_ultralight_personalize_step_s
+{
+    mifare_ultralight_personalize_stage_t stage;        /**< stage */
+    uint8_t page;                                       /**< written page */
+    uint8_t data[4];                                    /**< page content */
+    uint32_t us;                                        /**< run time of the last execution */
+} mifare_ultralight_personalize_step_t;
+
+/**
+ * @brief mifare ultralight personalize program structure definition
+ */
+typedef struct mifare_ultralight_personalize_program_s
+{
+    mifare_ultralight_personalize_step_t step[MIFARE_ULTRALIGHT_PERSONALIZE_MAX_STEP];        /**< ordered steps */
+    uint8_t count;                                                                            /**< number of steps */
+    uint8_t next;                                                                             /**< resume point, first step not done */
+    uint8_t key_stop;                                                                         /**< first step after the key, 0 without key */
+    uint8_t skipped;                                                                          /**< unchanged pages left out */
+    uint8_t uid[7];                                                                           /**< uid of the compiled card */
+    uint8_t pwd[4];                                                                           /**< pwd of the authenticate step */
+    uint8_t pack[2];                                                                          /**< pack of the authenticate step */
+    uint8_t current_pwd[4];                                                                   /**< pwd in force before the key steps */
+    uint8_t current_pack[2];                                                                  /**< pack in force before the key steps */
+    uint8_t flags;                                                                            /**< flags of the plan */
+    uint8_t started;                                                                          /**< a step has been sent */
+    uint8_t inited;                                                                           /**< inited flag */
+} mifare_ultralight_personalize_program_t;
+
+/**
+ * @brief      compile a personalization plan for the selected card
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *plan pointer to a plan structure
+ * @param[out] *program pointer to a program structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 compile failed
+ *             - 2 handle, plan or program is NULL
+ *             - 3 handle is not initialized
+ *             - 4 storage is invalid
+ *             - 5 plan is invalid
+ *             - 6 pages are protected
+ *             - 7 page is locked
+ *             - 8 otp or lock bits can't be cleared
+ * @note       the plan describes the final card state, pages 2 to cfg1 are read once with the
+ *             fewest fast read frames and only the pages whose content changes become steps,
+ *             pwd and pack are always written because they can't be read back,
+ *             the steps are ordered user pages, pwd and pack, configuration, otp and lock bits,
+ *             so a torn issue never protects the card with an unknown pwd and the one-time bits
+ *             are set last, cfg0 is written after cfg1 so auth0 turns the protection on with
+ *             the last configuration write, unless cfglck is set by the plan,
+ *             an authenticate step is put before the first step protected by auth0, it uses the
+ *             new pwd or the current pwd of a plan without the key, with the key and the current
+ *             pwd another authenticate step with the current pwd is put before the first step
+ *             protected by the current auth0, 6 is returned when a step is protected by the new
+ *             auth0 and the plan gives no pwd, without the current pwd the card must be
+ *             authenticated before when its current auth0 protects the steps before the
+ *             authenticate step
+ */
+uint8_t mifare_ultralight_personalize_compile(mifare_ultralight_handle_t *handle, const mifare_ultralight_personalize_plan_t *plan, 
+                                              mifare_ultralight_personalize_program_t *program);
+
+/**
+ * @brief     execute or resume a compiled personalization program
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *program pointer to a program structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 execute failed
+ *            - 2 handle or program is NULL
+ *            - 3 handle or program is not initialized
+ *            - 4 card is not the compiled card
+ * @note      the steps run from program->next, which is moved after each acked step and
+ *            stays on the failed step, so calling it again after a reactivation resumes the issue,
+ *            the run time of each step is kept in its us field,
+ *            the authenticate steps are skipped in an authenticated session and a resume out of a
+ *            session authenticates first, after the key steps with the new pwd, before them after
+ *            the current pwd step or after an authenticate step of a plan without the key with
+ *            the current pwd, inside the key
+ *            steps the torn write may have left either pwd in force, so the new pwd is tried,
+ *            then the card is reactivated and the current pwd is tried when the plan gives it,
+ *            otherwise the key pages are written without a session, a refused pwd counts
+ *            against authlim,
+ *            the written pages are queued when a verified write is begun
+ */
+uint8_t mifare_ultralight_personalize_execute(mifare_ultralight_handle_t *handle, mifare_ultralight_personalize_program_t *program);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
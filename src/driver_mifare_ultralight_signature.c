@@ -0,0 +1,867 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_signature.c
+ * @brief     driver mifare_ultralight signature source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_signature.h"
+
+#if (MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH < 1) || (MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH > 8)
+    #error "MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH must be from 1 to 8"
+#endif
+
+/**
+ * @brief comb definition
+ */
+#define MIFARE_ULTRALIGHT_SIGNATURE_COMB_SIZE        ((1 << MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH) - 1)                                   /**< table points */
+#define MIFARE_ULTRALIGHT_SIGNATURE_COMB_ROWS        ((128 + MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH - 1) / MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH)  /**< doublings */
+
+/**
+ * @brief modulus structure definition
+ */
+typedef struct mifare_ultralight_signature_modulus_s
+{
+    uint32_t m[4];        /**< modulus */
+    uint32_t r2[4];       /**< 2^256 mod m */
+    uint32_t m0inv;       /**< -m^-1 mod 2^32 */
+} mifare_ultralight_signature_modulus_t;
+
+/**
+ * @brief jacobian point structure definition
+ */
+typedef struct mifare_ultralight_signature_jacobian_s
+{
+    uint32_t x[4];        /**< x */
+    uint32_t y[4];        /**< y */
+    uint32_t z[4];        /**< z, 0 is the point at infinity */
+} mifare_ultralight_signature_jacobian_t;
+
+/**
+ * @brief secp128r1 field prime, 2^128 - 2^97 - 1
+ */
+static const mifare_ultralight_signature_modulus_t gs_p =
+{
+    {0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFFU, 0xFFFFFFFDU},
+    {0x00000011U, 0x00000008U, 0x00000004U, 0x00000024U},
+    0x00000001U,
+};
+
+/**
+ * @brief secp128r1 group order
+ */
+static const mifare_ultralight_signature_modulus_t gs_n =
+{
+    {0x9038A115U, 0x75A30D1BU, 0x00000000U, 0xFFFFFFFEU},
+    {0xFADE9BEDU, 0x26BC6448U, 0xCDD81516U, 0x71875047U},
+    0x26A959C3U,
+};
+
+/**
+ * @brief secp128r1 constants in montgomery form
+ */
+static const uint32_t gs_one[4] = {0x00000001U, 0x00000000U, 0x00000000U, 0x00000002U};        /**< 1 */
+static const uint32_t gs_b[4] = {0x62CB305AU, 0x9AEE68C3U, 0xE164E7C3U, 0xAE0BDA76U};          /**< b */
+static const mifare_ultralight_signature_point_t gs_g =
+{
+    {0x9CA343C9U, 0x7BBB7421U, 0xB7C989D2U, 0x4F667EE4U},
+    {0x47DEADD0U, 0xB4F899A6U, 0xFA657B89U, 0x5F1823DAU},
+};                                                                                               /**< base point */
+
+/**
+ * @brief nxp ultralight ev1 originality public key
+ */
+static const uint8_t gs_nxp_public_key[33] =
+{
+    0x04, 0x90, 0x93, 0x3B, 0xDC, 0xD6, 0xE9, 0x9B, 0x4E, 0x25, 0x5E, 0x3D, 0xA5, 0x53, 0x89, 0xA8, 0x27,
+    0x56, 0x4E, 0x11, 0x71, 0x8E, 0x01, 0x72, 0x92, 0xFA, 0xF2, 0x32, 0x26, 0xA9, 0x66, 0x14, 0xB8,
+};
+
+/**
+ * @brief      load a big endian number
+ * @param[out] *r pointer to a number buffer
+ * @param[in]  *buf pointer to a 16 bytes buffer
+ * @note       none
+ */
+static void a_mifare_ultralight_signature_load(uint32_t r[4], const uint8_t *buf)
+{
+    uint8_t i;
+    
+    for (i = 0; i < 4; i++)                                                        /* 4 words */
+    {
+        r[3 - i] = ((uint32_t)buf[4 * i + 0] << 24) | ((uint32_t)buf[4 * i + 1] << 16) | 
+                   ((uint32_t)buf[4 * i + 2] << 8) | ((uint32_t)buf[4 * i + 3] << 0);   /* most significant word first */
+    }
+}
+
+/**
+ * @brief     compare two numbers
+ * @param[in] *a pointer to a number
+ * @param[in] *b pointer to a number
+ * @return    -1 a < b, 0 a == b, 1 a > b
+ * @note      none
+ */
+static int8_t a_mifare_ultralight_signature_cmp(const uint32_t a[4], const uint32_t b[4])
+{
+    int8_t i;
+    
+    for (i = 3; i >= 0; i--)                                 /* from the most significant word */
+    {
+        if (a[i] != b[i])                                    /* check the word */
+        {
+            return (a[i] > b[i]) ? 1 : -1;                   /* return the order */
+        }
+    }
+    
+    return 0;                                                /* equal */
+}
+
+/**
+ * @brief     check a number is zero
+ * @param[in] *a pointer to a number
+ * @return    1 zero, 0 not zero
+ * @note      none
+ */
+static uint8_t a_mifare_ultralight_signature_is_zero(const uint32_t a[4])
+{
+    return ((a[0] | a[1] | a[2] | a[3]) == 0) ? 1 : 0;        /* check all words */
+}
+
+/**
+ * @brief      r = a - b with the borrow
+ * @param[out] *r pointer to a result buffer
+ * @param[in]  *a pointer to a number
+ * @param[in]  *b pointer to a number
+ * @return     borrow
+ * @note       none
+ */
+static uint32_t a_mifare_ultralight_signature_sub_raw(uint32_t r[4], const uint32_t a[4], const uint32_t b[4])
+{
+    uint8_t i;
+    uint64_t t;
+    uint32_t borrow;
+    
+    borrow = 0;                                                                 /* init the borrow */
+    for (i = 0; i < 4; i++)                                                     /* 4 words */
+    {
+        t = (uint64_t)a[i] - b[i] - borrow;                                     /* subtract */
+        r[i] = (uint32_t)t;                                                     /* save the word */
+        borrow = (uint32_t)(t >> 63);                                           /* save the borrow */
+    }
+    
+    return borrow;                                                              /* return the borrow */
+}
+
+/**
+ * @brief      r = a + b with the carry
+ * @param[out] *r pointer to a result buffer
+ * @param[in]  *a pointer to a number
+ * @param[in]  *b pointer to a number
+ * @return     carry
+ * @note       none
+ */
+static uint32_t a_mifare_ultralight_signature_add_raw(uint32_t r[4], const uint32_t a[4], const uint32_t b[4])
+{
+    uint8_t i;
+    uint64_t t;
+    
+    t = 0;                                                                      /* init the carry */
+    for (i = 0; i < 4; i++)                                                     /* 4 words */
+    {
+        t += (uint64_t)a[i] + b[i];                                             /* add */
+        r[i] = (uint32_t)t;                                                     /* save the word */
+        t >>= 32;                                                               /* keep the carry */
+    }
+    
+    return (uint32_t)t;                                                         /* return the carry */
+}
+
+/**
+ * @brief      r = a + b mod m
+ * @param[out] *r pointer to a result buffer
+ * @param[in]  *a pointer to a number below m
+ * @param[in]  *b pointer to a number below m
+ * @param[in]  *mod pointer to a modulus
+ * @note       none
+ */
+static void a_mifare_ultralight_signature_add(uint32_t r[4], const uint32_t a[4], const uint32_t b[4], 
+                                              const mifare_ultralight_signature_modulus_t *mod)
+{
+    if ((a_mifare_ultralight_signature_add_raw(r, a, b) != 0) || 
+        (a_mifare_ultralight_signature_cmp(r, mod->m) >= 0))                    /* check the range */
+    {
+        (void)a_mifare_ultralight_signature_sub_raw(r, r, mod->m);              /* reduce */
+    }
+}
+
+/**
+ * @brief      r = a - b mod m
+ * @param[out] *r pointer to a result buffer
+ * @param[in]  *a pointer to a number below m
+ * @param[in]  *b pointer to a number below m
+ * @param[in]  *mod pointer to a modulus
+ * @note       none
+ */
+static void a_mifare_ultralight_signature_sub(uint32_t r[4], const uint32_t a[4], const uint32_t b[4], 
+                                              const mifare_ultralight_signature_modulus_t *mod)
+{
+    if (a_mifare_ultralight_signature_sub_raw(r, a, b) != 0)                    /* check the borrow */
+    {
+        (void)a_mifare_ultralight_signature_add_raw(r, r, mod->m);              /* wrap around */
+    }
+}
+
+/**
+ * @brief      montgomery multiplication r = a * b / 2^128 mod m
+ * @param[out] *r pointer to a result buffer
+ * @param[in]  *a pointer to a number below m
+ * @param[in]  *b pointer to a number below m
+ * @param[in]  *mod pointer to a modulus
+ * @note       r may be a or b
+ */
+static void a_mifare_ultralight_signature_mul(uint32_t r[4], const uint32_t a[4], const uint32_t b[4], 
+                                              const mifare_ultralight_signature_modulus_t *mod)
+{
+    uint8_t i;
+    uint8_t j;
+    uint32_t m;
+    uint32_t t[6];
+    uint64_t c;
+    
+    memset(t, 0, sizeof(t));                                                    /* clear the accumulator */
+    for (i = 0; i < 4; i++)                                                     /* every word of b */
+    {
+        c = 0;                                                                  /* init the carry */
+        for (j = 0; j < 4; j++)                                                 /* t += a * b[i] */
+        {
+            c += (uint64_t)t[j] + (uint64_t)a[j] * b[i];                        /* multiply and add */
+            t[j] = (uint32_t)c;                                                 /* save the word */
+            c >>= 32;                                                           /* keep the carry */
+        }
+        c += t[4];                                                              /* add the carry */
+        t[4] = (uint32_t)c;                                                     /* save the word */
+        t[5] = (uint32_t)(c >> 32);                                             /* save the top */
+        
+        m = t[0] * mod->m0inv;                                                  /* clear the lowest word */
+        c = (uint64_t)t[0] + (uint64_t)m * mod->m[0];                           /* the lowest word is 0 */
+        c >>= 32;                                                               /* keep the carry */
+        for (j = 1; j < 4; j++)                                                 /* t = (t + m * mod) / 2^32 */
+        {
+            c += (uint64_t)t[j] + (uint64_t)m * mod->m[j];                      /* multiply and add */
+            t[j - 1] = (uint32_t)c;                                             /* shift one word */
+            c >>= 32;                                                           /* keep the carry */
+        }
+        c += t[4];                                                              /* add the carry */
+        t[3] = (uint32_t)c;                                                     /* save the word */
+        t[4] = t[5] + (uint32_t)(c >> 32);                                      /* save the top */
+    }
+    if ((t[4] != 0) || (a_mifare_ultralight_signature_cmp(t, mod->m) >= 0))     /* check the range */
+    {
+        (void)a_mifare_ultralight_signature_sub_raw(t, t, mod->m);              /* reduce */
+    }
+    memcpy(r, t, sizeof(uint32_t) * 4);                                         /* save the result */
+}
+
+/**
+ * @brief      modular inversion r = a^(m - 2) mod m
+ * @param[out] *r pointer to a result buffer
+ * @param[in]  *a pointer to a number in montgomery form
+ * @param[in]  *mod pointer to a prime modulus
+ * @note       r stays in montgomery form, 0 gives 0
+ */
+static void a_mifare_ultralight_signature_inv(uint32_t r[4], const uint32_t a[4], 
+                                              const mifare_ultralight_signature_modulus_t *mod)
+{
+    int16_t i;
+    uint32_t e[4];
+    uint32_t t[4];
+    uint32_t two[4] = {2, 0, 0, 0};
+    
+    (void)a_mifare_ultralight_signature_sub_raw(e, mod->m, two);                /* e = m - 2 */
+    memcpy(t, a, sizeof(uint32_t) * 4);                                         /* the top bit of e is set */
+    for (i = 126; i >= 0; i--)                                                  /* left to right */
+    {
+        a_mifare_ultralight_signature_mul(t, t, t, mod);                        /* square */
+        if (((e[i / 32] >> (i % 32)) & 1) != 0)                                 /* check the bit */
+        {
+            a_mifare_ultralight_signature_mul(t, t, a, mod);                    /* multiply */
+        }
+    }
+    memcpy(r, t, sizeof(uint32_t) * 4);                                         /* save the result */
+}
+
+/**
+ * @brief      double a point
+ * @param[out] *r pointer to a result point
+ * @param[in]  *p pointer to a point
+ * @note       a = -3 formula, r may be p
+ */
+static void a_mifare_ultralight_signature_double(mifare_ultralight_signature_jacobian_t *r, 
+                                                 const mifare_ultralight_signature_jacobian_t *p)
+{
+    uint32_t delta[4];
+    uint32_t gamma[4];
+    uint32_t beta[4];
+    uint32_t alpha[4];
+    uint32_t t[4];
+    uint32_t u[4];
+    
+    a_mifare_ultralight_signature_mul(delta, p->z, p->z, &gs_p);                /* delta = z^2 */
+    a_mifare_ultralight_signature_mul(gamma, p->y, p->y, &gs_p);                /* gamma = y^2 */
+    a_mifare_ultralight_signature_mul(beta, p->x, gamma, &gs_p);                /* beta = x * gamma */
+    a_mifare_ultralight_signature_sub(t, p->x, delta, &gs_p);                   /* x - delta */
+    a_mifare_ultralight_signature_add(u, p->x, delta, &gs_p);                   /* x + delta */
+    a_mifare_ultralight_signature_mul(alpha, t, u, &gs_p);                      /* (x - delta) * (x + delta) */
+    a_mifare_ultralight_signature_add(t, alpha, alpha, &gs_p);                  /* 2 times */
+    a_mifare_ultralight_signature_add(alpha, alpha, t, &gs_p);                  /* alpha = 3 times */
+    a_mifare_ultralight_signature_add(t, p->y, p->z, &gs_p);                    /* y + z */
+    a_mifare_ultralight_signature_mul(t, t, t, &gs_p);                          /* (y + z)^2 */
+    a_mifare_ultralight_signature_sub(t, t, gamma, &gs_p);                      /* - gamma */
+    a_mifare_ultralight_signature_sub(r->z, t, delta, &gs_p);                   /* z3 = - delta */
+    a_mifare_ultralight_signature_add(beta, beta, beta, &gs_p);                 /* 2 * beta */
+    a_mifare_ultralight_signature_add(beta, beta, beta, &gs_p);                 /* 4 * beta */
+    a_mifare_ultralight_signature_mul(t, alpha, alpha, &gs_p);                  /* alpha^2 */
+    a_mifare_ultralight_signature_sub(t, t, beta, &gs_p);                       /* - 4 * beta */
+    a_mifare_ultralight_signature_sub(r->x, t, beta, &gs_p);                    /* x3 = - 8 * beta */
+    a_mifare_ultralight_signature_sub(t, beta, r->x, &gs_p);                    /* 4 * beta - x3 */
+    a_mifare_ultralight_signature_mul(t, alpha, t, &gs_p);                      /* alpha * (4 * beta - x3) */
+    a_mifare_ultralight_signature_mul(u, gamma, gamma, &gs_p);                  /* gamma^2 */
+    a_mifare_ultralight_signature_add(u, u, u, &gs_p);                          /* 2 times */
+    a_mifare_ultralight_signature_add(u, u, u, &gs_p);                          /* 4 times */
+    a_mifare_ultralight_signature_add(u, u, u, &gs_p);                          /* 8 times */
+    a_mifare_ultralight_signature_sub(r->y, t, u, &gs_p);                       /* y3 */
+}
+
+/**
+ * @brief      add an affine point to a point
+ * @param[out] *r pointer to a result point
+ * @param[in]  *p pointer to a point
+ * @param[in]  *q pointer to an affine point
+ * @note       r may be p, equal and opposite points are handled
+ */
+static void a_mifare_ultralight_signature_add_affine(mifare_ultralight_signature_jacobian_t *r, 
+                                                     const mifare_ultralight_signature_jacobian_t *p, 
+                                                     const mifare_ultralight_signature_point_t *q)
+{
+    uint32_t zz[4];
+    uint32_t u2[4];
+    uint32_t s2[4];
+    uint32_t h[4];
+    uint32_t rr[4];
+    uint32_t hh[4];
+    uint32_t hhh[4];
+    uint32_t v[4];
+    uint32_t t[4];
+    
+    if (a_mifare_ultralight_signature_is_zero(p->z) != 0)                       /* p is the infinity */
+    {
+        memcpy(r->x, q->x, sizeof(uint32_t) * 4);                               /* copy x */
+        memcpy(r->y, q->y, sizeof(uint32_t) * 4);                               /* copy y */
+        memcpy(r->z, gs_one, sizeof(uint32_t) * 4);                             /* z = 1 */
+        
+        return;                                                                 /* done */
+    }
+    a_mifare_ultralight_signature_mul(zz, p->z, p->z, &gs_p);                   /* z1^2 */
+    a_mifare_ultralight_signature_mul(u2, q->x, zz, &gs_p);                     /* u2 = x2 * z1^2 */
+    a_mifare_ultralight_signature_mul(s2, q->y, zz, &gs_p);                     /* y2 * z1^2 */
+    a_mifare_ultralight_signature_mul(s2, s2, p->z, &gs_p);                     /* s2 = y2 * z1^3 */
+    a_mifare_ultralight_signature_sub(h, u2, p->x, &gs_p);                      /* h = u2 - x1 */
+    a_mifare_ultralight_signature_sub(rr, s2, p->y, &gs_p);                     /* r = s2 - y1 */
+    if (a_mifare_ultralight_signature_is_zero(h) != 0)                          /* same x */
+    {
+        if (a_mifare_ultralight_signature_is_zero(rr) != 0)                     /* same point */
+        {
+            a_mifare_ultralight_signature_double(r, p);                         /* double */
+        }
+        else
+        {
+            memset(r->z, 0, sizeof(uint32_t) * 4);                              /* opposite point, infinity */
+        }
+        
+        return;                                                                 /* done */
+    }
+    a_mifare_ultralight_signature_mul(hh, h, h, &gs_p);                         /* h^2 */
+    a_mifare_ultralight_signature_mul(hhh, h, hh, &gs_p);                       /* h^3 */
+    a_mifare_ultralight_signature_mul(v, p->x, hh, &gs_p);                      /* v = x1 * h^2 */
+    a_mifare_ultralight_signature_mul(r->z, p->z, h, &gs_p);                    /* z3 = z1 * h */
+    a_mifare_ultralight_signature_mul(t, p->y, hhh, &gs_p);                     /* y1 * h^3 */
+    a_mifare_ultralight_signature_mul(r->x, rr, rr, &gs_p);                     /* r^2 */
+    a_mifare_ultralight_signature_sub(r->x, r->x, hhh, &gs_p);                  /* - h^3 */
+    a_mifare_ultralight_signature_sub(r->x, r->x, v, &gs_p);                    /* - v */
+    a_mifare_ultralight_signature_sub(r->x, r->x, v, &gs_p);                    /* x3 = - 2 * v */
+    a_mifare_ultralight_signature_sub(v, v, r->x, &gs_p);                       /* v - x3 */
+    a_mifare_ultralight_signature_mul(v, rr, v, &gs_p);                         /* r * (v - x3) */
+    a_mifare_ultralight_signature_sub(r->y, v, t, &gs_p);                       /* y3 = - y1 * h^3 */
+}
+
+/**
+ * @brief      convert a point to affine
+ * @param[out] *r pointer to an affine point
+ * @param[in]  *p pointer to a point, not the infinity
+ * @note       none
+ */
+static void a_mifare_ultralight_signature_affine(mifare_ultralight_signature_point_t *r, 
+                                                 const mifare_ultralight_signature_jacobian_t *p)
+{
+    uint32_t zi[4];
+    uint32_t zi2[4];
+    
+    a_mifare_ultralight_signature_inv(zi, p->z, &gs_p);                         /* 1 / z */
+    a_mifare_ultralight_signature_mul(zi2, zi, zi, &gs_p);                      /* 1 / z^2 */
+    a_mifare_ultralight_signature_mul(r->x, p->x, zi2, &gs_p);                  /* x / z^2 */
+    a_mifare_ultralight_signature_mul(zi2, zi2, zi, &gs_p);                     /* 1 / z^3 */
+    a_mifare_ultralight_signature_mul(r->y, p->y, zi2, &gs_p);                  /* y / z^3 */
+}
+
+/**
+ * @brief      build the comb table of a point
+ * @param[out] *table pointer to a MIFARE_ULTRALIGHT_SIGNATURE_COMB_SIZE point table
+ * @param[in]  *base pointer to an affine point
+ * @note       entry i - 1 is the sum of 2^(j * rows) * base for every bit j set in i,
+ *             these sums are below the order so no entry is the infinity
+ */
+static void a_mifare_ultralight_signature_comb(mifare_ultralight_signature_point_t *table, 
+                                               const mifare_ultralight_signature_point_t *base)
+{
+    uint16_t i;
+    uint16_t j;
+    uint16_t top;
+    mifare_ultralight_signature_jacobian_t p;
+    
+    table[0] = *base;                                                           /* 1 * base */
+    for (j = 1; j < MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH; j++)                /* every tooth */
+    {
+        memcpy(p.x, table[(1 << (j - 1)) - 1].x, sizeof(uint32_t) * 4);         /* copy x */
+        memcpy(p.y, table[(1 << (j - 1)) - 1].y, sizeof(uint32_t) * 4);         /* copy y */
+        memcpy(p.z, gs_one, sizeof(uint32_t) * 4);                              /* z = 1 */
+        for (i = 0; i < MIFARE_ULTRALIGHT_SIGNATURE_COMB_ROWS; i++)             /* shift by the rows */
+        {
+            a_mifare_ultralight_signature_double(&p, &p);                       /* double */
+        }
+        a_mifare_ultralight_signature_affine(&table[(1 << j) - 1], &p);         /* 2^(j * rows) * base */
+    }
+    top = 1;                                                                    /* init the top bit */
+    for (i = 3; i <= MIFARE_ULTRALIGHT_SIGNATURE_COMB_SIZE; i++)                /* every sum */
+    {
+        if ((i & (i - 1)) == 0)                                                 /* power of 2 */
+        {
+            top = i;                                                            /* new top bit */
+            
+            continue;                                                           /* already built */
+        }
+        memcpy(p.x, table[(i ^ top) - 1].x, sizeof(uint32_t) * 4);              /* copy x */
+        memcpy(p.y, table[(i ^ top) - 1].y, sizeof(uint32_t) * 4);              /* copy y */
+        memcpy(p.z, gs_one, sizeof(uint32_t) * 4);                              /* z = 1 */
+        a_mifare_ultralight_signature_add_affine(&p, &p, &table[top - 1]);      /* add the top tooth */
+        a_mifare_ultralight_signature_affine(&table[i - 1], &p);                /* save the sum */
+    }
+}
+
+/**
+ * @brief     get the comb index of a row
+ * @param[in] *k pointer to a scalar
+ * @param[in] row comb row
+ * @return    comb index
+ * @note      none
+ */
+static uint16_t a_mifare_ultralight_signature_comb_index(const uint32_t k[4], uint16_t row)
+{
+    uint16_t j;
+    uint16_t bit;
+    uint16_t index;
+    
+    index = 0;                                                                  /* init the index */
+    for (j = 0; j < MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH; j++)                /* every tooth */
+    {
+        bit = (uint16_t)(j * MIFARE_ULTRALIGHT_SIGNATURE_COMB_ROWS + row);      /* bit of the tooth */
+        if ((bit < 128) && (((k[bit / 32] >> (bit % 32)) & 1) != 0))           /* check the bit */
+        {
+            index |= (uint16_t)(1 << j);                                        /* set the tooth */
+        }
+    }
+    
+    return index;                                                               /* return the index */
+}
+
+/**
+ * @brief     verify with the inverted s
+ * @param[in] *key pointer to a signature key structure
+ * @param[in] *e pointer to the message number
+ * @param[in] *r pointer to r
+ * @param[in] *w pointer to 1 / s in montgomery form
+ * @return    1 valid, 0 invalid
+ * @note      u1 * g + u2 * q is compared with r in jacobian coordinates, so no field inversion is needed,
+ *            n is above p, so x mod n is x and r must be below p
+ */
+static uint8_t a_mifare_ultralight_signature_evaluate(const mifare_ultralight_signature_key_t *key, const uint32_t e[4], 
+                                                       const uint32_t r[4], const uint32_t w[4])
+{
+    int16_t row;
+    uint16_t index;
+    uint32_t u1[4];
+    uint32_t u2[4];
+    uint32_t zz[4];
+    uint32_t t[4];
+    mifare_ultralight_signature_jacobian_t p;
+    
+    if (a_mifare_ultralight_signature_cmp(r, gs_p.m) >= 0)                      /* x < p < n, so x mod n is x */
+    {
+        return 0;                                                               /* r above the field prime is never x */
+    }
+    a_mifare_ultralight_signature_mul(u1, e, w, &gs_n);                         /* u1 = e / s */
+    a_mifare_ultralight_signature_mul(u2, r, w, &gs_n);                         /* u2 = r / s */
+    memset(p.z, 0, sizeof(uint32_t) * 4);                                       /* start from the infinity */
+    for (row = MIFARE_ULTRALIGHT_SIGNATURE_COMB_ROWS - 1; row >= 0; row--)      /* every row */
+    {
+        a_mifare_ultralight_signature_double(&p, &p);                           /* double */
+        index = a_mifare_ultralight_signature_comb_index(u1, (uint16_t)row);    /* get the g index */
+        if (index != 0)                                                         /* check the index */
+        {
+            a_mifare_ultralight_signature_add_affine(&p, &p, &key->g[index - 1]);   /* add the g entry */
+        }
+        index = a_mifare_ultralight_signature_comb_index(u2, (uint16_t)row);    /* get the q index */
+        if (index != 0)                                                         /* check the index */
+        {
+            a_mifare_ultralight_signature_add_affine(&p, &p, &key->q[index - 1]);   /* add the q entry */
+        }
+    }
+    if (a_mifare_ultralight_signature_is_zero(p.z) != 0)                        /* check the infinity */
+    {
+        return 0;                                                               /* invalid */
+    }
+    
+    a_mifare_ultralight_signature_mul(zz, p.z, p.z, &gs_p);                     /* z^2 */
+    a_mifare_ultralight_signature_mul(t, r, gs_p.r2, &gs_p);                    /* r in montgomery form */
+    a_mifare_ultralight_signature_mul(t, t, zz, &gs_p);                         /* r * z^2 */
+    if (a_mifare_ultralight_signature_cmp(t, p.x) == 0)                         /* x == r */
+    {
+        return 1;                                                               /* valid */
+    }
+    
+    return 0;                                                                   /* invalid */
+}
+
+/**
+ * @brief      parse a signature
+ * @param[in]  *uid pointer to a 7 bytes uid
+ * @param[in]  *signature pointer to a 32 bytes signature
+ * @param[out] *e pointer to the message number
+ * @param[out] *r pointer to r
+ * @param[out] *s pointer to s
+ * @return     1 r and s are in range, 0 out of range
+ * @note       none
+ */
+static uint8_t a_mifare_ultralight_signature_parse(const uint8_t uid[7], const uint8_t signature[32], 
+                                                   uint32_t e[4], uint32_t r[4], uint32_t s[4])
+{
+    uint8_t buf[16];
+    
+    memset(buf, 0, 9);                                                          /* the uid is the low bytes */
+    memcpy(buf + 9, uid, 7);                                                    /* copy the uid */
+    a_mifare_ultralight_signature_load(e, buf);                                 /* load e */
+    a_mifare_ultralight_signature_load(r, signature);                           /* load r */
+    a_mifare_ultralight_signature_load(s, signature + 16);                      /* load s */
+    if ((a_mifare_ultralight_signature_is_zero(r) != 0) || (a_mifare_ultralight_signature_cmp(r, gs_n.m) >= 0) || 
+        (a_mifare_ultralight_signature_is_zero(s) != 0) || (a_mifare_ultralight_signature_cmp(s, gs_n.m) >= 0))
+    {
+        return 0;                                                               /* out of range */
+    }
+    
+    return 1;                                                                   /* in range */
+}
+
+/**
+ * @brief     init a signature key
+ * @param[in] *key pointer to a signature key structure
+ * @param[in] *public_key pointer to an uncompressed secp128r1 public key, NULL is the nxp ultralight ev1 key
+ * @return    status code
+ *            - 0 success
+ *            - 1 public key is invalid
+ *            - 2 key is NULL
+ * @note      public_key is 0x04, x and y, 33 bytes big endian,
+ *            the comb tables of the base point and the public key are built here once,
+ *            key->id is the fnv-1a hash of the public key and keys the cached verdicts
+ */
+uint8_t mifare_ultralight_signature_init(mifare_ultralight_signature_key_t *key, const uint8_t public_key[33])
+{
+    uint32_t x[4];
+    uint32_t y[4];
+    uint32_t l[4];
+    uint32_t t[4];
+    uint8_t i;
+    mifare_ultralight_signature_point_t q;
+    
+    if (key == NULL)                                                            /* check key */
+    {
+        return 2;                                                               /* return error */
+    }
+    
+    key->inited = 0;                                                            /* not inited */
+    if (public_key == NULL)                                                     /* check the public key */
+    {
+        public_key = gs_nxp_public_key;                                         /* use the nxp key */
+    }
+    if (public_key[0] != 0x04)                                                  /* check the format */
+    {
+        return 1;                                                               /* return error */
+    }
+    a_mifare_ultralight_signature_load(x, public_key + 1);                      /* load x */
+    a_mifare_ultralight_signature_load(y, public_key + 17);                     /* load y */
+    if ((a_mifare_ultralight_signature_cmp(x, gs_p.m) >= 0) || 
+        (a_mifare_ultralight_signature_cmp(y, gs_p.m) >= 0))                    /* check the range */
+    {
+        return 1;                                                               /* return error */
+    }
+    a_mifare_ultralight_signature_mul(q.x, x, gs_p.r2, &gs_p);                  /* x in montgomery form */
+    a_mifare_ultralight_signature_mul(q.y, y, gs_p.r2, &gs_p);                  /* y in montgomery form */
+    a_mifare_ultralight_signature_mul(l, q.y, q.y, &gs_p);                      /* y^2 */
+    a_mifare_ultralight_signature_mul(t, q.x, q.x, &gs_p);                      /* x^2 */
+    a_mifare_ultralight_signature_mul(t, t, q.x, &gs_p);                        /* x^3 */
+    a_mifare_ultralight_signature_sub(t, t, q.x, &gs_p);                        /* x^3 - x */
+    a_mifare_ultralight_signature_sub(t, t, q.x, &gs_p);                        /* x^3 - 2x */
+    a_mifare_ultralight_signature_sub(t, t, q.x, &gs_p);                        /* x^3 - 3x */
+    a_mifare_ultralight_signature_add(t, t, gs_b, &gs_p);                       /* x^3 - 3x + b */
+    if (a_mifare_ultralight_signature_cmp(l, t) != 0)                           /* check the curve */
+    {
+        return 1;                                                               /* return error */
+    }
+    
+    a_mifare_ultralight_signature_comb(key->g, &gs_g);                          /* build the base point table */
+    a_mifare_ultralight_signature_comb(key->q, &q);                             /* build the public key table */
+    key->id = 2166136261U;                                                      /* fnv offset basis */
+    for (i = 0; i < 33; i++)                                                    /* hash the public key */
+    {
+        key->id ^= public_key[i];                                               /* xor the byte */
+        key->id *= 16777619U;                                                   /* fnv prime */
+    }
+    key->inited = 1;                                                            /* flag finish initialization */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      verify an originality signature
+ * @param[in]  *key pointer to a signature key structure
+ * @param[in]  *uid pointer to a 7 bytes uid
+ * @param[in]  *signature pointer to a 32 bytes signature
+ * @param[out] *valid pointer to a valid buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 key is NULL
+ *             - 3 key is not initialized
+ * @note       the signature is r and s, 16 bytes big endian each, over the raw uid with ecdsa secp128r1
+ */
+uint8_t mifare_ultralight_signature_verify(const mifare_ultralight_signature_key_t *key, const uint8_t uid[7], 
+                                           const uint8_t signature[32], mifare_ultralight_bool_t *valid)
+{
+    uint32_t e[4];
+    uint32_t r[4];
+    uint32_t s[4];
+    uint32_t w[4];
+    
+    if (key == NULL)                                                                /* check key */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (key->inited != 1)                                                           /* check key initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    
+    *valid = MIFARE_ULTRALIGHT_BOOL_FALSE;                                          /* init the result */
+    if (a_mifare_ultralight_signature_parse(uid, signature, e, r, s) == 0)          /* parse the signature */
+    {
+        return 0;                                                                   /* success return 0 */
+    }
+    a_mifare_ultralight_signature_mul(w, s, gs_n.r2, &gs_n);                        /* s in montgomery form */
+    a_mifare_ultralight_signature_inv(w, w, &gs_n);                                 /* 1 / s */
+    if (a_mifare_ultralight_signature_evaluate(key, e, r, w) != 0)                  /* check the signature */
+    {
+        *valid = MIFARE_ULTRALIGHT_BOOL_TRUE;                                       /* valid */
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+
+/**
+ * @brief      verify originality signatures in a batch
+ * @param[in]  *key pointer to a signature key structure
+ * @param[in]  *uid pointer to a uid array
+ * @param[in]  *signature pointer to a signature array
+ * @param[in]  count number of signatures
+ * @param[out] *valid pointer to a valid array
+ * @param[out] *passed pointer to a passed number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 key is NULL
+ *             - 3 key is not initialized
+ * @note       every MIFARE_ULTRALIGHT_SIGNATURE_BATCH signatures share one modular inversion
+ */
+uint8_t mifare_ultralight_signature_verify_batch(const mifare_ultralight_signature_key_t *key, const uint8_t (*uid)[7], 
+                                                 const uint8_t (*signature)[32], uint32_t count, 
+                                                 mifare_ultralight_bool_t *valid, uint32_t *passed)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t n;
+    uint32_t e[MIFARE_ULTRALIGHT_SIGNATURE_BATCH][4];
+    uint32_t r[MIFARE_ULTRALIGHT_SIGNATURE_BATCH][4];
+    uint32_t s[MIFARE_ULTRALIGHT_SIGNATURE_BATCH][4];
+    uint32_t acc[MIFARE_ULTRALIGHT_SIGNATURE_BATCH + 1][4];
+    uint32_t inv[4];
+    uint32_t w[4];
+    uint32_t raw_one[4] = {1, 0, 0, 0};
+    uint8_t ok[MIFARE_ULTRALIGHT_SIGNATURE_BATCH];
+    uint8_t any;
+    
+    if (key == NULL)                                                                            /* check key */
+    {
+        return 2;                                                                               /* return error */
+    }
+    if (key->inited != 1)                                                                       /* check key initialization */
+    {
+        return 3;                                                                               /* return error */
+    }
+    
+    *passed = 0;                                                                                /* init the passed number */
+    a_mifare_ultralight_signature_mul(acc[0], raw_one, gs_n.r2, &gs_n);                         /* 1 in montgomery form */
+    for (i = 0; i < count; i += n)                                                              /* every batch */
+    {
+        n = ((count - i) > MIFARE_ULTRALIGHT_SIGNATURE_BATCH) ? 
+             MIFARE_ULTRALIGHT_SIGNATURE_BATCH : (count - i);                                   /* batch size */
+        any = 0;                                                                                /* no valid entry yet */
+        for (j = 0; j < n; j++)                                                                 /* prefix products */
+        {
+            valid[i + j] = MIFARE_ULTRALIGHT_BOOL_FALSE;                                        /* init the result */
+            ok[j] = a_mifare_ultralight_signature_parse(uid[i + j], signature[i + j], 
+                                                        e[j], r[j], s[j]);                      /* parse the signature */
+            if (ok[j] == 0)                                                                     /* out of range */
+            {
+                memcpy(acc[j + 1], acc[j], sizeof(uint32_t) * 4);                               /* keep the product */
+                
+                continue;                                                                       /* skip */
+            }
+            a_mifare_ultralight_signature_mul(s[j], s[j], gs_n.r2, &gs_n);                      /* s in montgomery form */
+            a_mifare_ultralight_signature_mul(acc[j + 1], acc[j], s[j], &gs_n);                 /* extend the product */
+            any = 1;                                                                            /* one valid entry */
+        }
+        if (any == 0)                                                                           /* nothing to verify */
+        {
+            continue;                                                                           /* next batch */
+        }
+        a_mifare_ultralight_signature_inv(inv, acc[n], &gs_n);                                  /* one inversion */
+        for (j = n; j > 0; j--)                                                                 /* walk back */
+        {
+            if (ok[j - 1] == 0)                                                                 /* out of range */
+            {
+                continue;                                                                       /* skip */
+            }
+            a_mifare_ultralight_signature_mul(w, inv, acc[j - 1], &gs_n);                       /* 1 / s */
+            a_mifare_ultralight_signature_mul(inv, inv, s[j - 1], &gs_n);                       /* drop s */
+            if (a_mifare_ultralight_signature_evaluate(key, e[j - 1], r[j - 1], w) != 0)        /* check the signature */
+            {
+                valid[i + j - 1] = MIFARE_ULTRALIGHT_BOOL_TRUE;                                 /* valid */
+                (*passed)++;                                                                    /* count it */
+            }
+        }
+    }
+    
+    return 0;                                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      read and verify the originality signature of the selected card
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *key pointer to a signature key structure
+ * @param[out] *valid pointer to a valid buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle or key is NULL
+ *             - 3 handle or key is not initialized
+ * @note       with a result cache the verdict of a cached uid checked with the same key is returned without any frame,
+ *             otherwise the verdict is stored in the cache with key->id after the verify
+ */
+uint8_t mifare_ultralight_signature_check(mifare_ultralight_handle_t *handle, const mifare_ultralight_signature_key_t *key, 
+                                          mifare_ultralight_bool_t *valid)
+{
+    uint8_t res;
+    uint8_t storage;
+    uint8_t uid[7];
+    uint8_t signature[32];
+    mifare_ultralight_cache_verdict_t verdict;
+    
+    if ((handle == NULL) || (key == NULL))                                          /* check handle and key */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if ((handle->inited != 1) || (key->inited != 1))                                /* check handle and key initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    
+    if (mifare_ultralight_get_uid(handle, uid) == 0)                                /* the uid is known from the select */
+    {
+        if ((mifare_ultralight_cache_lookup(handle, uid, key->id, &storage, &verdict) == 0) && 
+            (verdict != MIFARE_ULTRALIGHT_CACHE_VERDICT_UNKNOWN))                   /* check the cache */
+        {
+            *valid = (verdict == MIFARE_ULTRALIGHT_CACHE_VERDICT_GENUINE) ? 
+                      MIFARE_ULTRALIGHT_BOOL_TRUE : MIFARE_ULTRALIGHT_BOOL_FALSE;   /* cached verdict */
+            
+            return 0;                                                               /* success return 0 */
+        }
+    }
+    else
+    {
+        res = mifare_ultralight_get_serial_number(handle, uid);                     /* get the serial number */
+        if (res != 0)                                                               /* check the result */
+        {
+            handle->debug_print("mifare_ultralight: get serial number failed.\n");  /* get serial number failed */
+            
+            return 1;                                                               /* return error */
+        }
+    }
+    res = mifare_ultralight_read_signature(handle, signature);                      /* read the signature */
+    if (res != 0)                                                                   /* check the result */
+    {
+        handle->debug_print("mifare_ultralight: read signature failed.\n");         /* read signature failed */
+        
+        return 1;                                                                   /* return error */
+    }
+    (void)mifare_ultralight_signature_verify(key, uid, signature, valid);           /* verify the signature */
+    (void)mifare_ultralight_cache_set_verdict(handle, uid, key->id, (*valid == MIFARE_ULTRALIGHT_BOOL_TRUE) ? 
+                                              MIFARE_ULTRALIGHT_CACHE_VERDICT_GENUINE : 
+                                              MIFARE_ULTRALIGHT_CACHE_VERDICT_NOT_GENUINE);   /* cache the verdict */
+    
+    return 0;                                                                       /* success return 0 */
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_signature.h
+ * @brief     driver mifare_ultralight signature header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MIFARE_ULTRALIGHT_SIGNATURE_H
+#define DRIVER_MIFARE_ULTRALIGHT_SIGNATURE_H
+
+#include "driver_mifare_ultralight.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief comb teeth of the precomputed tables, define it from 1 to 8 before including this file to override,
+ *        every table holds 2^teeth - 1 points of 32 bytes and a verify runs 128 / teeth doublings
+ */
+#ifndef MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH
+    #define MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH 4
+#endif
+
+/**
+ * @brief signatures of a batch sharing one modular inversion
+ */
+#ifndef MIFARE_ULTRALIGHT_SIGNATURE_BATCH
+    #define MIFARE_ULTRALIGHT_SIGNATURE_BATCH 16
+#endif
+
+/**
+ * @defgroup mifare_ultralight_signature_driver mifare ultralight signature driver function
+ * @brief    mifare ultralight originality signature driver modules
+ * @ingroup  mifare_ultralight_driver
+ * @{
+ */
+
+/**
+ * @brief mifare ultralight signature point structure definition
+ */
+typedef struct mifare_ultralight_signature_point_s
+{
+    uint32_t x[4];        /**< affine x in montgomery form, least significant word first */
+    uint32_t y[4];        /**< affine y in montgomery form, least significant word first */
+} mifare_ultralight_signature_point_t;
+
+/**
+ * @brief mifare ultralight signature key structure definition
+ */
+typedef struct mifare_ultralight_signature_key_s
+{
+    mifare_ultralight_signature_point_t g[(1 << MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH) - 1];        /**< comb table of the base point */
+    mifare_ultralight_signature_point_t q[(1 << MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH) - 1];        /**< comb table of the public key */
+    uint32_t id;                                                                                     /**< fnv-1a hash of the public key, keys the cached verdicts */
+    uint8_t inited;                                                                                  /**< inited flag */
+} mifare_ultralight_signature_key_t;
+
+/**
+ * @brief     init a signature key
+ * @param[in] *key pointer to a signature key structure
+ * @param[in] *public_key pointer to an uncompressed secp128r1 public key, NULL is the nxp ultralight ev1 key
+ * @return    status code
+ *            - 0 success
+ *            - 1 public key is invalid
+ *            - 2 key is NULL
+ * @note      public_key is 0x04, x and y, 33 bytes big endian,
+ *            the comb tables of the base point and the public key are built here once,
+ *            key->id is the fnv-1a hash of the public key and keys the cached verdicts
+ */
+uint8_t mifare_ultralight_signature_init(mifare_ultralight_signature_key_t *key, const uint8_t public_key[33]);
+
+/**
+ * @brief      verify an originality signature
+ * @param[in]  *key pointer to a signature key structure
+ * @param[in]  *uid pointer to a 7 bytes uid
+ * @param[in]  *signature pointer to a 32 bytes signature
+ * @param[out] *valid pointer to a valid buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 key is NULL
+ *             - 3 key is not initialized
+ * @note       the signature is r and s, 16 bytes big endian each, over the raw uid with ecdsa secp128r1
+ */
+uint8_t mifare_ultralight_signature_verify(const mifare_ultralight_signature_key_t *key, const uint8_t uid[7], 
+                                           const uint8_t signature[32], mifare_ultralight_bool_t *valid);
+
+/**
+ * @brief      verify originality signatures in a batch
+ * @param[in]  *key pointer to a signature key structure
+ * @param[in]  *uid pointer to a uid array
+ * @param[in]  *signature pointer to a signature array
+ * @param[in]  count number of signatures
+ * @param[out] *valid pointer to a valid array
+ * @param[out] *passed pointer to a passed number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 key is NULL
+ *             - 3 key is not initialized
+ * @note       every MIFARE_ULTRALIGHT_SIGNATURE_BATCH signatures share one modular inversion
+ */
+uint8_t mifare_ultralight_signature_verify_batch(const mifare_ultralight_signature_key_t *key, const uint8_t (*uid)[7], 
+                                                 const uint8_t (*signature)[32], uint32_t count, 
+                                                 mifare_ultralight_bool_t *valid, uint32_t *passed);
+
+/**
+ * @brief      read and verify the originality signature of the selected card
+ * @param[in]  *handle pointer to a mifare_ultralight handle structure
+ * @param[in]  *key pointer to a signature key structure
+ * @param[out] *valid pointer to a valid buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle or key is NULL
+ *             - 3 handle or key is not initialized
+ * @note       with a result cache the verdict of a cached uid checked with the same key is returned without any frame,
+ *             otherwise the verdict is stored in the cache with key->id after the verify
+ */
+uint8_t mifare_ultralight_signature_check(mifare_ultralight_handle_t *handle, const mifare_ultralight_signature_key_t *key, 
+                                          mifare_ultralight_bool_t *valid);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
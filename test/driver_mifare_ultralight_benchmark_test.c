@@ -0,0 +1,284 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_benchmark_test.c
+ * @brief     driver mifare_ultralight benchmark test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_benchmark_test.h"
+
+static uint32_t gs_sample[MIFARE_ULTRALIGHT_BENCHMARK_MAX_SAMPLE];        /**< latency samples */
+static uint8_t gs_dump[64 * 4];                                             /**< full dump buffer */
+static const char *const gs_op_name[MIFARE_ULTRALIGHT_BENCHMARK_MAX] =
+{
+    "request_activate",
+    "read_page",
+    "read_four_pages",
+    "fast_read_page_1",
+    "fast_read_page_4",
+    "fast_read_page_8",
+    "fast_read_page_15",
+    "read_all",
+    "write_page",
+    "authenticate",
+    "read_counter",
+    "increment_counter",
+    "set_modulation_mode",
+    "set_protect_start_page",
+    "set_virtual_card_type_identifier",
+};                                                                          /**< operation names */
+
+/**
+ * @brief     prepare one operation
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] op operation
+ * @return    status code
+ *            - 0 success
+ *            - 1 prepare failed
+ * @note      the preparation is not measured, the field is cycled so that request finds the card
+ */
+static uint8_t a_benchmark_prepare(mifare_ultralight_handle_t *handle, mifare_ultralight_benchmark_op_t op)
+{
+    if (op != MIFARE_ULTRALIGHT_BENCHMARK_ACTIVATE)
+    {
+        return 0;
+    }
+    if (mifare_ultralight_deinit(handle) != 0)
+    {
+        return 1;
+    }
+    if (mifare_ultralight_init(handle) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run one operation
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] op operation
+ * @param[in] i sample index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_benchmark_run(mifare_ultralight_handle_t *handle, mifare_ultralight_benchmark_op_t op, uint32_t i)
+{
+    uint8_t data[64];
+    uint8_t pwd[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t pack[2] = {0x00, 0x00};
+    uint8_t protected_page;
+    uint16_t len;
+    uint32_t cnt;
+    mifare_ultralight_activation_t activation;
+    
+    len = sizeof(data);
+    switch (op)
+    {
+        case MIFARE_ULTRALIGHT_BENCHMARK_ACTIVATE :
+        {
+            return (mifare_ultralight_activate(handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_NONE, &activation) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_READ_PAGE :
+        {
+            return (mifare_ultralight_read_page(handle, 0x04, data) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_READ_FOUR_PAGES :
+        {
+            return (mifare_ultralight_read_four_pages(handle, 0x04, data) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_FAST_READ_1 :
+        {
+            return (mifare_ultralight_fast_read_page(handle, 0x04, 0x04, data, &len) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_FAST_READ_4 :
+        {
+            return (mifare_ultralight_fast_read_page(handle, 0x04, 0x07, data, &len) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_FAST_READ_8 :
+        {
+            return (mifare_ultralight_fast_read_page(handle, 0x04, 0x0B, data, &len) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_FAST_READ_15 :
+        {
+            return (mifare_ultralight_fast_read_page(handle, 0x00, 0x0E, data, &len) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_READ_ALL :
+        {
+            len = sizeof(gs_dump);
+            
+            return (mifare_ultralight_read_all(handle, gs_dump, &len, &protected_page) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_WRITE_PAGE :
+        {
+            data[0] = (uint8_t)(i >> 0);
+            data[1] = (uint8_t)(i >> 8);
+            data[2] = (uint8_t)(i >> 16);
+            data[3] = (uint8_t)(i >> 24);
+            
+            return (mifare_ultralight_write_page(handle, 0x04, data) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_AUTHENTICATE :
+        {
+            return (mifare_ultralight_authenticate(handle, pwd, pack) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_READ_COUNTER :
+        {
+            return (mifare_ultralight_read_counter(handle, 2, &cnt) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_INCREMENT_COUNTER :
+        {
+            return (mifare_ultralight_increment_counter(handle, 2, 1) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_SET_MODULATION_MODE :
+        {
+            return (mifare_ultralight_set_modulation_mode(handle, MIFARE_ULTRALIGHT_MODULATION_MODE_STRONG) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_SET_PROTECT_START_PAGE :
+        {
+            return (mifare_ultralight_set_protect_start_page(handle, 0xFF) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_BENCHMARK_SET_VCTID :
+        {
+            return (mifare_ultralight_set_virtual_card_type_identifier(handle, 0x05) != 0) ? 1 : 0;
+        }
+        default :
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief      benchmark test
+ * @param[in]  *handle pointer to a linked mifare_ultralight handle structure
+ * @param[in]  *timestamp_us pointer to the clock of the transport
+ * @param[in]  samples samples of every operation
+ * @param[out] *result pointer to a MIFARE_ULTRALIGHT_BENCHMARK_MAX result array
+ * @return     status code
+ *             - 0 success
+ *             - 1 test failed
+ * @note       the handle is linked by the caller, so any transport can be measured,
+ *             the card must use the default password and leave page 4 and counter 2 free
+ */
+uint8_t mifare_ultralight_benchmark_test(mifare_ultralight_handle_t *handle, uint32_t (*timestamp_us)(void), 
+                                         uint32_t samples, mifare_ultralight_benchmark_result_t *result)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    uint32_t t;
+    uint32_t v;
+    uint32_t sum;
+    mifare_ultralight_activation_t activation;
+    
+    /* check the params */
+    if ((handle == NULL) || (timestamp_us == NULL) || (result == NULL) || 
+        (samples == 0) || (samples > MIFARE_ULTRALIGHT_BENCHMARK_MAX_SAMPLE))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: param is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* init */
+    res = mifare_ultralight_init(handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card and get the storage */
+    res = mifare_ultralight_activate(handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_NONE, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(handle);
+        
+        return 1;
+    }
+    
+    for (j = 0; j < MIFARE_ULTRALIGHT_BENCHMARK_MAX; j++)
+    {
+        /* sample the operation */
+        sum = 0;
+        for (i = 0; i < samples; i++)
+        {
+            if (a_benchmark_prepare(handle, (mifare_ultralight_benchmark_op_t)j) != 0)
+            {
+                mifare_ultralight_interface_debug_print("mifare_ultralight: prepare %s failed.\n", gs_op_name[j]);
+                (void)mifare_ultralight_deinit(handle);
+                
+                return 1;
+            }
+            t = timestamp_us();
+            res = a_benchmark_run(handle, (mifare_ultralight_benchmark_op_t)j, i);
+            v = timestamp_us() - t;
+            if (res != 0)
+            {
+                mifare_ultralight_interface_debug_print("mifare_ultralight: %s failed.\n", gs_op_name[j]);
+                (void)mifare_ultralight_deinit(handle);
+                
+                return 1;
+            }
+            sum += v;
+            
+            /* insert in order */
+            k = i;
+            while ((k > 0) && (gs_sample[k - 1] > v))
+            {
+                gs_sample[k] = gs_sample[k - 1];
+                k--;
+            }
+            gs_sample[k] = v;
+        }
+        
+        /* save the result */
+        result[j].name = gs_op_name[j];
+        result[j].samples = samples;
+        result[j].mean_us = sum / samples;
+        result[j].p50_us = gs_sample[((samples - 1) * 50) / 100];
+        result[j].p99_us = gs_sample[((samples - 1) * 99) / 100];
+        result[j].ops = (sum != 0) ? ((float)samples * 1000000.0f / (float)sum) : 0.0f;
+    }
+    
+    /* deinit */
+    (void)mifare_ultralight_deinit(handle);
+    
+    return 0;
+}
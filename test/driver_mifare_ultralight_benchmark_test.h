@@ -0,0 +1,115 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_benchmark_test.h
+ * @brief     driver mifare_ultralight benchmark test header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_MIFARE_ULTRALIGHT_BENCHMARK_TEST_H
+#define DRIVER_MIFARE_ULTRALIGHT_BENCHMARK_TEST_H
+
+#include "driver_mifare_ultralight_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup mifare_ultralight_test_driver
+ * @{
+ */
+
+/**
+ * @brief benchmark test max samples definition
+ */
+#define MIFARE_ULTRALIGHT_BENCHMARK_MAX_SAMPLE        256        /**< max samples of every operation */
+
+/**
+ * @brief mifare_ultralight benchmark operation enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_BENCHMARK_ACTIVATE = 0,              /**< request and activate */
+    MIFARE_ULTRALIGHT_BENCHMARK_READ_PAGE,                 /**< read page */
+    MIFARE_ULTRALIGHT_BENCHMARK_READ_FOUR_PAGES,           /**< read four pages */
+    MIFARE_ULTRALIGHT_BENCHMARK_FAST_READ_1,               /**< fast read 1 page */
+    MIFARE_ULTRALIGHT_BENCHMARK_FAST_READ_4,               /**< fast read 4 pages */
+    MIFARE_ULTRALIGHT_BENCHMARK_FAST_READ_8,               /**< fast read 8 pages */
+    MIFARE_ULTRALIGHT_BENCHMARK_FAST_READ_15,              /**< fast read 15 pages */
+    MIFARE_ULTRALIGHT_BENCHMARK_READ_ALL,                  /**< full dump */
+    MIFARE_ULTRALIGHT_BENCHMARK_WRITE_PAGE,                /**< write page */
+    MIFARE_ULTRALIGHT_BENCHMARK_AUTHENTICATE,              /**< authenticate */
+    MIFARE_ULTRALIGHT_BENCHMARK_READ_COUNTER,              /**< read counter */
+    MIFARE_ULTRALIGHT_BENCHMARK_INCREMENT_COUNTER,         /**< increment counter */
+    MIFARE_ULTRALIGHT_BENCHMARK_SET_MODULATION_MODE,       /**< set modulation mode */
+    MIFARE_ULTRALIGHT_BENCHMARK_SET_PROTECT_START_PAGE,    /**< set protect start page */
+    MIFARE_ULTRALIGHT_BENCHMARK_SET_VCTID,                 /**< set virtual card type identifier */
+    MIFARE_ULTRALIGHT_BENCHMARK_MAX,                       /**< operation number */
+} mifare_ultralight_benchmark_op_t;
+
+/**
+ * @brief mifare_ultralight benchmark result structure definition
+ */
+typedef struct mifare_ultralight_benchmark_result_s
+{
+    const char *name;        /**< operation name */
+    uint32_t samples;        /**< sample number */
+    uint32_t mean_us;        /**< mean latency */
+    uint32_t p50_us;         /**< 50th percentile latency */
+    uint32_t p99_us;         /**< 99th percentile latency */
+    float ops;               /**< operations per second */
+} mifare_ultralight_benchmark_result_t;
+
+/**
+ * @brief      benchmark test
+ * @param[in]  *handle pointer to a linked mifare_ultralight handle structure
+ * @param[in]  *timestamp_us pointer to the clock of the transport
+ * @param[in]  samples samples of every operation
+ * @param[out] *result pointer to a MIFARE_ULTRALIGHT_BENCHMARK_MAX result array
+ * @return     status code
+ *             - 0 success
+ *             - 1 test failed
+ * @note       the handle is linked by the caller, so any transport can be measured,
+ *             the card must use the default password and leave page 4 and counter 2 free
+ */
+uint8_t mifare_ultralight_benchmark_test(mifare_ultralight_handle_t *handle, uint32_t (*timestamp_us)(void), 
+                                         uint32_t samples, mifare_ultralight_benchmark_result_t *result);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
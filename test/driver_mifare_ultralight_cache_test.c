@@ -0,0 +1,297 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_cache_test.c
+ * @brief     driver mifare_ultralight cache test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_cache_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+#include <stdlib.h>
+
+/**
+ * @brief cache test definition
+ */
+#define MIFARE_ULTRALIGHT_CACHE_TEST_SIZE        64        /**< cache slots */
+
+static mifare_ultralight_handle_t gs_handle;                                         /**< mifare_ultralight handle */
+static mifare_ultralight_signature_key_t gs_key;                                     /**< signature key */
+static mifare_ultralight_signature_key_t gs_other;                                   /**< another signature key */
+static mifare_ultralight_cache_entry_t gs_entry[MIFARE_ULTRALIGHT_CACHE_TEST_SIZE];  /**< cache entries */
+static mifare_ultralight_cache_t gs_cache;                                           /**< cache */
+static mifare_ultralight_cache_verdict_t gs_verdict;                                 /**< verdict of the card */
+static const uint8_t gs_other_public_key[33] =                                       /**< secp128r1 base point as a public key */
+{
+    0x04,
+    0x16, 0x1F, 0xF7, 0x52, 0x8B, 0x89, 0x9B, 0x2D, 0x0C, 0x28, 0x60, 0x7C, 0xA5, 0x2C, 0x5B, 0x86,
+    0xCF, 0x5A, 0xC8, 0x39, 0x5B, 0xAF, 0xEB, 0x13, 0xC0, 0x2D, 0xA2, 0x92, 0xDD, 0xED, 0x7A, 0x83,
+};
+
+/**
+ * @brief     tap the card
+ * @param[in] *name pointer to a case name
+ * @param[in] *key pointer to a signature key structure
+ * @param[in] expect_verdict expected activation verdict
+ * @param[in] expect_key expected key id of the activation verdict
+ * @param[in] expect_frame expected frame number
+ * @return    status code
+ *            - 0 success
+ *            - 1 tap failed
+ * @note      the card is halted, woken up, activated and its signature is checked,
+ *            the verdict of the check is kept in gs_verdict
+ */
+static uint8_t a_cache_test_tap(const char *name, mifare_ultralight_signature_key_t *key, 
+                                mifare_ultralight_cache_verdict_t expect_verdict, uint32_t expect_key, uint32_t expect_frame)
+{
+    uint8_t res;
+    mifare_ultralight_bool_t valid;
+    mifare_ultralight_activation_t activation;
+    
+    /* leave and enter the field */
+    (void)mifare_ultralight_halt(&gs_handle);
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s activate failed.\n", name);
+        
+        return 1;
+    }
+    if ((activation.verdict != expect_verdict) || (activation.key != expect_key))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s verdict is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    /* check the signature */
+    res = mifare_ultralight_signature_check(&gs_handle, key, &valid);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s signature check failed.\n", name);
+        
+        return 1;
+    }
+    gs_verdict = (valid == MIFARE_ULTRALIGHT_BOOL_TRUE) ? MIFARE_ULTRALIGHT_CACHE_VERDICT_GENUINE : 
+                  MIFARE_ULTRALIGHT_CACHE_VERDICT_NOT_GENUINE;
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s verdict %d.\n", name, activation.verdict);
+    if (mifare_ultralight_test_helper_check(name, res, 0, expect_frame) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  cache test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   frames are counted between the driver and mifare_ultralight_interface_contactless_transceiver
+ */
+uint8_t mifare_ultralight_cache_test(void)
+{
+    uint8_t res;
+    uint8_t storage;
+    uint8_t uid[7];
+    uint16_t i;
+    uint32_t n;
+    mifare_ultralight_cache_verdict_t verdict;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start cache test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start cache test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(NULL);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    res = mifare_ultralight_signature_init(&gs_key, NULL);
+    if (res == 0)
+    {
+        res = mifare_ultralight_signature_init(&gs_other, gs_other_public_key);
+    }
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: signature init failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* attach the cache */
+    gs_cache.entry = gs_entry;
+    gs_cache.size = 48;
+    if (mifare_ultralight_set_cache(&gs_handle, &gs_cache) != 4)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: invalid size check failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_cache.size = MIFARE_ULTRALIGHT_CACHE_TEST_SIZE;
+    res = mifare_ultralight_set_cache(&gs_handle, &gs_cache);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set cache failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the first tap runs wake up, select, read page 0, get version and read signature */
+    if (a_cache_test_tap("first tap", &gs_key, MIFARE_ULTRALIGHT_CACHE_VERDICT_UNKNOWN, 0, 8) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a repeat tap skips get version, read signature and the verify */
+    if (a_cache_test_tap("repeat tap", &gs_key, gs_verdict, gs_key.id, 6) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if ((gs_cache.hits != 1) || (gs_cache.misses != 1) || (gs_cache.inserts != 1))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: hit counters are wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* fill the cache far past its budget */
+    srand(22);
+    for (n = 0; n < 1000; n++)
+    {
+        for (i = 0; i < 7; i++)
+        {
+            uid[i] = (uint8_t)(rand() % 256);
+        }
+        (void)mifare_ultralight_cache_set_verdict(&gs_handle, uid, gs_key.id, MIFARE_ULTRALIGHT_CACHE_VERDICT_GENUINE);
+        if ((n % 4) == 0)
+        {
+            /* a commuter taps the card again */
+            (void)mifare_ultralight_cache_lookup(&gs_handle, gs_handle.uid, gs_key.id, &storage, &verdict);
+        }
+        if (gs_cache.count > MIFARE_ULTRALIGHT_CACHE_TEST_SIZE - MIFARE_ULTRALIGHT_CACHE_TEST_SIZE / 4)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: cache is over the budget.\n");
+            (void)mifare_ultralight_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* every kept entry can still be found after the evictions */
+    for (i = 0; i < MIFARE_ULTRALIGHT_CACHE_TEST_SIZE; i++)
+    {
+        if (((gs_entry[i].flag & 0x01) != 0) && 
+            (mifare_ultralight_cache_lookup(&gs_handle, gs_entry[i].uid, gs_key.id, &storage, &verdict) != 0))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: entry %d is lost.\n", i);
+            (void)mifare_ultralight_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* the referenced card survived the clock sweeps */
+    res = mifare_ultralight_cache_lookup(&gs_handle, gs_handle.uid, gs_key.id, &storage, &verdict);
+    if ((res != 0) || (storage != gs_handle.end_page) || (verdict != gs_verdict))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: referenced entry is evicted.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %d entries, %d inserts, %d evictions.\n", 
+                                            gs_cache.count, (int)gs_cache.inserts, (int)gs_cache.evictions);
+    
+    /* the card is still a hit */
+    if (a_cache_test_tap("last tap", &gs_key, gs_verdict, gs_key.id, 6) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the verdict of another key is unknown */
+    res = mifare_ultralight_cache_lookup(&gs_handle, gs_handle.uid, gs_other.id, &storage, &verdict);
+    if ((res != 0) || (storage != gs_handle.end_page) || (verdict != MIFARE_ULTRALIGHT_CACHE_VERDICT_UNKNOWN))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: verdict of another key is used.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a check with another key reads the signature again and keeps its own verdict */
+    if (a_cache_test_tap("other key tap", &gs_other, gs_verdict, gs_key.id, 7) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (a_cache_test_tap("key back tap", &gs_key, gs_verdict, gs_other.id, 7) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: hit rate %d/%d.\n", 
+                                            (int)gs_cache.hits, (int)(gs_cache.hits + gs_cache.misses));
+    
+    /* finish cache test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish cache test.\n");
+    (void)mifare_ultralight_set_cache(&gs_handle, NULL);
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
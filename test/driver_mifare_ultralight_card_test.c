@@ -78,6 +78,7 @@ uint8_t mifare_ultralight_card_test(void)
     DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
     DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_interface_contactless_transceiver);
     DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
     DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
     
     /* get information */
@@ -166,11 +167,11 @@ uint8_t mifare_ultralight_card_test(void)
         return 1;
     }
     
-    /* anti collision cl2 */
-    res = mifare_ultralight_anticollision_cl2(&gs_handle, id);
+    /* select cl2 */
+    res = mifare_ultralight_select_cl2(&gs_handle, id);
     if (res != 0)
     {
-        mifare_ultralight_interface_debug_print("mifare_ultralight: anti collision cl2 failed.\n");
+        mifare_ultralight_interface_debug_print("mifare_ultralight: select cl2 failed.\n");
         (void)mifare_ultralight_deinit(&gs_handle);
         
         return 1;
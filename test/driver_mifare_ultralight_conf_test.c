@@ -0,0 +1,204 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_conf_test.c
+ * @brief     driver mifare_ultralight conf test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_mifare_ultralight_conf_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+
+static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
+
+/**
+ * @brief     check a conf case
+ * @param[in] *name pointer to a case name
+ * @param[in] res result of the case
+ * @param[in] expect_frame expected frame number
+ * @param[in] expect_auth0 expected auth0 of the card
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      auth0 is read from the card page, not from the shadow
+ */
+static uint8_t a_conf_test_check(const char *name, uint8_t res, uint32_t expect_frame, uint8_t expect_auth0)
+{
+    uint8_t data[4];
+    mifare_ultralight_storage_t storage;
+    
+    /* check the result */
+    if (mifare_ultralight_test_helper_check(name, res, 0, expect_frame) != 0)
+    {
+        return 1;
+    }
+    
+    /* read the card */
+    if ((mifare_ultralight_get_storage(&gs_handle, &storage) != 0) || 
+        (mifare_ultralight_read_page(&gs_handle, (uint8_t)(storage - 3), data) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s read cfg0 failed.\n", name);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s auth0 0x%02X.\n", name, data[3]);
+    if (data[3] != expect_auth0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s auth0 is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  conf test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the protect start page of the card is set back to the default at the end
+ */
+uint8_t mifare_ultralight_conf_test(void)
+{
+    uint8_t res;
+    uint8_t page;
+    uint8_t data[4];
+    mifare_ultralight_storage_t storage;
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start conf test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start conf test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(NULL);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = mifare_ultralight_get_storage(&gs_handle, &storage);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: get storage failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a transaction loads each page once and writes each dirty page once */
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_conf_begin(&gs_handle);
+    res |= mifare_ultralight_set_protect_start_page(&gs_handle, 0x80);
+    res |= mifare_ultralight_set_access(&gs_handle, MIFARE_ULTRALIGHT_ACCESS_READ_PROTECTION, MIFARE_ULTRALIGHT_BOOL_FALSE);
+    res |= mifare_ultralight_set_protect_start_page(&gs_handle, 0x90);
+    if (a_conf_test_check("transaction setters", res, 2, 0xFF) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_conf_commit(&gs_handle);
+    if (a_conf_test_check("commit", res, 2, 0x90) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* an abort leaves the card and reloads the dropped page */
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_conf_begin(&gs_handle);
+    res |= mifare_ultralight_set_protect_start_page(&gs_handle, 0xA0);
+    res |= mifare_ultralight_conf_abort(&gs_handle);
+    res |= mifare_ultralight_get_protect_start_page(&gs_handle, &page);
+    if ((a_conf_test_check("abort", res, 1, 0x90) != 0) || (page != 0x90))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: abort shadow is 0x%02X.\n", page);
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a raw write of cfg0 drops the pending change of cfg0 */
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_conf_begin(&gs_handle);
+    res |= mifare_ultralight_set_protect_start_page(&gs_handle, 0xC0);
+    res |= mifare_ultralight_read_page(&gs_handle, (uint8_t)(storage - 3), data);
+    data[3] = 0xB0;
+    res |= mifare_ultralight_write_page(&gs_handle, (uint8_t)(storage - 3), data);
+    res |= mifare_ultralight_conf_commit(&gs_handle);
+    if (a_conf_test_check("raw write in transaction", res, 2, 0xB0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set back the default protect start page */
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_set_protect_start_page(&gs_handle, 0xFF);
+    if (a_conf_test_check("set back", res, 2, 0xFF) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish conf test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish conf test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
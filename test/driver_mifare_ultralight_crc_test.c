@@ -0,0 +1,168 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_crc_test.c
+ * @brief     driver mifare_ultralight crc test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_crc_test.h"
+#include <stdlib.h>
+#include <time.h>
+
+/**
+ * @brief crc test frame definition
+ */
+#define MIFARE_ULTRALIGHT_CRC_TEST_FRAME_LEN        60        /**< fast read 15 pages response */
+
+/**
+ * @brief     reference bit serial crc
+ * @param[in] *p pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc
+ * @note      this is the original small footprint routine and is used as the reference
+ */
+static uint16_t a_crc_reference(const uint8_t *p, uint16_t len)
+{
+    uint32_t w_crc = 0x6363;
+    
+    while (len != 0)
+    {
+        uint8_t bt;
+        
+        bt = *p++;
+        bt = (bt ^ (uint8_t)(w_crc & 0x00FF));
+        bt = (bt ^ (bt << 4));
+        w_crc = (w_crc >> 8) ^ ((uint32_t) bt << 8) ^ ((uint32_t) bt << 3) ^ ((uint32_t) bt >> 4);
+        len--;
+    }
+    
+    return (uint16_t)w_crc;
+}
+
+/**
+ * @brief     crc test
+ * @param[in] times benchmark rounds
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+uint8_t mifare_ultralight_crc_test(uint32_t times)
+{
+    uint32_t i;
+    uint16_t len;
+    uint16_t crc;
+    uint16_t crc_check;
+    volatile uint16_t sink;
+    uint8_t out[2];
+    uint8_t buf[MIFARE_ULTRALIGHT_CRC_TEST_FRAME_LEN];
+    clock_t start;
+    double engine_s;
+    double reference_s;
+    const uint8_t halt[2] = {0x50, 0x00};
+    const uint8_t get_version[1] = {0x60};
+    
+    /* start crc test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start crc test.\n");
+    mifare_ultralight_interface_debug_print("mifare_ultralight: crc engine is %d.\n", MIFARE_ULTRALIGHT_CRC_ENGINE);
+    
+    /* known frames */
+    mifare_ultralight_crc_final(mifare_ultralight_crc_update(mifare_ultralight_crc_init(), halt, 2), out);
+    if ((out[0] != 0x57) || (out[1] != 0xCD))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: halt crc check failed.\n");
+        
+        return 1;
+    }
+    mifare_ultralight_crc_final(mifare_ultralight_crc_update(mifare_ultralight_crc_init(), get_version, 1), out);
+    if ((out[0] != 0xF8) || (out[1] != 0x32))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: get version crc check failed.\n");
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: known frames check ok.\n");
+    
+    /* random frames and split updates */
+    for (i = 0; i < 1000; i++)
+    {
+        uint16_t split;
+        
+        len = (uint16_t)(rand() % MIFARE_ULTRALIGHT_CRC_TEST_FRAME_LEN + 1);
+        for (split = 0; split < len; split++)
+        {
+            buf[split] = (uint8_t)(rand() % 256);
+        }
+        split = (uint16_t)(rand() % (len + 1));
+        crc = mifare_ultralight_crc_update(mifare_ultralight_crc_init(), buf, split);
+        crc = mifare_ultralight_crc_update(crc, buf + split, (uint16_t)(len - split));
+        crc_check = a_crc_reference(buf, len);
+        if (crc != crc_check)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: crc check failed at len %d.\n", len);
+            
+            return 1;
+        }
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: random frames check ok.\n");
+    
+    /* benchmark */
+    for (i = 0; i < MIFARE_ULTRALIGHT_CRC_TEST_FRAME_LEN; i++)
+    {
+        buf[i] = (uint8_t)(rand() % 256);
+    }
+    start = clock();
+    for (i = 0; i < times; i++)
+    {
+        sink = mifare_ultralight_crc_update(mifare_ultralight_crc_init(), buf, MIFARE_ULTRALIGHT_CRC_TEST_FRAME_LEN);
+        buf[0] = (uint8_t)sink;
+    }
+    engine_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for (i = 0; i < times; i++)
+    {
+        sink = a_crc_reference(buf, MIFARE_ULTRALIGHT_CRC_TEST_FRAME_LEN);
+        buf[0] = (uint8_t)sink;
+    }
+    reference_s = (double)(clock() - start) / CLOCKS_PER_SEC;
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %d frames of %d bytes.\n", times, MIFARE_ULTRALIGHT_CRC_TEST_FRAME_LEN);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: engine %0.3fs, reference %0.3fs.\n", engine_s, reference_s);
+    if (engine_s > 0.0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: speed up %0.2fx.\n", reference_s / engine_s);
+    }
+    
+    /* finish crc test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish crc test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,295 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_diff_test.c
+ * @brief     driver mifare_ultralight diff test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_diff_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+
+static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
+
+/**
+ * @brief     run a write diff case
+ * @param[in] *name pointer to a case name
+ * @param[in] start_page start page
+ * @param[in] stop_page stop page
+ * @param[in] *image pointer to an image buffer
+ * @param[in] *mask pointer to a mask buffer
+ * @param[in] allow bitwise or of mifare_ultralight_write_allow_t
+ * @param[in] expect_res expected result
+ * @param[in] expect_frame expected frame number
+ * @param[in] expect_written expected written pages
+ * @return    status code
+ *            - 0 success
+ *            - 1 case failed
+ * @note      none
+ */
+static uint8_t a_diff_test_case(const char *name, uint8_t start_page, uint8_t stop_page, uint8_t *image, uint8_t *mask,
+                                uint8_t allow, uint8_t expect_res, uint32_t expect_frame, uint8_t expect_written)
+{
+    uint8_t res;
+    uint8_t written;
+    
+    /* write the diff */
+    mifare_ultralight_test_helper_start();
+    written = 0;
+    res = mifare_ultralight_write_diff(&gs_handle, start_page, stop_page, image, mask, allow, &written);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s written %d.\n", name, written);
+    
+    /* check the result */
+    if (mifare_ultralight_test_helper_check(name, res, expect_res, expect_frame) != 0)
+    {
+        return 1;
+    }
+    if (written != expect_written)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s written pages are wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check the user pages
+ * @param[in] *name pointer to a case name
+ * @param[in] *expect pointer to the expected content of pages 4 to 7
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_diff_test_check(const char *name, uint8_t expect[16])
+{
+    uint8_t i;
+    uint8_t data[16];
+    
+    /* read pages 4 to 7 */
+    if (mifare_ultralight_read_four_pages(&gs_handle, 4, data) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s read failed.\n", name);
+        
+        return 1;
+    }
+    for (i = 0; i < 16; i++)
+    {
+        if (data[i] != expect[i])
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: %s byte %d is 0x%02X.\n", name, i, data[i]);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     diff test
+ * @param[in] lock run the case that sets the lock bit of page 4
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      user pages 4 to 7 are overwritten, the lock case can't be undone on a real card
+ */
+uint8_t mifare_ultralight_diff_test(mifare_ultralight_bool_t lock)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t zero[16];
+    uint8_t image[16];
+    uint8_t mask[16];
+    uint8_t expect[16];
+    mifare_ultralight_storage_t storage;
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start diff test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start diff test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(NULL);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = mifare_ultralight_get_storage(&gs_handle, &storage);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: get storage failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* clear the user pages */
+    memset(zero, 0, 16);
+    for (i = 0; i < 4; i++)
+    {
+        res = mifare_ultralight_write_page(&gs_handle, (uint8_t)(4 + i), zero + 4 * i);
+        if (res != 0)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: write page failed.\n");
+            (void)mifare_ultralight_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* every changed page is written after one read */
+    for (i = 0; i < 16; i++)
+    {
+        image[i] = (uint8_t)(0xA0 + i);
+    }
+    memset(mask, 0xFF, 16);
+    if ((a_diff_test_case("write all", 4, 7, image, mask, MIFARE_ULTRALIGHT_WRITE_ALLOW_NONE, 0, 5, 4) != 0) ||
+        (a_diff_test_check("write all", image) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the same image only reads */
+    if (a_diff_test_case("same image", 4, 7, image, mask, MIFARE_ULTRALIGHT_WRITE_ALLOW_NONE, 0, 1, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* one masked byte writes its page and keeps the other bytes */
+    memset(mask, 0, 16);
+    mask[9] = 0x0F;
+    image[9] = 0x55;
+    memcpy(expect, image, 16);
+    expect[9] = 0xA5;
+    if ((a_diff_test_case("one masked byte", 4, 7, image, mask, MIFARE_ULTRALIGHT_WRITE_ALLOW_NONE, 0, 2, 1) != 0) ||
+        (a_diff_test_check("one masked byte", expect) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* an empty mask sends no frame */
+    memset(mask, 0, 16);
+    if (a_diff_test_case("empty mask", 4, 7, image, mask, MIFARE_ULTRALIGHT_WRITE_ALLOW_NONE, 0, 0, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the uid pages are refused before any frame */
+    memset(mask, 0xFF, 16);
+    if (a_diff_test_case("uid page", 0, 3, image, mask, MIFARE_ULTRALIGHT_WRITE_ALLOW_NONE, 6, 0, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the configuration pages need the allow flag */
+    if (a_diff_test_case("conf page", (uint8_t)(storage - 1), (uint8_t)(storage - 1), image, mask, 
+                         MIFARE_ULTRALIGHT_WRITE_ALLOW_NONE, 6, 0, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the pwd page can't be read back and is always written */
+    memset(image, 0xFF, 16);
+    if (a_diff_test_case("pwd page", (uint8_t)(storage - 1), (uint8_t)(storage - 1), image, mask, 
+                         MIFARE_ULTRALIGHT_WRITE_ALLOW_CONF, 0, 1, 1) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a lock bit and the page it locks are written in one image, the page goes first */
+    if (lock == MIFARE_ULTRALIGHT_BOOL_TRUE)
+    {
+        memset(image, 0, 16);
+        memset(mask, 0, 16);
+        image[2] = 0x10;
+        mask[2] = 0x10;
+        memset(image + 8, 0x5A, 4);
+        memset(mask + 8, 0xFF, 4);
+        if (a_diff_test_case("lock and page", 2, 4, image, mask, MIFARE_ULTRALIGHT_WRITE_ALLOW_LOCK, 0, 3, 2) != 0)
+        {
+            (void)mifare_ultralight_deinit(&gs_handle);
+            
+            return 1;
+        }
+        res = mifare_ultralight_read_page(&gs_handle, 4, expect);
+        if ((res != 0) || (memcmp(expect, image + 8, 4) != 0))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: locked page content is wrong.\n");
+            (void)mifare_ultralight_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* finish diff test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish diff test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
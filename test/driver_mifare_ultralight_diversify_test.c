@@ -0,0 +1,295 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_diversify_test.c
+ * @brief     driver mifare_ultralight diversify test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_diversify_test.h"
+
+/**
+ * @brief diversify test definition
+ */
+#define MIFARE_ULTRALIGHT_DIVERSIFY_TEST_BATCH        19        /**< batch size */
+
+static mifare_ultralight_handle_t gs_handle;                                         /**< mifare_ultralight handle */
+static mifare_ultralight_diversify_key_t gs_key;                                     /**< diversify key */
+static uint8_t gs_uid[MIFARE_ULTRALIGHT_DIVERSIFY_TEST_BATCH][7];                    /**< batch uids */
+static uint8_t gs_pwd[MIFARE_ULTRALIGHT_DIVERSIFY_TEST_BATCH][4];                    /**< batch passwords */
+static uint8_t gs_pack[MIFARE_ULTRALIGHT_DIVERSIFY_TEST_BATCH][2];                   /**< batch packs */
+
+/**
+ * @brief diversify test master key
+ */
+static const uint8_t gs_master[16] =
+{
+    0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C,
+};
+
+/**
+ * @brief diversify test system identifier
+ */
+static const uint8_t gs_system[8] = {'L', 'i', 'b', 'D', 'r', 'v', '0', '1'};
+
+/**
+ * @brief diversify test vector structure definition
+ */
+typedef struct diversify_test_vector_s
+{
+    uint8_t system_len;        /**< system identifier length */
+    uint8_t uid[7];            /**< uid */
+    uint8_t pwd[4];            /**< expected password */
+    uint8_t pack[2];           /**< expected pack */
+} diversify_test_vector_t;
+
+/**
+ * @brief diversify test vectors, aes-cmac(master, 0x01 || uid || system) truncated to 6 bytes
+ */
+static const diversify_test_vector_t gs_vector[4] =
+{
+    {0, {0x04, 0x0F, 0x1A, 0x25, 0x30, 0x3B, 0x46}, {0x3A, 0x5E, 0xA2, 0x9A}, {0x2F, 0x91}},
+    {0, {0x29, 0x34, 0x3F, 0x4A, 0x55, 0x60, 0x6B}, {0x9C, 0x0F, 0xFF, 0x23}, {0x41, 0x53}},
+    {8, {0x04, 0x0F, 0x1A, 0x25, 0x30, 0x3B, 0x46}, {0x73, 0x45, 0xA2, 0xFA}, {0x22, 0x34}},
+    {8, {0x4E, 0x59, 0x64, 0x6F, 0x7A, 0x85, 0x90}, {0x68, 0x95, 0x30, 0x08}, {0xF2, 0x12}},
+};
+
+/**
+ * @brief     select the card again
+ * @return    status code
+ *            - 0 success
+ *            - 1 activate failed
+ * @note      none
+ */
+static uint8_t a_diversify_test_activate(void)
+{
+    mifare_ultralight_activation_t activation;
+    
+    (void)mifare_ultralight_halt(&gs_handle);
+    if (mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  diversify test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the password and the pack of the card are set back to 0xFFFFFFFF and 0x0000 at the end
+ */
+uint8_t mifare_ultralight_diversify_test(void)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t j;
+    uint8_t pwd[4];
+    uint8_t pack[2];
+    uint8_t uid[7];
+    uint8_t number[7];
+    mifare_ultralight_diversify_key_t other;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_interface_contactless_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start diversify test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start diversify test.\n");
+    
+    /* the system identifier is limited to one block */
+    if (mifare_ultralight_diversify_init(&gs_key, gs_master, gs_system, 9) != 4)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: system length check failed.\n");
+        
+        return 1;
+    }
+    
+    /* known answers */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: check known answers.\n");
+    for (i = 0; i < 4; i++)
+    {
+        res = mifare_ultralight_diversify_init(&gs_key, gs_master, gs_system, gs_vector[i].system_len);
+        if (res != 0)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: diversify init failed.\n");
+            
+            return 1;
+        }
+        res = mifare_ultralight_diversify(&gs_key, gs_vector[i].uid, pwd, pack);
+        if ((res != 0) || (memcmp(pwd, gs_vector[i].pwd, 4) != 0) || (memcmp(pack, gs_vector[i].pack, 2) != 0))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: vector %d is wrong.\n", i);
+            
+            return 1;
+        }
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: check known answers ok.\n");
+    
+    /* the batch matches the single derivation */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: check batch of %d.\n", MIFARE_ULTRALIGHT_DIVERSIFY_TEST_BATCH);
+    for (i = 0; i < MIFARE_ULTRALIGHT_DIVERSIFY_TEST_BATCH; i++)
+    {
+        for (j = 0; j < 7; j++)
+        {
+            gs_uid[i][j] = (uint8_t)(0x04 + i * 37 + j * 11);
+        }
+    }
+    res = mifare_ultralight_diversify_batch(&gs_key, (const uint8_t (*)[7])gs_uid, MIFARE_ULTRALIGHT_DIVERSIFY_TEST_BATCH, gs_pwd, gs_pack);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: diversify batch failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < MIFARE_ULTRALIGHT_DIVERSIFY_TEST_BATCH; i++)
+    {
+        (void)mifare_ultralight_diversify(&gs_key, gs_uid[i], pwd, pack);
+        if ((memcmp(pwd, gs_pwd[i], 4) != 0) || (memcmp(pack, gs_pack[i], 2) != 0))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: batch entry %d is wrong.\n", i);
+            
+            return 1;
+        }
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: check batch ok.\n");
+    
+    /* init */
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    if (a_diversify_test_activate() != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the uid of the select is the serial number */
+    if ((mifare_ultralight_get_uid(&gs_handle, uid) != 0) || 
+        (mifare_ultralight_get_serial_number(&gs_handle, number) != 0) || 
+        (memcmp(uid, number, 7) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: check uid error.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: check uid ok.\n");
+    
+    /* provision the card */
+    res = mifare_ultralight_diversify_provision(&gs_handle, &gs_key);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: diversify provision failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the card accepts its own password */
+    if (a_diversify_test_activate() != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = mifare_ultralight_diversify_authenticate(&gs_handle, &gs_key);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: diversify authenticate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: check diversified password ok.\n");
+    
+    /* the card rejects the password of another system */
+    res = mifare_ultralight_diversify_init(&other, gs_master, gs_system, 4);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: diversify init failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (a_diversify_test_activate() != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (mifare_ultralight_diversify_authenticate(&gs_handle, &other) == 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: wrong password is accepted.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: check wrong password ok.\n");
+    
+    /* set back the default password and pack */
+    if (a_diversify_test_activate() != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    memset(pwd, 0xFF, 4);
+    memset(pack, 0x00, 2);
+    if ((mifare_ultralight_set_password(&gs_handle, pwd) != 0) || (mifare_ultralight_set_pack(&gs_handle, pack) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set default password failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish diversify test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish diversify test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_enumerate_test.c
+ * @brief     driver mifare_ultralight enumerate test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_enumerate_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+
+static mifare_ultralight_handle_t gs_handle;                                                   /**< mifare_ultralight handle */
+static uint8_t gs_uid[9][7];                                                                   /**< enumerated uids */
+static uint8_t gs_all[8][7];                                                                   /**< uids of enumerate all */
+
+/**
+ * @brief  switch the field off and on
+ * @return status code
+ *         - 0 success
+ *         - 1 power cycle failed
+ * @note   every tag leaves the halt state
+ */
+static uint8_t a_enumerate_test_power_cycle(void)
+{
+    (void)mifare_ultralight_deinit(&gs_handle);
+    if (mifare_ultralight_init(&gs_handle) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check an enumerate all case
+ * @param[in] *name pointer to a case name
+ * @param[in] max max uid number
+ * @param[in] expect_count expected found tags
+ * @param[in] expect_frame expected frame number
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the field is switched off and on before, the found uids are compared with the ones of the iterator
+ */
+static uint8_t a_enumerate_test_all(const char *name, uint8_t max, uint8_t expect_count, uint32_t expect_frame)
+{
+    uint8_t res;
+    uint8_t count;
+    
+    if (a_enumerate_test_power_cycle() != 0)
+    {
+        return 1;
+    }
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_enumerate_all(&gs_handle, gs_all, max, &count);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s count %d.\n", name, count);
+    if (mifare_ultralight_test_helper_check(name, res, 0, expect_frame) != 0)
+    {
+        return 1;
+    }
+    if (count != expect_count)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s tag number is wrong.\n", name);
+        
+        return 1;
+    }
+    if (memcmp(gs_all, gs_uid, 7 * (size_t)count) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s uid is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     enumerate test
+ * @param[in] tags tag number in the field
+ * @param[in] *transceiver_bits pointer to a contactless_transceiver_bits function, NULL for one tag
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the first found tag is enumerated again at the end
+ */
+uint8_t mifare_ultralight_enumerate_test(uint8_t tags, uint8_t (*transceiver_bits)(uint8_t *in_buf, uint8_t in_bits, uint8_t *out_buf,
+                                                                                   uint8_t *out_bits, uint8_t *collision))
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t j;
+    uint32_t frame[9];
+    uint32_t total;
+    mifare_ultralight_iterator_t iterator;
+    
+    /* check the tags */
+    if ((tags == 0) || (tags > 8) || ((tags > 1) && (transceiver_bits == NULL)))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: tags is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    if (transceiver_bits != NULL)
+    {
+        DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER_BITS(&gs_handle, mifare_ultralight_test_helper_transceiver_bits);
+    }
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start enumerate test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start enumerate test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(transceiver_bits);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* step through the tags */
+    res = mifare_ultralight_enumerate_begin(&gs_handle, &iterator);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: enumerate begin failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    total = 0;
+    for (i = 0; i < 9; i++)
+    {
+        mifare_ultralight_test_helper_start();
+        res = mifare_ultralight_enumerate_next(&gs_handle, &iterator, gs_uid[i]);
+        frame[i] = mifare_ultralight_test_helper_get_frame();
+        total += frame[i];
+        if (res == 4)
+        {
+            break;
+        }
+        if (res != 0)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: enumerate next failed.\n");
+            (void)mifare_ultralight_deinit(&gs_handle);
+            
+            return 1;
+        }
+        mifare_ultralight_interface_debug_print("mifare_ultralight: tag %02X%02X%02X%02X%02X%02X%02X frame %d.\n", 
+                                                gs_uid[i][0], gs_uid[i][1], gs_uid[i][2], gs_uid[i][3], 
+                                                gs_uid[i][4], gs_uid[i][5], gs_uid[i][6], (int)frame[i]);
+    }
+    
+    /* every tag is found once and the last poll is one unanswered request */
+    if ((i != tags) || (iterator.index != tags) || (frame[i] != 1))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %d tags are found, the last poll takes %d frames.\n", 
+                                                i, (int)frame[i]);
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < tags; i++)
+    {
+        for (j = 0; j < i; j++)
+        {
+            if (memcmp(gs_uid[i], gs_uid[j], 7) == 0)
+            {
+                mifare_ultralight_interface_debug_print("mifare_ultralight: tag %d is found twice.\n", i);
+                (void)mifare_ultralight_deinit(&gs_handle);
+                
+                return 1;
+            }
+        }
+    }
+    
+    /* a done iterator sends no frame */
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_enumerate_next(&gs_handle, &iterator, gs_uid[0]);
+    if (mifare_ultralight_test_helper_check("done iterator", res, 4, 0) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: done iterator check failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* enumerate all finds the same tags in the same frames */
+    if (a_enumerate_test_all("enumerate all", 8, tags, total) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a full list stops without the last poll */
+    if (a_enumerate_test_all("enumerate one", 1, 1, frame[0]) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish enumerate test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish enumerate test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
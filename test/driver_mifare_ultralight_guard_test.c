@@ -0,0 +1,272 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_guard_test.c
+ * @brief     driver mifare_ultralight guard test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_guard_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+
+static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
+static uint32_t gs_wait_us;                         /**< waited us */
+static uint32_t gs_wait_ms;                         /**< waited ms */
+
+/**
+ * @brief     delay us with a counter
+ * @param[in] us time
+ * @note      none
+ */
+static void a_guard_test_delay_us(uint32_t us)
+{
+    gs_wait_us += us;
+    
+    mifare_ultralight_interface_delay_us(us);
+}
+
+/**
+ * @brief     delay ms with a counter
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_guard_test_delay_ms(uint32_t ms)
+{
+    gs_wait_ms += ms;
+    
+    mifare_ultralight_interface_delay_ms(ms);
+}
+
+/**
+ * @brief     check a guard case
+ * @param[in] *name pointer to a case name
+ * @param[in] res result of the case
+ * @param[in] expect_res expected result
+ * @param[in] expect_frame expected frame number
+ * @param[in] expect_us expected waited us
+ * @param[in] expect_ms expected waited ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_guard_test_check(const char *name, uint8_t res, uint8_t expect_res, uint32_t expect_frame, 
+                                  uint32_t expect_us, uint32_t expect_ms)
+{
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s wait %dus %dms.\n", name, (int)gs_wait_us, (int)gs_wait_ms);
+    if (mifare_ultralight_test_helper_check(name, res, expect_res, expect_frame) != 0)
+    {
+        return 1;
+    }
+    if ((gs_wait_us != expect_us) || (gs_wait_ms != expect_ms))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s guard time is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  guard test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the guard times are set back to the defaults at the end
+ */
+uint8_t mifare_ultralight_guard_test(void)
+{
+    uint8_t res;
+    uint32_t us[3];
+    mifare_ultralight_type_t type;
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, a_guard_test_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, a_guard_test_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start guard test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start guard test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(NULL);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* check the defaults */
+    res = mifare_ultralight_get_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_WAKE_UP, &us[0]);
+    res |= mifare_ultralight_get_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_REQUEST, &us[1]);
+    res |= mifare_ultralight_get_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_HALT, &us[2]);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: default guard time %d %d %d.\n", 
+                                            (int)us[0], (int)us[1], (int)us[2]);
+    if ((res != 0) || (us[0] != 1000) || (us[1] != 0) || (us[2] != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: default guard time is wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* an invalid guard is refused */
+    if ((mifare_ultralight_set_guard_time(&gs_handle, (mifare_ultralight_guard_time_t)3, 100) != 4) || 
+        (mifare_ultralight_get_guard_time(&gs_handle, (mifare_ultralight_guard_time_t)3, &us[0]) != 4))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: invalid guard check failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the default halt has no guard time and the default wake up waits 1000us */
+    mifare_ultralight_test_helper_start();
+    gs_wait_us = 0;
+    gs_wait_ms = 0;
+    res = mifare_ultralight_halt(&gs_handle);
+    if (a_guard_test_check("default halt", res, 0, 1, 0, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_wake_up(&gs_handle, &type);
+    if (a_guard_test_check("default wake up", res, 0, 1, 1000, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set and get every guard time */
+    res = mifare_ultralight_set_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_WAKE_UP, 300);
+    res |= mifare_ultralight_set_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_REQUEST, 200);
+    res |= mifare_ultralight_set_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_HALT, 500);
+    res |= mifare_ultralight_get_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_WAKE_UP, &us[0]);
+    res |= mifare_ultralight_get_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_REQUEST, &us[1]);
+    res |= mifare_ultralight_get_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_HALT, &us[2]);
+    if ((res != 0) || (us[0] != 300) || (us[1] != 200) || (us[2] != 500))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set guard time failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* each command waits its own guard time */
+    (void)mifare_ultralight_halt(&gs_handle);
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_test_helper_start();
+    gs_wait_us = 0;
+    res = mifare_ultralight_halt(&gs_handle);
+    if (a_guard_test_check("halt", res, 0, 1, 500, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_test_helper_start();
+    gs_wait_us = 0;
+    res = mifare_ultralight_request(&gs_handle, &type);
+    if (a_guard_test_check("request of a halted card", res, 1, 1, 200, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_test_helper_start();
+    gs_wait_us = 0;
+    res = mifare_ultralight_wake_up(&gs_handle, &type);
+    if (a_guard_test_check("wake up", res, 0, 1, 300, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* without delay_us the guard time is rounded up to ms */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, NULL);
+    (void)mifare_ultralight_set_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_WAKE_UP, 1500);
+    (void)mifare_ultralight_halt(&gs_handle);
+    mifare_ultralight_test_helper_start();
+    gs_wait_us = 0;
+    gs_wait_ms = 0;
+    res = mifare_ultralight_wake_up(&gs_handle, &type);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, a_guard_test_delay_us);
+    if (a_guard_test_check("wake up in ms", res, 0, 1, 0, 2) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a zero guard time doesn't wait */
+    (void)mifare_ultralight_set_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_WAKE_UP, 0);
+    (void)mifare_ultralight_set_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_HALT, 0);
+    (void)mifare_ultralight_halt(&gs_handle);
+    mifare_ultralight_test_helper_start();
+    gs_wait_us = 0;
+    gs_wait_ms = 0;
+    res = mifare_ultralight_wake_up(&gs_handle, &type);
+    if (a_guard_test_check("wake up without guard", res, 0, 1, 0, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set back the default guard times */
+    (void)mifare_ultralight_set_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_WAKE_UP, 1000);
+    (void)mifare_ultralight_set_guard_time(&gs_handle, MIFARE_ULTRALIGHT_GUARD_TIME_REQUEST, 0);
+    
+    /* finish guard test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish guard test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
@@ -0,0 +1,291 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_inventory_test.c
+ * @brief     driver mifare_ultralight inventory test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_mifare_ultralight_inventory_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+
+static mifare_ultralight_handle_t gs_handle;                                                   /**< mifare_ultralight handle */
+static uint32_t gs_reported;                                                                   /**< reported tags */
+static uint8_t gs_uid[8][7];                                                                   /**< enumerated uids */
+static uint8_t gs_set[8][7];                                                                   /**< uid set */
+static uint8_t gs_window[16];                                                                  /**< read window */
+
+/**
+ * @brief     new tag callback
+ * @param[in] *uid pointer to a uid buffer
+ * @param[in] *data pointer to a window buffer
+ * @param[in] len window length
+ * @note      none
+ */
+static void a_inventory_test_callback(uint8_t uid[7], uint8_t *data, uint16_t len)
+{
+    (void)data;
+    
+    gs_reported++;
+    mifare_ultralight_interface_debug_print("mifare_ultralight: tag %02X%02X%02X%02X%02X%02X%02X len %d.\n", 
+                                            uid[0], uid[1], uid[2], uid[3], uid[4], uid[5], uid[6], len);
+}
+
+/**
+ * @brief  switch the field off and on
+ * @return status code
+ *         - 0 success
+ *         - 1 power cycle failed
+ * @note   every tag leaves the halt state
+ */
+static uint8_t a_inventory_test_power_cycle(void)
+{
+    (void)mifare_ultralight_deinit(&gs_handle);
+    if (mifare_ultralight_init(&gs_handle) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     select a tag by its uid
+ * @param[in] *uid pointer to a uid buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      the other tags are halted before
+ */
+static uint8_t a_inventory_test_select(uint8_t uid[7])
+{
+    mifare_ultralight_activation_t activation;
+    
+    memcpy(activation.uid, uid, 7);
+    if (mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP | 
+                                   MIFARE_ULTRALIGHT_ACTIVATE_POLICY_KNOWN_UID, &activation) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: select failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief         run one inventory cycle
+ * @param[in]     *name pointer to a case name
+ * @param[in,out] *inventory pointer to an inventory structure
+ * @param[in]     expect_new expected new tags of the session
+ * @param[in]     expect_duplicate expected duplicate tags of the session
+ * @param[in]     expect_error expected errors of the session
+ * @param[in]     expect_frame expected frame number
+ * @return        status code
+ *                - 0 success
+ *                - 1 run failed
+ * @note          the reported tags must match the new tags
+ */
+static uint8_t a_inventory_test_cycle(const char *name, mifare_ultralight_inventory_t *inventory, uint32_t expect_new,
+                                      uint32_t expect_duplicate, uint32_t expect_error, uint32_t expect_frame)
+{
+    uint8_t res;
+    
+    /* run the cycle */
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_inventory_cycle(&gs_handle, inventory);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s new %d duplicate %d error %d set %d.\n", 
+                                            name, (int)inventory->new_tags, (int)inventory->duplicate_tags, 
+                                            (int)inventory->errors, inventory->set_count);
+    
+    /* check the result */
+    if (mifare_ultralight_test_helper_check(name, res, 0, expect_frame) != 0)
+    {
+        return 1;
+    }
+    if ((inventory->new_tags != expect_new) || (gs_reported != expect_new) || 
+        (inventory->duplicate_tags != expect_duplicate) || (inventory->errors != expect_error))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s tag number is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     inventory test
+ * @param[in] tags tag number in the field
+ * @param[in] *transceiver_bits pointer to a contactless_transceiver_bits function, NULL for one tag
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the last enumerated tag is read protected during the test and set back at the end
+ */
+uint8_t mifare_ultralight_inventory_test(uint8_t tags, uint8_t (*transceiver_bits)(uint8_t *in_buf, uint8_t in_bits, uint8_t *out_buf,
+                                                                                   uint8_t *out_bits, uint8_t *collision))
+{
+    uint8_t res;
+    uint8_t count;
+    uint32_t enumerate_frame;
+    uint8_t pwd_default[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t pack_default[2] = {0x00, 0x00};
+    mifare_ultralight_inventory_t inventory;
+    
+    /* check the tags */
+    if ((tags == 0) || (tags > 8) || ((tags > 1) && (transceiver_bits == NULL)))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: tags is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    if (transceiver_bits != NULL)
+    {
+        DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER_BITS(&gs_handle, mifare_ultralight_test_helper_transceiver_bits);
+    }
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start inventory test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start inventory test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(transceiver_bits);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* find the tags */
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_enumerate_all(&gs_handle, gs_uid, 8, &count);
+    enumerate_frame = mifare_ultralight_test_helper_get_frame();
+    if ((res != 0) || (count != tags))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: enumerate all failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: find %d tags in %d frames.\n", count, (int)enumerate_frame);
+    
+    /* read protect the last tag */
+    if ((a_inventory_test_select(gs_uid[tags - 1]) != 0) || 
+        (mifare_ultralight_set_access(&gs_handle, MIFARE_ULTRALIGHT_ACCESS_READ_PROTECTION, MIFARE_ULTRALIGHT_BOOL_TRUE) != 0) || 
+        (mifare_ultralight_set_protect_start_page(&gs_handle, 0x04) != 0) || 
+        (a_inventory_test_power_cycle() != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: protect failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: read protect the last tag from page 4.\n");
+    
+    /* begin the session */
+    inventory.set = gs_set;
+    inventory.set_size = 8;
+    inventory.start_page = 0x04;
+    inventory.stop_page = 0x07;
+    inventory.data = gs_window;
+    inventory.data_len = sizeof(gs_window);
+    inventory.callback = a_inventory_test_callback;
+    res = mifare_ultralight_inventory_begin(&gs_handle, &inventory);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: inventory begin failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_reported = 0;
+    
+    /* every tag is seen once and the protected one is kept as an error, */
+    /* a window costs one frame and the refused one 13 frames to narrow and reselect */
+    if ((a_inventory_test_cycle("first cycle", &inventory, tags - 1, 0, 1, enumerate_frame + tags - 1 + 13) != 0) || 
+        (inventory.set_count != tags))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the halted tags stay silent */
+    if (a_inventory_test_cycle("second cycle", &inventory, tags - 1, 0, 1, 1) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the returning tags are halted again without a read */
+    if ((a_inventory_test_power_cycle() != 0) || 
+        (a_inventory_test_cycle("returning tags", &inventory, tags - 1, tags, 1, enumerate_frame) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set back the default protection */
+    if ((a_inventory_test_select(gs_uid[tags - 1]) != 0) || 
+        (mifare_ultralight_authenticate(&gs_handle, pwd_default, pack_default) != 0) || 
+        (mifare_ultralight_set_protect_start_page(&gs_handle, 0xFF) != 0) || 
+        (mifare_ultralight_set_access(&gs_handle, MIFARE_ULTRALIGHT_ACCESS_READ_PROTECTION, MIFARE_ULTRALIGHT_BOOL_FALSE) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set back the protection failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: set back the default protection.\n");
+    
+    /* finish inventory test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish inventory test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
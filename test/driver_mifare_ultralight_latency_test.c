@@ -0,0 +1,266 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_latency_test.c
+ * @brief     driver mifare_ultralight latency test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_latency_test.h"
+
+/**
+ * @brief latency test api enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_LATENCY_HALT = 0,          /**< halt */
+    MIFARE_ULTRALIGHT_LATENCY_ACTIVATE,          /**< wake up, anti collision and select */
+    MIFARE_ULTRALIGHT_LATENCY_GET_VERSION,       /**< get version */
+    MIFARE_ULTRALIGHT_LATENCY_READ_PAGE,         /**< read page */
+    MIFARE_ULTRALIGHT_LATENCY_READ_FOUR_PAGES,   /**< read four pages */
+    MIFARE_ULTRALIGHT_LATENCY_FAST_READ_1,       /**< fast read 1 page */
+    MIFARE_ULTRALIGHT_LATENCY_FAST_READ_4,       /**< fast read 4 pages */
+    MIFARE_ULTRALIGHT_LATENCY_FAST_READ_15,      /**< fast read 15 pages */
+    MIFARE_ULTRALIGHT_LATENCY_READ_SIGNATURE,    /**< read signature */
+    MIFARE_ULTRALIGHT_LATENCY_READ_COUNTER,      /**< read counter */
+    MIFARE_ULTRALIGHT_LATENCY_INCREMENT_COUNTER, /**< increment counter */
+    MIFARE_ULTRALIGHT_LATENCY_WRITE_PAGE,        /**< write page */
+    MIFARE_ULTRALIGHT_LATENCY_AUTHENTICATE,      /**< authenticate */
+    MIFARE_ULTRALIGHT_LATENCY_MAX,               /**< api number */
+} mifare_ultralight_latency_api_t;
+
+static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
+static const char *const gs_api_name[MIFARE_ULTRALIGHT_LATENCY_MAX] =
+{
+    "halt",
+    "activate",
+    "get_version",
+    "read_page",
+    "read_four_pages",
+    "fast_read_page 1",
+    "fast_read_page 4",
+    "fast_read_page 15",
+    "read_signature",
+    "read_counter",
+    "increment_counter",
+    "write_page",
+    "authenticate",
+};                                                  /**< api names */
+
+/**
+ * @brief     run one api call
+ * @param[in] api api index
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      halt and activate are always run as a pair
+ */
+static uint8_t a_latency_run(mifare_ultralight_latency_api_t api)
+{
+    uint8_t data[64];
+    uint8_t pwd[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t pack[2] = {0x00, 0x00};
+    uint16_t len;
+    uint32_t cnt;
+    mifare_ultralight_version_t version;
+    mifare_ultralight_activation_t activation;
+    
+    len = sizeof(data);
+    switch (api)
+    {
+        case MIFARE_ULTRALIGHT_LATENCY_HALT :
+        {
+            return (mifare_ultralight_halt(&gs_handle) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_ACTIVATE :
+        {
+            return (mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP | 
+                                               MIFARE_ULTRALIGHT_ACTIVATE_POLICY_SKIP_READ_PAGE0 | 
+                                               MIFARE_ULTRALIGHT_ACTIVATE_POLICY_SKIP_VERSION, &activation) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_GET_VERSION :
+        {
+            return (mifare_ultralight_get_version(&gs_handle, &version) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_READ_PAGE :
+        {
+            return (mifare_ultralight_read_page(&gs_handle, 0x04, data) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_READ_FOUR_PAGES :
+        {
+            return (mifare_ultralight_read_four_pages(&gs_handle, 0x04, data) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_FAST_READ_1 :
+        {
+            return (mifare_ultralight_fast_read_page(&gs_handle, 0x04, 0x04, data, &len) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_FAST_READ_4 :
+        {
+            return (mifare_ultralight_fast_read_page(&gs_handle, 0x04, 0x07, data, &len) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_FAST_READ_15 :
+        {
+            return (mifare_ultralight_fast_read_page(&gs_handle, 0x00, 0x0E, data, &len) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_READ_SIGNATURE :
+        {
+            return (mifare_ultralight_read_signature(&gs_handle, data) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_READ_COUNTER :
+        {
+            return (mifare_ultralight_read_counter(&gs_handle, 0, &cnt) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_INCREMENT_COUNTER :
+        {
+            return (mifare_ultralight_increment_counter(&gs_handle, 0, 1) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_WRITE_PAGE :
+        {
+            data[0] = 0x01;
+            data[1] = 0x02;
+            data[2] = 0x03;
+            data[3] = 0x04;
+            
+            return (mifare_ultralight_write_page(&gs_handle, 0x04, data) != 0) ? 1 : 0;
+        }
+        case MIFARE_ULTRALIGHT_LATENCY_AUTHENTICATE :
+        {
+            return (mifare_ultralight_authenticate(&gs_handle, pwd, pack) != 0) ? 1 : 0;
+        }
+        default :
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief     latency test
+ * @param[in] times rounds of every api call
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the latency is taken from mifare_ultralight_interface_timestamp_us,
+ *            which is the modeled on air time in the emulator
+ */
+uint8_t mifare_ultralight_latency_test(uint32_t times)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t j;
+    uint32_t t;
+    uint32_t sum[MIFARE_ULTRALIGHT_LATENCY_MAX];
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_interface_contactless_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* check the times */
+    if (times == 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: times is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* start latency test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start latency test.\n");
+    
+    /* init */
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: atqa 0x%02X 0x%02X sak 0x%02X.\n", 
+                                            activation.atqa[0], activation.atqa[1], activation.sak);
+    if ((activation.atqa[0] != 0x44) || (activation.atqa[1] != 0x00) || (activation.sak != 0x00))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: atqa or sak is wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* run every api */
+    for (j = 0; j < MIFARE_ULTRALIGHT_LATENCY_MAX; j++)
+    {
+        sum[j] = 0;
+    }
+    for (i = 0; i < times; i++)
+    {
+        for (j = 0; j < MIFARE_ULTRALIGHT_LATENCY_MAX; j++)
+        {
+            t = mifare_ultralight_interface_timestamp_us();
+            res = a_latency_run((mifare_ultralight_latency_api_t)j);
+            if (res != 0)
+            {
+                mifare_ultralight_interface_debug_print("mifare_ultralight: %s failed.\n", gs_api_name[j]);
+                (void)mifare_ultralight_deinit(&gs_handle);
+                
+                return 1;
+            }
+            sum[j] += mifare_ultralight_interface_timestamp_us() - t;
+        }
+    }
+    
+    /* print the latency */
+    for (j = 0; j < MIFARE_ULTRALIGHT_LATENCY_MAX; j++)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s latency is %d us.\n", 
+                                                gs_api_name[j], (int)(sum[j] / times));
+    }
+    
+    /* finish latency test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish latency test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
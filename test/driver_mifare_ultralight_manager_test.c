@@ -0,0 +1,314 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_manager_test.c
+ * @brief     driver mifare_ultralight manager test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_manager_test.h"
+#include "driver_mifare_ultralight_manager.h"
+#include <time.h>
+
+/**
+ * @brief manager test definition
+ */
+#define MIFARE_ULTRALIGHT_MANAGER_TEST_AIRTIME_US        500        /**< simulated airtime of a read frame */
+
+/**
+ * @brief simulated reader structure definition
+ */
+typedef struct mifare_ultralight_sim_reader_s
+{
+    uint8_t index;                /**< reader index */
+    uint8_t mem[20 * 4];          /**< tag memory */
+    uint32_t frames;              /**< frame counter */
+} mifare_ultralight_sim_reader_t;
+
+static mifare_ultralight_sim_reader_t gs_reader[MIFARE_ULTRALIGHT_MANAGER_MAX_READER];        /**< simulated readers */
+static mifare_ultralight_handle_t gs_handle[MIFARE_ULTRALIGHT_MANAGER_MAX_READER];            /**< reader handles */
+
+/**
+ * @brief     sleep the simulated airtime
+ * @param[in] us time
+ * @note      the thread sleeps like a blocking reader driver waiting for the irq
+ */
+static void a_sim_sleep_us(uint32_t us)
+{
+    struct timespec ts;
+    
+    ts.tv_sec = (time_t)(us / 1000000);
+    ts.tv_nsec = (long)(us % 1000000) * 1000;
+    (void)nanosleep(&ts, NULL);
+}
+
+/**
+ * @brief     simulated reader init
+ * @param[in] *user pointer to a simulated reader
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_sim_init(void *user)
+{
+    (void)user;
+    
+    return 0;
+}
+
+/**
+ * @brief     simulated reader deinit
+ * @param[in] *user pointer to a simulated reader
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_sim_deinit(void *user)
+{
+    (void)user;
+    
+    return 0;
+}
+
+/**
+ * @brief         simulated reader transceiver
+ * @param[in]     *user pointer to a simulated reader
+ * @param[in]     *in_buf pointer to an input buffer
+ * @param[in]     in_len input length
+ * @param[out]    *out_buf pointer to an output buffer
+ * @param[in,out] *out_len pointer to an output length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 transceiver failed
+ * @note          only read is answered
+ */
+static uint8_t a_sim_transceiver(void *user, uint8_t *in_buf, uint8_t in_len, uint8_t *out_buf, uint8_t *out_len)
+{
+    mifare_ultralight_sim_reader_t *reader = (mifare_ultralight_sim_reader_t *)user;
+    uint8_t i;
+    
+    a_sim_sleep_us(MIFARE_ULTRALIGHT_MANAGER_TEST_AIRTIME_US);
+    reader->frames++;
+    if ((in_len != 4) || (in_buf[0] != 0x30) || (in_buf[1] >= 20) || (*out_len < 18))
+    {
+        return 1;
+    }
+    for (i = 0; i < 16; i++)
+    {
+        out_buf[i] = reader->mem[((in_buf[1] * 4) + i) % (20 * 4)];
+    }
+    mifare_ultralight_crc_final(mifare_ultralight_crc_update(mifare_ultralight_crc_init(), out_buf, 16), out_buf + 16);
+    *out_len = 18;
+    
+    return 0;
+}
+
+/**
+ * @brief     simulated reader delay ms
+ * @param[in] *user pointer to a simulated reader
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_sim_delay_ms(void *user, uint32_t ms)
+{
+    (void)user;
+    
+    a_sim_sleep_us(ms * 1000);
+}
+
+/**
+ * @brief     silent print
+ * @param[in] fmt format data
+ * @note      none
+ */
+static void a_sim_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     read job
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *arg pointer to a page buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 5 data is not from the used reader
+ * @note      none
+ */
+static uint8_t a_read_job(mifare_ultralight_handle_t *handle, void *arg)
+{
+    mifare_ultralight_sim_reader_t *reader = (mifare_ultralight_sim_reader_t *)handle->user;
+    uint8_t *data = (uint8_t *)arg;
+    
+    if (mifare_ultralight_read_four_pages(handle, 4, data) != 0)
+    {
+        return 1;
+    }
+    if (data[0] != reader->mem[16])
+    {
+        return 5;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  get the wall time
+ * @return time in seconds
+ * @note   none
+ */
+static double a_wall_time(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief     manager test
+ * @param[in] jobs job number of every round
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      the readers are simulated, so no hardware is needed
+ */
+uint8_t mifare_ultralight_manager_test(uint32_t jobs)
+{
+    static mifare_ultralight_manager_job_t job[MIFARE_ULTRALIGHT_MANAGER_QUEUE_LEN];
+    static uint8_t data[MIFARE_ULTRALIGHT_MANAGER_QUEUE_LEN][16];
+    mifare_ultralight_manager_t manager;
+    mifare_ultralight_handle_t *handle[MIFARE_ULTRALIGHT_MANAGER_MAX_READER];
+    uint8_t readers;
+    uint8_t i;
+    uint32_t j;
+    uint32_t k;
+    uint32_t done;
+    uint32_t frames;
+    double start;
+    double s;
+    double base = 0.0;
+    
+    /* start manager test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start manager test.\n");
+    mifare_ultralight_interface_debug_print("mifare_ultralight: simulated airtime is %d us per frame.\n", 
+                                            MIFARE_ULTRALIGHT_MANAGER_TEST_AIRTIME_US);
+    
+    for (readers = 1; readers <= MIFARE_ULTRALIGHT_MANAGER_MAX_READER; readers = (uint8_t)(readers * 2))
+    {
+        /* link the simulated readers */
+        for (i = 0; i < readers; i++)
+        {
+            gs_reader[i].index = i;
+            gs_reader[i].frames = 0;
+            for (k = 0; k < sizeof(gs_reader[i].mem); k++)
+            {
+                gs_reader[i].mem[k] = (uint8_t)(i * 16 + k);
+            }
+            DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle[i], mifare_ultralight_handle_t);
+            DRIVER_MIFARE_ULTRALIGHT_LINK_USER(&gs_handle[i], &gs_reader[i]);
+            DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT_CTX(&gs_handle[i], a_sim_init);
+            DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT_CTX(&gs_handle[i], a_sim_deinit);
+            DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER_CTX(&gs_handle[i], a_sim_transceiver);
+            DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS_CTX(&gs_handle[i], a_sim_delay_ms);
+            DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle[i], a_sim_debug_print);
+            handle[i] = &gs_handle[i];
+        }
+        
+        /* one worker per reader */
+        if (mifare_ultralight_manager_init(&manager, handle, readers, readers) != 0)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: manager init failed.\n");
+            
+            return 1;
+        }
+        
+        /* run the jobs in batches of the queue length */
+        start = a_wall_time();
+        for (j = 0; j < jobs; j += k)
+        {
+            done = jobs - j;
+            k = (done > MIFARE_ULTRALIGHT_MANAGER_QUEUE_LEN) ? MIFARE_ULTRALIGHT_MANAGER_QUEUE_LEN : done;
+            for (done = 0; done < k; done++)
+            {
+                job[done].reader = MIFARE_ULTRALIGHT_MANAGER_ANY_READER;
+                job[done].run = a_read_job;
+                job[done].arg = data[done];
+                (void)mifare_ultralight_manager_submit(&manager, &job[done]);
+            }
+            for (done = 0; done < k; done++)
+            {
+                (void)mifare_ultralight_manager_wait(&manager, &job[done]);
+                if ((job[done].res != 0) || (data[done][0] != (uint8_t)(job[done].used_reader * 16 + 16)))
+                {
+                    mifare_ultralight_interface_debug_print("mifare_ultralight: job check failed.\n");
+                    (void)mifare_ultralight_manager_deinit(&manager);
+                    
+                    return 1;
+                }
+            }
+        }
+        s = a_wall_time() - start;
+        (void)mifare_ultralight_manager_deinit(&manager);
+        
+        /* check every reader took part */
+        frames = 0;
+        for (i = 0; i < readers; i++)
+        {
+            if ((jobs >= readers) && (gs_reader[i].frames == 0))
+            {
+                mifare_ultralight_interface_debug_print("mifare_ultralight: reader %d is idle.\n", i);
+                
+                return 1;
+            }
+            frames += gs_reader[i].frames;
+        }
+        if (frames != jobs)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: frame count check failed.\n");
+            
+            return 1;
+        }
+        if (readers == 1)
+        {
+            base = (double)jobs / s;
+        }
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %2d readers %8.1f jobs/s speedup %5.2fx.\n", 
+                                                readers, (double)jobs / s, ((double)jobs / s) / base);
+    }
+    
+    /* finish manager test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish manager test.\n");
+    
+    return 0;
+}
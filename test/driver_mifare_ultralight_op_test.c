@@ -0,0 +1,363 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_op_test.c
+ * @brief     driver mifare_ultralight op test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_mifare_ultralight_op_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+
+static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
+static uint8_t gs_frame_buf[32];                    /**< queued frame */
+static uint8_t gs_frame_len;                        /**< queued frame length, 0 means empty */
+static uint8_t gs_busy;                             /**< submits refused as busy */
+static uint8_t gs_pending;                          /**< polls answered as pending */
+static uint8_t gs_lose;                             /**< the queued frame never reaches the card */
+
+/**
+ * @brief     submit with a frame queue
+ * @param[in] *in_buf pointer to an input buffer
+ * @param[in] in_len input length
+ * @return    status code
+ *            - 0 success
+ *            - 1 submit failed
+ *            - 2 busy
+ * @note      the frame is sent by the next poll
+ */
+static uint8_t a_op_test_submit(uint8_t *in_buf, uint8_t in_len)
+{
+    /* refuse the frame */
+    if (gs_busy != 0)
+    {
+        gs_busy--;
+        
+        return 2;
+    }
+    if (in_len > sizeof(gs_frame_buf))
+    {
+        return 1;
+    }
+    
+    /* queue the frame */
+    memcpy(gs_frame_buf, in_buf, in_len);
+    gs_frame_len = in_len;
+    
+    return 0;
+}
+
+/**
+ * @brief         poll with a frame counter
+ * @param[out]    *out_buf pointer to an output buffer
+ * @param[in,out] *out_len pointer to an output length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 poll failed
+ *                - 2 pending
+ * @note          a lost frame stays pending
+ */
+static uint8_t a_op_test_poll(uint8_t *out_buf, uint8_t *out_len)
+{
+    uint8_t res;
+    
+    /* wait the response */
+    if ((gs_pending != 0) || (gs_lose != 0))
+    {
+        if (gs_pending != 0)
+        {
+            gs_pending--;
+        }
+        
+        return 2;
+    }
+    if (gs_frame_len == 0)
+    {
+        return 1;
+    }
+    
+    /* run the frame */
+    res = mifare_ultralight_test_helper_transceiver(gs_frame_buf, gs_frame_len, out_buf, out_len);
+    gs_frame_len = 0;
+    
+    return res;
+}
+
+/**
+ * @brief      run an op until it is finished
+ * @param[in]  *op pointer to a mifare_ultralight op structure
+ * @param[out] *steps pointer to a step number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the time goes on by 100us between the steps of a pending op
+ */
+static uint8_t a_op_test_run(mifare_ultralight_op_t *op, uint32_t *steps)
+{
+    uint8_t res;
+    
+    *steps = 0;
+    while ((op->state != MIFARE_ULTRALIGHT_OP_STATE_DONE) && (op->state != MIFARE_ULTRALIGHT_OP_STATE_ERROR))
+    {
+        if (*steps >= 1000)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: op is not finished.\n");
+            
+            return 1;
+        }
+        res = mifare_ultralight_op_step(&gs_handle, op);
+        if (res != 0)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: op step failed.\n");
+            
+            return 1;
+        }
+        (*steps)++;
+        if (op->state == MIFARE_ULTRALIGHT_OP_STATE_WAIT)
+        {
+            mifare_ultralight_interface_delay_us(100);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run an op
+ * @param[in] *name pointer to a case name
+ * @param[in] type op type
+ * @param[in] page page of the op
+ * @param[in] *data pointer to a data buffer
+ * @param[in] expect_res expected op result
+ * @param[in] expect_frame expected frame number
+ * @param[in] expect_steps expected step number, 0 means any
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_op_test_case(const char *name, mifare_ultralight_op_type_t type, uint8_t page, uint8_t *data,
+                              uint8_t expect_res, uint32_t expect_frame, uint32_t expect_steps)
+{
+    uint8_t res;
+    uint32_t steps;
+    mifare_ultralight_op_t op;
+    
+    /* start the op */
+    memset(&op, 0, sizeof(op));
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_op_start(&gs_handle, &op, type, page, page, data);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s op start failed.\n", name);
+        
+        return 1;
+    }
+    
+    /* a started op is busy */
+    if ((op.state != MIFARE_ULTRALIGHT_OP_STATE_DONE) && 
+        (mifare_ultralight_op_start(&gs_handle, &op, type, page, page, data) != 7))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s op is not busy.\n", name);
+        
+        return 1;
+    }
+    
+    /* run the op */
+    if (a_op_test_run(&op, &steps) != 0)
+    {
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s steps %d.\n", name, (int)steps);
+    
+    /* check the result */
+    if (mifare_ultralight_test_helper_check(name, op.res, expect_res, expect_frame) != 0)
+    {
+        return 1;
+    }
+    if ((expect_steps != 0) && (steps != expect_steps))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s step number is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  op test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the submit and poll functions queue the frames of the contactless transceiver
+ */
+uint8_t mifare_ultralight_op_test(void)
+{
+    uint8_t res;
+    uint8_t identifier;
+    uint8_t page[4];
+    uint8_t data[16];
+    uint8_t vcsl[21];
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_interface_contactless_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_SUBMIT(&gs_handle, a_op_test_submit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_POLL(&gs_handle, a_op_test_poll);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start op test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start op test.\n");
+    
+    /* init */
+    gs_frame_len = 0;
+    gs_busy = 0;
+    gs_pending = 0;
+    gs_lose = 0;
+    mifare_ultralight_test_helper_reset(NULL);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the op reads what the blocking api reads */
+    if ((mifare_ultralight_read_page(&gs_handle, 0x04, page) != 0) || 
+        (a_op_test_case("read page", MIFARE_ULTRALIGHT_OP_READ_PAGE, 0x04, data, 0, 1, 1) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (memcmp(page, data, 4) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: read page data is wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a busy transport and a pending response only take more steps */
+    gs_busy = 2;
+    gs_pending = 3;
+    if (a_op_test_case("busy and pending", MIFARE_ULTRALIGHT_OP_READ_PAGE, 0x04, data, 0, 1, 6) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the compatibility write sends the address and the data phase */
+    if (a_op_test_case("compatibility write", MIFARE_ULTRALIGHT_OP_COMPATIBILITY_WRITE_PAGE, 0x04, page, 0, 2, 1) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the vcsl op returns the identifier of the blocking api */
+    memset(vcsl, 0, sizeof(vcsl));
+    res = mifare_ultralight_vcsl(&gs_handle, vcsl, vcsl + 16, &identifier);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: vcsl failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    vcsl[20] = (uint8_t)(~identifier);
+    if (a_op_test_case("vcsl", MIFARE_ULTRALIGHT_OP_VCSL, 0x00, vcsl, 0, 1, 1) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (vcsl[20] != identifier)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: vcsl identifier is wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a lost frame times out */
+    res = mifare_ultralight_set_op_timeout(&gs_handle, 1000);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set op timeout failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_lose = 1;
+    if (a_op_test_case("lost frame", MIFARE_ULTRALIGHT_OP_READ_PAGE, 0x04, data, 8, 0, 0) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    gs_lose = 0;
+    gs_frame_len = 0;
+    
+    /* the card answers the next op */
+    if (a_op_test_case("read after timeout", MIFARE_ULTRALIGHT_OP_READ_PAGE, 0x04, data, 0, 1, 1) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish op test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish op test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
@@ -0,0 +1,436 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_personalize_test.c
+ * @brief     driver mifare_ultralight personalize test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_personalize_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+#include "driver_mifare_ultralight_personalize.h"
+
+static mifare_ultralight_handle_t gs_handle;                            /**< mifare_ultralight handle */
+static mifare_ultralight_personalize_plan_t gs_plan;                    /**< personalization plan */
+static mifare_ultralight_personalize_program_t gs_program;              /**< personalization program */
+
+/**
+ * @brief     compile the plan
+ * @param[in] *name pointer to a case name
+ * @param[in] expect_count expected step number
+ * @param[in] expect_skipped expected skipped page number
+ * @return    status code
+ *            - 0 success
+ *            - 1 compile failed
+ * @note      none
+ */
+static uint8_t a_personalize_test_compile(const char *name, uint8_t expect_count, uint8_t expect_skipped)
+{
+    uint8_t res;
+    uint8_t i;
+    
+    /* compile the plan */
+    res = mifare_ultralight_personalize_compile(&gs_handle, &gs_plan, &gs_program);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s compile failed.\n", name);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s %d steps %d skipped.\n", name, gs_program.count, gs_program.skipped);
+    for (i = 0; i < gs_program.count; i++)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: step %d stage %d page 0x%02X.\n", 
+                                                i, gs_program.step[i].stage, gs_program.step[i].page);
+    }
+    
+    /* check the program */
+    if ((gs_program.count != expect_count) || (gs_program.skipped != expect_skipped))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s step number is wrong.\n", name);
+        
+        return 1;
+    }
+    for (i = 1; i < gs_program.count; i++)
+    {
+        if ((gs_program.step[i].stage != MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_AUTHENTICATE) && 
+            (gs_program.step[i - 1].stage != MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_AUTHENTICATE) && 
+            (gs_program.step[i].stage != MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CURRENT) && 
+            (gs_program.step[i - 1].stage != MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CURRENT) && 
+            (gs_program.step[i].stage < gs_program.step[i - 1].stage))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: %s step order is wrong.\n", name);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     execute the program
+ * @param[in] *name pointer to a case name
+ * @param[in] drop frame whose response is dropped, 0 means none
+ * @param[in] lose frame lost before the card, 0 means none
+ * @param[in] expect_res expected result
+ * @param[in] expect_frame expected frame number
+ * @param[in] expect_next expected resume point
+ * @return    status code
+ *            - 0 success
+ *            - 1 execute failed
+ * @note      none
+ */
+static uint8_t a_personalize_test_execute(const char *name, uint32_t drop, uint32_t lose, uint8_t expect_res, 
+                                          uint32_t expect_frame, uint8_t expect_next)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t start;
+    
+    /* execute the program */
+    start = gs_program.next;
+    mifare_ultralight_test_helper_start();
+    mifare_ultralight_test_helper_set_fault(drop, lose);
+    res = mifare_ultralight_personalize_execute(&gs_handle, &gs_program);
+    mifare_ultralight_test_helper_set_fault(0, 0);
+    for (i = start; (i < gs_program.next) && (i < gs_program.count); i++)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: step %d page 0x%02X %dus.\n", 
+                                                i, gs_program.step[i].page, (int)gs_program.step[i].us);
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s next %d.\n", name, gs_program.next);
+    
+    /* check the result */
+    if (mifare_ultralight_test_helper_check(name, res, expect_res, expect_frame) != 0)
+    {
+        return 1;
+    }
+    if (gs_program.next != expect_next)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s resume point is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  reactivate the card
+ * @return status code
+ *         - 0 success
+ *         - 1 reactivate failed
+ * @note   none
+ */
+static uint8_t a_personalize_test_reactivate(void)
+{
+    uint8_t res;
+    mifare_ultralight_activation_t activation;
+    
+    /* halt and wake up the card */
+    (void)mifare_ultralight_halt(&gs_handle);
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  personalize test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the user pages, the password, the pack and the access protection of the card are set back at the end
+ */
+uint8_t mifare_ultralight_personalize_test(void)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t protected_page;
+    uint8_t pwd[4] = {0x4C, 0x69, 0x62, 0x44};
+    uint8_t pack[2] = {0x72, 0x76};
+    uint8_t pwd_default[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t pack_default[2] = {0x00, 0x00};
+    uint8_t origin[4 * 8 + 2];
+    uint16_t len;
+    mifare_ultralight_snapshot_t snapshot;
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start personalize test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start personalize test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(NULL);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* keep the user pages and the configuration */
+    len = sizeof(origin);
+    res = mifare_ultralight_read_range(&gs_handle, 0x04, 0x0B, origin, &len, &protected_page);
+    if ((res != 0) || (protected_page != 0xFF))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: read range failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = mifare_ultralight_get_snapshot(&gs_handle, &snapshot);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: get snapshot failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* issue the card, pages 4 and 5 keep their content */
+    memset(&gs_plan, 0, sizeof(mifare_ultralight_personalize_plan_t));
+    gs_plan.flags = MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_USER | MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_KEY | 
+                    MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CONF | MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CURRENT_KEY;
+    gs_plan.start_page = 0x04;
+    gs_plan.stop_page = 0x0B;
+    for (i = 0; i < 4 * 8; i++)
+    {
+        gs_plan.user[i] = (i < 4 * 2) ? origin[i] : (uint8_t)(~origin[i]);
+    }
+    memcpy(gs_plan.pwd, pwd, 4);
+    memcpy(gs_plan.pack, pack, 2);
+    gs_plan.protect_start_page = 0x04;
+    gs_plan.read_protection = MIFARE_ULTRALIGHT_BOOL_TRUE;
+    gs_plan.user_conf_protection = snapshot.user_conf_protection;
+    gs_plan.authenticate_limitation = snapshot.authenticate_limitation;
+    memcpy(gs_plan.current_pwd, pwd_default, 4);
+    memcpy(gs_plan.current_pack, pack_default, 2);
+    if ((a_personalize_test_compile("issue", 10, 2) != 0) || 
+        (a_personalize_test_execute("torn issue", 0, 7, 1, 7, 6) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the pwd write never reached the card, the new pwd is refused and the current one is used */
+    if ((a_personalize_test_reactivate() != 0) || 
+        (a_personalize_test_execute("resumed issue", 0, 0, 0, 9, 10) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the protected card is read after an authentication */
+    if ((a_personalize_test_reactivate() != 0) || 
+        (mifare_ultralight_authenticate(&gs_handle, pwd, pack) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: authenticate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set the card back, the response of the cfg1 write is lost */
+    memcpy(gs_plan.user, origin, 4 * 8);
+    memcpy(gs_plan.pwd, pwd_default, 4);
+    memcpy(gs_plan.pack, pack_default, 2);
+    memcpy(gs_plan.current_pwd, pwd, 4);
+    memcpy(gs_plan.current_pack, pack, 2);
+    gs_plan.protect_start_page = snapshot.protect_start_page;
+    gs_plan.read_protection = snapshot.read_protection;
+    if ((a_personalize_test_compile("set back", 12, 2) != 0) || 
+        (gs_program.step[0].stage != MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CURRENT) || 
+        (gs_program.step[9].stage != MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_AUTHENTICATE) || 
+        (a_personalize_test_execute("torn pwd write", 7, 0, 1, 7, 7) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the torn pwd write reached the card, the new pwd is accepted with the old pack, */
+    /* then the response of the cfg1 write is lost */
+    if ((a_personalize_test_reactivate() != 0) || 
+        (a_personalize_test_execute("torn set back", 5, 0, 1, 5, 10) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* resume after a reactivation, the new pwd is authenticated first */
+    if ((a_personalize_test_reactivate() != 0) || 
+        (a_personalize_test_execute("resumed set back", 0, 0, 0, 3, 12) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* only the key is written again to a personalized card */
+    if ((a_personalize_test_compile("unchanged", 2, 10) != 0) || 
+        (a_personalize_test_execute("unchanged", 0, 0, 0, 2, 2) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* cfglck writes cfg0 first, so lowering auth0 without a pwd is refused */
+    memset(&gs_plan, 0, sizeof(mifare_ultralight_personalize_plan_t));
+    gs_plan.flags = MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CONF;
+    gs_plan.protect_start_page = 0x10;
+    gs_plan.read_protection = MIFARE_ULTRALIGHT_BOOL_FALSE;
+    gs_plan.user_conf_protection = MIFARE_ULTRALIGHT_BOOL_TRUE;
+    gs_plan.authenticate_limitation = snapshot.authenticate_limitation;
+    res = mifare_ultralight_personalize_compile(&gs_handle, &gs_plan, &gs_program);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: locked conf without pwd res %d.\n", res);
+    if (res != 6)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: locked conf without pwd result is wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* with the current pwd cfg1 is written in a session, the plan is not executed */
+    gs_plan.flags |= MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CURRENT_KEY;
+    memcpy(gs_plan.current_pwd, pwd_default, 4);
+    memcpy(gs_plan.current_pack, pack_default, 2);
+    if ((a_personalize_test_compile("locked conf", 3, 0) != 0) || 
+        (gs_program.step[1].stage != MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_AUTHENTICATE) || 
+        (memcmp(gs_program.pwd, pwd_default, 4) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: locked conf program is wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* protect the user pages from writes with the current pwd */
+    gs_plan.flags = MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CONF | MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CURRENT_KEY;
+    gs_plan.protect_start_page = 0x04;
+    gs_plan.read_protection = MIFARE_ULTRALIGHT_BOOL_FALSE;
+    gs_plan.user_conf_protection = snapshot.user_conf_protection;
+    if ((a_personalize_test_compile("protect", 1, 1) != 0) || 
+        (a_personalize_test_execute("protect", 0, 0, 0, 1, 1) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the protected card is issued out of a session, the current pwd is authenticated first, */
+    /* then the frame of a user page write is lost */
+    gs_plan.flags = MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_USER | MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_KEY | 
+                    MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CURRENT_KEY;
+    gs_plan.start_page = 0x04;
+    gs_plan.stop_page = 0x0B;
+    for (i = 0; i < 4 * 8; i++)
+    {
+        gs_plan.user[i] = (i < 4 * 2) ? origin[i] : (uint8_t)(~origin[i]);
+    }
+    memcpy(gs_plan.pwd, pwd, 4);
+    memcpy(gs_plan.pack, pack, 2);
+    if ((a_personalize_test_reactivate() != 0) || 
+        (a_personalize_test_compile("protected issue", 9, 2) != 0) || 
+        (gs_program.step[0].stage != MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CURRENT) || 
+        (a_personalize_test_execute("torn protected issue", 0, 4, 1, 4, 3) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* resume after a reactivation, the current pwd is authenticated first */
+    if ((a_personalize_test_reactivate() != 0) || 
+        (a_personalize_test_execute("resumed protected issue", 0, 0, 0, 7, 9) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set the card back out of a session */
+    gs_plan.flags = MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_USER | MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_KEY | 
+                    MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CONF | MIFARE_ULTRALIGHT_PERSONALIZE_FLAG_CURRENT_KEY;
+    memcpy(gs_plan.user, origin, 4 * 8);
+    memcpy(gs_plan.pwd, pwd_default, 4);
+    memcpy(gs_plan.pack, pack_default, 2);
+    memcpy(gs_plan.current_pwd, pwd, 4);
+    memcpy(gs_plan.current_pack, pack, 2);
+    gs_plan.protect_start_page = snapshot.protect_start_page;
+    gs_plan.read_protection = snapshot.read_protection;
+    if ((a_personalize_test_reactivate() != 0) || 
+        (a_personalize_test_compile("protected set back", 11, 3) != 0) || 
+        (gs_program.step[0].stage != MIFARE_ULTRALIGHT_PERSONALIZE_STAGE_CURRENT) || 
+        (a_personalize_test_execute("protected set back", 0, 0, 0, 10, 11) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish personalize test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish personalize test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
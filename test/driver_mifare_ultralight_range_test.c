@@ -0,0 +1,353 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_range_test.c
+ * @brief     driver mifare_ultralight range test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_mifare_ultralight_range_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+
+static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
+static uint8_t gs_buf[64];                          /**< data buffer */
+
+/**
+ * @brief     run a range read
+ * @param[in] *name pointer to a case name
+ * @param[in] start_page start page
+ * @param[in] stop_page stop page
+ * @param[in] expect_res expected result
+ * @param[in] expect_page expected protected page
+ * @param[in] expect_len expected length
+ * @param[in] expect_frame expected frame number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the card must still be selected after a successful read
+ */
+static uint8_t a_range_test_case(const char *name, uint8_t start_page, uint8_t stop_page, uint8_t expect_res,
+                                 uint8_t expect_page, uint16_t expect_len, uint32_t expect_frame)
+{
+    uint8_t res;
+    uint8_t page;
+    uint16_t len;
+    uint8_t data[16];
+    
+    /* run the read */
+    mifare_ultralight_test_helper_start();
+    len = sizeof(gs_buf);
+    page = 0;
+    res = mifare_ultralight_read_range(&gs_handle, start_page, stop_page, gs_buf, &len, &page);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s protected page 0x%02X len %d.\n", name, page, len);
+    
+    /* check the result */
+    if (mifare_ultralight_test_helper_check(name, res, expect_res, expect_frame) != 0)
+    {
+        return 1;
+    }
+    if (page != expect_page)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s protected page is wrong.\n", name);
+        
+        return 1;
+    }
+    if (len != expect_len)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s length is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    /* the card is selected after a refused range */
+    if ((expect_res == 0) && (mifare_ultralight_read_page(&gs_handle, 0x00, data) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s card is not selected.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  reactivate the card
+ * @return status code
+ *         - 0 success
+ *         - 1 reactivate failed
+ * @note   the conf shadow is dropped by the wake up
+ */
+static uint8_t a_range_test_reactivate(void)
+{
+    uint8_t res;
+    mifare_ultralight_activation_t activation;
+    
+    /* halt the card */
+    (void)mifare_ultralight_halt(&gs_handle);
+    
+    /* wake up the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  set back the default protection
+ * @return status code
+ *         - 0 success
+ *         - 1 set back failed
+ * @note   the card is reactivated and authenticated with the default password
+ */
+static uint8_t a_range_test_unprotect(void)
+{
+    uint8_t pwd_default[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t pack_default[2] = {0x00, 0x00};
+    
+    if ((a_range_test_reactivate() != 0) || 
+        (mifare_ultralight_authenticate(&gs_handle, pwd_default, pack_default) != 0) || 
+        (mifare_ultralight_set_protect_start_page(&gs_handle, 0xFF) != 0) || 
+        (mifare_ultralight_set_access(&gs_handle, MIFARE_ULTRALIGHT_ACCESS_READ_PROTECTION, MIFARE_ULTRALIGHT_BOOL_FALSE) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set back the protection failed.\n");
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: set back the default protection.\n");
+    
+    return 0;
+}
+
+/**
+ * @brief  select the card without the select cl2 of the driver
+ * @return status code
+ *         - 0 success
+ *         - 1 select failed
+ * @note   the select cl2 frame is sent raw, so the driver keeps no uid
+ */
+static uint8_t a_range_test_select_raw(void)
+{
+    uint8_t i;
+    uint8_t id[4];
+    uint8_t out[1];
+    uint8_t out_len;
+    uint8_t frame[9];
+    mifare_ultralight_type_t type;
+    
+    (void)mifare_ultralight_halt(&gs_handle);
+    if ((mifare_ultralight_wake_up(&gs_handle, &type) != 0) || 
+        (mifare_ultralight_anticollision_cl1(&gs_handle, id) != 0) || 
+        (mifare_ultralight_select_cl1(&gs_handle, id) != 0) || 
+        (mifare_ultralight_anticollision_cl2(&gs_handle, id) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: select cl1 failed.\n");
+        
+        return 1;
+    }
+    frame[0] = 0x95;
+    frame[1] = 0x70;
+    frame[6] = 0;
+    for (i = 0; i < 4; i++)
+    {
+        frame[2 + i] = id[i];
+        frame[6] ^= id[i];
+    }
+    mifare_ultralight_crc_final(mifare_ultralight_crc_update(mifare_ultralight_crc_init(), frame, 7), frame + 7);
+    out_len = 1;
+    if ((mifare_ultralight_transceiver(&gs_handle, frame, 9, out, &out_len) != 0) || (out_len != 1) || (out[0] != 0x00))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: select cl2 failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  range test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the access protection of the card is set back to the default at the end
+ */
+uint8_t mifare_ultralight_range_test(void)
+{
+    uint8_t res;
+    uint8_t page;
+    uint16_t len;
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start range test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start range test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(NULL);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* read protect the card from page 10 */
+    if ((mifare_ultralight_set_access(&gs_handle, MIFARE_ULTRALIGHT_ACCESS_READ_PROTECTION, MIFARE_ULTRALIGHT_BOOL_TRUE) != 0) || 
+        (mifare_ultralight_set_protect_start_page(&gs_handle, 0x0A) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: protect failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: read protect from page 10.\n");
+    
+    /* auth0 of the conf shadow gives the protected page */
+    if (a_range_test_case("known auth0", 0x04, 0x0F, 0, 0x0A, 24, 5) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the refused frame is narrowed without the conf shadow */
+    if ((a_range_test_reactivate() != 0) || 
+        (a_range_test_case("narrowed", 0x04, 0x0F, 0, 0x0A, 24, 18) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a protected first page gives no data */
+    if ((a_range_test_reactivate() != 0) || 
+        (a_range_test_case("protected start", 0x0B, 0x0F, 0, 0x0B, 0, 16) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a lost frame is an error */
+    if (mifare_ultralight_set_max_frame_length(&gs_handle, 6) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set max frame length failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_test_helper_set_fault(2, 0);
+    if ((a_range_test_case("lost frame", 0x04, 0x07, 1, 0xFF, 4, 2) != 0) || 
+        (a_range_test_reactivate() != 0) || 
+        (a_range_test_case("single page frames", 0x04, 0x0F, 0, 0x0A, 24, 10) != 0) || 
+        (mifare_ultralight_set_max_frame_length(&gs_handle, 64) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set back the default protection */
+    if (a_range_test_unprotect() != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* every page is read again */
+    if (a_range_test_case("unprotected", 0x04, 0x0F, 0, 0xFF, 48, 1) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* auth0 of the conf shadow is reported without a selected uid */
+    if ((a_range_test_select_raw() != 0) || 
+        (mifare_ultralight_set_access(&gs_handle, MIFARE_ULTRALIGHT_ACCESS_READ_PROTECTION, MIFARE_ULTRALIGHT_BOOL_TRUE) != 0) || 
+        (mifare_ultralight_set_protect_start_page(&gs_handle, 0x0A) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: protect failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_test_helper_start();
+    len = sizeof(gs_buf);
+    res = mifare_ultralight_read_range(&gs_handle, 0x04, 0x0F, gs_buf, &len, &page);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: unselected uid protected page 0x%02X len %d.\n", page, len);
+    if ((mifare_ultralight_test_helper_check("unselected uid", res, 0, 1) != 0) || (page != 0x0A) || (len != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: unselected uid is wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (a_range_test_unprotect() != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish range test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish range test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
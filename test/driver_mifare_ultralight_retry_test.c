@@ -0,0 +1,420 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_retry_test.c
+ * @brief     driver mifare_ultralight retry test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_retry_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+
+/**
+ * @brief retry test fault enumeration definition
+ */
+typedef enum
+{
+    MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_NONE = 0,        /**< no fault */
+    MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_CRC,             /**< corrupt the response crc */
+    MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_DROP,            /**< drop the response */
+    MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_NAK,             /**< answer a crc nak */
+} mifare_ultralight_retry_test_fault_t;
+
+/**
+ * @brief retry test job structure definition
+ */
+typedef struct mifare_ultralight_retry_test_job_s
+{
+    uint8_t page;          /**< page */
+    uint8_t data[4];       /**< data buffer */
+} mifare_ultralight_retry_test_job_t;
+
+static mifare_ultralight_handle_t gs_handle;                   /**< mifare_ultralight handle */
+static mifare_ultralight_retry_test_fault_t gs_fault;          /**< fault of the next frame */
+
+/**
+ * @brief         response hook with fault injection
+ * @param[in]     *in_buf pointer to an input buffer
+ * @param[in]     in_len input length
+ * @param[out]    *out_buf pointer to an output buffer
+ * @param[in,out] *out_len pointer to an output length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 transceiver failed
+ * @note          the fault is used once
+ */
+static uint8_t a_retry_test_hook(uint8_t *in_buf, uint8_t in_len, uint8_t *out_buf, uint8_t *out_len)
+{
+    mifare_ultralight_retry_test_fault_t fault;
+    
+    (void)in_buf;
+    (void)in_len;
+    
+    /* inject the fault */
+    fault = gs_fault;
+    gs_fault = MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_NONE;
+    switch (fault)
+    {
+        case MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_CRC :
+        {
+            if (*out_len > 2)
+            {
+                out_buf[*out_len - 1] ^= 0xFF;
+            }
+            
+            return 0;
+        }
+        case MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_DROP :
+        {
+            return 1;
+        }
+        case MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_NAK :
+        {
+            out_buf[0] = MIFARE_ULTRALIGHT_NAK_CRC;
+            *out_len = 1;
+            
+            return 0;
+        }
+        default :
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief     read page job
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *arg pointer to a job structure
+ * @return    status code
+ *            - 0 success
+ *            - others read failed
+ * @note      none
+ */
+static uint8_t a_retry_test_read_page(mifare_ultralight_handle_t *handle, void *arg)
+{
+    mifare_ultralight_retry_test_job_t *job = (mifare_ultralight_retry_test_job_t *)arg;
+    
+    return mifare_ultralight_read_page(handle, job->page, job->data);
+}
+
+/**
+ * @brief     write page job
+ * @param[in] *handle pointer to a mifare_ultralight handle structure
+ * @param[in] *arg pointer to a job structure
+ * @return    status code
+ *            - 0 success
+ *            - others write failed
+ * @note      none
+ */
+static uint8_t a_retry_test_write_page(mifare_ultralight_handle_t *handle, void *arg)
+{
+    mifare_ultralight_retry_test_job_t *job = (mifare_ultralight_retry_test_job_t *)arg;
+    
+    return mifare_ultralight_write_page(handle, job->page, job->data);
+}
+
+/**
+ * @brief     run a job with a fault
+ * @param[in] *name pointer to a case name
+ * @param[in] fault injected fault
+ * @param[in] *run pointer to a job function address
+ * @param[in] *job pointer to a job structure
+ * @param[in] flags retry flags
+ * @param[in] expect_res expected result
+ * @param[in] expect_failure expected failure class
+ * @param[in] expect_frame expected frame number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_retry_test_case(const char *name, mifare_ultralight_retry_test_fault_t fault,
+                                 uint8_t (*run)(mifare_ultralight_handle_t *handle, void *arg),
+                                 mifare_ultralight_retry_test_job_t *job, uint8_t flags, uint8_t expect_res,
+                                 mifare_ultralight_failure_t expect_failure, uint32_t expect_frame)
+{
+    uint8_t res;
+    uint8_t nak;
+    mifare_ultralight_failure_t failure;
+    
+    /* run the job */
+    mifare_ultralight_test_helper_start();
+    gs_fault = fault;
+    res = mifare_ultralight_retry(&gs_handle, run, job, flags);
+    (void)mifare_ultralight_get_failure(&gs_handle, &failure, &nak);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s failure %d nak 0x%02X.\n", name, failure, nak);
+    
+    /* check the result */
+    if (mifare_ultralight_test_helper_check(name, res, expect_res, expect_frame) != 0)
+    {
+        return 1;
+    }
+    if (failure != expect_failure)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s failure is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  retry test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   faults are injected between the driver and mifare_ultralight_interface_contactless_transceiver
+ */
+uint8_t mifare_ultralight_retry_test(void)
+{
+    uint8_t res;
+    mifare_ultralight_retry_test_job_t job;
+    uint8_t i;
+    uint8_t nak;
+    uint8_t id[4];
+    mifare_ultralight_type_t type;
+    mifare_ultralight_failure_t failure;
+    mifare_ultralight_retry_policy_t policy;
+    mifare_ultralight_retry_policy_t check;
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start retry test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start retry test.\n");
+    
+    /* init */
+    gs_fault = MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_NONE;
+    mifare_ultralight_test_helper_reset(NULL);
+    mifare_ultralight_test_helper_set_hook(a_retry_test_hook);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* init sets a policy without any retry */
+    res = mifare_ultralight_get_retry_policy(&gs_handle, &policy);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: get retry policy failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < MIFARE_ULTRALIGHT_FAILURE_MAX; i++)
+    {
+        if (policy.failure[i].budget != 0)
+        {
+            break;
+        }
+    }
+    if ((i != MIFARE_ULTRALIGHT_FAILURE_MAX) || (policy.max_retry != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init retry policy is wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a lost response is not retried by the init policy */
+    job.page = 0x04;
+    if (a_retry_test_case("lost read without retry", MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_DROP, a_retry_test_read_page, &job, 
+                          MIFARE_ULTRALIGHT_RETRY_FLAG_NONE, 1, MIFARE_ULTRALIGHT_FAILURE_NO_RESPONSE, 1) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set the retry policy */
+    memset(&policy, 0, sizeof(mifare_ultralight_retry_policy_t));
+    policy.failure[MIFARE_ULTRALIGHT_FAILURE_CORRUPT].budget = 2;
+    policy.failure[MIFARE_ULTRALIGHT_FAILURE_NO_RESPONSE].budget = 1;
+    policy.failure[MIFARE_ULTRALIGHT_FAILURE_NO_RESPONSE].backoff_us = 1000;
+    policy.failure[MIFARE_ULTRALIGHT_FAILURE_NAK_TRANSIENT].budget = 1;
+    policy.max_retry = 3;
+    policy.max_backoff_us = 4000;
+    res = mifare_ultralight_set_retry_policy(&gs_handle, &policy);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set retry policy failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    res = mifare_ultralight_get_retry_policy(&gs_handle, &check);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: get retry policy failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (memcmp(&policy, &check, sizeof(mifare_ultralight_retry_policy_t)) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: check retry policy error.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a corrupted response is retried at once */
+    job.page = 0x04;
+    if (a_retry_test_case("corrupted read", MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_CRC, a_retry_test_read_page, &job, 
+                          MIFARE_ULTRALIGHT_RETRY_FLAG_NONE, 0, MIFARE_ULTRALIGHT_FAILURE_NONE, 2) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a lost response reactivates the card before the retry */
+    if (a_retry_test_case("lost read", MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_DROP, a_retry_test_read_page, &job, 
+                          MIFARE_ULTRALIGHT_RETRY_FLAG_NONE, 0, MIFARE_ULTRALIGHT_FAILURE_NONE, 6) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a transient nak reactivates the card before the retry */
+    job.data[0] = 0x01;
+    job.data[1] = 0x02;
+    job.data[2] = 0x03;
+    job.data[3] = 0x04;
+    if (a_retry_test_case("nak write", MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_NAK, a_retry_test_write_page, &job, 
+                          MIFARE_ULTRALIGHT_RETRY_FLAG_NOT_IDEMPOTENT, 0, MIFARE_ULTRALIGHT_FAILURE_NONE, 6) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a lost ack of a not idempotent job is not retried */
+    if (a_retry_test_case("lost write", MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_DROP, a_retry_test_write_page, &job, 
+                          MIFARE_ULTRALIGHT_RETRY_FLAG_NOT_IDEMPOTENT, 1, MIFARE_ULTRALIGHT_FAILURE_NO_RESPONSE, 1) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a corrupted response is not retried without budget */
+    (void)mifare_ultralight_get_retry_policy(&gs_handle, &policy);
+    policy.failure[MIFARE_ULTRALIGHT_FAILURE_CORRUPT].budget = 0;
+    (void)mifare_ultralight_set_retry_policy(&gs_handle, &policy);
+    job.page = 0x04;
+    if (a_retry_test_case("corrupted read without budget", MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_CRC, a_retry_test_read_page, &job, 
+                          MIFARE_ULTRALIGHT_RETRY_FLAG_NONE, 5, MIFARE_ULTRALIGHT_FAILURE_CORRUPT, 1) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a permanent nak returns at once */
+    job.page = 0xF0;
+    if (a_retry_test_case("out of range read", MIFARE_ULTRALIGHT_RETRY_TEST_FAULT_NONE, a_retry_test_read_page, &job, 
+                          MIFARE_ULTRALIGHT_RETRY_FLAG_NONE, 4, MIFARE_ULTRALIGHT_FAILURE_NAK_PERMANENT, 1) != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the sak of the select is not a nak */
+    (void)mifare_ultralight_halt(&gs_handle);
+    if ((mifare_ultralight_wake_up(&gs_handle, &type) != 0) || 
+        (mifare_ultralight_anticollision_cl1(&gs_handle, id) != 0) || 
+        (mifare_ultralight_select_cl1(&gs_handle, id) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: select cl1 failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)mifare_ultralight_get_failure(&gs_handle, &failure, &nak);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: select cl1 nak 0x%02X.\n", nak);
+    if (nak != MIFARE_ULTRALIGHT_NAK_NONE)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: select cl1 nak is wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if ((mifare_ultralight_anticollision_cl2(&gs_handle, id) != 0) || 
+        (mifare_ultralight_select_cl2(&gs_handle, id) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: select cl2 failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)mifare_ultralight_get_failure(&gs_handle, &failure, &nak);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: select cl2 nak 0x%02X.\n", nak);
+    if (nak != MIFARE_ULTRALIGHT_NAK_NONE)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: select cl2 nak is wrong.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish retry test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish retry test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
@@ -0,0 +1,275 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_session_test.c
+ * @brief     driver mifare_ultralight session test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_session_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+
+static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
+
+/**
+ * @brief     run a page access
+ * @param[in] *name pointer to a case name
+ * @param[in] page accessed page
+ * @param[in] write 1 for a write and 0 for a read
+ * @param[in] expect_res expected result
+ * @param[in] expect_frame expected frame number
+ * @param[in] expect_auth expected session
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      a write puts back the content of the page
+ */
+static uint8_t a_session_test_case(const char *name, uint8_t page, uint8_t write, uint8_t expect_res,
+                                   uint32_t expect_frame, mifare_ultralight_bool_t expect_auth)
+{
+    uint8_t res;
+    uint8_t data[16];
+    mifare_ultralight_bool_t auth;
+    
+    /* read the page before a write */
+    if (write != 0)
+    {
+        res = mifare_ultralight_read_page(&gs_handle, page, data);
+        if (res != 0)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: %s read page failed.\n", name);
+            
+            return 1;
+        }
+    }
+    
+    /* run the access */
+    mifare_ultralight_test_helper_start();
+    if (write != 0)
+    {
+        res = mifare_ultralight_write_page(&gs_handle, page, data);
+    }
+    else
+    {
+        res = mifare_ultralight_read_page(&gs_handle, page, data);
+    }
+    (void)mifare_ultralight_get_authenticated(&gs_handle, &auth);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s authenticated %d.\n", name, auth);
+    
+    /* check the result */
+    if (mifare_ultralight_test_helper_check(name, res, expect_res, expect_frame) != 0)
+    {
+        return 1;
+    }
+    if (auth != expect_auth)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s session is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  reactivate the card
+ * @return status code
+ *         - 0 success
+ *         - 1 reactivate failed
+ * @note   the session must be lost after the halt
+ */
+static uint8_t a_session_test_reactivate(void)
+{
+    uint8_t res;
+    mifare_ultralight_bool_t auth;
+    mifare_ultralight_activation_t activation;
+    
+    /* halt the card */
+    (void)mifare_ultralight_halt(&gs_handle);
+    (void)mifare_ultralight_get_authenticated(&gs_handle, &auth);
+    if (auth != MIFARE_ULTRALIGHT_BOOL_FALSE)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: session is kept after halt.\n");
+        
+        return 1;
+    }
+    
+    /* wake up the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  session test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the access protection of the card is set back to the default at the end
+ */
+uint8_t mifare_ultralight_session_test(void)
+{
+    uint8_t res;
+    uint8_t pwd[4] = {0x12, 0x34, 0x56, 0x78};
+    uint8_t pack[2] = {0xA5, 0x5A};
+    uint8_t pwd_default[4] = {0xFF, 0xFF, 0xFF, 0xFF};
+    uint8_t pack_default[2] = {0x00, 0x00};
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start session test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start session test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(NULL);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* protect the user pages */
+    if ((mifare_ultralight_set_password(&gs_handle, pwd) != 0) || 
+        (mifare_ultralight_set_pack(&gs_handle, pack) != 0) || 
+        (mifare_ultralight_set_access(&gs_handle, MIFARE_ULTRALIGHT_ACCESS_READ_PROTECTION, MIFARE_ULTRALIGHT_BOOL_TRUE) != 0) || 
+        (mifare_ultralight_set_protect_start_page(&gs_handle, 0x04) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: protect failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: protect from page 4.\n");
+    if (a_session_test_reactivate() != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set the auto authenticate */
+    res = mifare_ultralight_set_auto_authenticate(&gs_handle, pwd, pack);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set auto authenticate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the first protected access authenticates, the next ones reuse the session */
+    if ((a_session_test_case("first read", 0x04, 0, 0, 2, MIFARE_ULTRALIGHT_BOOL_TRUE) != 0) || 
+        (a_session_test_case("second read", 0x08, 0, 0, 1, MIFARE_ULTRALIGHT_BOOL_TRUE) != 0) || 
+        (a_session_test_case("write", 0x05, 1, 0, 1, MIFARE_ULTRALIGHT_BOOL_TRUE) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a transport failure ends the session */
+    mifare_ultralight_test_helper_set_fault(1, 0);
+    if ((a_session_test_case("lost read", 0x08, 0, 1, 1, MIFARE_ULTRALIGHT_BOOL_FALSE) != 0) || 
+        (a_session_test_case("read after loss", 0x08, 0, 0, 2, MIFARE_ULTRALIGHT_BOOL_TRUE) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a halt ends the session */
+    if ((a_session_test_reactivate() != 0) || 
+        (a_session_test_case("read after halt", 0x04, 0, 0, 2, MIFARE_ULTRALIGHT_BOOL_TRUE) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a protected read is refused without the auto authenticate */
+    (void)mifare_ultralight_set_auto_authenticate(&gs_handle, NULL, NULL);
+    if ((a_session_test_reactivate() != 0) || 
+        (a_session_test_case("read without auto", 0x04, 0, 4, 1, MIFARE_ULTRALIGHT_BOOL_FALSE) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set back the default protection */
+    (void)mifare_ultralight_set_auto_authenticate(&gs_handle, pwd, pack);
+    if ((a_session_test_reactivate() != 0) || 
+        (mifare_ultralight_set_protect_start_page(&gs_handle, 0xFF) != 0) || 
+        (mifare_ultralight_set_access(&gs_handle, MIFARE_ULTRALIGHT_ACCESS_READ_PROTECTION, MIFARE_ULTRALIGHT_BOOL_FALSE) != 0) || 
+        (mifare_ultralight_set_password(&gs_handle, pwd_default) != 0) || 
+        (mifare_ultralight_set_pack(&gs_handle, pack_default) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set back the protection failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    (void)mifare_ultralight_set_auto_authenticate(&gs_handle, NULL, NULL);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: set back the default protection.\n");
+    
+    /* finish session test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish session test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
@@ -0,0 +1,344 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_signature_test.c
+ * @brief     driver mifare_ultralight signature test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_signature_test.h"
+
+/**
+ * @brief signature test definition
+ */
+#define MIFARE_ULTRALIGHT_SIGNATURE_TEST_BATCH        40        /**< batch verify entries */
+
+/**
+ * @brief signature test public key
+ */
+static const uint8_t gs_public_key[33] =
+{
+    0x04, 0x7F, 0xEB, 0x2D, 0x17, 0xF8, 0xF9, 0x55, 0x6E, 0xC9, 0x77, 0x2D, 0xC6, 0xCA, 0xC6, 0x97, 0x17,
+    0x94, 0x09, 0xEB, 0x7F, 0xBC, 0xE9, 0x09, 0x54, 0xCB, 0xD5, 0xFB, 0xE6, 0xF2, 0xDD, 0x4A, 0x1C,
+};
+
+/**
+ * @brief signature test uids
+ */
+static const uint8_t gs_uid[4][7] =
+{
+    {0x04, 0x54, 0xD6, 0xD6, 0x90, 0xF5, 0x6E},
+    {0x04, 0x5D, 0x78, 0x01, 0x07, 0xBD, 0xDB},
+    {0x04, 0x76, 0x77, 0x15, 0xDF, 0xD0, 0xE2},
+    {0x04, 0xFE, 0x3B, 0xBC, 0x0B, 0x4F, 0x2D},
+};
+
+/**
+ * @brief signature test signatures of the uids
+ */
+static const uint8_t gs_signature[4][32] =
+{
+    {
+        0xDE, 0x26, 0x78, 0x58, 0xA3, 0xA4, 0x24, 0x59, 0x13, 0xC9, 0x8B, 0xEC, 0xD9, 0x4D, 0x9D, 0xA6,
+        0x6D, 0x0E, 0xEE, 0xA3, 0x71, 0xF9, 0xD7, 0xE5, 0x74, 0x4C, 0x39, 0x19, 0x4B, 0x58, 0x39, 0x7E,
+    },
+    {
+        0x59, 0x21, 0x13, 0x54, 0x07, 0x28, 0xCA, 0x93, 0x36, 0x4D, 0x96, 0x20, 0xFA, 0x9C, 0x53, 0x63,
+        0x2D, 0xC5, 0x77, 0x4B, 0x60, 0xAD, 0x0B, 0x5B, 0x86, 0xE4, 0x22, 0x24, 0x53, 0x59, 0x32, 0xA9,
+    },
+    {
+        0x3C, 0x48, 0xB0, 0x0B, 0x15, 0x2C, 0x06, 0xC3, 0x3C, 0x93, 0x7E, 0xF4, 0x80, 0x8B, 0xBF, 0x98,
+        0xF1, 0x26, 0x41, 0x4A, 0x9F, 0xFE, 0xAB, 0xDA, 0x2B, 0xE0, 0x8A, 0x57, 0xE6, 0xF2, 0x8A, 0x23,
+    },
+    {
+        0xFE, 0x61, 0xB3, 0x8F, 0x78, 0xD5, 0xD3, 0x8D, 0x4F, 0xB1, 0x2E, 0x9F, 0x8A, 0xF8, 0x68, 0x59,
+        0xE9, 0x27, 0xFB, 0x43, 0xAF, 0x3D, 0x5A, 0x07, 0x3A, 0xEB, 0x38, 0xA0, 0x6E, 0x3D, 0x96, 0xD3,
+    },
+};
+
+/**
+ * @brief signature test public key of a signature whose r is x + p
+ */
+static const uint8_t gs_wrap_public_key[33] =
+{
+    0x04, 0x7D, 0x2D, 0x1D, 0xC5, 0x3E, 0x26, 0x88, 0x7E, 0x1D, 0x0E, 0xE8, 0x02, 0x22, 0x02, 0x5C, 0xB7,
+    0x3C, 0xFE, 0x74, 0x27, 0x94, 0xCD, 0xD3, 0x3C, 0x4C, 0xD7, 0xE3, 0xDE, 0xE4, 0x65, 0x85, 0x26,
+};
+
+/**
+ * @brief signature test signature of the first uid, u1 * g + u2 * q has x 3 and r is 3 + p
+ */
+static const uint8_t gs_wrap_signature[32] =
+{
+    0xFF, 0xFF, 0xFF, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+    0x1D, 0x2C, 0x3B, 0x4A, 0x59, 0x68, 0x77, 0x86, 0x95, 0xA4, 0xB3, 0xC2, 0xD1, 0xE0, 0xF0, 0xF1,
+};
+
+static mifare_ultralight_handle_t gs_handle;                  /**< mifare_ultralight handle */
+static mifare_ultralight_signature_key_t gs_key;              /**< signature key */
+static uint8_t gs_batch_uid[MIFARE_ULTRALIGHT_SIGNATURE_TEST_BATCH][7];               /**< batch uids */
+static uint8_t gs_batch_signature[MIFARE_ULTRALIGHT_SIGNATURE_TEST_BATCH][32];        /**< batch signatures */
+
+/**
+ * @brief     tamper a signature entry
+ * @param[in] i entry index
+ * @param[in] *uid pointer to a uid buffer
+ * @param[in] *signature pointer to a signature buffer
+ * @return    1 the entry is tampered, 0 the entry is kept
+ * @note      none
+ */
+static uint8_t a_signature_test_tamper(uint32_t i, uint8_t uid[7], uint8_t signature[32])
+{
+    memcpy(uid, gs_uid[i % 4], 7);
+    memcpy(signature, gs_signature[i % 4], 32);
+    switch (i % 5)
+    {
+        case 1 :
+        {
+            /* flip a bit of s */
+            signature[31] ^= 0x01;
+            
+            return 1;
+        }
+        case 2 :
+        {
+            /* flip a bit of the uid */
+            uid[3] ^= 0x80;
+            
+            return 1;
+        }
+        case 3 :
+        {
+            /* r is 0 */
+            memset(signature, 0, 16);
+            
+            return 1;
+        }
+        case 4 :
+        {
+            /* s is above the order */
+            memset(signature + 16, 0xFF, 16);
+            
+            return 1;
+        }
+        default :
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief  signature test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the card result is printed and not checked, emulated cards carry no real signature
+ */
+uint8_t mifare_ultralight_signature_test(void)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t passed;
+    uint32_t expect;
+    uint8_t uid[7];
+    uint8_t signature[32];
+    uint8_t public_key[33];
+    mifare_ultralight_bool_t valid;
+    mifare_ultralight_bool_t batch_valid[MIFARE_ULTRALIGHT_SIGNATURE_TEST_BATCH];
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_interface_contactless_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start signature test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start signature test.\n");
+    mifare_ultralight_interface_debug_print("mifare_ultralight: comb teeth is %d.\n", MIFARE_ULTRALIGHT_SIGNATURE_COMB_TEETH);
+    
+    /* invalid public keys */
+    memcpy(public_key, gs_public_key, 33);
+    public_key[0] = 0x02;
+    if (mifare_ultralight_signature_init(&gs_key, public_key) != 1)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: compressed key check failed.\n");
+        
+        return 1;
+    }
+    public_key[0] = 0x04;
+    public_key[32] ^= 0x01;
+    if (mifare_ultralight_signature_init(&gs_key, public_key) != 1)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: off curve key check failed.\n");
+        
+        return 1;
+    }
+    if (mifare_ultralight_signature_verify(&gs_key, gs_uid[0], gs_signature[0], &valid) != 3)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: uninitialized key check failed.\n");
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: invalid key check ok.\n");
+    
+    /* known signatures */
+    res = mifare_ultralight_signature_init(&gs_key, gs_public_key);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: signature init failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        res = mifare_ultralight_signature_verify(&gs_key, gs_uid[i], gs_signature[i], &valid);
+        if ((res != 0) || (valid != MIFARE_ULTRALIGHT_BOOL_TRUE))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: signature %d check failed.\n", (int)i);
+            
+            return 1;
+        }
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: known signatures check ok.\n");
+    
+    /* tampered signatures */
+    for (i = 1; i < 5; i++)
+    {
+        (void)a_signature_test_tamper(i, uid, signature);
+        res = mifare_ultralight_signature_verify(&gs_key, uid, signature, &valid);
+        if ((res != 0) || (valid != MIFARE_ULTRALIGHT_BOOL_FALSE))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: tampered signature %d check failed.\n", (int)i);
+            
+            return 1;
+        }
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: tampered signatures check ok.\n");
+    
+    /* batch verify */
+    expect = 0;
+    for (i = 0; i < MIFARE_ULTRALIGHT_SIGNATURE_TEST_BATCH; i++)
+    {
+        if (a_signature_test_tamper(i, gs_batch_uid[i], gs_batch_signature[i]) == 0)
+        {
+            expect++;
+        }
+    }
+    res = mifare_ultralight_signature_verify_batch(&gs_key, (const uint8_t (*)[7])gs_batch_uid, 
+                                                   (const uint8_t (*)[32])gs_batch_signature, 
+                                                   MIFARE_ULTRALIGHT_SIGNATURE_TEST_BATCH, batch_valid, &passed);
+    if ((res != 0) || (passed != expect))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: batch verify failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < MIFARE_ULTRALIGHT_SIGNATURE_TEST_BATCH; i++)
+    {
+        if ((batch_valid[i] == MIFARE_ULTRALIGHT_BOOL_TRUE) != ((i % 5) == 0))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: batch entry %d check failed.\n", (int)i);
+            
+            return 1;
+        }
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: batch verify %d/%d check ok.\n", 
+                                            (int)passed, MIFARE_ULTRALIGHT_SIGNATURE_TEST_BATCH);
+    
+    /* r is above the field prime, x mod n is never r */
+    res = mifare_ultralight_signature_init(&gs_key, gs_wrap_public_key);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: signature init failed.\n");
+        
+        return 1;
+    }
+    res = mifare_ultralight_signature_verify(&gs_key, gs_uid[0], gs_wrap_signature, &valid);
+    if ((res != 0) || (valid != MIFARE_ULTRALIGHT_BOOL_FALSE))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: r above the field prime check failed.\n");
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: r above the field prime check ok.\n");
+    
+    /* nxp key */
+    res = mifare_ultralight_signature_init(&gs_key, NULL);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: nxp key init failed.\n");
+        
+        return 1;
+    }
+    
+    /* init */
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* check the card */
+    res = mifare_ultralight_signature_check(&gs_handle, &gs_key, &valid);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: signature check failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: card signature is %s.\n", 
+                                            (valid == MIFARE_ULTRALIGHT_BOOL_TRUE) ? "genuine" : "not genuine");
+    
+    /* finish signature test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish signature test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}
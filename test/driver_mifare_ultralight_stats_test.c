@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_stats_test.c
+ * @brief     driver mifare_ultralight stats test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_stats_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
+static mifare_ultralight_stats_t gs_stats;          /**< statistics */
+static mifare_ultralight_stats_t gs_zero;           /**< cleared statistics */
+
+/**
+ * @brief     check the statistics
+ * @param[in] *name pointer to a case name
+ * @param[in] command counted command or MIFARE_ULTRALIGHT_STATS_COMMAND_MAX for every command
+ * @param[in] expect_frame expected frames of the command
+ * @param[in] error counted error or MIFARE_ULTRALIGHT_STATS_ERROR_MAX for none
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      every frame must be counted once in the commands and once in the latency,
+ *            the other commands and errors must be 0
+ */
+static uint8_t a_stats_test_check(const char *name, uint8_t command, uint32_t expect_frame, uint8_t error)
+{
+    uint8_t i;
+    uint8_t j;
+    uint32_t frames;
+    uint32_t latency;
+    uint32_t frame;
+    
+    frame = mifare_ultralight_test_helper_get_frame();
+    if (mifare_ultralight_get_stats(&gs_handle, &gs_stats) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s get stats failed.\n", name);
+        
+        return 1;
+    }
+    frames = 0;
+    latency = 0;
+    for (i = 0; i < MIFARE_ULTRALIGHT_STATS_COMMAND_MAX; i++)
+    {
+        frames += gs_stats.command[i];
+        for (j = 0; j < MIFARE_ULTRALIGHT_STATS_BUCKET; j++)
+        {
+            latency += gs_stats.latency[i][j];
+        }
+        if ((command != MIFARE_ULTRALIGHT_STATS_COMMAND_MAX) && (i != command) && (gs_stats.command[i] != 0))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: %s command %d is counted.\n", name, i);
+            
+            return 1;
+        }
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s frame %d counted %d latency %d tx %d rx %d.\n", name, 
+                                            (int)frame, (int)frames, (int)latency, (int)gs_stats.tx_bytes, (int)gs_stats.rx_bytes);
+    if ((frames != expect_frame) || (latency != expect_frame) || (frame != expect_frame))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s frame number is wrong.\n", name);
+        
+        return 1;
+    }
+    if ((expect_frame != 0) && ((gs_stats.tx_bytes == 0) || (gs_stats.rx_bytes == 0)))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s bytes are not counted.\n", name);
+        
+        return 1;
+    }
+    for (i = 0; i < MIFARE_ULTRALIGHT_STATS_ERROR_MAX; i++)
+    {
+        if (gs_stats.error[i] != ((i == error) ? 1U : 0U))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: %s error %d is %d.\n", name, i, (int)gs_stats.error[i]);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     reset the statistics and check them
+ * @param[in] *name pointer to a case name
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      every field must be 0 after the reset
+ */
+static uint8_t a_stats_test_reset(const char *name)
+{
+    mifare_ultralight_test_helper_start();
+    if ((mifare_ultralight_reset_stats(&gs_handle) != 0) || 
+        (mifare_ultralight_get_stats(&gs_handle, &gs_stats) != 0))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s reset stats failed.\n", name);
+        
+        return 1;
+    }
+    if (memcmp(&gs_stats, &gs_zero, sizeof(mifare_ultralight_stats_t)) != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s statistics are not cleared.\n", name);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s cleared.\n", name);
+    
+    return 0;
+}
+#endif
+
+/**
+ * @brief  stats test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   MIFARE_ULTRALIGHT_STATS must be 1
+ */
+uint8_t mifare_ultralight_stats_test(void)
+{
+#if (MIFARE_ULTRALIGHT_STATS != 0)
+    uint8_t res;
+    uint8_t data[4];
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start stats test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start stats test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(NULL);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    if ((mifare_ultralight_reset_stats(NULL) != 2) || (mifare_ultralight_get_stats(NULL, &gs_stats) != 2))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: null handle check failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* every frame of the activation is counted */
+    mifare_ultralight_test_helper_start();
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if ((res != 0) || (a_stats_test_check("activate", MIFARE_ULTRALIGHT_STATS_COMMAND_MAX, 
+                                                 mifare_ultralight_test_helper_get_frame(), MIFARE_ULTRALIGHT_STATS_ERROR_MAX) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a reset clears the counters, the bytes and the latency */
+    if (a_stats_test_reset("first reset") != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* only the frames after the reset are counted */
+    res = mifare_ultralight_read_page(&gs_handle, 4, data);
+    if ((res != 0) || (a_stats_test_check("read", MIFARE_ULTRALIGHT_STATS_COMMAND_READ, 1, MIFARE_ULTRALIGHT_STATS_ERROR_MAX) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the short nak of a read is counted as an output length error */
+    if (a_stats_test_reset("second reset") != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = mifare_ultralight_read_page(&gs_handle, 0xF0, data);
+    if ((res == 0) || (a_stats_test_check("read out of range", MIFARE_ULTRALIGHT_STATS_COMMAND_READ, 1, 
+                                          MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* deinit and init keep the statistics */
+    (void)mifare_ultralight_deinit(&gs_handle);
+    if ((mifare_ultralight_init(&gs_handle) != 0) || 
+        (a_stats_test_check("init again", MIFARE_ULTRALIGHT_STATS_COMMAND_READ, 1, MIFARE_ULTRALIGHT_STATS_ERROR_OUTPUT_LEN) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (a_stats_test_reset("last reset") != 0)
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish stats test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish stats test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+#else
+    mifare_ultralight_interface_debug_print("mifare_ultralight: stats is not compiled in.\n");
+    
+    return 1;
+#endif
+}
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_test_helper.c
+ * @brief     driver mifare_ultralight test helper source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_test_helper.h"
+
+static uint32_t gs_frame;                                                                      /**< frame counter */
+static uint32_t gs_drop;                                                                       /**< frame whose response is dropped, 0 means none */
+static uint32_t gs_lose;                                                                       /**< frame lost before the card, 0 means none */
+static uint8_t (*gs_hook)(uint8_t *in_buf, uint8_t in_len, uint8_t *out_buf, 
+                          uint8_t *out_len);                                                   /**< response hook */
+static uint8_t (*gs_bits)(uint8_t *in_buf, uint8_t in_bits, uint8_t *out_buf, 
+                          uint8_t *out_bits, uint8_t *collision);                              /**< bit transceiver */
+
+/**
+ * @brief     reset the test helper
+ * @param[in] *transceiver_bits pointer to a contactless_transceiver_bits function, NULL for none
+ * @note      the frame counter, the faults and the hook are cleared
+ */
+void mifare_ultralight_test_helper_reset(uint8_t (*transceiver_bits)(uint8_t *in_buf, uint8_t in_bits, uint8_t *out_buf,
+                                                                     uint8_t *out_bits, uint8_t *collision))
+{
+    gs_frame = 0;
+    gs_drop = 0;
+    gs_lose = 0;
+    gs_hook = NULL;
+    gs_bits = transceiver_bits;
+}
+
+/**
+ * @brief         transceiver with a frame counter
+ * @param[in]     *in_buf pointer to an input buffer
+ * @param[in]     in_len input length
+ * @param[out]    *out_buf pointer to an output buffer
+ * @param[in,out] *out_len pointer to an output length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 transceiver failed
+ * @note          a lost frame never reaches the card, a dropped frame still runs on the card,
+ *                the hook may change the response of a frame that is not dropped
+ */
+uint8_t mifare_ultralight_test_helper_transceiver(uint8_t *in_buf, uint8_t in_len, uint8_t *out_buf, uint8_t *out_len)
+{
+    uint8_t res;
+    
+    /* lose the frame */
+    gs_frame++;
+    if (gs_frame == gs_lose)
+    {
+        gs_lose = 0;
+        
+        return 1;
+    }
+    
+    /* run the frame */
+    res = mifare_ultralight_interface_contactless_transceiver(in_buf, in_len, out_buf, out_len);
+    if (res != 0)
+    {
+        return res;
+    }
+    
+    /* drop the response */
+    if (gs_frame == gs_drop)
+    {
+        gs_drop = 0;
+        
+        return 1;
+    }
+    
+    /* change the response */
+    if (gs_hook != NULL)
+    {
+        return gs_hook(in_buf, in_len, out_buf, out_len);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      bit transceiver with a frame counter
+ * @param[in]  *in_buf pointer to an input buffer
+ * @param[in]  in_bits input bit number
+ * @param[out] *out_buf pointer to an output buffer
+ * @param[out] *out_bits pointer to an output bit number buffer
+ * @param[out] *collision pointer to a collision index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 transceiver failed
+ * @note       the frame runs on the transceiver_bits function of the reset
+ */
+uint8_t mifare_ultralight_test_helper_transceiver_bits(uint8_t *in_buf, uint8_t in_bits, uint8_t *out_buf, 
+                                                       uint8_t *out_bits, uint8_t *collision)
+{
+    gs_frame++;
+    if (gs_bits == NULL)
+    {
+        return 1;
+    }
+    
+    return gs_bits(in_buf, in_bits, out_buf, out_bits, collision);
+}
+
+/**
+ * @brief     set the frame faults
+ * @param[in] drop frame whose response is dropped, 0 means none
+ * @param[in] lose frame lost before the card, 0 means none
+ * @note      the frames are counted from the case start and each fault is used once
+ */
+void mifare_ultralight_test_helper_set_fault(uint32_t drop, uint32_t lose)
+{
+    gs_drop = drop;
+    gs_lose = lose;
+}
+
+/**
+ * @brief     set the response hook
+ * @param[in] *hook pointer to a hook function, NULL for none
+ * @note      the hook runs after each frame answered by the card and returns the transceiver result
+ */
+void mifare_ultralight_test_helper_set_hook(uint8_t (*hook)(uint8_t *in_buf, uint8_t in_len, uint8_t *out_buf, uint8_t *out_len))
+{
+    gs_hook = hook;
+}
+
+/**
+ * @brief  start a case
+ * @note   the frame counter is cleared
+ */
+void mifare_ultralight_test_helper_start(void)
+{
+    gs_frame = 0;
+}
+
+/**
+ * @brief  get the frame number
+ * @return frame number since the case start
+ * @note   none
+ */
+uint32_t mifare_ultralight_test_helper_get_frame(void)
+{
+    return gs_frame;
+}
+
+/**
+ * @brief     check the result and the frame number of a case
+ * @param[in] *name pointer to a case name
+ * @param[in] res result of the case
+ * @param[in] expect_res expected result
+ * @param[in] expect_frame expected frame number
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the result and the frame number are printed
+ */
+uint8_t mifare_ultralight_test_helper_check(const char *name, uint8_t res, uint8_t expect_res, uint32_t expect_frame)
+{
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s res %d frame %d.\n", name, res, (int)gs_frame);
+    
+    /* check the result */
+    if (res != expect_res)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s result is wrong.\n", name);
+        
+        return 1;
+    }
+    if (gs_frame != expect_frame)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s frame number is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,223 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_trace_test.c
+ * @brief     driver mifare_ultralight trace test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+
+#include "driver_mifare_ultralight_trace_test.h"
+
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
+static mifare_ultralight_trace_t gs_trace;          /**< trace ring */
+
+/**
+ * @brief     read pages to fill the trace ring
+ * @param[in] reads read number
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      read i reads page i % 16 and records a sent and a received entry
+ */
+static uint8_t a_trace_test_produce(uint32_t reads)
+{
+    uint32_t i;
+    uint8_t data[16];
+    
+    for (i = 0; i < reads; i++)
+    {
+        if (mifare_ultralight_read_page(&gs_handle, (uint8_t)(i & 0x0F), data) != 0)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: read page failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     read the trace ring
+ * @param[in] *name pointer to a case name
+ * @param[in] head head index before the reads
+ * @param[in] reads read number
+ * @param[in] expect_lost expected lost entries
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      entry k of the reads is sent when k is even and received when k is odd,
+ *            the first entry read is entry expect_lost
+ */
+static uint8_t a_trace_test_case(const char *name, uint32_t head, uint32_t reads, uint32_t expect_lost)
+{
+    uint32_t k;
+    uint32_t count;
+    mifare_ultralight_trace_entry_t entry;
+    
+    /* set the ring indexes */
+    gs_trace.head = head;
+    gs_trace.tail = head;
+    gs_trace.lost = 0;
+    
+    /* fill the ring */
+    if (a_trace_test_produce(reads) != 0)
+    {
+        return 1;
+    }
+    
+    /* read the ring */
+    count = 0;
+    while (mifare_ultralight_read_trace(&gs_handle, &entry) == 0)
+    {
+        k = expect_lost + count;
+        if ((entry.dir != (((k & 1) != 0) ? MIFARE_ULTRALIGHT_TRACE_DIR_RX : MIFARE_ULTRALIGHT_TRACE_DIR_TX)) || 
+            (entry.command != 0x30) || 
+            ((entry.dir == MIFARE_ULTRALIGHT_TRACE_DIR_TX) && (entry.data[1] != ((k / 2) & 0x0F))) || 
+            ((entry.dir == MIFARE_ULTRALIGHT_TRACE_DIR_RX) && ((entry.res != 0) || (entry.len != 18))))
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: %s entry %d is wrong.\n", name, (int)k);
+            
+            return 1;
+        }
+        count++;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s head 0x%08X entries %d lost %d.\n", 
+                                            name, (unsigned int)gs_trace.head, (int)count, (int)gs_trace.lost);
+    
+    /* check the result */
+    if ((gs_trace.lost != expect_lost) || (count != 2 * reads - expect_lost))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s entry number is wrong.\n", name);
+        
+        return 1;
+    }
+    if (gs_trace.tail != gs_trace.head)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: %s tail is wrong.\n", name);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+#endif
+
+/**
+ * @brief  trace test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   MIFARE_ULTRALIGHT_TRACE must be 1, the trace ring is read after it wraps and overruns
+ */
+uint8_t mifare_ultralight_trace_test(void)
+{
+#if (MIFARE_ULTRALIGHT_TRACE != 0)
+    uint8_t res;
+    const uint32_t depth = MIFARE_ULTRALIGHT_TRACE_DEPTH;
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_interface_contactless_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_TIMESTAMP_US(&gs_handle, mifare_ultralight_interface_timestamp_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start trace test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start trace test.\n");
+    
+    /* init */
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set the trace ring */
+    res = mifare_ultralight_set_trace(&gs_handle, &gs_trace);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: set trace failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the slot written next is never read, so a full ring loses its oldest entry */
+    if ((a_trace_test_case("short", 0, 5, 0) != 0) || 
+        (a_trace_test_case("almost full", 0, depth / 2 - 1, 0) != 0) || 
+        (a_trace_test_case("full", 0, depth / 2, 1) != 0) || 
+        (a_trace_test_case("overrun", 0, depth + 8, depth + 17) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the indexes wrap around 32 bits */
+    if ((a_trace_test_case("index wrap", 0xFFFFFFF8U, 10, 0) != 0) || 
+        (a_trace_test_case("index wrap overrun", 0xFFFFFFF0U, depth, depth + 1) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish trace test */
+    (void)mifare_ultralight_set_trace(&gs_handle, NULL);
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish trace test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+#else
+    mifare_ultralight_interface_debug_print("mifare_ultralight: trace is not compiled in.\n");
+    
+    return 1;
+#endif
+}
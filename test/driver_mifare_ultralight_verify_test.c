@@ -0,0 +1,214 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_mifare_ultralight_verify_test.c
+ * @brief     driver mifare_ultralight verify test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_mifare_ultralight_verify_test.h"
+#include "driver_mifare_ultralight_test_helper.h"
+#include <stdlib.h>
+
+static mifare_ultralight_handle_t gs_handle;        /**< mifare_ultralight handle */
+static uint8_t gs_corrupt;                          /**< corrupt the next fast read response */
+
+/**
+ * @brief         response hook with a corrupted read back
+ * @param[in]     *in_buf pointer to an input buffer
+ * @param[in]     in_len input length
+ * @param[out]    *out_buf pointer to an output buffer
+ * @param[in,out] *out_len pointer to an output length buffer
+ * @return        status code
+ *                - 0 success
+ * @note          the first byte of the response is inverted with a valid crc, the corruption is used once
+ */
+static uint8_t a_verify_test_hook(uint8_t *in_buf, uint8_t in_len, uint8_t *out_buf, uint8_t *out_len)
+{
+    (void)in_len;
+    
+    /* corrupt the fast read response */
+    if ((gs_corrupt != 0) && (in_buf[0] == 0x3A) && (*out_len > 2))
+    {
+        gs_corrupt = 0;
+        out_buf[0] ^= 0xFF;
+        mifare_ultralight_crc_final(mifare_ultralight_crc_update(mifare_ultralight_crc_init(), out_buf, (uint16_t)(*out_len - 2)), 
+                                    out_buf + *out_len - 2);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run a verified write of page 4, 6, 9 and 15
+ * @param[in] *name pointer to a case name
+ * @param[in] retry rewrite rounds of the commit
+ * @param[in] corrupt 1 corrupts the first read back
+ * @param[in] expect_frame expected frame number of the commit
+ * @param[in] expect_frames expected fast read frames
+ * @param[in] expect_rewritten expected rewritten pages
+ * @param[in] expect_mismatched expected mismatched pages
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the corruption hits page 4
+ */
+static uint8_t a_verify_test_verified_write(const char *name, uint8_t retry, uint8_t corrupt, uint32_t expect_frame,
+                                          uint8_t expect_frames, uint8_t expect_rewritten, uint8_t expect_mismatched)
+{
+    uint8_t res;
+    uint8_t p;
+    uint8_t i;
+    uint8_t mismatched;
+    uint8_t data[4];
+    mifare_ultralight_verify_t verify;
+    
+    /* verify begin */
+    res = mifare_ultralight_verify_begin(&gs_handle, &verify);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: verify begin failed.\n");
+        
+        return 1;
+    }
+    for (p = 4; p <= 15; p++)
+    {
+        if ((p != 4) && (p != 6) && (p != 9) && (p != 15))
+        {
+            continue;
+        }
+        for (i = 0; i < 4; i++)
+        {
+            data[i] = rand() % 256;
+        }
+        res = mifare_ultralight_write_page(&gs_handle, p, data);
+        if (res != 0)
+        {
+            mifare_ultralight_interface_debug_print("mifare_ultralight: write page failed.\n");
+            (void)mifare_ultralight_verify_abort(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* verify commit */
+    mifare_ultralight_test_helper_start();
+    gs_corrupt = corrupt;
+    res = mifare_ultralight_verify_commit(&gs_handle, retry, &mismatched);
+    gs_corrupt = 0;
+    if (mifare_ultralight_test_helper_check(name, res, 0, expect_frame) != 0)
+    {
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: %s verify frames %d, rewritten pages %d, mismatched pages %d.\n", 
+                                            name, verify.frames, verify.rewritten, mismatched);
+    
+    /* check the result */
+    if ((verify.frames != expect_frames) || 
+        (verify.rewritten != expect_rewritten) || (mismatched != expect_mismatched))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: check %s error.\n", name);
+        
+        return 1;
+    }
+    if ((expect_mismatched != 0) && (verify.mismatch[0] != (1 << 4)))
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: check %s mismatched page error.\n", name);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: check %s ok.\n", name);
+    
+    return 0;
+}
+
+/**
+ * @brief  verify test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   pages 4, 6, 9 and 15 are written with random data
+ */
+uint8_t mifare_ultralight_verify_test(void)
+{
+    uint8_t res;
+    mifare_ultralight_activation_t activation;
+    
+    /* link functions */
+    DRIVER_MIFARE_ULTRALIGHT_LINK_INIT(&gs_handle, mifare_ultralight_handle_t);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_INIT(&gs_handle, mifare_ultralight_interface_contactless_init);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_DEINIT(&gs_handle, mifare_ultralight_interface_contactless_deinit);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_CONTACTLESS_TRANSCEIVER(&gs_handle, mifare_ultralight_test_helper_transceiver);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_MS(&gs_handle, mifare_ultralight_interface_delay_ms);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DELAY_US(&gs_handle, mifare_ultralight_interface_delay_us);
+    DRIVER_MIFARE_ULTRALIGHT_LINK_DEBUG_PRINT(&gs_handle, mifare_ultralight_interface_debug_print);
+    
+    /* start verify test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: start verify test.\n");
+    
+    /* init */
+    mifare_ultralight_test_helper_reset(NULL);
+    mifare_ultralight_test_helper_set_hook(a_verify_test_hook);
+    res = mifare_ultralight_init(&gs_handle);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* activate the card */
+    res = mifare_ultralight_activate(&gs_handle, MIFARE_ULTRALIGHT_ACTIVATE_POLICY_WAKE_UP, &activation);
+    if (res != 0)
+    {
+        mifare_ultralight_interface_debug_print("mifare_ultralight: activate failed.\n");
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    mifare_ultralight_interface_debug_print("mifare_ultralight: verified write page 4, 6, 9 and 15.\n");
+    
+    /* a clean read back, a rewritten corruption and a corruption without retry */
+    if ((a_verify_test_verified_write("verified write", 1, 0, 1, 1, 0, 0) != 0) || 
+        (a_verify_test_verified_write("verified rewrite", 1, 1, 3, 2, 1, 0) != 0) || 
+        (a_verify_test_verified_write("verified mismatch", 0, 1, 1, 1, 0, 1) != 0))
+    {
+        (void)mifare_ultralight_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* finish verify test */
+    mifare_ultralight_interface_debug_print("mifare_ultralight: finish verify test.\n");
+    (void)mifare_ultralight_deinit(&gs_handle);
+    
+    return 0;
+}